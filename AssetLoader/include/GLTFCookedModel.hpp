@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Cooked binary cache of a fully built GLTF model.
+
+#include <string>
+#include <vector>
+
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/Sampler.h"
+#include "../../../DiligentCore/Common/interface/XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+struct Model;
+struct ModelCreateInfo;
+
+/// Reads and writes the cooked representation of a GLTF model.
+///
+/// A cooked file stores everything ModelBuilder and MeshLoader produce from the source
+/// document: the node, mesh, camera, light, skin, material and animation tables, the
+/// converted index data and the converted per-buffer vertex data, together with the
+/// texture references and sampler descriptions needed to bind textures. The file starts
+/// with a fixed header followed by a table of 16-byte aligned blobs, so that index and
+/// vertex data can be copied directly from a memory-mapped view of the file.
+///
+/// The file is keyed by a hash of the file name, the resolved vertex and texture layouts
+/// and the load settings. It also stores the size, the modification time and a hash of the
+/// contents of the source file. The source file is hashed again only when its size matches
+/// but the modification time differs or is not available, so an unchanged source file is
+/// not read when the model is restored. A file whose version, key or source does not match
+/// is ignored and overwritten with a fresh one.
+class CookedModel
+{
+public:
+    static constexpr Uint32 Version = 9;
+
+    /// Source file identity stored in the cooked file.
+    struct SourceInfo
+    {
+        /// Size of the source file in bytes.
+        Uint64 Size = 0;
+
+        /// Platform-specific modification time of the source file, or 0 if it is not available
+        /// (e.g. when the file is read by ModelCreateInfo::ReadWholeFileCallback).
+        Uint64 ModificationTime = 0;
+
+        /// Hash of the source file contents.
+        XXH128Hash ContentHash;
+    };
+
+    /// Texture referenced by the cooked model.
+    struct TextureRef
+    {
+        /// Texture cache id (the resolved image path). Empty for embedded images.
+        std::string CacheId;
+
+        /// Index of the sampler in the samplers array, or -1 if the texture uses the default sampler.
+        int SamplerId = -1;
+    };
+
+    /// Returns true if the model can be loaded from or saved to a cooked file.
+    ///
+    /// Models that use node, mesh, primitive or material load callbacks are not
+    /// cacheable, because the callbacks require the source GLTF objects.
+    static bool IsCacheable(const ModelCreateInfo& CI);
+
+    /// Computes the cache key from the source file name, the resolved layout of the model and the load settings.
+    static bool ComputeKey(const Model& Mdl, const ModelCreateInfo& CI, XXH128Hash& Key);
+
+    /// Reads the size and the modification time of the source file and hashes its contents.
+    ///
+    /// The modification time is read before the contents, so a file that is modified while
+    /// the model is being built is detected when the cooked file is read next time.
+    static bool GetSourceInfo(const ModelCreateInfo& CI, SourceInfo& Info);
+
+    /// Writes the model, its texture references and the converted index and vertex data to the cooked file.
+    static bool Write(const char*                            FilePath,
+                      const XXH128Hash&                      Key,
+                      const SourceInfo&                      Source,
+                      const Model&                           Mdl,
+                      const std::vector<TextureRef>&         Textures,
+                      const std::vector<SamplerDesc>&        Samplers,
+                      const std::vector<Uint8>&              IndexData,
+                      const std::vector<std::vector<Uint8>>& VertexData);
+
+    /// Reads the model, its texture references and the converted index and vertex data from the cooked file.
+    ///
+    /// Returns false if the file does not exist, was produced by a different version
+    /// or from a different source, or is corrupted. The model is not modified in this case.
+    static bool Read(const char*                      FilePath,
+                     const XXH128Hash&                Key,
+                     const ModelCreateInfo&           CI,
+                     Model&                           Mdl,
+                     std::vector<TextureRef>&         Textures,
+                     std::vector<SamplerDesc>&        Samplers,
+                     std::vector<Uint8>&              IndexData,
+                     std::vector<std::vector<Uint8>>& VertexData);
+
+private:
+    class TableWriter;
+    class TableReader;
+
+    static void WriteTables(TableWriter&                    Writer,
+                            const Model&                    Mdl,
+                            const std::vector<TextureRef>&  Textures,
+                            const std::vector<SamplerDesc>& Samplers);
+
+    static bool ReadTables(TableReader&              Reader,
+                           Model&                    Mdl,
+                           std::vector<TextureRef>&  Textures,
+                           std::vector<SamplerDesc>& Samplers);
+};
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Read-only memory-mapped file.
+
+#include <memory>
+
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Read-only view of a whole file mapped into the process address space.
+///
+/// The view remains valid until the object is destroyed.
+class MemoryMappedFile
+{
+public:
+    /// Maps the whole file into memory.
+    ///
+    /// Returns null if the file cannot be opened or is empty, or if memory
+    /// mapping is not supported on the platform. In this case, the caller
+    /// is expected to fall back to reading the file.
+    static std::unique_ptr<MemoryMappedFile> Open(const char* FilePath);
+
+    ~MemoryMappedFile();
+
+    // clang-format off
+    MemoryMappedFile           (const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    // clang-format on
+
+    const Uint8* GetData() const { return m_pData; }
+    size_t       GetSize() const { return m_Size; }
+
+private:
+    MemoryMappedFile(const Uint8* pData, size_t Size) :
+        m_pData{pData},
+        m_Size{Size}
+    {}
+
+    const Uint8* const m_pData;
+    const size_t       m_Size;
+};
+
+} // namespace Diligent
@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Helpers to split work into thread pool tasks.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Processes the range [0, Count) in chunks of ChunkSize elements using the thread pool.
+///
+/// Handler(Start, End) is called once for every chunk. The calling thread processes the first
+/// chunk, then claims the chunks that no worker has started yet, and finally waits for the tasks
+/// that are processing the remaining chunks. Only the tasks enqueued by this function are waited
+/// for, so the function does not block on unrelated work in a shared pool, and it does not
+/// deadlock when called from a pool task while all other workers are busy.
+///
+/// If pThreadPool is null or the range fits in one chunk, all chunks are processed on the calling thread.
+template <typename HandlerType>
+void ProcessChunksAsync(IThreadPool* pThreadPool, size_t Count, size_t ChunkSize, HandlerType&& Handler)
+{
+    ChunkSize = std::max(ChunkSize, size_t{1});
+    if (pThreadPool == nullptr || Count <= ChunkSize)
+    {
+        if (Count > 0)
+            Handler(size_t{0}, Count);
+        return;
+    }
+
+    const size_t NumChunks = (Count + ChunkSize - 1) / ChunkSize;
+
+    // A task that starts after the calling thread has claimed its chunk must not touch the handler,
+    // so the claim flags are shared with the tasks rather than kept on the stack.
+    std::shared_ptr<std::vector<std::atomic<bool>>> pClaimed = std::make_shared<std::vector<std::atomic<bool>>>(NumChunks);
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks(NumChunks);
+    for (size_t Chunk = 1; Chunk < NumChunks; ++Chunk)
+    {
+        const size_t Start = Chunk * ChunkSize;
+        const size_t End   = std::min(Start + ChunkSize, Count);
+
+        Tasks[Chunk] = EnqueueAsyncWork(pThreadPool,
+                                        [pClaimed, &Handler, Chunk, Start, End](Uint32 ThreadId) {
+                                            if (!(*pClaimed)[Chunk].exchange(true))
+                                                Handler(Start, End);
+                                            return ASYNC_TASK_STATUS_COMPLETE;
+                                        });
+    }
+
+    Handler(size_t{0}, ChunkSize);
+
+    for (size_t Chunk = 1; Chunk < NumChunks; ++Chunk)
+    {
+        if (!(*pClaimed)[Chunk].exchange(true))
+        {
+            const size_t Start = Chunk * ChunkSize;
+            Handler(Start, std::min(Start + ChunkSize, Count));
+        }
+        else if (Tasks[Chunk])
+        {
+            // The chunk has been claimed by its task, which is running or complete
+            Tasks[Chunk]->WaitForCompletion();
+        }
+    }
+}
+
+} // namespace Diligent
@@ -171,6 +171,12 @@ private:
                    int                  GltfMeshIndex,
                    MeshLoaderType&      MeshLoader);
 
+    // Loads the instance transforms defined by the EXT_mesh_gpu_instancing extension.
+    template <typename GltfModelType, typename GltfNodeType>
+    void LoadInstanceMatrices(const GltfModelType& GltfModel,
+                              const GltfNodeType&  GltfNode,
+                              Node&                NewNode);
+
     template <typename GltfModelType>
     Camera* LoadCamera(const GltfModelType& GltfModel,
                        int                  GltfCameraIndex);
@@ -228,6 +234,34 @@ public:
 
     Mesh* GetLoadedMesh(int LoadedMeshId);
 
+    const std::vector<Uint8>&              GetIndexData() const { return m_IndexData; }
+    const std::vector<std::vector<Uint8>>& GetVertexData() const { return m_VertexData; }
+
+    // Replaces the converted index and vertex data, e.g. with the data restored from a cooked model file.
+    void SetData(std::vector<Uint8>&& IndexData, std::vector<std::vector<Uint8>>&& VertexData);
+
+    // Reorders the triangles of all loaded primitives for the post-transform vertex cache
+    // and, optionally, overdraw, and renumbers the vertices in the order of first use
+    // (see ModelCreateInfo::OptimizeVertexCache).
+    void OptimizePrimitives();
+
+    // Generates simplified index ranges for all loaded indexed primitives
+    // (see ModelCreateInfo::LODCount).
+    void BuildLODs();
+
+    // Splits the triangles of all loaded primitives into meshlets
+    // (see ModelCreateInfo::BuildMeshlets).
+    void BuildMeshlets();
+
+    // Builds the triangle hierarchies of all meshes from the converted index and vertex data
+    // (see ModelCreateInfo::BuildRayCastBVHs). Only uses the loaded primitives, so it also
+    // works with the data restored from a cooked model file.
+    void BuildRayCastBVHs();
+
+    // Computes the joint-space bounds of the vertices influenced by every joint of every skin
+    // (see ModelCreateInfo::ComputeJointBounds). Like BuildRayCastBVHs, only uses the loaded primitives.
+    void ComputeJointBounds();
+
     template <typename GltfModelType>
     Mesh* LoadMesh(const GltfModelType& GltfModel,
                    int                  GltfMeshIndex,
@@ -250,12 +284,63 @@ private:
         };
     };
 
+    // Index and vertex ranges of a loaded primitive. Unlike Primitive::FirstVertex,
+    // FirstVertex is the start of the vertex range even if the primitive is indexed.
+    struct PrimitiveRange
+    {
+        Uint32 FirstIndex  = 0;
+        Uint32 IndexCount  = 0;
+        Uint32 FirstVertex = 0;
+        Uint32 VertexCount = 0;
+
+        int    MeshId      = -1;
+        Uint32 PrimitiveId = 0;
+
+        // The size of the primitive indices and the value added to the stored indices,
+        // which is FirstVertex unless the indices are narrowed or shared (see ModelCreateInfo::NarrowIndices
+        // and ModelCreateInfo::DeduplicateMeshData).
+        Uint32 IndexSize = 0;
+        Uint32 IndexBase = 0;
+
+        // Morph target deltas reference the vertices in their original order.
+        bool HasMorphTargets = false;
+
+        // Points, lines and triangle strips or fans are loaded, but are not split into meshlets.
+        bool IsTriangleList = true;
+    };
+
     void WriteDefaultAttibutes(Uint32 BufferId, size_t StartOffset, size_t EndOffset);
 
+    // Allocates the index and vertex data of every primitive separately and shares the allocations
+    // with other models that have identical primitives (see ModelCreateInfo::DeduplicateMeshData).
+    void InitSharedIndexData(IRenderDevice* pDevice);
+    void InitSharedVertexData(IRenderDevice* pDevice, const ResourceManager::VertexLayoutKey& LayoutKey);
+
+    void ReadIndices(const PrimitiveRange& Range, Uint32* pIndices) const;
+    void WriteIndices(const PrimitiveRange& Range, const Uint32* pIndices);
+
+    // Returns the range of the loaded primitive. The index count is rounded down to whole triangles.
+    PrimitiveRange GetPrimitiveRange(size_t MeshId, Uint32 PrimId) const;
+
+    // Reads the float3 or AABB-quantized positions of the range. Returns false if positions are stored in a different format.
+    bool ReadPositions(const PrimitiveRange& Range, std::vector<float3>& Positions) const;
+
+    // Reads up to four components of the attribute of the range converted to floats. Returns false if the attribute is not available.
+    bool ReadAttribute(const PrimitiveRange& Range, const char* Name, bool IsNormalized, std::vector<float4>& Values) const;
+
+    // Reads the morph target deltas of the primitive into Model::MorphTargets, skipping zero deltas.
+    template <typename GltfModelType, typename GltfPrimitiveType>
+    void LoadMorphTargets(const GltfModelType&     GltfModel,
+                          const GltfPrimitiveType& GltfPrimitive,
+                          Uint32                   VertexCount,
+                          Primitive&               Prim);
+
     template <typename GltfModelType>
     Uint32 ConvertVertexData(const GltfModelType& GltfModel,
                              const PrimitiveKey&  Key,
-                             Uint32               VertexCount);
+                             Uint32               VertexCount,
+                             const float3&        PosMin,
+                             const float3&        PosMax);
 
     template <typename SrcType, typename DstType>
     inline static void WriteIndexData(const void*                  pSrc,
@@ -267,7 +352,13 @@ private:
     template <typename GltfModelType>
     Uint32 ConvertIndexData(const GltfModelType& GltfModel,
                             int                  AccessorId,
-                            Uint32               BaseVertex);
+                            Uint32               BaseVertex,
+                            Uint32               IndexSize);
+
+    // Resizes the index data to hold IndexCount more indices of the given size and returns the index
+    // of the first one. The data size is kept a multiple of the model index size, so that the ranges
+    // of the model index type stay aligned.
+    Uint32 AllocateIndices(Uint32 IndexSize, size_t IndexCount);
 
 private:
     const ModelCreateInfo&          m_CI;
@@ -277,7 +368,13 @@ private:
 
     std::unordered_map<PrimitiveKey, Uint32, PrimitiveKey::Hasher> m_PrimitiveOffsets;
 
+    std::vector<PrimitiveRange> m_PrimitiveRanges;
+
     int m_DefaultMaterialId = -1;
+
+    // Whether positions are quantized relative to the primitive bounding boxes, which
+    // then must be computed from the vertex positions.
+    bool m_HasQuantizedPositions = false;
 };
 
 template <typename GltfModelType>
@@ -451,9 +548,7 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
     {
         const auto& GltfPrimitive = GltfMesh.GetPrimitive(prim);
 
-        const auto DstIndexSize = m_Model.IndexData.IndexSize;
-
-        uint32_t IndexStart  = static_cast<uint32_t>(m_IndexData.size()) / DstIndexSize;
+        uint32_t IndexStart  = 0;
         uint32_t VertexStart = 0;
         uint32_t IndexCount  = 0;
         uint32_t VertexCount = 0;
@@ -481,7 +576,7 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
 
                 PosMin = PosAccessor.GetMinValues();
                 PosMax = PosAccessor.GetMaxValues();
-                if (m_CI.ComputeBoundingBoxes)
+                if (m_CI.ComputeBoundingBoxes || m_HasQuantizedPositions)
                 {
                     ComputePrimitiveBoundingBox(GetGltfDataInfo(GltfModel, *pPosAttribId), PosMin, PosMax);
                 }
@@ -492,7 +587,7 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
             auto offset_it = m_PrimitiveOffsets.find(Key);
             if (offset_it == m_PrimitiveOffsets.end())
             {
-                auto Offset = ConvertVertexData(GltfModel, Key, VertexCount);
+                auto Offset = ConvertVertexData(GltfModel, Key, VertexCount, PosMin, PosMax);
                 VERIFY_EXPR(Offset != ~0u);
                 offset_it = m_PrimitiveOffsets.emplace(Key, Offset).first;
             }
@@ -507,11 +602,26 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
         }
 
         // Indices
+        VALUE_TYPE IndexType = VT_UNDEFINED;
         if (GltfPrimitive.GetIndicesId() >= 0)
         {
-            IndexCount = ConvertIndexData(GltfModel, GltfPrimitive.GetIndicesId(), VertexStart);
-            // Vertex offset is baked into the indices
-            VertexStart = 0;
+            // Indices of small primitives are stored as 16-bit values relative to the vertex range.
+            // 0xFFFF is excluded since it is the strip cut value. Shared primitive indices are also
+            // relative to the vertex range, so that they do not depend on its position in the model.
+            const bool   NarrowIndices = m_CI.NarrowIndices && m_Model.IndexData.IndexSize == 4 && VertexCount <= 0xFFFF;
+            const Uint32 IndexSize     = NarrowIndices ? 2 : m_Model.IndexData.IndexSize;
+            const Uint32 IndexBase     = NarrowIndices || m_CI.DeduplicateMeshData ? 0 : VertexStart;
+
+            IndexStart = static_cast<uint32_t>(m_IndexData.size() / IndexSize);
+            IndexCount = ConvertIndexData(GltfModel, GltfPrimitive.GetIndicesId(), IndexBase, IndexSize);
+            IndexType  = IndexSize == 4 ? VT_UINT32 : VT_UINT16;
+            m_PrimitiveRanges.push_back({IndexStart, IndexCount, VertexStart, VertexCount, LoadedMeshId, static_cast<Uint32>(prim), IndexSize, IndexBase});
+            // Vertex offset is either baked into the indices or is the base vertex of the narrowed indices
+            VertexStart -= IndexBase;
+        }
+        else
+        {
+            m_PrimitiveRanges.push_back({0, 0, VertexStart, VertexCount, LoadedMeshId, static_cast<Uint32>(prim)});
         }
 
         int MaterialId = GltfPrimitive.GetMaterialId();
@@ -532,8 +642,17 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
             VertexCount,
             static_cast<Uint32>(MaterialId),
             PosMin,
-            PosMax //
+            PosMax,
+            IndexType //
         );
+        NewMesh.Primitives.back().VertexRangeStart = m_PrimitiveRanges.back().FirstVertex;
+        m_PrimitiveRanges.back().IsTriangleList    = GltfPrimitive.IsTriangleList();
+
+        if (GltfPrimitive.GetTargetCount() > 0)
+        {
+            LoadMorphTargets(GltfModel, GltfPrimitive, VertexCount, NewMesh.Primitives.back());
+            m_PrimitiveRanges.back().HasMorphTargets = true;
+        }
 
         if (m_CI.PrimitiveLoadCallback)
             m_CI.PrimitiveLoadCallback(&GltfModel.Get(), &GltfPrimitive.Get(), NewMesh.Primitives.back());
@@ -541,12 +660,84 @@ Mesh* MeshLoader::LoadMesh(const GltfModelType& GltfModel,
 
     NewMesh.UpdateBoundingBox();
 
+    // All primitives of the mesh must have the same number of morph targets
+    Uint32 MorphTargetCount = 0;
+    for (const Primitive& Prim : NewMesh.Primitives)
+        MorphTargetCount = std::max(MorphTargetCount, Prim.MorphTargetCount);
+    if (MorphTargetCount > 0)
+    {
+        const auto& GltfWeights = GltfMesh.GetWeights();
+        NewMesh.MorphWeights.resize(MorphTargetCount);
+        for (size_t i = 0; i < GltfWeights.size() && i < MorphTargetCount; ++i)
+            NewMesh.MorphWeights[i] = static_cast<float>(GltfWeights[i]);
+    }
+
     if (m_CI.MeshLoadCallback)
         m_CI.MeshLoadCallback(&GltfModel.Get(), &GltfMesh.Get(), NewMesh);
 
     return &NewMesh;
 }
 
+template <typename GltfModelType, typename GltfPrimitiveType>
+void MeshLoader::LoadMorphTargets(const GltfModelType&     GltfModel,
+                                  const GltfPrimitiveType& GltfPrimitive,
+                                  Uint32                   VertexCount,
+                                  Primitive&               Prim)
+{
+    static constexpr const char* AttribNames[MorphTargetData::ATTRIBUTE_COUNT] = {"POSITION", "NORMAL", "TANGENT"};
+
+    MorphTargetData& MorphTargets = m_Model.MorphTargets;
+
+    const size_t TargetCount = GltfPrimitive.GetTargetCount();
+    Prim.FirstMorphTarget    = static_cast<Uint32>(MorphTargets.Targets.size());
+    Prim.MorphTargetCount    = static_cast<Uint32>(TargetCount);
+    for (size_t target = 0; target < TargetCount; ++target)
+    {
+        MorphTargetData::Target NewTarget;
+        for (Uint32 attrib = 0; attrib < MorphTargetData::ATTRIBUTE_COUNT; ++attrib)
+        {
+            NewTarget.FirstDelta[attrib] = static_cast<Uint32>(MorphTargets.Deltas.size());
+
+            const int* pAccessorId = GltfPrimitive.GetTargetAttribute(target, AttribNames[attrib]);
+            if (pAccessorId == nullptr || *pAccessorId < 0)
+                continue;
+
+            const auto& GltfAccessor = GltfModel.GetAccessor(*pAccessorId);
+            if (GltfAccessor.GetBufferViewId() < 0)
+            {
+                LOG_WARNING_MESSAGE("Sparse accessors are not supported for morph target ", AttribNames[attrib], " deltas, skipping the attribute");
+                continue;
+            }
+            if (GltfAccessor.GetComponentType() != VT_FLOAT32 || GltfAccessor.GetNumComponents() < 3)
+            {
+                LOG_WARNING_MESSAGE("Only float3 morph target ", AttribNames[attrib], " deltas are supported, skipping the attribute");
+                continue;
+            }
+
+            const auto GltfDeltas = GetGltfDataInfo(GltfModel, *pAccessorId);
+            if (GltfDeltas.Count != VertexCount)
+            {
+                LOG_WARNING_MESSAGE("The number of morph target ", AttribNames[attrib], " deltas (", GltfDeltas.Count,
+                                    ") does not match the primitive vertex count (", VertexCount, "), skipping the attribute");
+                continue;
+            }
+
+            // Most targets only affect a small part of the mesh, so zero deltas are not stored
+            for (Uint32 v = 0; v < VertexCount; ++v)
+            {
+                const float3& Delta = *reinterpret_cast<const float3*>(static_cast<const Uint8*>(GltfDeltas.pData) + GltfDeltas.ByteStride * v);
+                if (Delta.x != 0 || Delta.y != 0 || Delta.z != 0)
+                {
+                    MorphTargets.VertexIds.push_back(v);
+                    MorphTargets.Deltas.push_back(Delta);
+                }
+            }
+            NewTarget.DeltaCount[attrib] = static_cast<Uint32>(MorphTargets.Deltas.size()) - NewTarget.FirstDelta[attrib];
+        }
+        MorphTargets.Targets.push_back(NewTarget);
+    }
+}
+
 template <typename GltfModelType>
 Camera* ModelBuilder::LoadCamera(const GltfModelType& GltfModel,
                                  int                  GltfCameraIndex)
@@ -716,6 +907,26 @@ Node* ModelBuilder::LoadNode(const GltfModelType& GltfModel,
     NewNode.pCamera = LoadCamera(GltfModel, GltfNode.GetCameraId());
     NewNode.pLight  = LoadLight(GltfModel, GltfNode.GetLightId());
 
+    if (NewNode.pMesh != nullptr && !NewNode.pMesh->MorphWeights.empty())
+    {
+        // The node weights override the default weights of the mesh
+        std::vector<float>& DefaultWeights = m_Model.DefaultMorphWeights;
+        NewNode.MorphWeightsOffset         = static_cast<int>(DefaultWeights.size());
+        DefaultWeights.insert(DefaultWeights.end(), NewNode.pMesh->MorphWeights.begin(), NewNode.pMesh->MorphWeights.end());
+
+        const auto& GltfWeights = GltfNode.GetWeights();
+        if (GltfWeights.size() == NewNode.pMesh->MorphWeights.size())
+        {
+            for (size_t i = 0; i < GltfWeights.size(); ++i)
+                DefaultWeights[NewNode.MorphWeightsOffset + i] = static_cast<float>(GltfWeights[i]);
+        }
+    }
+
+    if (NewNode.pMesh != nullptr)
+    {
+        LoadInstanceMatrices(GltfModel, GltfNode, NewNode);
+    }
+
     if (m_CI.NodeLoadCallback)
     {
         m_CI.NodeLoadCallback(&GltfModel.Get(), GltfNodeIndex, &GltfNode.Get(), NewNode);
@@ -724,10 +935,85 @@ Node* ModelBuilder::LoadNode(const GltfModelType& GltfModel,
     return &NewNode;
 }
 
+template <typename GltfModelType, typename GltfNodeType>
+void ModelBuilder::LoadInstanceMatrices(const GltfModelType& GltfModel,
+                                        const GltfNodeType&  GltfNode,
+                                        Node&                NewNode)
+{
+    // https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_mesh_gpu_instancing
+
+    const int TranslationId = GltfNode.GetInstancingAttributeId("TRANSLATION");
+    const int RotationId    = GltfNode.GetInstancingAttributeId("ROTATION");
+    const int ScaleId       = GltfNode.GetInstancingAttributeId("SCALE");
+    if (TranslationId < 0 && RotationId < 0 && ScaleId < 0)
+        return;
+
+    // All attributes must have the same count
+    size_t NumInstances = 0;
+    for (int AccessorId : {TranslationId, RotationId, ScaleId})
+    {
+        if (AccessorId < 0)
+            continue;
+
+        const size_t Count = GltfModel.GetAccessor(AccessorId).GetCount();
+        if (NumInstances != 0 && Count != NumInstances)
+        {
+            LOG_WARNING_MESSAGE("Instancing attributes of node '", NewNode.Name, "' have different counts. The extension will be ignored.");
+            return;
+        }
+        NumInstances = Count;
+    }
+    if (NumInstances == 0)
+        return;
+
+    // Reads the attribute converted to floats. Rotations may be stored as normalized integers.
+    const auto ReadAttribute = [&](int AccessorId, Uint32 NumComponents, std::vector<float4>& Values) {
+        Values.assign(NumInstances, float4{0, 0, 0, 0});
+        if (AccessorId < 0)
+            return false;
+
+        const auto GltfData = GetGltfDataInfo(GltfModel, AccessorId);
+        const bool Written  = VertexDataConverter::Write({
+            GltfData.pData,
+            GltfData.Accessor.GetComponentType(),
+            NumComponents,
+            static_cast<Uint32>(GltfData.ByteStride),
+            Values.data(),
+            VT_FLOAT32,
+            NumComponents,
+            sizeof(float4),
+            static_cast<Uint32>(NumInstances),
+            GltfData.Accessor.GetComponentType() != VT_FLOAT32,
+        });
+        return Written;
+    };
+
+    std::vector<float4> Translations;
+    std::vector<float4> Rotations;
+    std::vector<float4> Scales;
+    const bool HasTranslations = ReadAttribute(TranslationId, 3, Translations);
+    const bool HasRotations    = ReadAttribute(RotationId, 4, Rotations);
+    const bool HasScales       = ReadAttribute(ScaleId, 3, Scales);
+
+    NewNode.InstanceMatrices.resize(NumInstances);
+    for (size_t i = 0; i < NumInstances; ++i)
+    {
+        const float3 Translation = HasTranslations ? float3{Translations[i]} : float3{0, 0, 0};
+        const float3 Scale       = HasScales ? float3{Scales[i]} : float3{1, 1, 1};
+        QuaternionF  Rotation;
+        if (HasRotations)
+            Rotation.q = Rotations[i];
+
+        NewNode.InstanceMatrices[i] = ComputeNodeLocalMatrix(Scale, Rotation, Translation, float4x4::Identity());
+    }
+}
+
 template <typename GltfModelType>
 Uint32 MeshLoader::ConvertVertexData(const GltfModelType& GltfModel,
                                      const PrimitiveKey&  Key,
-                                     Uint32               VertexCount)
+                                     Uint32               VertexCount,
+                                     const float3&        PosMin,
+                                     const float3&        PosMax)
 {
     Uint32 StartVertex = ~0u;
 
@@ -809,7 +1095,7 @@ Uint32 MeshLoader::ConvertVertexData(const GltfModelType& GltfModel,
         VERIFY_EXPR(SrcStride > 0);
 
         VERIFY_EXPR(static_cast<Uint32>(GltfVerts.Count) == VertexCount);
-        const bool Written = VertexDataConverter::Write({
+        VertexDataConverter::WriteAttribs WriteAttribs{
             GltfVerts.pData,
             ValueType,
             static_cast<Uint32>(NumComponents),
@@ -820,7 +1106,15 @@ Uint32 MeshLoader::ConvertVertexData(const GltfModelType& GltfModel,
             VertexStride,
             VertexCount,
             IsNormalized,
-        });
+        };
+        WriteAttribs.Encoding = Attrib.Encoding;
+        if (Attrib.Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED)
+        {
+            // Positions are quantized relative to the primitive bounding box
+            WriteAttribs.pQuantizationMin = &PosMin.x;
+            WriteAttribs.pQuantizationMax = &PosMax.x;
+        }
+        const bool Written = VertexDataConverter::Write(WriteAttribs);
         VERIFY_EXPR(Written);
 
         m_Model.VertexData.EnabledAttributeFlags |= (1u << i);
@@ -849,18 +1143,16 @@ inline void MeshLoader::WriteIndexData(const void*                  pSrc,
 template <typename GltfModelType>
 Uint32 MeshLoader::ConvertIndexData(const GltfModelType& GltfModel,
                                     int                  AccessorId,
-                                    Uint32               BaseVertex)
+                                    Uint32               BaseVertex,
+                                    Uint32               IndexSize)
 {
     VERIFY_EXPR(AccessorId >= 0);
 
     const auto GltfIndices = GetGltfDataInfo(GltfModel, AccessorId);
-    const auto IndexSize   = m_Model.IndexData.IndexSize;
     const auto IndexCount  = static_cast<uint32_t>(GltfIndices.Count);
 
-    auto IndexDataStart = m_IndexData.size();
-    VERIFY((IndexDataStart % IndexSize) == 0, "Current offset is not a multiple of index size");
-    m_IndexData.resize(IndexDataStart + size_t{IndexCount} * size_t{IndexSize});
-    auto index_it = m_IndexData.begin() + IndexDataStart;
+    const auto IndexDataStart = size_t{AllocateIndices(IndexSize, IndexCount)} * IndexSize;
+    auto       index_it       = m_IndexData.begin() + IndexDataStart;
 
     const auto ComponentType = GltfIndices.Accessor.GetComponentType();
     const auto SrcStride     = static_cast<size_t>(GltfIndices.ByteStride);
@@ -985,7 +1277,7 @@ void ModelBuilder::LoadAnimations(const GltfModelType& GltfModel)
             }
 
 
-            // Read sampler output T/R/S values
+            // Read sampler output T/R/S or morph target weight values
             {
                 const auto GltfOutputs = GetGltfDataInfo(GltfModel, GltfSam.GetOutputId());
                 VERIFY(GltfOutputs.Accessor.GetComponentType() == VT_FLOAT32, "Float32 data is expected.");
@@ -1015,6 +1307,15 @@ void ModelBuilder::LoadAnimations(const GltfModelType& GltfModel)
                         break;
                     }
 
+                    case 1:
+                    {
+                        // Morph target weights
+                        AnimSampler.OutputWeights.resize(GltfOutputs.Count);
+                        for (size_t i = 0; i < GltfOutputs.Count; ++i)
+                            AnimSampler.OutputWeights[i] = *reinterpret_cast<const float*>(static_cast<const Uint8*>(GltfOutputs.pData) + GltfOutputs.ByteStride * i);
+                        break;
+                    }
+
                     default:
                     {
                         LOG_WARNING_MESSAGE("Unsupported component count: ", NumComponents);
@@ -1031,11 +1332,6 @@ void ModelBuilder::LoadAnimations(const GltfModelType& GltfModel)
             const auto& GltfChannel = GltfAnim.GetChannel(chnl);
 
             const auto PathType = GltfChannel.GetPathType();
-            if (PathType == AnimationChannel::PATH_TYPE::WEIGHTS)
-            {
-                LOG_WARNING_MESSAGE("Weights are not yet supported, skipping channel");
-                continue;
-            }
 
             const auto SamplerIndex = GltfChannel.GetSamplerId();
             if (SamplerIndex < 0)
@@ -1130,6 +1426,7 @@ void ModelBuilder::BuildModel(const GltfModelType& GltfModel,
             pNode                 = LoadNode(GltfModel, nullptr, scene, GltfNodeId, MeshLoader);
         }
         scene.LinearNodes.shrink_to_fit();
+        scene.InitHierarchy(m_Model.Nodes.size());
     }
     m_Model.Materials.shrink_to_fit();
     VERIFY_EXPR(m_LoadedNodes.size() == m_Model.Nodes.size());
@@ -1138,6 +1435,13 @@ void ModelBuilder::BuildModel(const GltfModelType& GltfModel,
     VERIFY_EXPR(m_LoadedLights.size() == m_Model.Lights.size());
 
     LoadAnimationAndSkin(GltfModel);
+
+    // Skins are required to find the skin dependencies and to exclude skinned nodes from instancing
+    for (auto& scene : m_Model.Scenes)
+    {
+        scene.InitSkinDependencies(m_Model.Nodes.size());
+        scene.InitInstanceGroups(m_CI.InstancingMinNodeCount);
+    }
 }
 
 class MaterialBuilder
@@ -51,6 +51,8 @@ namespace Diligent
 {
 
 struct ITexture;
+struct IThreadPool;
+class MemoryMappedFile;
 
 namespace GLTF
 {
@@ -96,6 +98,26 @@ struct DocumentLoadInfo
     /// tinygltf::Image::image as encoded image bytes because tinygltf supplies them
     /// through temporary callback storage.
     bool DecodeImages = true;
+
+    /// Optional thread pool to use for decoding images in parallel.
+    ///
+    /// When the thread pool is provided, image decoding is deferred until the document
+    /// has been parsed, and then all images that are not found in the texture cache or
+    /// the resource manager are decoded concurrently. When the pool is null, images are
+    /// decoded sequentially while the document is being parsed.
+    /// The pool is not used when DecodeImages is false.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Whether to memory-map the binary data instead of reading it into memory.
+    ///
+    /// When this is true, the BIN chunk of a .glb file and external .bin buffers are
+    /// referenced in place by tinygltf::Buffer::external_data, and accessors, buffer views
+    /// and TextureSourceInfo::pData point directly into the mapping, which stays alive
+    /// for the lifetime of the document. Files that cannot be mapped are read as usual.
+    /// Use tinygltf::Buffer::GetData() and GetSize() to access buffer contents; the tinygltf
+    /// writer does so, too, so mapped buffers are serialized like owned ones.
+    /// Memory mapping is not used when ReadWholeFileCallback is provided.
+    bool UseMemoryMapping = false;
 };
 
 /// Resolved texture source referenced by a GLTF texture.
@@ -114,6 +136,8 @@ struct TextureSourceInfo
     std::string URI;
 
     /// Pointer to encoded image data for embedded buffer-view or data URI images.
+    ///
+    /// For buffer-view images of a memory-mapped document, points into the mapping.
     const void* pData = nullptr;
 
     /// Size of encoded image data in bytes.
@@ -153,7 +177,11 @@ private:
     std::string m_BaseDir;
 
     std::vector<RefCntAutoPtr<IObject>> m_TexturesHold;
-    std::unique_ptr<tinygltf::Model>    m_pModel;
+
+    // Memory-mapped files referenced by the model buffers. Must be destroyed after the model.
+    std::vector<std::unique_ptr<MemoryMappedFile>> m_MappedFiles;
+
+    std::unique_ptr<tinygltf::Model> m_pModel;
 };
 
 int GetTextureImageIndex(const tinygltf::Model&   GltfModel,
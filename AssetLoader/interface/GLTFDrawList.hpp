@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Sorted draw records and indirect draw arguments generated from the primitives of a GLTF model scene.
+
+#include <vector>
+
+#include "GLTFLoader.hpp"
+#include "GLTFSceneBVH.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+/// Arguments of an indexed indirect draw command.
+
+/// The layout matches the argument buffer layout expected by IDeviceContext::DrawIndexedIndirect
+/// and IDeviceContext::MultiDrawIndexedIndirect on all backends.
+struct DrawIndexedIndirectArgs
+{
+    Uint32 NumIndices            = 0;
+    Uint32 NumInstances          = 0;
+    Uint32 FirstIndexLocation    = 0;
+    Int32  BaseVertex            = 0;
+    Uint32 FirstInstanceLocation = 0;
+};
+static_assert(sizeof(DrawIndexedIndirectArgs) == 20, "The size of DrawIndexedIndirectArgs must be 20 bytes");
+
+/// Arguments of a non-indexed indirect draw command, see DrawIndexedIndirectArgs.
+struct DrawIndirectArgs
+{
+    Uint32 NumVertices           = 0;
+    Uint32 NumInstances          = 0;
+    Uint32 StartVertexLocation   = 0;
+    Uint32 FirstInstanceLocation = 0;
+};
+static_assert(sizeof(DrawIndirectArgs) == 16, "The size of DrawIndirectArgs must be 16 bytes");
+
+/// Draw record of a primitive of a scene node.
+struct DrawRecord
+{
+    /// Sort key of the record, see DrawList.
+    Uint64 SortKey = 0;
+
+    /// Index of the node in the Model::Nodes array.
+    Uint32 NodeIndex = 0;
+
+    /// Index of the primitive in the Mesh::Primitives array of the node mesh.
+    Uint32 PrimitiveIndex = 0;
+
+    /// Index of the primitive material in the Model::Materials array.
+    Uint32 MaterialId = 0;
+
+    /// Material alpha mode, see Material::ALPHA_MODE.
+    Uint8 AlphaMode = Material::ALPHA_MODE_OPAQUE;
+
+    /// Whether the material is double-sided.
+    bool DoubleSided = false;
+
+    /// Index type of the primitive, or VT_UNDEFINED if the primitive is not indexed.
+    VALUE_TYPE IndexType = VT_UNDEFINED;
+
+    /// Index of the vertex pool in the resource manager, see Model::GetVertexPoolIndex(const Primitive&).
+    Uint32 VertexPoolIndex = 0;
+
+    /// Index of the index buffer allocator in the resource manager, see Model::GetIndexAllocatorIndex(const Primitive&).
+    Uint32 IndexAllocatorIndex = 0;
+
+    /// The number of indices for indexed primitives or vertices otherwise.
+    Uint32 NumElements = 0;
+
+    /// Location of the first index in the index buffer in the units of IndexType,
+    /// or the location of the first vertex for non-indexed primitives.
+    Uint32 FirstElementLocation = 0;
+
+    /// The value added to the indices of indexed primitives.
+    Uint32 BaseVertex = 0;
+
+    /// The id passed to the shader as the first instance location, see DrawListBuildInfo::InstanceIds.
+    /// For instanced records, this is the index of the first instance matrix of the record
+    /// in ModelTransforms::InstanceMatrices.
+    Uint32 InstanceId = 0;
+
+    /// The number of instances, see DrawListBuildInfo::UseInstanceGroups.
+    Uint32 NumInstances = 1;
+
+    /// Index of the instance group in Scene::InstanceGroups for instanced records, or -1.
+    /// NodeIndex is then the index of the first node of the group if the record draws the whole group,
+    /// or the index of the node with EXT_mesh_gpu_instancing instances if the record only draws them.
+    Int32 InstanceGroupIndex = -1;
+
+    bool IsIndexed() const
+    {
+        return IndexType != VT_UNDEFINED;
+    }
+
+    bool IsInstanced() const
+    {
+        return InstanceGroupIndex >= 0;
+    }
+};
+
+/// Range of consecutive draw records that share the same pipeline state and buffers.
+
+/// All records of a batch can be drawn with a single multi-draw indirect command
+/// using the arguments starting at FirstArgs in DrawList::GetIndexedArgs() for
+/// indexed batches or DrawList::GetArgs() otherwise.
+struct DrawBatch
+{
+    /// Index of the first record of the batch in DrawList::GetRecords().
+    Uint32 FirstRecord = 0;
+
+    /// The number of records in the batch.
+    Uint32 NumRecords = 0;
+
+    /// Index of the first argument structure of the batch.
+    Uint32 FirstArgs = 0;
+
+    Uint8      AlphaMode           = Material::ALPHA_MODE_OPAQUE;
+    bool       DoubleSided         = false;
+    bool       Instanced           = false;
+    VALUE_TYPE IndexType           = VT_UNDEFINED;
+    Uint32     VertexPoolIndex     = 0;
+    Uint32     IndexAllocatorIndex = 0;
+
+    /// Material of all records in the batch if DrawListBuildInfo::SplitBatchesByMaterial is true.
+    Uint32 MaterialId = 0;
+
+    bool IsIndexed() const
+    {
+        return IndexType != VT_UNDEFINED;
+    }
+};
+
+/// Draw list build parameters.
+struct DrawListBuildInfo
+{
+    /// Whether to start a new batch when the material changes.
+
+    /// Set this flag if the material resources are bound per draw call. Otherwise, the shader
+    /// is expected to fetch the material by the instance id, see InstanceIds.
+    bool SplitBatchesByMaterial = false;
+
+    /// Whether to draw the nodes of every instance group of the scene with one instanced record per primitive.
+
+    /// The instanced records use the matrices of the group in ModelTransforms::InstanceMatrices
+    /// (see Scene::InstanceGroups) and are kept in separate batches. Only used when the list is
+    /// built from a scene.
+    ///
+    /// \note   The nodes with EXT_mesh_gpu_instancing instances can only be drawn by their instances.
+    ///         Without this flag, or when the list is built from the given primitives, every such node
+    ///         is drawn by an instanced record that uses the matrices of its own instances in the group.
+    bool UseInstanceGroups = false;
+
+    /// Optional transforms of the scene nodes, see Model::ComputeTransforms().
+
+    /// If not null, the blended primitives are sorted back-to-front by the distance from
+    /// the centers of their world-space bounding boxes to ViewPosition.
+    const ModelTransforms* pTransforms = nullptr;
+
+    /// World-space view position used to sort blended primitives.
+    float3 ViewPosition = float3{0, 0, 0};
+
+    /// The ids passed to the shader as the first instance location of every draw command.
+    enum INSTANCE_IDS : Uint8
+    {
+        /// Node index, e.g. to fetch the node matrix from ModelTransforms::NodeGlobalMatrices.
+        INSTANCE_IDS_NODE_INDEX = 0,
+
+        /// Index of the draw record, e.g. to fetch per-draw data stored in the order of the records.
+        INSTANCE_IDS_RECORD_INDEX
+    };
+    INSTANCE_IDS InstanceIds = INSTANCE_IDS_NODE_INDEX;
+};
+
+/// Flat array of draw records of a model scene sorted to minimize state changes.
+
+/// The 64-bit sort key of every record orders the draws by alpha mode (opaque, mask, blend),
+/// then by the double-sided and instanced flags, index type, vertex pool and index allocator, so that the
+/// records that can be drawn with the same pipeline and buffers are adjacent. Opaque and masked
+/// records are then sorted by material. Blended records are sorted back-to-front before the other
+/// state if the transforms are provided, and keep the scene order regardless of the state otherwise,
+/// so that a state change between blended records starts a new batch. Instanced blended records
+/// are sorted by the distance to the first node of the group.
+/// Records with equal keys keep the order of the scene nodes.
+///
+/// \note   Only triangle list primitives are supported, as Model only loads them.
+class DrawList
+{
+public:
+    /// Builds the draw list from all primitives of the scene.
+
+    /// \param [in] Mdl        - Model whose scene is processed.
+    /// \param [in] SceneIndex - Index of the scene in Mdl.Scenes.
+    /// \param [in] BuildInfo  - Build parameters.
+    void Build(const Model& Mdl, Uint32 SceneIndex, const DrawListBuildInfo& BuildInfo = {});
+
+    /// Builds the draw list from the given primitives, e.g. the visible primitives found by SceneBVH::QueryVisible().
+
+    /// \param [in] Mdl       - Model that contains the primitives.
+    /// \param [in] pPrims    - Array of NumPrims primitives.
+    /// \param [in] NumPrims  - The number of primitives.
+    /// \param [in] BuildInfo - Build parameters.
+    void Build(const Model& Mdl, const ScenePrimitiveRef* pPrims, size_t NumPrims, const DrawListBuildInfo& BuildInfo = {});
+
+    void Clear();
+
+    const std::vector<DrawRecord>&              GetRecords() const { return m_Records; }
+    const std::vector<DrawBatch>&               GetBatches() const { return m_Batches; }
+    const std::vector<DrawIndexedIndirectArgs>& GetIndexedArgs() const { return m_IndexedArgs; }
+    const std::vector<DrawIndirectArgs>&        GetArgs() const { return m_Args; }
+
+private:
+    void AddPrimitive(const Model&             Mdl,
+                      Uint32                   NodeIndex,
+                      Uint32                   PrimitiveIndex,
+                      const DrawListBuildInfo& BuildInfo,
+                      Int32                    GroupIndex    = -1,
+                      Uint32                   FirstInstance = 0,
+                      Uint32                   NumInstances  = 1);
+    void Finalize(const DrawListBuildInfo& BuildInfo);
+
+    std::vector<DrawRecord>              m_Records;
+    std::vector<DrawBatch>               m_Batches;
+    std::vector<DrawIndexedIndirectArgs> m_IndexedArgs;
+    std::vector<DrawIndirectArgs>        m_Args;
+};
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -52,6 +52,8 @@
 #include "../../../DiligentCore/Common/interface/STDAllocator.hpp"
 #include "GLTFDocument.hpp"
 #include "GLTFResourceManager.hpp"
+#include "GLTFMeshOptimizer.hpp"
+#include "GLTFTriangleBVH.hpp"
 
 namespace tinygltf
 {
@@ -69,6 +71,7 @@ namespace Diligent
 {
 
 enum IMAGE_FILE_FORMAT : Uint8;
+struct XXH128Hash;
 
 namespace GLTF
 {
@@ -76,6 +79,7 @@ namespace GLTF
 class MeshLoader;
 class ModelBuilder;
 class MaterialBuilder;
+class CookedModel;
 
 /// Texture attribute description.
 struct TextureAttributeDesc
@@ -352,6 +356,7 @@ private:
     }
 
     friend MaterialBuilder;
+    friend CookedModel;
 
 public:
     bool DoubleSided  = false;
@@ -434,28 +439,125 @@ Material LoadMaterial(const Document&            GltfDoc,
                       const MaterialLoadContext& LoadCtx = {});
 
 
+/// Sparse morph target deltas of all primitives in the model.
+
+/// Only the vertices whose deltas are not zero are stored. The deltas of
+/// every attribute of a target occupy a separate range in the VertexIds and
+/// Deltas arrays.
+struct MorphTargetData
+{
+    enum ATTRIBUTE : Uint8
+    {
+        ATTRIBUTE_POSITION = 0,
+        ATTRIBUTE_NORMAL,
+        ATTRIBUTE_TANGENT,
+        ATTRIBUTE_COUNT
+    };
+
+    struct Target
+    {
+        /// Index of the first delta of every attribute in VertexIds and Deltas.
+        Uint32 FirstDelta[ATTRIBUTE_COUNT] = {};
+
+        /// The number of deltas of every attribute.
+        Uint32 DeltaCount[ATTRIBUTE_COUNT] = {};
+    };
+    std::vector<Target> Targets;
+
+    /// Vertex indices relative to the start of the primitive vertex range.
+    std::vector<Uint32> VertexIds;
+
+    std::vector<float3> Deltas;
+};
+
+/// Simplified level of detail of a primitive.
+struct PrimitiveLOD
+{
+    /// Index of the first LOD index in the model index buffer, in the units of Primitive::IndexType.
+    ///
+    /// When the primitive data is shared with other models, use Model::GetFirstIndexLocation(const Primitive&, size_t).
+    Uint32 FirstIndex = 0;
+
+    /// The number of LOD indices.
+    Uint32 IndexCount = 0;
+
+    /// The maximum deviation of the LOD surface from the full-detail primitive, in the primitive space units.
+    float Error = 0;
+
+    /// Returns the LOD error projected to the screen, in pixels.
+
+    /// \param [in] Distance  - Distance from the camera to the primitive in the primitive space units.
+    /// \param [in] ProjScale - Projection scale, ViewportHeight / (2 * tan(FovY / 2)).
+    float GetScreenSpaceError(float Distance, float ProjScale) const
+    {
+        return Distance > 0 ? Error * ProjScale / Distance : FLT_MAX;
+    }
+};
+
 struct Primitive
 {
+    /// Index of the first primitive index in the model index buffer, in the units of IndexType.
     const Uint32 FirstIndex;
     const Uint32 IndexCount;
+
+    /// Index of the first vertex for non-indexed primitives, or the value that must be
+    /// added to the indices of indexed primitives (see ModelCreateInfo::NarrowIndices
+    /// and ModelCreateInfo::DeduplicateMeshData).
     const Uint32 FirstVertex;
     const Uint32 VertexCount;
     const Uint32 MaterialId;
 
+    /// Index of the first vertex of the primitive vertex range in the model vertex data.
+    /// Unlike FirstVertex, this is the start of the range even if the primitive is indexed.
+    Uint32 VertexRangeStart = 0;
+
+    /// Index type, VT_UINT16 or VT_UINT32. VT_UNDEFINED if the primitive is not indexed.
+    const VALUE_TYPE IndexType;
+
     const BoundBox BB;
 
+    /// Index of the first primitive meshlet in Model::Meshlets.Meshlets.
+    Uint32 FirstMeshlet = 0;
+
+    /// The number of primitive meshlets, see ModelCreateInfo::BuildMeshlets.
+    Uint32 MeshletCount = 0;
+
+    /// Simplified levels of detail, from the most to the least detailed one, see ModelCreateInfo::LODCount.
+    ///
+    /// The LODs use the same vertices as the primitive itself and only replace the index range.
+    std::vector<PrimitiveLOD> LODs;
+
+    /// Index of the first primitive morph target in Model::MorphTargets.Targets.
+    Uint32 FirstMorphTarget = 0;
+
+    /// The number of primitive morph targets.
+    Uint32 MorphTargetCount = 0;
+
+    /// Vertex and index data of the primitive that are shared with other models, see ModelCreateInfo::DeduplicateMeshData.
+    struct SharedDataInfo
+    {
+        RefCntAutoPtr<IVertexPoolAllocation> pVertexAllocation;
+        RefCntAutoPtr<IBufferSuballocation>  pIndexAllocation;
+
+        Uint32 VertexPoolId     = 0; // Vertex pool index
+        Uint32 IndexAllocatorId = 0; // Index buffer allocator index
+    };
+    SharedDataInfo SharedData;
+
     Primitive(Uint32        _FirstIndex,
               Uint32        _IndexCount,
               Uint32        _FirstVertex,
               Uint32        _VertexCount,
               Uint32        _MaterialId,
               const float3& _BBMin,
-              const float3& _BBMax) :
+              const float3& _BBMax,
+              VALUE_TYPE    _IndexType = VT_UNDEFINED) :
         FirstIndex{_FirstIndex},
         IndexCount{_IndexCount},
         FirstVertex{_FirstVertex},
         VertexCount{_VertexCount},
         MaterialId{_MaterialId},
+        IndexType{_IndexType},
         BB{_BBMin, _BBMax}
     {
     }
@@ -466,6 +568,12 @@ struct Primitive
     {
         return IndexCount > 0;
     }
+
+    /// Returns the number of triangles of the triangle list primitive.
+    Uint32 GetTriangleCount() const
+    {
+        return (HasIndices() ? IndexCount : VertexCount) / 3;
+    }
 };
 
 struct Mesh
@@ -474,6 +582,13 @@ struct Mesh
     std::vector<Primitive> Primitives;
     BoundBox               BB;
 
+    // Default morph target weights. The size is the number of morph targets.
+    std::vector<float> MorphWeights;
+
+    // Hierarchy over the triangles of all primitives in the mesh space, see ModelCreateInfo::BuildRayCastBVHs.
+    // The triangle ids are the triangle indices in the order of the primitives (see Primitive::GetTriangleCount).
+    TriangleBVH RayCastBVH;
+
     // Any user-specific data. One way to set this field is from the
     // MeshLoadCallback.
     RefCntAutoPtr<IObject> pUserData;
@@ -507,6 +622,11 @@ struct Skin
     const Node*              pSkeletonRoot = nullptr;
     std::vector<float4x4>    InverseBindMatrices;
     std::vector<const Node*> Joints;
+
+    // Bounding boxes of the vertices influenced by every joint in the joint space, i.e. the bind-pose
+    // positions transformed by the inverse bind matrix (see ModelCreateInfo::ComputeJointBounds).
+    // The box of a joint that does not influence any vertex is empty (Min > Max).
+    std::vector<BoundBox> JointBounds;
 };
 
 struct Camera
@@ -576,6 +696,10 @@ struct Node
     // Index in ModelTransforms.Skins array.
     int SkinTransformsIndex = -1;
 
+    // Offset of the node's morph target weights in ModelTransforms.MorphWeights array,
+    // or -1 if the node's mesh has no morph targets.
+    int MorphWeightsOffset = -1;
+
     std::string Name;
 
     const Node* Parent = nullptr;
@@ -592,6 +716,11 @@ struct Node
     float3      Scale  = float3{1, 1, 1};
     float4x4    Matrix = float4x4::Identity();
 
+    // Transforms of the mesh instances relative to the node defined by the EXT_mesh_gpu_instancing extension.
+    // If not empty, the node mesh is drawn once for every matrix, see Scene::InstanceGroups.
+    // https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_mesh_gpu_instancing
+    std::vector<float4x4> InstanceMatrices;
+
     explicit Node(int _Index) :
         Index{_Index}
     {}
@@ -599,12 +728,65 @@ struct Node
     inline float4x4 ComputeLocalTransform() const;
 };
 
+/// Nodes of a scene that reference the same mesh and can be drawn with one instanced draw call per primitive.
+
+/// The nodes share the mesh, and thus the materials of its primitives. The instance matrices of the group
+/// are stored contiguously in ModelTransforms::InstanceMatrices starting at FirstInstance: one matrix for every
+/// node, or Node::InstanceMatrices.size() matrices for the nodes with the EXT_mesh_gpu_instancing extension,
+/// in the order of NodeIds.
+struct InstanceGroup
+{
+    const Mesh* pMesh = nullptr;
+
+    /// Indices of the nodes in the Model::Nodes array.
+    std::vector<Uint32> NodeIds;
+
+    /// Index of the first instance matrix of the group in ModelTransforms::InstanceMatrices.
+    Uint32 FirstInstance = 0;
+
+    /// The number of instances in the group.
+    Uint32 InstanceCount = 0;
+};
+
 struct Scene
 {
     std::string        Name;
     std::vector<Node*> RootNodes;
     // Linear list of all nodes in the scene.
     std::vector<Node*> LinearNodes;
+
+    // Flattened node hierarchy used to compute node transforms in a single linear pass.
+    // HierarchyNodeIds lists the indices of the scene nodes in depth-first order, so that every
+    // parent precedes its children. HierarchyParentIds holds the index of the parent of each node
+    // in the Model::Nodes array, or -1 for root nodes.
+    std::vector<Uint32> HierarchyNodeIds;
+    std::vector<Int32>  HierarchyParentIds;
+
+    // Initializes the flattened hierarchy from the RootNodes and Node::Children.
+    void InitHierarchy(size_t NumNodes);
+
+    // Skinned nodes whose joint matrices depend on the transform of each node, in compressed form:
+    // the indices of the skinned nodes that must be updated when the global matrix of node i changes
+    // are SkinDependencies[SkinDependencyOffsets[i]] ... SkinDependencies[SkinDependencyOffsets[i + 1] - 1].
+    // A skinned node depends on its own transform and on the transforms of all joints of its skin.
+    std::vector<Uint32> SkinDependencyOffsets;
+    std::vector<Uint32> SkinDependencies;
+
+    // Initializes the skin dependencies from the skinned nodes in LinearNodes.
+    // Must be called after the skins have been linked to the nodes.
+    void InitSkinDependencies(size_t NumNodes);
+
+    // Groups of nodes drawn with instancing, see ModelCreateInfo::InstancingMinNodeCount.
+    std::vector<InstanceGroup> InstanceGroups;
+
+    // The total number of instances in all groups.
+    Uint32 InstanceCount = 0;
+
+    // Groups the nodes of the scene that reference the same mesh if there are at least MinNodeCount
+    // of them (0 disables the grouping). The nodes with EXT_mesh_gpu_instancing instances are always
+    // grouped. Skinned nodes and the nodes with morph targets are never grouped, as they require
+    // per-node vertex transformations.
+    void InitInstanceGroups(Uint32 MinNodeCount);
 };
 
 struct AnimationChannel
@@ -643,9 +825,48 @@ struct AnimationSampler
     std::vector<float>  Inputs;
     std::vector<float4> OutputsVec4;
 
+    // Morph target weights of the WEIGHTS channels. Every key has one weight per morph target
+    // (or three for the cubic spline interpolation: in-tangents, values, out-tangents).
+    std::vector<float> OutputWeights;
+
+    // Output value encoding, see Model::CompressAnimations().
+    enum class OUTPUT_ENCODING : Uint8
+    {
+        // Values are stored in OutputsVec4.
+        FLOAT4,
+
+        // Three 16-bit values per output in CompressedOutputs mapped to
+        // the [OutputsMin, OutputsMin + 65535 * OutputsScale] range.
+        RANGE_UNORM16,
+
+        // Unit quaternions stored in CompressedOutputs as three 15-bit values
+        // of the smallest components. The index of the largest component is
+        // stored in the high bits of the first two values.
+        QUATERNION_SMALLEST_THREE,
+    };
+    OUTPUT_ENCODING OutputEncoding = OUTPUT_ENCODING::FLOAT4;
+
+    std::vector<Uint16> CompressedOutputs;
+
+    float3 OutputsMin;
+    float3 OutputsScale;
+
+    // Returns the number of output values.
+    size_t GetOutputCount() const
+    {
+        return OutputEncoding == OUTPUT_ENCODING::FLOAT4 ? OutputsVec4.size() : CompressedOutputs.size() / 3;
+    }
+
+    // Returns the output value with the given index.
+    inline float4 GetOutput(size_t Idx) const;
+
     // Returns the index of the key frame for the given animation time.
     inline size_t FindKeyFrame(float Time) const;
 
+    // Returns the same index as FindKeyFrame(Time), but first checks the key frame
+    // at Cursor and the next one. Cursor is updated with the found index.
+    inline size_t FindKeyFrame(float Time, Uint32& Cursor) const;
+
     explicit AnimationSampler(INTERPOLATION_TYPE _Interpolation) :
         Interpolation{_Interpolation}
     {}
@@ -659,9 +880,96 @@ struct Animation
 
     float Start = +(std::numeric_limits<float>::max)();
     float End   = -(std::numeric_limits<float>::max)();
+
+    // Values of all channels resampled at a uniform rate, see Model::BakeAnimations().
+    // The values of frame f are stored in the order of Channels starting at
+    // BakedValues[f * Channels.size()]. Rotations are stored as quaternions,
+    // translations and scales as float3 values with zero w component.
+    std::vector<float4> BakedValues;
+
+    // The number of baked frames. The first frame is at Start, the last one is at End.
+    Uint32 BakedFrameCount = 0;
+
+    // The number of baked frames per second.
+    float BakedFrameRate = 0;
+
+    // Conservative bounding box of the default scene over the animation, see Model::ComputeAnimationBounds().
+    BoundBox Bounds{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+
+    bool IsBaked() const
+    {
+        return BakedFrameCount != 0;
+    }
+
+    bool HasBounds() const
+    {
+        return Bounds.Min.x <= Bounds.Max.x;
+    }
 };
 
 
+/// Animation compression statistics, see Model::CompressAnimations().
+struct AnimationCompressionStats
+{
+    /// The memory size of the key times and values before the compression, in bytes.
+    size_t OriginalSize = 0;
+
+    /// The memory size of the key times and values after the compression, in bytes.
+    size_t CompressedSize = 0;
+
+    /// The total number of keys in all samplers before the compression.
+    Uint32 OriginalKeyCount = 0;
+
+    /// The total number of keys in all samplers after the compression.
+    Uint32 CompressedKeyCount = 0;
+
+    /// The maximum distance between the original and decompressed translations.
+    float MaxTranslationError = 0;
+
+    /// The maximum angle, in radians, between the original and decompressed rotations.
+    float MaxRotationError = 0;
+
+    /// The maximum distance between the original and decompressed scales.
+    float MaxScaleError = 0;
+};
+
+/// Vertex attribute encoding.
+enum VERTEX_ATTRIBUTE_ENCODING : Uint8
+{
+    /// The attribute components are converted to the attribute value type.
+    VERTEX_ATTRIBUTE_ENCODING_NONE = 0,
+
+    /// A unit vector (normal or tangent) is stored as two octahedral coordinates in [-1, 1].
+
+    /// The value type must be VT_INT8 or VT_INT16 (signed normalized), VT_FLOAT16 or VT_FLOAT32,
+    /// and the attribute must have at least two components. If there is a third component, it
+    /// receives the sign of the source w component (e.g. tangent handedness), or +1 if the source
+    /// has no w component. The vector is decoded in the shader as follows:
+    ///
+    ///     float3 n = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    ///     float  t = max(-n.z, 0.0);
+    ///     n.xy += float2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    ///     n = normalize(n);
+    VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL,
+
+    /// Three components in [-1, 1] and one component in [-1, 1] (e.g. tangent handedness)
+    /// are stored as 10:10:10:2 unsigned normalized values packed into one VT_UINT32 component.
+
+    /// The attribute must have exactly one VT_UINT32 component. The x component occupies the
+    /// lowest bits. A missing source w component is treated as +1. The value is decoded in the
+    /// shader as `float4(p & 1023u, (p >> 10u) & 1023u, (p >> 20u) & 1023u, p >> 30u) / float4(1023, 1023, 1023, 3) * 2.0 - 1.0`.
+    VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2,
+
+    /// Positions are stored as unsigned normalized values relative to the primitive bounding box.
+
+    /// The value type must be VT_UINT8 or VT_UINT16, and only the POSITION attribute may use
+    /// this encoding. The position is decoded in the shader as `BB.Min + Value * (BB.Max - BB.Min)`,
+    /// where BB is the primitive bounding box (see Primitive::BB). Components past the third
+    /// are set to zero.
+    VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED,
+
+    VERTEX_ATTRIBUTE_ENCODING_COUNT
+};
 
 /// Vertex attribute description.
 struct VertexAttributeDesc
@@ -690,6 +998,9 @@ struct VertexAttributeDesc
     /// If this value is null, the attribute will be initialized with zeros.
     const void* pDefaultValue = nullptr;
 
+    /// Attribute encoding, see VERTEX_ATTRIBUTE_ENCODING.
+    VERTEX_ATTRIBUTE_ENCODING Encoding = VERTEX_ATTRIBUTE_ENCODING_NONE;
+
     constexpr VertexAttributeDesc() noexcept {}
 
     constexpr VertexAttributeDesc(const char* _Name,
@@ -717,6 +1028,20 @@ struct VertexAttributeDesc
         NumComponents{_NumComponents},
         pDefaultValue{_pDefaultValue}
     {}
+
+    constexpr VertexAttributeDesc(const char*               _Name,
+                                  Uint8                     _BufferId,
+                                  VALUE_TYPE                _ValueType,
+                                  Uint8                     _NumComponents,
+                                  VERTEX_ATTRIBUTE_ENCODING _Encoding,
+                                  const void*               _pDefaultValue = VertexAttributeDesc{}.pDefaultValue) noexcept :
+        Name{_Name},
+        BufferId{_BufferId},
+        ValueType{_ValueType},
+        NumComponents{_NumComponents},
+        pDefaultValue{_pDefaultValue},
+        Encoding{_Encoding}
+    {}
 };
 
 static constexpr char PositionAttributeName[]    = "POSITION";
@@ -747,6 +1072,18 @@ static constexpr std::array<VertexAttributeDesc, 8> DefaultVertexAttributes =
     };
 // clang-format on
 
+/// Returns the default vertex attributes stored in the most compact formats whose error does not exceed MaxError.
+
+/// The following formats are selected when the error allows:
+/// - Positions: VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED as VT_UINT16 x 4 (maximum error 0.5/65535) or
+///   VT_UINT8 x 4 (0.5/255), relative to the primitive bounding box size.
+/// - Normals and tangents: VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL as VT_INT16 x 2 (maximum unit vector component error 4e-5).
+/// - Texture coordinates: VT_FLOAT16 x 2 (maximum error 1/2048 for coordinates in the [-2, 2] range).
+///
+/// Joints, weights and colors keep their default formats. The offsets of all attributes
+/// remain multiples of four bytes.
+std::array<VertexAttributeDesc, DefaultVertexAttributes.size()> GetQuantizedVertexAttributes(float MaxError);
+
 InputLayoutDescX VertexAttributesToInputLayout(const VertexAttributeDesc* pAttributes, size_t NumAttributes);
 
 
@@ -764,6 +1101,18 @@ struct ModelCreateInfo
     /// Optional resource manager to use when allocating resources for the model.
     ResourceManager* pResourceManager = nullptr;
 
+    /// Whether to share vertex and index data with other models that have identical content.
+
+    /// When this flag is set and pResourceManager is not null, the vertex and index data of every primitive
+    /// are allocated separately and are looked up in the resource manager by their content hash. If another
+    /// live model has already allocated identical data, its allocations are shared and no data is uploaded.
+    ///
+    /// The indices of every primitive are stored relative to its vertex range, and the primitive's index data
+    /// is followed by the indices of its levels of detail. The model itself has no vertex and index allocations,
+    /// so draw commands must use Model::GetBaseVertex(const Primitive&), Model::GetFirstIndexLocation(const Primitive&),
+    /// Model::GetVertexPoolIndex(const Primitive&) and Model::GetIndexAllocatorIndex(const Primitive&).
+    bool DeduplicateMeshData = false;
+
     /// Optional GPU upload manager to facilitate asynchronous data upload.
     IGPUUploadManager* pUploadMgr = nullptr;
 
@@ -836,9 +1185,47 @@ struct ModelCreateInfo
     /// Optional callback function that will be called by the loader to read the whole file.
     ReadWholeFileCallbackType ReadWholeFileCallback = nullptr;
 
+    /// Optional thread pool to use for decoding images in parallel (see DocumentLoadInfo::pThreadPool).
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Whether to memory-map the binary data of the source file (see DocumentLoadInfo::UseMemoryMapping).
+    bool UseMemoryMapping = false;
+
+    /// Optional path to the cooked model file.
+
+    /// When the path is provided, the loader first tries to restore the model from the cooked
+    /// file, which stores the converted vertex and index data together with the node, mesh,
+    /// material and animation tables (see CookedModel). The file is used only if it was produced
+    /// from the same source file with the same vertex and texture layout, index type and scene.
+    /// Otherwise, the model is loaded from the source file and the cooked file is rewritten.
+    ///
+    /// Texture pixel data is not stored in the cooked file. If all textures referenced by the
+    /// model are found in the texture cache or in the resource manager, the source file is not
+    /// parsed at all; otherwise, it is parsed to load the images.
+    ///
+    /// The source file is checked by its size and modification time, and its contents are hashed
+    /// only if the size matches but the modification time is different or not available (e.g. when
+    /// the file is read by ReadWholeFileCallback).
+    ///
+    /// \note   The cache covers the main source file only. Changes to external
+    ///         buffers or images that do not modify the main file are not detected.
+    ///         The cooked file is not used when node, mesh, primitive or material load callbacks
+    ///         are provided.
+    const char* CookedFileName = nullptr;
+
     /// Index data type.
     VALUE_TYPE IndexType = VT_UINT32;
 
+    /// Whether to store the indices of small primitives as 16-bit values when IndexType is VT_UINT32.
+
+    /// When this flag is set, the indices of every indexed primitive with at most 65535 vertices
+    /// are stored as 16-bit values relative to the primitive's vertex range, and Primitive::FirstVertex
+    /// is the base vertex that must be added to them. 16-bit and 32-bit index ranges share the same
+    /// index buffer, and every 32-bit range is 4-byte aligned, so Primitive::FirstIndex is in the units
+    /// of Primitive::IndexType and the draw command should use Primitive::IndexType and
+    /// Model::GetFirstIndexLocation(Primitive::IndexType).
+    bool NarrowIndices = false;
+
     /// Index buffer bind flags
     BIND_FLAGS IndBufferBindFlags = BIND_INDEX_BUFFER;
 
@@ -892,6 +1279,125 @@ struct ModelCreateInfo
     /// The buffer will be zero-initialized.
     bool CreateStubVertexBuffers = false;
 
+    /// Whether to keep a copy of the vertex data in Model::CPUVertexData.
+
+    /// The copy is required to process the vertices on the CPU, e.g. by Model::SkinVertices().
+    /// It is kept regardless of whether the render device is provided.
+    bool KeepCPUVertexData = false;
+
+    /// Whether to keep a copy of the index data in Model::CPUIndexData.
+
+    /// The copy is kept regardless of whether the render device is provided.
+    bool KeepCPUIndexData = false;
+
+    /// Whether to optimize the triangle and vertex order of indexed primitives.
+
+    /// When this flag is set, the triangles of every indexed primitive are reordered
+    /// to improve the post-transform vertex cache efficiency (see MeshOptimizer::OptimizeVertexCache),
+    /// and the vertices are renumbered in the order of their first use so that vertex
+    /// fetches are sequential. Primitives that share the vertex range with a non-indexed
+    /// primitive keep the original vertex order.
+    bool OptimizeVertexCache = false;
+
+    /// Overdraw optimization threshold.
+
+    /// If OptimizeVertexCache is true and the threshold is greater than zero, the triangles
+    /// are additionally reordered to reduce overdraw (see MeshOptimizer::OptimizeOverdraw).
+    /// The threshold is the maximum allowed vertex cache efficiency degradation factor,
+    /// e.g. 1.05 allows the ACMR to grow by up to 5%.
+    float OverdrawThreshold = 0;
+
+    /// Optional pointer to the structure that receives the vertex cache statistics
+    /// of all primitives before and after the optimization (see OptimizeVertexCache).
+    ///
+    /// \note   The statistics are not computed when the model is restored from the cooked file.
+    MeshOptimizationStats* pMeshOptimizationStats = nullptr;
+
+    /// Whether to split primitives into meshlets.
+
+    /// When this flag is set, the triangles of every triangle list primitive are split into
+    /// meshlets (see MeshOptimizer::BuildMeshlets) that are stored in Model::Meshlets.
+    /// The meshlets are built after the vertex cache optimization, if it is enabled.
+    /// The loader does not create GPU buffers for the meshlet data.
+    ///
+    /// The meshlet vertex indices of a primitive are relative to its vertex range. Add
+    /// Model::GetVertexRangeStart() to them to get the locations in the vertex buffers.
+    /// Primitives that are not triangle lists have no meshlets.
+    bool BuildMeshlets = false;
+
+    /// The maximum number of vertices in a meshlet, up to MeshOptimizer::MaxMeshletVertices.
+    Uint32 MeshletMaxVertices = 64;
+
+    /// The maximum number of triangles in a meshlet, up to MeshOptimizer::MaxMeshletTriangles.
+    Uint32 MeshletMaxTriangles = 124;
+
+    /// Whether to build triangle hierarchies of the meshes for CPU ray casts.
+
+    /// When this flag is set, the triangles of every mesh are added to Mesh::RayCastBVH,
+    /// which is used by Model::RayCast(). The hierarchies are built from the converted vertex
+    /// data when the model is loaded, including from a cooked model file, and require float32
+    /// or AABB-quantized positions.
+    bool BuildRayCastBVHs = false;
+
+    /// Whether to compute the bounds of the vertices influenced by every joint of every skin.
+
+    /// When this flag is set, Skin::JointBounds is computed from the converted vertex data when the model
+    /// is loaded, including from a cooked model file. Model::ComputeBoundingBox() and SceneBVH then bound
+    /// the skinned nodes by the boxes of their joints instead of the bind-pose mesh boxes (see
+    /// Model::ComputeSkinnedBoundingBox). Without the joint bounds, SceneBVH never culls skinned nodes.
+    /// Requires float32 or AABB-quantized positions.
+    bool ComputeJointBounds = false;
+
+    /// The minimum number of nodes that reference the same mesh to group them for instanced drawing.
+
+    /// If greater than zero, the nodes of every scene that share a mesh are collected in
+    /// Scene::InstanceGroups when there are at least this many of them, and
+    /// Model::ComputeTransforms() stores their matrices contiguously in ModelTransforms::InstanceMatrices.
+    /// The nodes with the EXT_mesh_gpu_instancing extension are always grouped.
+    Uint32 InstancingMinNodeCount = 0;
+
+    /// The maximum number of simplified levels of detail to generate for every indexed triangle list primitive.
+
+    /// Each level is simplified from the full-detail primitive (see MeshOptimizer::SimplifyMesh) and is
+    /// stored in the model index buffer as a separate index range in Primitive::LODs. The chain ends
+    /// early when a level can't be simplified further within LODTargetError.
+    Uint32 LODCount = 0;
+
+    /// The target ratio between the index counts of consecutive levels of detail.
+    float LODReductionRatio = 0.5f;
+
+    /// The maximum simplification error of every level of detail relative to the primitive bounding box size.
+    float LODTargetError = 0.01f;
+
+    /// The maximum vertex attribute quantization error allowed when the default vertex layout is used.
+
+    /// If VertexAttributes is null and this value is greater than zero, every default attribute is stored
+    /// in the most compact format whose error does not exceed this value (see GetQuantizedVertexAttributes).
+    /// The error is measured relative to the primitive bounding box size for positions and in the
+    /// attribute units for the other attributes.
+    ///
+    /// \note   Positions, normals and tangents may use encodings that must be decoded in the
+    ///         shader (see VERTEX_ATTRIBUTE_ENCODING). Use VertexAttributesToInputLayout and
+    ///         check the Encoding of every attribute returned by Model::GetVertexAttribute.
+    float VertexQuantizationError = 0;
+
+    /// If greater than zero, the maximum error of the animation compression performed after loading (see Model::CompressAnimations).
+    float AnimationCompressionError = 0;
+
+    /// Optional pointer to the vector that receives the compression statistics of every animation.
+    std::vector<AnimationCompressionStats>* pAnimationCompressionStats = nullptr;
+
+    /// If greater than zero, the frame rate at which the animations are baked after loading (see Model::BakeAnimations).
+    ///
+    /// \note If the animations are also compressed, they are baked from the compressed data.
+    float AnimationBakeRate = 0;
+
+    /// If greater than zero, the number of samples per second at which the bounds of every animation
+    /// are computed after loading (see Model::ComputeAnimationBounds).
+    ///
+    /// \note Skinned nodes are only bounded correctly if ComputeJointBounds is also set.
+    float AnimationBoundsSampleRate = 0;
+
     ModelCreateInfo() = default;
 
     explicit ModelCreateInfo(const char*                _FileName,
@@ -920,6 +1426,38 @@ struct ModelCreateInfo
     }
 };
 
+/// Joint transform format, see Model::WriteJointTransforms().
+enum JOINT_TRANSFORM_FORMAT : Uint8
+{
+    /// float4x4 matrix, the same as ModelTransforms::SkinTransforms::JointMatrices.
+    JOINT_TRANSFORM_FORMAT_FLOAT4X4 = 0,
+
+    /// Row-major 3x4 affine matrix: the three rows are the transposed first three columns
+    /// of the joint matrix, so that the joint transforms the position in the shader as
+    /// `float3(dot(Row0, float4(p, 1)), dot(Row1, float4(p, 1)), dot(Row2, float4(p, 1)))`.
+    JOINT_TRANSFORM_FORMAT_FLOAT3X4,
+
+    /// Unit dual quaternion stored as two float4 values: the real part (rotation) and
+    /// the dual part (translation). Scale can't be represented and is discarded.
+    JOINT_TRANSFORM_FORMAT_DUAL_QUATERNION,
+
+    JOINT_TRANSFORM_FORMAT_COUNT
+};
+
+/// Returns the size of one joint transform in the given format, in bytes.
+inline Uint32 GetJointTransformSize(JOINT_TRANSFORM_FORMAT Format)
+{
+    switch (Format)
+    {
+        case JOINT_TRANSFORM_FORMAT_FLOAT4X4: return sizeof(float) * 16;
+        case JOINT_TRANSFORM_FORMAT_FLOAT3X4: return sizeof(float) * 12;
+        case JOINT_TRANSFORM_FORMAT_DUAL_QUATERNION: return sizeof(float) * 8;
+        default:
+            UNEXPECTED("Unexpected joint transform format");
+            return 0;
+    }
+}
+
 struct ModelTransforms
 {
     // Transform matrices for each node in the model.
@@ -929,18 +1467,187 @@ struct ModelTransforms
     struct SkinTransforms
     {
         std::vector<float4x4> JointMatrices;
+
+        // Global matrix of the skinned node and its inverse. The inverse is only
+        // recomputed when the global matrix of the node changes.
+        float4x4 NodeGlobalMatrix;
+        float4x4 NodeGlobalInverse;
     };
     std::vector<SkinTransforms> Skins;
 
-    // Animation transforms for each node in the model.
+    // Animation transforms for each node in the model, stored as separate arrays.
     // This is an intermediate data to compute transform matrices.
     struct AnimationTransforms
     {
-        float3      Translation;
-        float3      Scale{1, 1, 1};
-        QuaternionF Rotation;
+        std::vector<float3>      Translations;
+        std::vector<QuaternionF> Rotations;
+        std::vector<float3>      Scales;
+
+        void Resize(size_t NumNodes)
+        {
+            Translations.resize(NumNodes);
+            Rotations.resize(NumNodes);
+            Scales.resize(NumNodes, float3{1, 1, 1});
+        }
+    };
+    AnimationTransforms NodeAnimations;
+
+    // Morph target weights of all nodes with morph targets, see Node::MorphWeightsOffset.
+    std::vector<float> MorphWeights;
+
+    // Global matrices of the instances of all instance groups of the scene, see InstanceGroup.
+    std::vector<float4x4> InstanceMatrices;
+
+    // Scratch data used to blend animation layers, see Model::ComputeTransforms().
+    AnimationTransforms LayerAnimations;
+    std::vector<float>  NodeBlendWeights;
+    std::vector<float>  LayerMorphWeights;
+
+    // Key frame indices found for each animation sampler by the last update.
+    // Animation time usually advances by a small delta between updates, so the
+    // search for the next key frame starts at these indices.
+    std::vector<Uint32> KeyFrameCursors;
+
+    // Incremental update state, see Model::UpdateTransforms().
+    // Per-node flags that mark the nodes whose transforms must be recomputed by the next
+    // incremental update.
+    enum NODE_DIRTY_FLAGS : Uint8
+    {
+        NODE_DIRTY_FLAG_NONE   = 0,
+        NODE_DIRTY_FLAG_LOCAL  = 1u << 0u,
+        NODE_DIRTY_FLAG_GLOBAL = 1u << 1u,
+        // Set temporarily while the skins are updated, to update every skin once.
+        NODE_DIRTY_FLAG_SKIN   = 1u << 2u,
     };
-    std::vector<AnimationTransforms> NodeAnimations;
+    std::vector<Uint8> NodeDirtyFlags;
+
+    // Indices of the nodes whose global matrices were recomputed by the last update,
+    // in the order of Scene::HierarchyNodeIds.
+    std::vector<Uint32> ChangedNodes;
+
+    // Indices of the Skins elements whose joint matrices were recomputed by the last update.
+    std::vector<Uint32> ChangedSkins;
+
+    // Parameters of the last update. A change of any of them results in a full update.
+    Int32    UpdateSceneIndex     = -1;
+    Int32    UpdateAnimationIndex = -1;
+    float4x4 UpdateRootTransform  = float4x4::Identity();
+
+    // Returns true if the transforms have been initialized by Model::UpdateTransforms()
+    // and the node transforms can be edited.
+    bool IsIncrementalUpdateEnabled() const
+    {
+        return !NodeDirtyFlags.empty();
+    }
+
+    // Set the transform of the given node and mark the node for the next incremental update.
+    // The values are kept until the next full update, which is performed when the scene,
+    // the animation or the root transform changes.
+    void SetNodeTranslation(Uint32 NodeIndex, const float3& Translation)
+    {
+        VERIFY(NodeIndex < NodeDirtyFlags.size(), "Node index is out of range. Call Model::UpdateTransforms() first.");
+        NodeAnimations.Translations[NodeIndex] = Translation;
+        NodeDirtyFlags[NodeIndex] |= NODE_DIRTY_FLAG_LOCAL;
+    }
+
+    void SetNodeRotation(Uint32 NodeIndex, const QuaternionF& Rotation)
+    {
+        VERIFY(NodeIndex < NodeDirtyFlags.size(), "Node index is out of range. Call Model::UpdateTransforms() first.");
+        NodeAnimations.Rotations[NodeIndex] = Rotation;
+        NodeDirtyFlags[NodeIndex] |= NODE_DIRTY_FLAG_LOCAL;
+    }
+
+    void SetNodeScale(Uint32 NodeIndex, const float3& Scale)
+    {
+        VERIFY(NodeIndex < NodeDirtyFlags.size(), "Node index is out of range. Call Model::UpdateTransforms() first.");
+        NodeAnimations.Scales[NodeIndex] = Scale;
+        NodeDirtyFlags[NodeIndex] |= NODE_DIRTY_FLAG_LOCAL;
+    }
+};
+
+/// Animation layer blended by Model::ComputeTransforms().
+struct AnimationLayer
+{
+    /// Animation index, or -1 to use the rest pose of the nodes.
+    Int32 AnimationIndex = -1;
+
+    /// Animation time.
+    float Time = 0;
+
+    /// Layer weight.
+    float Weight = 1;
+
+    /// Optional per-node weight multipliers indexed by the node index in Model::Nodes.
+
+    /// A mask restricts the layer to a part of the hierarchy, e.g. to the upper body.
+    /// If null, the layer affects all nodes.
+    const float* pNodeWeights = nullptr;
+
+    /// Whether the layer is additive.
+
+    /// Regular layers are blended together by their weights. If the total weight of
+    /// a node is less than one, the rest pose takes the remaining weight.
+    /// Additive layers are then applied on top of the blended pose: the difference between
+    /// the layer values and the rest pose of the node is scaled by the weight and added
+    /// to the translation, multiplied with the rotation and the scale.
+    bool Additive = false;
+};
+
+/// Parameters of a single model instance processed by the batched Model::ComputeTransforms().
+struct ModelTransformsBatchItem
+{
+    /// Transforms of the instance. Every item must reference its own object.
+    ModelTransforms* pTransforms = nullptr;
+
+    /// Root transform of the instance.
+    float4x4 RootTransform = float4x4::Identity();
+
+    /// Animation index, or -1 if the instance is not animated.
+    Int32 AnimationIndex = -1;
+
+    /// Animation time.
+    float Time = 0;
+};
+
+/// Ray cast against the model by Model::RayCast().
+struct ModelRay
+{
+    /// Ray origin in the model space, the same as the space of ModelTransforms::NodeGlobalMatrices.
+    float3 Origin;
+
+    /// Ray direction. Does not need to be normalized.
+    float3 Direction;
+
+    /// The maximum distance to the intersection, in the units of the direction length.
+    float MaxDistance = FLT_MAX;
+};
+
+/// The closest intersection of a ray with the model, see Model::RayCast().
+struct ModelRayHit
+{
+    /// Distance from the ray origin to the intersection, in the units of the ray direction length.
+    float Distance = FLT_MAX;
+
+    /// Index of the intersected node in Model::Nodes, or -1 if the ray hits nothing.
+    int NodeIndex = -1;
+
+    /// Index of the intersected instance in Node::InstanceMatrices if the node has
+    /// EXT_mesh_gpu_instancing instances, or 0 otherwise.
+    Uint32 InstanceIndex = 0;
+
+    /// Index of the intersected primitive in the mesh of the node.
+    Uint32 PrimitiveIndex = 0;
+
+    /// Index of the intersected triangle in the primitive.
+    Uint32 TriangleIndex = 0;
+
+    /// Barycentric coordinates of the intersection relative to the second and the third triangle vertices.
+    float2 Barycentrics;
+
+    bool IsHit() const
+    {
+        return NodeIndex >= 0;
+    }
 };
 
 /// GLTF model.
@@ -956,6 +1663,26 @@ struct Model
     std::vector<Animation>   Animations;
     std::vector<std::string> Extensions;
 
+    /// Meshlets of all primitives, see ModelCreateInfo::BuildMeshlets.
+    ///
+    /// Meshlet vertex indices are absolute indices in the model vertex data,
+    /// in the same way as the values in the index buffer.
+    MeshletData Meshlets;
+
+    /// Morph targets of all primitives, see Primitive::FirstMorphTarget.
+    MorphTargetData MorphTargets;
+
+    /// Copy of the data of every vertex buffer, see ModelCreateInfo::KeepCPUVertexData.
+    std::vector<std::vector<Uint8>> CPUVertexData;
+
+    /// Copy of the index data, see ModelCreateInfo::KeepCPUIndexData.
+    ///
+    /// The data is in the format of the index buffer, see Primitive::IndexType.
+    std::vector<Uint8> CPUIndexData;
+
+    /// Default morph target weights of all nodes, see Node::MorphWeightsOffset.
+    std::vector<float> DefaultMorphWeights;
+
     std::vector<RefCntAutoPtr<ISampler>> TextureSamplers;
 
     // The number of nodes that have skin.
@@ -1073,6 +1800,23 @@ struct Model
         return 0;
     }
 
+    /// Returns the first index location of the model index data in the units of the given index type.
+
+    /// Use this method with Primitive::IndexType when ModelCreateInfo::NarrowIndices is enabled.
+    Uint32 GetFirstIndexLocation(VALUE_TYPE IndexType) const
+    {
+        VERIFY(IndexType == VT_UINT16 || IndexType == VT_UINT32, "Invalid index type");
+        if (IndexData.pAllocation)
+        {
+            const Uint32 IndexSize = IndexType == VT_UINT32 ? 4 : 2;
+            const Uint32 Offset    = IndexData.pAllocation->GetOffset();
+            VERIFY((Offset % IndexSize) == 0, "Index data allocation offset is not a multiple of index size (", IndexSize, ")");
+            return Offset / IndexSize;
+        }
+
+        return 0;
+    }
+
     Uint32 GetBaseVertex() const
     {
         return VertexData.pAllocation ?
@@ -1103,6 +1847,79 @@ struct Model
         return IndexData.AllocatorId;
     }
 
+    /// Returns the base vertex of the primitive.
+
+    /// For an indexed primitive, this is the value that must be added to its indices.
+    /// For a non-indexed primitive, this is the location of its first vertex.
+    /// Unlike GetBaseVertex() + Primitive::FirstVertex, this method also works when
+    /// the primitive data is shared with other models (see ModelCreateInfo::DeduplicateMeshData).
+    Uint32 GetBaseVertex(const Primitive& Prim) const
+    {
+        return Prim.SharedData.pVertexAllocation ?
+            Prim.SharedData.pVertexAllocation->GetStartVertex() :
+            GetBaseVertex() + Prim.FirstVertex;
+    }
+
+    /// Returns the location of the first vertex of the primitive vertex range.
+
+    /// Unlike GetBaseVertex(const Primitive&), this is the start of the range even if the indices
+    /// of the primitive are not relative to it. The meshlet vertex indices are relative to this
+    /// location (see ModelCreateInfo::BuildMeshlets).
+    Uint32 GetVertexRangeStart(const Primitive& Prim) const
+    {
+        return Prim.SharedData.pVertexAllocation ?
+            Prim.SharedData.pVertexAllocation->GetStartVertex() :
+            GetBaseVertex() + Prim.VertexRangeStart;
+    }
+
+    /// Returns the location of the first index of the primitive in the units of Primitive::IndexType.
+
+    /// Similar to GetBaseVertex(const Primitive&), this method also works when the primitive
+    /// data is shared with other models.
+    Uint32 GetFirstIndexLocation(const Primitive& Prim) const
+    {
+        VERIFY(Prim.IndexType == VT_UINT16 || Prim.IndexType == VT_UINT32, "The primitive is not indexed");
+        if (Prim.SharedData.pIndexAllocation)
+        {
+            const Uint32 IndexSize = Prim.IndexType == VT_UINT32 ? 4 : 2;
+            const Uint32 Offset    = Prim.SharedData.pIndexAllocation->GetOffset();
+            VERIFY((Offset % IndexSize) == 0, "Index data allocation offset is not a multiple of index size (", IndexSize, ")");
+            return Offset / IndexSize;
+        }
+
+        return GetFirstIndexLocation(Prim.IndexType) + Prim.FirstIndex;
+    }
+
+    /// Returns the location of the first index of the primitive level of detail in the units of Primitive::IndexType.
+    Uint32 GetFirstIndexLocation(const Primitive& Prim, size_t LOD) const
+    {
+        VERIFY_EXPR(LOD < Prim.LODs.size());
+        if (!Prim.SharedData.pIndexAllocation)
+            return GetFirstIndexLocation(Prim.IndexType) + Prim.LODs[LOD].FirstIndex;
+
+        // Shared index data of the primitive is followed by the indices of its levels of detail
+        Uint32 Location = GetFirstIndexLocation(Prim) + Prim.IndexCount;
+        for (size_t i = 0; i < LOD; ++i)
+            Location += Prim.LODs[i].IndexCount;
+        return Location;
+    }
+
+    /// Returns an index of the vertex pool that contains the primitive vertices.
+    Uint32 GetVertexPoolIndex(const Primitive& Prim) const
+    {
+        return Prim.SharedData.pVertexAllocation ?
+            Prim.SharedData.VertexPoolId :
+            VertexData.PoolId;
+    }
+
+    /// Returns an index of the index buffer allocator that contains the primitive indices.
+    Uint32 GetIndexAllocatorIndex(const Primitive& Prim) const
+    {
+        return Prim.SharedData.pIndexAllocation ?
+            Prim.SharedData.IndexAllocatorId :
+            IndexData.AllocatorId;
+    }
+
     struct ImageData
     {
         int Width         = 0;
@@ -1160,8 +1977,197 @@ struct Model
                            Int32            AnimationIndex = -1,
                            float            Time           = 0) const;
 
+    /// Computes the transforms of the given scene by blending multiple animation layers.
+
+    /// All layers are accumulated per node in ModelTransforms::NodeAnimations: translations
+    /// and scales are blended linearly, rotations are blended as normalized quaternion sums
+    /// in the same hemisphere. The local matrices are computed once from the blended values.
+    /// See AnimationLayer for the description of the blending rules.
+    void ComputeTransforms(Uint32                SceneIndex,
+                           ModelTransforms&      Transforms,
+                           const AnimationLayer* pLayers,
+                           Uint32                NumLayers,
+                           const float4x4&       RootTransform = float4x4::Identity()) const;
+
+    /// Computes the transforms of multiple instances of the model in the given scene.
+
+    /// The items are split into contiguous chunks of ItemsPerTask elements. When the thread pool
+    /// is provided, the chunks are processed by the pool, while the calling thread processes the
+    /// first chunk and then the chunks that no pool thread has started yet. All instances share
+    /// the scene hierarchy and the animation data of the model, and every task only writes to the
+    /// transforms of its own items.
+    /// The results are identical to calling ComputeTransforms() for every item.
+    ///
+    /// \note The method only waits for the tasks it has enqueued, so it can be called while
+    ///       the pool is busy with unrelated work, as well as from a thread pool task.
+    void ComputeTransforms(Uint32                          SceneIndex,
+                           const ModelTransformsBatchItem* pItems,
+                           size_t                          NumItems,
+                           IThreadPool*                    pThreadPool  = nullptr,
+                           size_t                          ItemsPerTask = 16) const;
+
+    /// Incrementally updates the transforms of the given scene.
+
+    /// The first call, as well as any call with a different scene index, animation index or
+    /// root transform than the previous one, performs a full update equivalent to ComputeTransforms().
+    /// Subsequent calls only recompute the nodes that were modified by the
+    /// ModelTransforms::SetNodeTranslation/Rotation/Scale methods or whose values were changed
+    /// by the animation, the subtrees of these nodes and the skins that use them.
+    ///
+    /// The indices of the recomputed nodes and skins are written to ModelTransforms::ChangedNodes
+    /// and ModelTransforms::ChangedSkins, so that the application can only upload the modified matrices.
+    ///
+    /// \note ComputeTransforms() discards the incremental state of the transforms, so the next
+    ///       call to UpdateTransforms() performs a full update.
+    void UpdateTransforms(Uint32           SceneIndex,
+                          ModelTransforms& Transforms,
+                          const float4x4&  RootTransform  = float4x4::Identity(),
+                          Int32            AnimationIndex = -1,
+                          float            Time           = 0) const;
+
     BoundBox ComputeBoundingBox(Uint32 SceneIndex, const ModelTransforms& Transforms) const;
 
+    /// Computes the bounding box of the skinned mesh of the node in the model space.
+
+    /// \param [in] SkinnedNode - Node with a mesh and a skin.
+    /// \param [in] Transforms  - Transforms of the scene nodes, see ComputeTransforms().
+    /// \return     The union of the joint bounds (see Skin::JointBounds) transformed by the
+    ///             global matrices of the joints. The box is empty if the joint bounds are not available.
+    ///
+    /// The cost is proportional to the number of joints and does not depend on the vertex count.
+    /// The box is conservative for any pose, but it does not account for morph targets.
+    /// ComputeBoundingBox() and SceneBVH use this box for every skinned node whose skin has joint bounds.
+    BoundBox ComputeSkinnedBoundingBox(const Node& SkinnedNode, const ModelTransforms& Transforms) const;
+
+    /// Computes the conservative bounds of every animation.
+
+    /// The transforms of the default scene are computed at uniformly distributed times between
+    /// Animation::Start and Animation::End, and the union of the scene bounding boxes
+    /// (see ComputeBoundingBox) is stored in Animation::Bounds. The bounds are exact at the
+    /// sampled times only, so fast motion between the samples may slightly exceed them.
+    ///
+    /// \param [in] SampleRate - The number of samples per second.
+    void ComputeAnimationBounds(float SampleRate);
+
+    /// Applies the morph targets of the primitive to its vertex attributes on the CPU.
+
+    /// \param [in]     Prim       - Primitive of one of the model meshes.
+    /// \param [in]     pWeights   - Morph target weights of the primitive, e.g. the weights
+    ///                              of the node in ModelTransforms::MorphWeights.
+    /// \param [in,out] pPositions - Positions of the primitive vertices, or null.
+    /// \param [in,out] pNormals   - Normals of the primitive vertices, or null.
+    /// \param [in,out] pTangents  - Tangents of the primitive vertices, or null.
+    ///
+    /// \note The arrays must contain Prim.VertexCount elements. Normals and tangents are not renormalized.
+    void ApplyMorphTargets(const Primitive& Prim,
+                           const float*     pWeights,
+                           float3*          pPositions,
+                           float3*          pNormals  = nullptr,
+                           float3*          pTangents = nullptr) const;
+
+    /// Writes the joint transforms of the skinned node to the given buffer.
+
+    /// \param [in]     SkinnedNode - Node that has a mesh and a skin.
+    /// \param [in,out] Transforms  - Transforms computed by ComputeTransforms() or UpdateTransforms().
+    ///                               The inverse of the node global matrix is cached in Transforms.Skins.
+    /// \param [in]     Format      - Joint transform format.
+    /// \param [out]    pDst        - Destination buffer, e.g. a mapped GPU buffer.
+    /// \param [in]     Stride      - Distance between two joint transforms in bytes,
+    ///                               or 0 to use GetJointTransformSize(Format).
+    ///
+    /// The joint transforms are computed directly from the node global matrices,
+    /// so Transforms.Skins[].JointMatrices are neither used nor updated.
+    ///
+    /// \note The buffer must have room for SkinnedNode.pSkin->Joints.size() transforms.
+    void WriteJointTransforms(const Node&            SkinnedNode,
+                              ModelTransforms&       Transforms,
+                              JOINT_TRANSFORM_FORMAT Format,
+                              void*                  pDst,
+                              size_t                 Stride = 0) const;
+
+    /// Computes the skinned positions and normals of the primitive on the CPU.
+
+    /// \param [in]  SkinnedNode - Node that has a skin and the mesh that contains the primitive.
+    /// \param [in]  Prim        - Primitive of the node mesh.
+    /// \param [in]  Transforms  - Transforms with the joint matrices of the node skin, computed
+    ///                            by ComputeTransforms() or UpdateTransforms().
+    /// \param [out] pPositions  - Skinned positions of the Prim.VertexCount vertices, in the space of
+    ///                            the skinned node, the same as on the GPU.
+    /// \param [out] pNormals    - Skinned normals, or null.
+    /// \param [in]  pThreadPool - Optional thread pool to process the vertices in parallel.
+    /// \return true if the vertices have been skinned, and false if the vertex data is not
+    ///         available or its format is not supported.
+    ///
+    /// The model must be loaded with ModelCreateInfo::KeepCPUVertexData. Attributes may use any 8-, 16-
+    /// or 32-bit integer type or VT_FLOAT32; positions may be AABB-quantized and normals may be
+    /// octahedral-encoded. Integer weights are treated as normalized. Normals are transformed by the
+    /// blended joint matrix and renormalized.
+    bool SkinVertices(const Node&            SkinnedNode,
+                      const Primitive&       Prim,
+                      const ModelTransforms& Transforms,
+                      float3*                pPositions,
+                      float3*                pNormals    = nullptr,
+                      IThreadPool*           pThreadPool = nullptr) const;
+
+    /// Finds the closest intersection of the ray with the meshes of the scene nodes.
+
+    /// \param [in]  SceneIndex - Scene index.
+    /// \param [in]  Transforms - Transforms of the scene nodes, see ComputeTransforms().
+    /// \param [in]  Ray        - Ray in the model space.
+    /// \param [out] Hit        - The closest intersection.
+    /// \return true if the ray hits a triangle closer than Ray.MaxDistance.
+    ///
+    /// The model must be loaded with ModelCreateInfo::BuildRayCastBVHs. The ray is transformed into
+    /// the space of every mesh by the inverse of the node global matrix, so the mesh hierarchies are
+    /// never rebuilt. The meshes of the nodes with EXT_mesh_gpu_instancing instances are tested once
+    /// for every instance. Skinning and morph targets are not taken into account.
+    bool RayCast(Uint32                 SceneIndex,
+                 const ModelTransforms& Transforms,
+                 const ModelRay&        Ray,
+                 ModelRayHit&           Hit) const;
+
+    /// Finds the closest intersections of multiple rays, see RayCast().
+
+    /// \param [in]  SceneIndex  - Scene index.
+    /// \param [in]  Transforms  - Transforms of the scene nodes, see ComputeTransforms().
+    /// \param [in]  pRays       - Array of NumRays rays.
+    /// \param [in]  NumRays     - The number of rays.
+    /// \param [out] pHits       - Array of NumRays intersections.
+    /// \param [in]  pThreadPool - Optional thread pool to cast the rays in parallel.
+    /// \param [in]  RaysPerTask - The number of rays processed by one thread pool task.
+    void RayCast(Uint32                 SceneIndex,
+                 const ModelTransforms& Transforms,
+                 const ModelRay*        pRays,
+                 size_t                 NumRays,
+                 ModelRayHit*           pHits,
+                 IThreadPool*           pThreadPool = nullptr,
+                 size_t                 RaysPerTask = 64) const;
+
+    /// Resamples all animations at the given frame rate.
+
+    /// The values of every channel, including cubic spline channels, are evaluated at uniformly
+    /// distributed frames and stored in Animation::BakedValues. Baked animations are evaluated
+    /// by interpolating between two adjacent frames without searching the key frames:
+    /// translations and scales are linearly interpolated, rotations are normalized-linearly
+    /// interpolated. Step channels change their values at the frame boundaries.
+    /// The frame rate is slightly increased so that the last frame lands on the end of the animation.
+    /// Morph target weight channels are not baked and are always evaluated from their samplers.
+    ///
+    /// \note The original samplers are kept, so the animations may be baked again at a different rate.
+    void BakeAnimations(float FrameRate);
+
+    /// Compresses the key frames of all animations.
+
+    /// Redundant keys of linear and step samplers are removed as long as the animation does not
+    /// deviate from the original by more than MaxError. Rotations of linear and step samplers are
+    /// then stored as smallest-three quantized quaternions, translations and scales as 16-bit values
+    /// quantized to the sampler's range. Cubic spline rotations are not quantized.
+    /// MaxError is the distance for translations and scales and the angle in radians for rotations.
+    ///
+    /// Returns the statistics of every animation, including the maximum error measured
+    /// at the original key frame times and between them.
+    std::vector<AnimationCompressionStats> CompressAnimations(float MaxError);
+
     size_t GetTextureCount() const
     {
         return Textures.size();
@@ -1172,6 +2178,12 @@ struct Model
         return VertexData.Strides.size();
     }
 
+    Uint32 GetVertexBufferStride(Uint32 BufferId) const
+    {
+        VERIFY_EXPR(BufferId < VertexData.Strides.size());
+        return VertexData.Strides[BufferId];
+    }
+
     bool IsVertexAttributeEnabled(Uint32 AttribId) const
     {
         return (VertexData.EnabledAttributeFlags & (1u << AttribId)) != 0;
@@ -1182,11 +2194,17 @@ struct Model
 private:
     friend ModelBuilder;
     friend MeshLoader;
+    friend CookedModel;
 
     void LoadFromFile(IRenderDevice*         pDevice,
                       IDeviceContext*        pContext,
                       const ModelCreateInfo& CI);
 
+    bool LoadFromCookedFile(IRenderDevice*         pDevice,
+                            IDeviceContext*        pContext,
+                            const ModelCreateInfo& CI,
+                            const XXH128Hash&      CookedKey);
+
     void LoadTextures(IRenderDevice*         pDevice,
                       const tinygltf::Model& gltf_model,
                       const std::string&     BaseDir,
@@ -1197,6 +2215,11 @@ private:
     void LoadTextureSamplers(IRenderDevice* pDevice, const tinygltf::Model& gltf_model);
     void LoadMaterials(const tinygltf::Model& gltf_model, const ModelCreateInfo::MaterialLoadCallbackType& MaterialLoadCallback);
     void UpdateAnimation(Uint32 SceneIndex, Uint32 AnimationIndex, float time, ModelTransforms& Transforms) const;
+    void UpdateSkinTransforms(const Node& SkinnedNode, ModelTransforms& Transforms) const;
+    void ComputeGlobalTransforms(const Scene& scene, ModelTransforms& Transforms, const float4x4& RootTransform) const;
+
+    // Writes the instance matrices of the scene, only for the nodes with dirty flags if pDirtyFlags is not null.
+    void UpdateInstanceTransforms(const Scene& scene, ModelTransforms& Transforms, const Uint8* pDirtyFlags = nullptr) const;
 
     // Returns the alpha cutoff value for the given texture.
     // TextureIdx is the texture index in the GLTF file and also the Textures array.
@@ -1279,6 +2302,47 @@ inline float4x4 Node::ComputeLocalTransform() const
     return ComputeNodeLocalMatrix(Scale, Rotation, Translation, Matrix);
 }
 
+inline float4 AnimationSampler::GetOutput(size_t Idx) const
+{
+    switch (OutputEncoding)
+    {
+        case OUTPUT_ENCODING::FLOAT4:
+            return OutputsVec4[Idx];
+
+        case OUTPUT_ENCODING::RANGE_UNORM16:
+        {
+            const Uint16* pQ = &CompressedOutputs[Idx * 3];
+            return float4{OutputsMin + float3{static_cast<float>(pQ[0]), static_cast<float>(pQ[1]), static_cast<float>(pQ[2])} * OutputsScale, 0};
+        }
+
+        case OUTPUT_ENCODING::QUATERNION_SMALLEST_THREE:
+        {
+            const Uint16* pQ      = &CompressedOutputs[Idx * 3];
+            const Uint32  Largest = (pQ[0] >> 15u) | ((pQ[1] >> 15u) << 1u);
+
+            // The smallest components are in the [-1/sqrt(2), 1/sqrt(2)] range
+            constexpr float Scale = 1.4142135f / 32767.f;
+            constexpr float Bias  = -0.70710678f;
+
+            float4 q;
+            float  SumSq = 0;
+            for (Uint32 i = 0, j = 0; i < 4; ++i)
+            {
+                if (i == Largest)
+                    continue;
+                q[i] = static_cast<float>(pQ[j++] & 0x7FFFu) * Scale + Bias;
+                SumSq += q[i] * q[i];
+            }
+            q[Largest] = std::sqrt(std::max(1.f - SumSq, 0.f));
+            return q;
+        }
+
+        default:
+            UNEXPECTED("Unexpected output encoding");
+            return float4{};
+    }
+}
+
 inline size_t AnimationSampler::FindKeyFrame(float Time) const
 {
     if (Inputs.size() <= 2)
@@ -1308,6 +2372,32 @@ inline size_t AnimationSampler::FindKeyFrame(float Time) const
     return Idx;
 }
 
+inline size_t AnimationSampler::FindKeyFrame(float Time, Uint32& Cursor) const
+{
+    const size_t NumKeys = Inputs.size();
+    if (NumKeys <= 2)
+        return 0;
+
+    // Checks if FindKeyFrame(Time) returns Idx
+    const auto IsKeyFrame = [this, Time, NumKeys](size_t Idx) {
+        if (Idx == NumKeys - 1)
+            return Time > Inputs.back();
+        return (Idx == 0 || Inputs[Idx] < Time) && Time <= Inputs[Idx + 1];
+    };
+
+    if (Cursor < NumKeys)
+    {
+        if (IsKeyFrame(Cursor))
+            return Cursor;
+        if (Cursor + 1 < NumKeys && IsKeyFrame(Cursor + 1))
+            return ++Cursor;
+    }
+
+    const size_t Idx = FindKeyFrame(Time);
+    Cursor           = static_cast<Uint32>(Idx);
+    return Idx;
+}
+
 } // namespace GLTF
 
 } // namespace Diligent
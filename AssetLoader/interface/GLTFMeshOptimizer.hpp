@@ -0,0 +1,267 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Index and vertex order optimization for the post-transform vertex cache, overdraw and vertex fetch.
+
+#include <cstddef>
+#include <vector>
+
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
+#include "../../../DiligentCore/Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+/// Post-transform vertex cache statistics of a triangle list.
+struct VertexCacheStats
+{
+    /// The number of triangles.
+    Uint32 NumTriangles = 0;
+
+    /// The number of unique vertices referenced by the triangles.
+    Uint32 NumVertices = 0;
+
+    /// The number of vertices transformed by the simulated cache, i.e. the number of cache misses.
+    Uint32 NumTransformedVertices = 0;
+
+    /// Average cache miss ratio: the number of transformed vertices per triangle.
+    ///
+    /// The ratio is 3 when no vertex is reused and approaches 0.5 for large regular grids.
+    float GetACMR() const
+    {
+        return NumTriangles > 0 ? static_cast<float>(NumTransformedVertices) / static_cast<float>(NumTriangles) : 0.f;
+    }
+
+    /// Average transformed vertex ratio: the number of transformed vertices per unique vertex.
+    ///
+    /// The optimal ratio is 1, when every vertex is transformed exactly once.
+    float GetATVR() const
+    {
+        return NumVertices > 0 ? static_cast<float>(NumTransformedVertices) / static_cast<float>(NumVertices) : 0.f;
+    }
+
+    VertexCacheStats& operator+=(const VertexCacheStats& Rhs)
+    {
+        NumTriangles += Rhs.NumTriangles;
+        NumVertices += Rhs.NumVertices;
+        NumTransformedVertices += Rhs.NumTransformedVertices;
+        return *this;
+    }
+};
+
+/// Vertex cache statistics of all primitives optimized by the loader (see ModelCreateInfo::OptimizeVertexCache).
+struct MeshOptimizationStats
+{
+    /// Statistics of the original triangle order.
+    VertexCacheStats Before;
+
+    /// Statistics of the optimized triangle order.
+    VertexCacheStats After;
+};
+
+/// A small cluster of triangles that can be processed by a single mesh shader work group.
+struct Meshlet
+{
+    /// Index of the first meshlet vertex in MeshletData::VertexIndices.
+    Uint32 FirstVertex = 0;
+
+    /// Index of the first meshlet triangle in MeshletData::Triangles.
+    Uint32 FirstTriangle = 0;
+
+    /// The number of unique vertices referenced by the meshlet.
+    Uint32 VertexCount = 0;
+
+    /// The number of triangles in the meshlet.
+    Uint32 TriangleCount = 0;
+
+    /// Bounding sphere of the meshlet vertices: xyz - center, w - radius.
+    float4 BoundingSphere;
+
+    /// Normal cone of the meshlet triangles: xyz - axis, w - cutoff.
+    ///
+    /// All triangles of the meshlet face away from the camera and the meshlet can be culled if
+    ///
+    ///     dot(Center - CameraPos, Axis) >= Cutoff * length(Center - CameraPos) + Radius
+    ///
+    /// where Center and Radius define the bounding sphere. Cutoff is 1 when the triangle
+    /// normals span a half-space or more, in which case the test never passes.
+    float4 NormalCone = float4{0, 0, 0, 1};
+};
+
+/// Meshlets of a set of triangle lists.
+struct MeshletData
+{
+    /// Meshlets.
+    std::vector<Meshlet> Meshlets;
+
+    /// Vertex indices referenced by the meshlets.
+    std::vector<Uint32> VertexIndices;
+
+    /// Meshlet triangles. Every element packs three 8-bit indices into the meshlet
+    /// vertex list (bits 0-7, 8-15 and 16-23).
+    std::vector<Uint32> Triangles;
+};
+
+/// Triangle list optimization functions.
+///
+/// All functions operate on 32-bit triangle list indices in the range [0, NumVertices).
+class MeshOptimizer final
+{
+public:
+    /// The size of the FIFO cache used to compute the statistics.
+    static constexpr Uint32 StatsCacheSize = 16;
+
+    /// Simulates a FIFO post-transform vertex cache of the given size and returns the statistics.
+    static VertexCacheStats ComputeVertexCacheStats(const Uint32* pIndices,
+                                                    size_t        NumIndices,
+                                                    Uint32        NumVertices,
+                                                    Uint32        CacheSize = StatsCacheSize);
+
+    /// Reorders the triangles in place to improve post-transform vertex cache locality.
+    ///
+    /// The function implements the linear-speed vertex cache optimization algorithm
+    /// by Tom Forsyth. The vertex order within each triangle is preserved, so the
+    /// winding does not change.
+    static void OptimizeVertexCache(Uint32* pIndices,
+                                    size_t  NumIndices,
+                                    Uint32  NumVertices);
+
+    /// Reorders clusters of triangles in place to reduce overdraw.
+    ///
+    /// The triangles are split into clusters that keep the cache efficiency within
+    /// Threshold times the original ACMR (e.g. 1.05 allows 5% degradation), and the
+    /// clusters are sorted so that the outward-facing clusters are drawn first.
+    /// The function should be called after OptimizeVertexCache.
+    ///
+    /// \param [in, out] pIndices       - Triangle list indices.
+    /// \param [in]      NumIndices     - The number of indices.
+    /// \param [in]      pPositions     - A pointer to the first vertex position (three floats).
+    /// \param [in]      PositionStride - The distance in bytes between consecutive positions.
+    /// \param [in]      NumVertices    - The number of vertices.
+    /// \param [in]      Threshold      - Maximum allowed ACMR degradation factor.
+    static void OptimizeOverdraw(Uint32*     pIndices,
+                                 size_t      NumIndices,
+                                 const void* pPositions,
+                                 Uint32      PositionStride,
+                                 Uint32      NumVertices,
+                                 float       Threshold);
+
+    /// Computes the vertex remap table that orders the vertices by their first use.
+    ///
+    /// After the remap, vertex fetches of the index buffer are sequential. Vertices
+    /// that are not referenced by the indices are placed after the referenced ones
+    /// in their original order.
+    ///
+    /// \param [in]  pIndices    - Indices.
+    /// \param [in]  NumIndices  - The number of indices.
+    /// \param [in]  NumVertices - The number of vertices.
+    /// \param [out] pRemap      - An array of NumVertices elements that receives the
+    ///                            new index of every vertex.
+    ///
+    /// \return The number of referenced vertices.
+    static Uint32 ComputeVertexFetchRemap(const Uint32* pIndices,
+                                          size_t        NumIndices,
+                                          Uint32        NumVertices,
+                                          Uint32*       pRemap);
+
+    /// The maximum number of vertices in a meshlet addressable by 8-bit local indices.
+    static constexpr Uint32 MaxMeshletVertices = 256;
+
+    /// The maximum number of triangles in a meshlet.
+    static constexpr Uint32 MaxMeshletTriangles = 512;
+
+    /// Splits the triangle list into meshlets and appends them to Data.
+    ///
+    /// Triangles are added to the current meshlet in the order that shares the most vertices
+    /// with it, so the index buffer should be optimized for the vertex cache first.
+    ///
+    /// \param [in]      pIndices       - Triangle list indices.
+    /// \param [in]      NumIndices     - The number of indices.
+    /// \param [in]      pPositions     - A pointer to the first vertex position (three floats).
+    ///                                   If null, meshlet bounds are not computed.
+    /// \param [in]      PositionStride - The distance in bytes between consecutive positions.
+    /// \param [in]      NumVertices    - The number of vertices.
+    /// \param [in]      BaseVertex     - The value added to the vertex indices written to Data.VertexIndices.
+    /// \param [in]      MaxVertices    - The maximum number of vertices in a meshlet, up to MaxMeshletVertices.
+    /// \param [in]      MaxTriangles   - The maximum number of triangles in a meshlet, up to MaxMeshletTriangles.
+    /// \param [in, out] Data           - Meshlet data to append the meshlets to.
+    ///
+    /// \return The number of meshlets appended to Data.
+    static Uint32 BuildMeshlets(const Uint32* pIndices,
+                                size_t        NumIndices,
+                                const void*   pPositions,
+                                Uint32        PositionStride,
+                                Uint32        NumVertices,
+                                Uint32        BaseVertex,
+                                Uint32        MaxVertices,
+                                Uint32        MaxTriangles,
+                                MeshletData&  Data);
+
+    /// Simplifies the triangle list using quadric error metric edge collapses.
+    ///
+    /// Every edge collapse moves one vertex into the other end of the edge, so the result
+    /// references a subset of the original vertices and can share the vertex buffer with
+    /// the original triangles. Vertices on attribute seams (vertices with equal positions)
+    /// and on non-manifold edges are never removed, and border vertices only move along the border.
+    ///
+    /// \param [in]  pIndices         - Triangle list indices.
+    /// \param [in]  NumIndices       - The number of indices.
+    /// \param [in]  pPositions       - A pointer to the first vertex position (three floats).
+    /// \param [in]  PositionStride   - The distance in bytes between consecutive positions.
+    /// \param [in]  NumVertices      - The number of vertices.
+    /// \param [in]  TargetIndexCount - The target number of indices.
+    /// \param [in]  TargetError      - The maximum allowed deviation of the simplified surface
+    ///                                 from the original one, in the position units.
+    /// \param [out] pDstIndices      - An array of at least NumIndices elements that receives the
+    ///                                 simplified indices. May be the same as pIndices.
+    /// \param [out] pResultError     - Optional pointer to the variable that receives the
+    ///                                 deviation of the simplified surface, in the position units.
+    ///
+    /// \return The number of indices written to pDstIndices.
+    ///
+    /// \note   Simplification stops when either the target index count is reached or no edge
+    ///         can be collapsed without exceeding the target error, so the result may contain
+    ///         more indices than requested.
+    static size_t SimplifyMesh(const Uint32* pIndices,
+                               size_t        NumIndices,
+                               const void*   pPositions,
+                               Uint32        PositionStride,
+                               Uint32        NumVertices,
+                               size_t        TargetIndexCount,
+                               float         TargetError,
+                               Uint32*       pDstIndices,
+                               float*        pResultError = nullptr);
+};
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -33,12 +33,14 @@
 #include <vector>
 #include <unordered_map>
 #include <atomic>
+#include <functional>
 
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
 #include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../DiligentCore/Common/interface/ObjectBase.hpp"
 #include "../../../DiligentCore/Common/interface/SharedMutex.hpp"
+#include "../../../DiligentCore/Common/interface/XXH128Hasher.hpp"
 #include "../../../DiligentCore/Graphics/GraphicsTools/interface/BufferSuballocator.h"
 #include "../../../DiligentCore/Graphics/GraphicsTools/interface/DynamicTextureAtlas.h"
 #include "../../../DiligentCore/Graphics/GraphicsTools/interface/VertexPoolX.hpp"
@@ -200,6 +202,26 @@ public:
     /// in parallel with other thread-safe class methods.
     RefCntAutoPtr<IBufferSuballocation> AllocateIndices(Uint32 Size, Uint32 Alignment = 4);
 
+    /// Finds the index allocation registered with the content hash or allocates new indices and registers them.
+
+    /// \param[in]  Size           - The size of the index data, in bytes.
+    /// \param[in]  Alignment      - The allocation alignment.
+    /// \param[in]  ContentHash    - Hash of the index data.
+    /// \param[in]  InitAllocation - Function that is called for a new allocation before it is
+    ///                              registered. It should set up the index data upload.
+    ///
+    /// The lookup and the allocation are performed under a single lock, so that models that are
+    /// loaded in parallel and contain identical data always end up with the same allocation.
+    /// The manager only keeps a weak reference to the allocation, so the space is released
+    /// when the last model that uses it is destroyed.
+    ///
+    /// The function is thread-safe and can be called from multiple threads simultaneously and
+    /// in parallel with other thread-safe class methods.
+    RefCntAutoPtr<IBufferSuballocation> FindOrAllocateIndices(Uint32                                            Size,
+                                                              Uint32                                            Alignment,
+                                                              const XXH128Hash&                                 ContentHash,
+                                                              const std::function<void(IBufferSuballocation*)>& InitAllocation);
+
     /// Allocates vertices in the vertex pool that matches the specified layout.
 
     /// \param[in]  LayoutKey   - Vertex layout key, see VertexLayoutKey.
@@ -220,6 +242,25 @@ public:
     /// in parallel with other thread-safe class methods.
     RefCntAutoPtr<IVertexPoolAllocation> AllocateVertices(const VertexLayoutKey& LayoutKey, Uint32 VertexCount);
 
+    /// Finds the vertex allocation registered with the layout key and content hash or allocates
+    /// new vertices and registers them.
+
+    /// \param[in]  LayoutKey      - Vertex layout key, see VertexLayoutKey.
+    /// \param[in]  VertexCount    - The number of vertices to allocate.
+    /// \param[in]  ContentHash    - Hash of the vertex data.
+    /// \param[in]  InitAllocation - Function that is called for a new allocation before it is
+    ///                              registered. It should set up the vertex data upload.
+    ///
+    /// Similar to FindOrAllocateIndices(), the lookup and the allocation are performed under a single lock
+    /// and the manager only keeps a weak reference to the allocation.
+    ///
+    /// The function is thread-safe and can be called from multiple threads simultaneously and
+    /// in parallel with other thread-safe class methods.
+    RefCntAutoPtr<IVertexPoolAllocation> FindOrAllocateVertices(const VertexLayoutKey&                             LayoutKey,
+                                                                Uint32                                             VertexCount,
+                                                                const XXH128Hash&                                  ContentHash,
+                                                                const std::function<void(IVertexPoolAllocation*)>& InitAllocation);
+
 
     /// Returns the combined texture atlas version, i.e. the sum of the texture versions of all
     /// atlases.
@@ -512,6 +553,60 @@ private:
     };
     std::vector<TexAllocations> m_TexAllocations;
 
+    // Vertex and index allocations registered by their content hash
+    template <typename KeyType, typename AllocationType>
+    class ContentAllocations
+    {
+    public:
+        template <typename CreateAllocationType>
+        RefCntAutoPtr<AllocationType> FindOrCreate(const KeyType& Key, CreateAllocationType&& CreateAllocation);
+
+    private:
+        using AllocationsHashMapType = std::unordered_map<KeyType, RefCntWeakPtr<AllocationType>, typename KeyType::Hasher>;
+
+        // Released allocations are only erased when they are looked up again, so the map is swept
+        // when it grows to twice its size after the previous sweep.
+        void RemoveExpiredAllocations();
+
+        Threading::SharedMutex m_Mtx;
+        AllocationsHashMapType m_Map;
+        size_t                 m_SizeAfterSweep = 0;
+    };
+
+    struct IndexDataKey
+    {
+        XXH128Hash ContentHash;
+
+        bool operator==(const IndexDataKey& rhs) const
+        {
+            return ContentHash.LowPart == rhs.ContentHash.LowPart && ContentHash.HighPart == rhs.ContentHash.HighPart;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const IndexDataKey& Key) const;
+        };
+    };
+
+    struct VertexDataKey
+    {
+        VertexLayoutKey LayoutKey;
+        XXH128Hash      ContentHash;
+
+        bool operator==(const VertexDataKey& rhs) const
+        {
+            return ContentHash.LowPart == rhs.ContentHash.LowPart && ContentHash.HighPart == rhs.ContentHash.HighPart && LayoutKey == rhs.LayoutKey;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const VertexDataKey& Key) const;
+        };
+    };
+
+    ContentAllocations<IndexDataKey, IBufferSuballocation>   m_IndexAllocations;
+    ContentAllocations<VertexDataKey, IVertexPoolAllocation> m_VertexAllocations;
+
     std::vector<StateTransitionDesc> m_Barriers;
 };
 
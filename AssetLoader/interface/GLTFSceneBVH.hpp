@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Bounding volume hierarchy over the primitives of a GLTF model scene and frustum culling.
+
+#include <vector>
+
+#include "GLTFLoader.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+/// Primitive of a scene node returned by SceneBVH queries.
+struct ScenePrimitiveRef
+{
+    /// Index of the node in the Model::Nodes array.
+    Uint32 NodeIndex = 0;
+
+    /// Index of the primitive in the Mesh::Primitives array of the node mesh.
+    Uint32 PrimitiveIndex = 0;
+
+    constexpr bool operator==(const ScenePrimitiveRef& Rhs) const
+    {
+        return NodeIndex == Rhs.NodeIndex && PrimitiveIndex == Rhs.PrimitiveIndex;
+    }
+};
+
+/// Statistics of a SceneBVH::QueryVisible() call.
+struct SceneBVHQueryStats
+{
+    /// The number of hierarchy nodes tested against the frustum.
+    Uint32 NumNodeTests = 0;
+
+    /// The number of primitive bounding boxes tested against the frustum.
+    Uint32 NumPrimitiveTests = 0;
+};
+
+/// Bounding volume hierarchy over the world-space bounding boxes of the primitives of a model scene.
+
+/// The primitives of the nodes that may move when the model is animated, i.e. the nodes targeted by
+/// animation channels, their descendants and skinned nodes, are kept in a separate dynamic subtree.
+/// Refit() only updates the dynamic subtree, so static parts of the scene add no per-frame cost.
+///
+/// The bounding box of a primitive of a node with EXT_mesh_gpu_instancing instances encloses
+/// all instances, so the primitive is visible if any of its instances is.
+///
+/// The joints rather than the node matrix place the vertices of a skinned node, so the box of its
+/// primitives is the box computed by Model::ComputeSkinnedBoundingBox() from the joint bounds
+/// (see ModelCreateInfo::ComputeJointBounds). Without the joint bounds, the primitives of skinned
+/// nodes are never culled.
+///
+/// \note   Primitives without a valid bounding box are not added to the hierarchy.
+class SceneBVH
+{
+public:
+    /// Builds the hierarchy over the primitives of the scene.
+
+    /// \param [in] Mdl        - Model whose scene is processed. The model must outlive the hierarchy.
+    /// \param [in] SceneIndex - Index of the scene in Mdl.Scenes.
+    /// \param [in] Transforms - Transforms computed by Model::ComputeTransforms() for the same scene.
+    void Build(const Model& Mdl, Uint32 SceneIndex, const ModelTransforms& Transforms);
+
+    /// Updates the bounding boxes from the node global matrices without changing the hierarchy.
+
+    /// \param [in] Transforms  - Updated transforms of the model.
+    /// \param [in] RefitStatic - Whether to also refit the static subtree, e.g. after a node that is
+    ///                           not animated has been moved by the application.
+    ///
+    /// \note   The quality of the hierarchy degrades when the dynamic primitives move far from their
+    ///         original positions. Call Build() to rebuild it in this case.
+    void Refit(const ModelTransforms& Transforms, bool RefitStatic = false);
+
+    /// Finds the primitives whose world-space bounding boxes intersect the view frustum.
+
+    /// \param [in]  Frustum      - View frustum. A point is inside the frustum when its signed
+    ///                             distance to every plane is not negative, see ExtractViewFrustumPlanesFromMatrix.
+    /// \param [out] VisiblePrims - The visible primitives are appended to this array.
+    /// \param [out] pStats       - Optional statistics of the query.
+    ///
+    /// \return The number of primitives appended to VisiblePrims.
+    size_t QueryVisible(const ViewFrustum&              Frustum,
+                        std::vector<ScenePrimitiveRef>& VisiblePrims,
+                        SceneBVHQueryStats*             pStats = nullptr) const;
+
+    /// Returns the bounding box of all primitives in the hierarchy.
+    BoundBox GetBounds() const;
+
+    size_t GetPrimitiveCount() const { return m_Prims.size(); }
+    size_t GetDynamicPrimitiveCount() const { return m_Prims.size() - m_NumStaticPrims; }
+    size_t GetNodeCount() const { return m_Nodes.size(); }
+
+    /// Returns the world-space bounding box of the primitive with the given index in the hierarchy.
+    const BoundBox&          GetPrimitiveBounds(size_t Idx) const { return m_PrimBounds[Idx]; }
+    const ScenePrimitiveRef& GetPrimitive(size_t Idx) const { return m_Prims[Idx]; }
+
+private:
+    // Nodes are stored in depth-first order, so the first child of an internal node immediately
+    // follows it, and children are always stored after their parents.
+    struct BVHNode
+    {
+        BoundBox BB;
+
+        // Index of the first primitive for leaves, or the index of the second child for internal nodes.
+        Uint32 Offset = 0;
+
+        // The number of primitives in a leaf, or 0 for internal nodes.
+        Uint32 NumPrims = 0;
+    };
+
+    Uint32 BuildSubtree(std::vector<Uint32>& Order, Uint32 FirstPrim, Uint32 EndPrim);
+    void   RefitNode(Uint32 NodeIdx, const ModelTransforms& Transforms);
+
+    const Model* m_pModel = nullptr;
+
+    std::vector<BVHNode> m_Nodes;
+
+    // Primitives in the order of the leaves. Static primitives precede dynamic ones.
+    std::vector<ScenePrimitiveRef> m_Prims;
+    std::vector<BoundBox>          m_PrimBounds;
+    size_t                         m_NumStaticPrims = 0;
+
+    // Index of the first node of the dynamic subtree. All nodes from this index on belong to it.
+    Uint32 m_DynamicNodesStart = 0;
+};
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Bounding volume hierarchy over triangles for CPU ray casts.
+
+#include <cfloat>
+#include <vector>
+
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
+#include "../../../DiligentCore/Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+/// Bounding volume hierarchy over a triangle list, built with the surface area heuristic.
+
+/// The triangle vertices are copied into the hierarchy in the order of the leaves,
+/// so the hierarchy does not reference the source data after it has been built.
+class TriangleBVH
+{
+public:
+    /// Ray-triangle intersection.
+    struct Hit
+    {
+        /// Distance to the intersection along the ray, in the units of the ray direction length.
+        float Distance = FLT_MAX;
+
+        /// Barycentric coordinates of the intersection relative to the second and the third
+        /// triangle vertices.
+        float U = 0;
+        float V = 0;
+
+        /// Id of the intersected triangle.
+        Uint32 TriangleId = ~0u;
+    };
+
+    /// Builds the hierarchy.
+
+    /// \param [in] pPositions   - Vertex positions.
+    /// \param [in] NumVertices  - The number of vertices.
+    /// \param [in] pIndices     - Triangle list indices, three per triangle.
+    /// \param [in] NumTriangles - The number of triangles.
+    /// \param [in] pTriangleIds - Optional ids of the triangles returned in Hit::TriangleId.
+    ///                            If null, the index of the triangle is used.
+    ///
+    /// \note   Triangles with out-of-range indices are skipped.
+    void Build(const float3* pPositions,
+               Uint32        NumVertices,
+               const Uint32* pIndices,
+               Uint32        NumTriangles,
+               const Uint32* pTriangleIds = nullptr);
+
+    /// Finds the closest intersection of the ray with the triangles.
+
+    /// \param [in]     Origin    - Ray origin.
+    /// \param [in]     Direction - Ray direction. Does not need to be normalized.
+    /// \param [in,out] Hit       - Only intersections closer than Hit.Distance are reported.
+    ///                             On input, this is typically the maximum ray length.
+    ///
+    /// \return true if a closer intersection has been found, in which case Hit is updated.
+    ///
+    /// \note   Triangles are two-sided.
+    bool RayCast(const float3& Origin, const float3& Direction, Hit& Hit) const;
+
+    bool IsEmpty() const { return m_Nodes.empty(); }
+
+    size_t GetTriangleCount() const { return m_TriangleIds.size(); }
+    size_t GetNodeCount() const { return m_Nodes.size(); }
+
+    /// Returns the bounding box of all triangles.
+    BoundBox GetBounds() const;
+
+    /// Returns the memory used by the hierarchy, in bytes.
+    size_t GetMemorySize() const;
+
+private:
+    // Nodes are stored in depth-first order: the first child of an internal node immediately follows it.
+    struct BVHNode
+    {
+        float3 Min;
+
+        // Index of the first triangle for leaves, or the index of the second child for internal nodes.
+        Uint32 Offset = 0;
+
+        float3 Max;
+
+        // The number of triangles in a leaf, or 0 for internal nodes.
+        Uint32 NumTriangles = 0;
+    };
+    static_assert(sizeof(BVHNode) == 32, "Unexpected BVH node size");
+
+    struct BuildTriangle;
+    Uint32 BuildSubtree(std::vector<BuildTriangle>& Triangles, Uint32 First, Uint32 End, Uint32 Depth);
+
+    std::vector<BVHNode> m_Nodes;
+
+    // Three vertices per triangle, in the order of the leaves
+    std::vector<float3> m_Vertices;
+    std::vector<Uint32> m_TriangleIds;
+};
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -34,6 +34,8 @@ namespace Diligent
 namespace GLTF
 {
 
+enum VERTEX_ATTRIBUTE_ENCODING : Uint8;
+
 class VertexDataConverter final
 {
 public:
@@ -51,6 +53,19 @@ public:
 
         Uint32 NumElements  = 0;
         bool   IsNormalized = false;
+
+        // Whether to use the vectorized kernels for the common conversions.
+        // The scalar path is the reference implementation; both produce identical bits
+        // as long as the converter is compiled without FMA contraction (see CMakeLists.txt).
+        bool UseSIMD = true;
+
+        // Destination encoding (see VERTEX_ATTRIBUTE_ENCODING). Encoded attributes and VT_FLOAT16
+        // destinations are converted through floats by the scalar path.
+        VERTEX_ATTRIBUTE_ENCODING Encoding = {};
+
+        // The source value range mapped to [0, 1] by VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED (three floats each).
+        const float* pQuantizationMin = nullptr;
+        const float* pQuantizationMax = nullptr;
     };
 
     static bool Write(const WriteAttribs& Attribs);
@@ -63,6 +78,9 @@ public:
         Uint32      NumDstComponents = 0;
         Uint32      DstElementStride = 0;
         Uint32      NumElements      = 0;
+
+        // Whether to use the fixed-size fill kernels for common element sizes.
+        bool UseSIMD = true;
     };
 
     static bool WriteDefault(const WriteDefaultAttribs& Attribs);
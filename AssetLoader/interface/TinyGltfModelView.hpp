@@ -67,12 +67,28 @@ struct TinyGltfNodeView
     const std::vector<double>& GetScale()       const { return Node.scale; }
     const std::vector<double>& GetMatrix()      const { return Node.matrix; }
     const std::vector<int>&    GetChildrenIds() const { return Node.children; }
+    const std::vector<double>& GetWeights()     const { return Node.weights; }
 
     int GetMeshId()   const { return Node.mesh; }
     int GetCameraId() const { return Node.camera; }
     int GetLightId()  const { return Node.light; }
     int GetSkinId()   const { return Node.skin; }
     // clang-format on
+
+    // Returns the accessor index of the EXT_mesh_gpu_instancing attribute (TRANSLATION, ROTATION or SCALE), or -1.
+    int GetInstancingAttributeId(const char* Name) const
+    {
+        auto ext_it = Node.extensions.find("EXT_mesh_gpu_instancing");
+        if (ext_it == Node.extensions.end() || !ext_it->second.Has("attributes"))
+            return -1;
+
+        const tinygltf::Value& Attribs = ext_it->second.Get("attributes");
+        if (!Attribs.IsObject() || !Attribs.Has(Name))
+            return -1;
+
+        const tinygltf::Value& AccessorId = Attribs.Get(Name);
+        return AccessorId.IsNumber() ? AccessorId.GetNumberAsInt() : -1;
+    }
 };
 
 struct TinyGltfPrimitiveView
@@ -87,10 +103,24 @@ struct TinyGltfPrimitiveView
             nullptr;
     }
 
+    size_t GetTargetCount() const { return Primitive.targets.size(); }
+
+    const int* GetTargetAttribute(size_t Target, const char* Name) const
+    {
+        const auto& Attribs   = Primitive.targets[Target];
+        auto        attrib_it = Attribs.find(Name);
+        return attrib_it != Attribs.end() ?
+            &attrib_it->second :
+            nullptr;
+    }
+
     const tinygltf::Primitive& Get() const { return Primitive; }
 
     int GetIndicesId() const { return Primitive.indices; }
     int GetMaterialId() const { return Primitive.material; }
+
+    // The mode is -1 if the primitive was not parsed from a file, which means the default mode.
+    bool IsTriangleList() const { return Primitive.mode == TINYGLTF_MODE_TRIANGLES || Primitive.mode == -1; }
 };
 
 struct TinyGltfMeshView
@@ -100,6 +130,8 @@ struct TinyGltfMeshView
     const tinygltf::Mesh& Get() const { return Mesh; }
     const std::string&    GetName() const { return Mesh.name; }
 
+    const std::vector<double>& GetWeights() const { return Mesh.weights; }
+
     size_t                GetPrimitiveCount() const { return Mesh.primitives.size(); }
     TinyGltfPrimitiveView GetPrimitive(size_t Idx) const { return TinyGltfPrimitiveView{Mesh.primitives[Idx]}; }
 };
@@ -205,7 +237,7 @@ struct TinyGltfBufferView
 
     const unsigned char* GetData(size_t Offset) const
     {
-        return Offset < Buffer.data.size() ? Buffer.data.data() + Offset : nullptr;
+        return Offset < Buffer.GetSize() ? Buffer.GetData() + Offset : nullptr;
     }
 };
 
@@ -26,7 +26,12 @@
 
 #include "GLTFBuilder.hpp"
 #include "GLTFLoader.hpp"
+#include "GLTFMeshOptimizer.hpp"
 #include "GraphicsAccessories.hpp"
+#include "XXH128Hasher.hpp"
+
+#include <cstring>
+#include <numeric>
 
 namespace Diligent
 {
@@ -40,6 +45,12 @@ MeshLoader::MeshLoader(const ModelCreateInfo& _CI, Model& _Model) :
 {
     VERIFY_EXPR(!m_Model.VertexData.Strides.empty());
     m_VertexData.resize(m_Model.VertexData.Strides.size());
+
+    for (Uint32 i = 0; i < m_Model.GetNumVertexAttributes(); ++i)
+    {
+        if (m_Model.VertexAttributes[i].Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED)
+            m_HasQuantizedPositions = true;
+    }
 }
 
 Mesh* MeshLoader::GetLoadedMesh(int LoadedMeshId)
@@ -47,6 +58,13 @@ Mesh* MeshLoader::GetLoadedMesh(int LoadedMeshId)
     return &m_Model.Meshes[LoadedMeshId];
 }
 
+void MeshLoader::SetData(std::vector<Uint8>&& IndexData, std::vector<std::vector<Uint8>>&& VertexData)
+{
+    VERIFY(VertexData.size() == m_Model.VertexData.Strides.size(), "The number of vertex buffers does not match the model layout");
+    m_IndexData  = std::move(IndexData);
+    m_VertexData = std::move(VertexData);
+}
+
 size_t MeshLoader::PrimitiveKey::Hasher::operator()(const PrimitiveKey& Key) const noexcept
 {
     if (Key.Hash == 0)
@@ -82,6 +100,536 @@ void MeshLoader::WriteDefaultAttibutes(Uint32 BufferId, size_t StartOffset, size
     }
 }
 
+Uint32 MeshLoader::AllocateIndices(Uint32 IndexSize, size_t IndexCount)
+{
+    VERIFY_EXPR(IndexSize == 2 || IndexSize == 4);
+    VERIFY((m_IndexData.size() % m_Model.IndexData.IndexSize) == 0, "Current offset is not a multiple of the model index size");
+
+    const Uint32 FirstIndex = static_cast<Uint32>(m_IndexData.size() / IndexSize);
+
+    const size_t ModelIndexSize = m_Model.IndexData.IndexSize;
+    const size_t DataSize       = m_IndexData.size() + IndexCount * IndexSize;
+    m_IndexData.resize((DataSize + ModelIndexSize - 1) / ModelIndexSize * ModelIndexSize);
+
+    return FirstIndex;
+}
+
+void MeshLoader::ReadIndices(const PrimitiveRange& Range, Uint32* pIndices) const
+{
+    const Uint32 IndexSize = Range.IndexSize;
+    const Uint8* pSrc      = &m_IndexData[size_t{Range.FirstIndex} * IndexSize];
+    for (Uint32 i = 0; i < Range.IndexCount; ++i)
+    {
+        Uint32 Index = 0;
+        if (IndexSize == 4)
+        {
+            std::memcpy(&Index, pSrc + size_t{i} * 4, sizeof(Uint32));
+        }
+        else
+        {
+            Uint16 Index16 = 0;
+            std::memcpy(&Index16, pSrc + size_t{i} * 2, sizeof(Uint16));
+            Index = Index16;
+        }
+        // Note: indices below the first vertex wrap around and are rejected by the range check
+        pIndices[i] = Index - Range.IndexBase;
+    }
+}
+
+void MeshLoader::WriteIndices(const PrimitiveRange& Range, const Uint32* pIndices)
+{
+    const Uint32 IndexSize = Range.IndexSize;
+    Uint8*       pDst      = &m_IndexData[size_t{Range.FirstIndex} * IndexSize];
+    for (Uint32 i = 0; i < Range.IndexCount; ++i)
+    {
+        const Uint32 Index = pIndices[i] + Range.IndexBase;
+        if (IndexSize == 4)
+        {
+            std::memcpy(pDst + size_t{i} * 4, &Index, sizeof(Uint32));
+        }
+        else
+        {
+            const Uint16 Index16 = static_cast<Uint16>(Index);
+            std::memcpy(pDst + size_t{i} * 2, &Index16, sizeof(Uint16));
+        }
+    }
+}
+
+MeshLoader::PrimitiveRange MeshLoader::GetPrimitiveRange(size_t MeshId, Uint32 PrimId) const
+{
+    const Primitive& Prim = m_Model.Meshes[MeshId].Primitives[PrimId];
+
+    // Primitive::FirstVertex is the value added to the stored indices (see LoadMesh)
+    PrimitiveRange Range;
+    Range.FirstIndex  = Prim.FirstIndex;
+    Range.IndexCount  = Prim.HasIndices() ? Prim.GetTriangleCount() * 3 : 0;
+    Range.FirstVertex = Prim.VertexRangeStart;
+    Range.VertexCount = Prim.VertexCount;
+    Range.MeshId      = static_cast<int>(MeshId);
+    Range.PrimitiveId = PrimId;
+    Range.IndexSize   = Prim.IndexType == VT_UINT16 ? 2 : 4;
+    Range.IndexBase   = Prim.VertexRangeStart - Prim.FirstVertex;
+    return Range;
+}
+
+bool MeshLoader::ReadPositions(const PrimitiveRange& Range, std::vector<float3>& Positions) const
+{
+    for (Uint32 i = 0; i < m_Model.GetNumVertexAttributes(); ++i)
+    {
+        const VertexAttributeDesc& Attrib = m_Model.VertexAttributes[i];
+        if (std::strcmp(Attrib.Name, PositionAttributeName) != 0)
+            continue;
+
+        const std::vector<Uint8>& PosData   = m_VertexData[Attrib.BufferId];
+        const Uint32              PosStride = m_Model.VertexData.Strides[Attrib.BufferId];
+        if (Attrib.NumComponents < 3 || PosData.size() < (size_t{Range.FirstVertex} + Range.VertexCount) * PosStride)
+            return false;
+
+        const Uint8* pPositions = &PosData[size_t{Range.FirstVertex} * PosStride + Attrib.RelativeOffset];
+        if (Attrib.Encoding == VERTEX_ATTRIBUTE_ENCODING_NONE && Attrib.ValueType == VT_FLOAT32)
+        {
+            Positions.resize(Range.VertexCount);
+            for (Uint32 v = 0; v < Range.VertexCount; ++v)
+                std::memcpy(&Positions[v], pPositions + size_t{v} * PosStride, sizeof(float3));
+            return true;
+        }
+
+        if (Attrib.Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED)
+        {
+            VERIFY_EXPR(Attrib.ValueType == VT_UINT8 || Attrib.ValueType == VT_UINT16);
+
+            // Positions are quantized relative to the primitive bounding box (see ConvertVertexData)
+            const BoundBox& BB       = m_Model.Meshes[Range.MeshId].Primitives[Range.PrimitiveId].BB;
+            const float     MaxValue = Attrib.ValueType == VT_UINT8 ? 255.f : 65535.f;
+            const float3    Scale    = (BB.Max - BB.Min) / MaxValue;
+
+            Positions.resize(Range.VertexCount);
+            for (Uint32 v = 0; v < Range.VertexCount; ++v)
+            {
+                const Uint8* pPos = pPositions + size_t{v} * PosStride;
+                for (Uint32 c = 0; c < 3; ++c)
+                {
+                    Uint32 Value = 0;
+                    if (Attrib.ValueType == VT_UINT8)
+                    {
+                        Value = pPos[c];
+                    }
+                    else
+                    {
+                        Uint16 Value16 = 0;
+                        std::memcpy(&Value16, pPos + c * sizeof(Uint16), sizeof(Value16));
+                        Value = Value16;
+                    }
+                    Positions[v][c] = BB.Min[c] + static_cast<float>(Value) * Scale[c];
+                }
+            }
+            return true;
+        }
+
+        return false;
+    }
+    return false;
+}
+
+bool MeshLoader::ReadAttribute(const PrimitiveRange& Range, const char* Name, bool IsNormalized, std::vector<float4>& Values) const
+{
+    for (Uint32 i = 0; i < m_Model.GetNumVertexAttributes(); ++i)
+    {
+        const VertexAttributeDesc& Attrib = m_Model.VertexAttributes[i];
+        if (!m_Model.IsVertexAttributeEnabled(i) || std::strcmp(Attrib.Name, Name) != 0)
+            continue;
+
+        const std::vector<Uint8>& Data   = m_VertexData[Attrib.BufferId];
+        const Uint32              Stride = m_Model.VertexData.Strides[Attrib.BufferId];
+        if (Attrib.Encoding != VERTEX_ATTRIBUTE_ENCODING_NONE ||
+            Attrib.ValueType == VT_FLOAT16 ||
+            Data.size() < (size_t{Range.FirstVertex} + Range.VertexCount) * Stride)
+            return false;
+
+        Values.assign(Range.VertexCount, float4{0, 0, 0, 0});
+        if (Range.VertexCount == 0)
+            return true;
+
+        const Uint32 NumComponents = std::min<Uint32>(Attrib.NumComponents, 4);
+        return VertexDataConverter::Write({
+            &Data[size_t{Range.FirstVertex} * Stride + Attrib.RelativeOffset],
+            Attrib.ValueType,
+            NumComponents,
+            Stride,
+            Values.data(),
+            VT_FLOAT32,
+            NumComponents,
+            sizeof(float4),
+            Range.VertexCount,
+            IsNormalized && Attrib.ValueType != VT_FLOAT32,
+        });
+    }
+    return false;
+}
+
+void MeshLoader::OptimizePrimitives()
+{
+    if (!m_CI.OptimizeVertexCache || m_IndexData.empty())
+        return;
+
+    VERIFY_EXPR(m_Model.IndexData.IndexSize == 2 || m_Model.IndexData.IndexSize == 4);
+
+    // Primitives that share the same vertex range must be renumbered together
+    std::vector<size_t> SortedRanges(m_PrimitiveRanges.size());
+    std::iota(SortedRanges.begin(), SortedRanges.end(), size_t{0});
+    std::stable_sort(SortedRanges.begin(), SortedRanges.end(),
+                     [this](size_t r0, size_t r1) {
+                         return m_PrimitiveRanges[r0].FirstVertex < m_PrimitiveRanges[r1].FirstVertex;
+                     });
+
+    MeshOptimizationStats Stats;
+
+    // Offsets of the primitive indices in GroupIndices
+    constexpr size_t InvalidOffset = ~size_t{0};
+
+    std::vector<Uint32> GroupIndices;
+    std::vector<size_t> GroupOffsets;
+    std::vector<Uint32> Remap;
+    std::vector<Uint8>  VertexRangeData;
+    std::vector<float3> Positions;
+    for (size_t GroupStart = 0; GroupStart < SortedRanges.size();)
+    {
+        const Uint32 FirstVertex = m_PrimitiveRanges[SortedRanges[GroupStart]].FirstVertex;
+        const Uint32 VertexCount = m_PrimitiveRanges[SortedRanges[GroupStart]].VertexCount;
+
+        size_t GroupEnd = GroupStart + 1;
+        while (GroupEnd < SortedRanges.size() && m_PrimitiveRanges[SortedRanges[GroupEnd]].FirstVertex == FirstVertex)
+            ++GroupEnd;
+
+        // Overdraw optimization requires vertex positions. All primitives of the group share them.
+        const bool HasPositions = m_CI.OverdrawThreshold > 0 && ReadPositions(m_PrimitiveRanges[SortedRanges[GroupStart]], Positions);
+
+        // Non-indexed primitives fetch the vertices in their original order, and
+        // morph target deltas reference the original vertex indices
+        bool CanRemapVertices = true;
+
+        GroupIndices.clear();
+        GroupOffsets.clear();
+        for (size_t r = GroupStart; r < GroupEnd; ++r)
+        {
+            const PrimitiveRange& Range = m_PrimitiveRanges[SortedRanges[r]];
+            VERIFY_EXPR(Range.VertexCount == VertexCount);
+
+            if (Range.HasMorphTargets)
+                CanRemapVertices = false;
+
+            if (Range.IndexCount == 0)
+            {
+                GroupOffsets.push_back(InvalidOffset);
+                CanRemapVertices = false;
+                continue;
+            }
+
+            GroupOffsets.push_back(GroupIndices.size());
+
+            GroupIndices.resize(GroupIndices.size() + Range.IndexCount);
+            Uint32* pIndices = &GroupIndices[GroupOffsets.back()];
+            ReadIndices(Range, pIndices);
+
+            if (!std::all_of(pIndices, pIndices + Range.IndexCount, [VertexCount](Uint32 Index) { return Index < VertexCount; }))
+            {
+                LOG_WARNING_MESSAGE("Primitive references vertices outside of its vertex range and will not be optimized.");
+                GroupIndices.resize(GroupOffsets.back());
+                GroupOffsets.back() = InvalidOffset;
+                CanRemapVertices = false;
+                continue;
+            }
+
+            // Only triangle lists can be reordered
+            if (Range.IndexCount % 3 != 0)
+                continue;
+
+            Stats.Before += MeshOptimizer::ComputeVertexCacheStats(pIndices, Range.IndexCount, VertexCount);
+            MeshOptimizer::OptimizeVertexCache(pIndices, Range.IndexCount, VertexCount);
+            if (HasPositions)
+            {
+                MeshOptimizer::OptimizeOverdraw(pIndices, Range.IndexCount, Positions.data(), sizeof(float3),
+                                                VertexCount, m_CI.OverdrawThreshold);
+            }
+            Stats.After += MeshOptimizer::ComputeVertexCacheStats(pIndices, Range.IndexCount, VertexCount);
+        }
+
+        if (CanRemapVertices && !GroupIndices.empty())
+        {
+            Remap.resize(VertexCount);
+            MeshOptimizer::ComputeVertexFetchRemap(GroupIndices.data(), GroupIndices.size(), VertexCount, Remap.data());
+            for (Uint32& Index : GroupIndices)
+                Index = Remap[Index];
+
+            for (size_t i = 0; i < m_VertexData.size(); ++i)
+            {
+                const size_t Stride = m_Model.VertexData.Strides[i];
+                if (Stride == 0 || m_VertexData[i].size() < (size_t{FirstVertex} + VertexCount) * Stride)
+                    continue;
+
+                Uint8* pRangeData = &m_VertexData[i][size_t{FirstVertex} * Stride];
+                VertexRangeData.assign(pRangeData, pRangeData + size_t{VertexCount} * Stride);
+                for (Uint32 v = 0; v < VertexCount; ++v)
+                    std::memcpy(pRangeData + size_t{Remap[v]} * Stride, &VertexRangeData[size_t{v} * Stride], Stride);
+            }
+        }
+
+        for (size_t r = GroupStart; r < GroupEnd; ++r)
+        {
+            const size_t Offset = GroupOffsets[r - GroupStart];
+            if (Offset != InvalidOffset)
+                WriteIndices(m_PrimitiveRanges[SortedRanges[r]], &GroupIndices[Offset]);
+        }
+
+        GroupStart = GroupEnd;
+    }
+
+    if (m_CI.pMeshOptimizationStats != nullptr)
+        *m_CI.pMeshOptimizationStats = Stats;
+}
+
+void MeshLoader::BuildLODs()
+{
+    if (m_CI.LODCount == 0 || m_IndexData.empty())
+        return;
+
+    VERIFY_EXPR(m_Model.IndexData.IndexSize == 2 || m_Model.IndexData.IndexSize == 4);
+
+    std::vector<Uint32> Indices;
+    std::vector<Uint32> LODIndices;
+    std::vector<float3> Positions;
+    for (const PrimitiveRange& Range : m_PrimitiveRanges)
+    {
+        if (Range.IndexCount == 0 || Range.IndexCount % 3 != 0)
+            continue;
+
+        if (!ReadPositions(Range, Positions))
+        {
+            LOG_WARNING_MESSAGE("Positions of mesh '", m_Model.Meshes[Range.MeshId].Name, "' primitive ", Range.PrimitiveId,
+                                " are not stored as float3 or AABB-quantized values: levels of detail will not be generated for it.");
+            continue;
+        }
+
+        Indices.resize(Range.IndexCount);
+        ReadIndices(Range, Indices.data());
+        if (!std::all_of(Indices.begin(), Indices.end(), [&Range](Uint32 Index) { return Index < Range.VertexCount; }))
+        {
+            LOG_WARNING_MESSAGE("Primitive references vertices outside of its vertex range. Levels of detail will not be generated.");
+            continue;
+        }
+
+        Primitive& Prim = m_Model.Meshes[Range.MeshId].Primitives[Range.PrimitiveId];
+
+        const float3 Extent      = Prim.BB.Max - Prim.BB.Min;
+        const float  TargetError = m_CI.LODTargetError * std::max(std::max(Extent.x, Extent.y), Extent.z);
+
+        // Every level is simplified from the full-detail indices, so that its error
+        // is measured against the original surface.
+        size_t TargetIndexCount = Range.IndexCount;
+        size_t PrevIndexCount   = Range.IndexCount;
+        for (Uint32 Level = 0; Level < m_CI.LODCount; ++Level)
+        {
+            TargetIndexCount = static_cast<size_t>(static_cast<float>(TargetIndexCount) * m_CI.LODReductionRatio) / 3 * 3;
+
+            LODIndices.resize(Indices.size());
+
+            float        Error         = 0;
+            const size_t NumLODIndices = MeshOptimizer::SimplifyMesh(Indices.data(), Indices.size(), Positions.data(), sizeof(float3), Range.VertexCount,
+                                                                     TargetIndexCount, TargetError, LODIndices.data(), &Error);
+            // Stop when the level is not noticeably simpler than the previous one
+            if (NumLODIndices == 0 || NumLODIndices * 20 > PrevIndexCount * 19)
+                break;
+            PrevIndexCount = NumLODIndices;
+
+            if (m_CI.OptimizeVertexCache)
+                MeshOptimizer::OptimizeVertexCache(LODIndices.data(), NumLODIndices, Range.VertexCount);
+
+            PrimitiveRange LODRange = Range;
+            LODRange.FirstIndex     = AllocateIndices(Range.IndexSize, NumLODIndices);
+            LODRange.IndexCount     = static_cast<Uint32>(NumLODIndices);
+            WriteIndices(LODRange, LODIndices.data());
+
+            if (!Prim.LODs.empty())
+                Error = std::max(Error, Prim.LODs.back().Error);
+            Prim.LODs.push_back({LODRange.FirstIndex, LODRange.IndexCount, Error});
+        }
+    }
+}
+
+void MeshLoader::BuildMeshlets()
+{
+    if (!m_CI.BuildMeshlets)
+        return;
+
+    VERIFY_EXPR(m_IndexData.empty() || m_Model.IndexData.IndexSize == 2 || m_Model.IndexData.IndexSize == 4);
+
+    MeshletData& Meshlets = m_Model.Meshlets;
+    Meshlets              = {};
+
+    std::vector<Uint32> Indices;
+    std::vector<float3> Positions;
+    for (const PrimitiveRange& Range : m_PrimitiveRanges)
+    {
+        if (!Range.IsTriangleList)
+            continue;
+
+        // Non-indexed triangle lists use sequential indices
+        const Uint32 NumIndices = Range.IndexCount > 0 ? Range.IndexCount : Range.VertexCount;
+        if (NumIndices == 0 || NumIndices % 3 != 0)
+            continue;
+
+        Indices.resize(NumIndices);
+        if (Range.IndexCount > 0)
+        {
+            ReadIndices(Range, Indices.data());
+            if (!std::all_of(Indices.begin(), Indices.end(), [&Range](Uint32 Index) { return Index < Range.VertexCount; }))
+            {
+                LOG_WARNING_MESSAGE("Primitive references vertices outside of its vertex range. Meshlets will not be built.");
+                continue;
+            }
+        }
+        else
+        {
+            std::iota(Indices.begin(), Indices.end(), 0u);
+        }
+
+        // Meshlet bounds require vertex positions
+        const float3* pPositions = ReadPositions(Range, Positions) ? Positions.data() : nullptr;
+
+        // Vertex indices are relative to the vertex range, as the range may be moved to a shared
+        // allocation (see ModelCreateInfo::DeduplicateMeshData).
+        Primitive& Prim   = m_Model.Meshes[Range.MeshId].Primitives[Range.PrimitiveId];
+        Prim.FirstMeshlet = static_cast<Uint32>(Meshlets.Meshlets.size());
+        Prim.MeshletCount = MeshOptimizer::BuildMeshlets(Indices.data(), NumIndices, pPositions, sizeof(float3), Range.VertexCount, 0,
+                                                         m_CI.MeshletMaxVertices, m_CI.MeshletMaxTriangles, Meshlets);
+    }
+}
+
+void MeshLoader::BuildRayCastBVHs()
+{
+    if (!m_CI.BuildRayCastBVHs)
+        return;
+
+    std::vector<float3> MeshPositions;
+    std::vector<Uint32> MeshIndices;
+    std::vector<Uint32> TriangleIds;
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    for (size_t MeshId = 0; MeshId < m_Model.Meshes.size(); ++MeshId)
+    {
+        Mesh& M = m_Model.Meshes[MeshId];
+        MeshPositions.clear();
+        MeshIndices.clear();
+        TriangleIds.clear();
+
+        // Triangle ids are assigned to all primitives, including the ones that are skipped
+        Uint32 FirstTriangle = 0;
+        for (Uint32 PrimId = 0; PrimId < M.Primitives.size(); ++PrimId)
+        {
+            const Primitive& Prim              = M.Primitives[PrimId];
+            const Uint32     NumTriangles      = Prim.GetTriangleCount();
+            const Uint32     PrimFirstTriangle = FirstTriangle;
+            FirstTriangle += NumTriangles;
+            if (NumTriangles == 0)
+                continue;
+
+            const PrimitiveRange Range = GetPrimitiveRange(MeshId, PrimId);
+            if (!ReadPositions(Range, Positions))
+            {
+                LOG_WARNING_MESSAGE("Positions of mesh '", M.Name, "' are stored in a format that is not supported by the ray cast BVH.");
+                continue;
+            }
+
+            Indices.resize(size_t{NumTriangles} * 3);
+            if (Prim.HasIndices())
+            {
+                ReadIndices(Range, Indices.data());
+                if (!std::all_of(Indices.begin(), Indices.end(), [&Range](Uint32 Index) { return Index < Range.VertexCount; }))
+                {
+                    LOG_WARNING_MESSAGE("Primitive references vertices outside of its vertex range. It will not be added to the ray cast BVH.");
+                    continue;
+                }
+            }
+            else
+            {
+                std::iota(Indices.begin(), Indices.end(), 0u);
+            }
+
+            const Uint32 BaseVertex = static_cast<Uint32>(MeshPositions.size());
+            MeshPositions.insert(MeshPositions.end(), Positions.begin(), Positions.end());
+            for (Uint32 Index : Indices)
+                MeshIndices.push_back(BaseVertex + Index);
+            for (Uint32 t = 0; t < NumTriangles; ++t)
+                TriangleIds.push_back(PrimFirstTriangle + t);
+        }
+
+        M.RayCastBVH.Build(MeshPositions.data(), static_cast<Uint32>(MeshPositions.size()),
+                           MeshIndices.data(), static_cast<Uint32>(TriangleIds.size()), TriangleIds.data());
+    }
+}
+
+void MeshLoader::ComputeJointBounds()
+{
+    if (!m_CI.ComputeJointBounds || m_Model.Skins.empty())
+        return;
+
+    for (Skin& S : m_Model.Skins)
+    {
+        S.JointBounds.assign(S.Joints.size(), BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}});
+    }
+
+    // The same mesh may be skinned by different skins, and the same skin may be used by different meshes
+    std::vector<bool>   ProcessedPairs(m_Model.Meshes.size() * m_Model.Skins.size());
+    std::vector<float3> Positions;
+    std::vector<float4> Joints;
+    std::vector<float4> Weights;
+    for (const Node& N : m_Model.Nodes)
+    {
+        if (N.pMesh == nullptr || N.pSkin == nullptr)
+            continue;
+
+        const size_t MeshId = static_cast<size_t>(N.pMesh - m_Model.Meshes.data());
+        const size_t SkinId = static_cast<size_t>(N.pSkin - m_Model.Skins.data());
+        VERIFY_EXPR(MeshId < m_Model.Meshes.size() && SkinId < m_Model.Skins.size());
+        if (ProcessedPairs[MeshId * m_Model.Skins.size() + SkinId])
+            continue;
+        ProcessedPairs[MeshId * m_Model.Skins.size() + SkinId] = true;
+
+        Skin&        S         = m_Model.Skins[SkinId];
+        const Uint32 NumJoints = static_cast<Uint32>(S.Joints.size());
+        const Mesh&  M         = m_Model.Meshes[MeshId];
+        for (Uint32 PrimId = 0; PrimId < M.Primitives.size(); ++PrimId)
+        {
+            const PrimitiveRange Range = GetPrimitiveRange(MeshId, PrimId);
+            if (!ReadPositions(Range, Positions) ||
+                !ReadAttribute(Range, JointsAttributeName, false, Joints) ||
+                !ReadAttribute(Range, WeightsAttributeName, true, Weights))
+            {
+                LOG_WARNING_MESSAGE("Skinning attributes of mesh '", M.Name, "' are stored in a format that is not supported by the joint bounds.");
+                continue;
+            }
+
+            for (Uint32 v = 0; v < Range.VertexCount; ++v)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                {
+                    const Uint32 Joint = static_cast<Uint32>(Joints[v][c]);
+                    if (Weights[v][c] <= 0 || Joint >= NumJoints)
+                        continue;
+
+                    const float3 JointPos = Joint < S.InverseBindMatrices.size() ?
+                        float3{float4{Positions[v], 1} * S.InverseBindMatrices[Joint]} :
+                        Positions[v];
+
+                    BoundBox& BB = S.JointBounds[Joint];
+                    BB.Min       = std::min(BB.Min, JointPos);
+                    BB.Max       = std::max(BB.Max, JointPos);
+                }
+            }
+        }
+    }
+}
+
 template <typename GetDstBufferFn, typename GetDstOffsetFn>
 static void ScheduleBufferUpdate(IGPUUploadManager*            pUploadMgr,
                                  RefCntAutoPtr<BufferInitData> pBuffInitData,
@@ -181,15 +729,21 @@ void MeshLoader::InitIndexBuffer(IRenderDevice* pDevice)
     if (m_IndexData.empty())
         return;
 
+    if (m_CI.KeepCPUIndexData)
+        m_Model.CPUIndexData = m_IndexData;
+
     VERIFY_EXPR(m_Model.IndexData.IndexSize > 0);
     VERIFY_EXPR((m_IndexData.size() % m_Model.IndexData.IndexSize) == 0);
     VERIFY(!m_Model.IndexData.pBuffer && !m_Model.IndexData.pAllocation, "Index buffer has already been initialized");
 
     const Uint32 DataSize = static_cast<Uint32>(m_IndexData.size());
-    if (m_CI.pResourceManager != nullptr)
+    if (m_CI.pResourceManager != nullptr && m_CI.DeduplicateMeshData)
+    {
+        InitSharedIndexData(pDevice);
+    }
+    else if (m_CI.pResourceManager != nullptr)
     {
         m_Model.IndexData.pAllocation = m_CI.pResourceManager->AllocateIndices(DataSize, 4);
-
         if (m_Model.IndexData.pAllocation)
         {
             RefCntAutoPtr<BufferInitData> pBuffInitData = BufferInitData::Create();
@@ -243,6 +797,9 @@ void MeshLoader::InitVertexBuffers(IRenderDevice* pDevice)
     const size_t VBCount = m_Model.GetVertexBufferCount();
     VERIFY_EXPR(m_VertexData.size() == VBCount);
 
+    if (m_CI.KeepCPUVertexData)
+        m_Model.CPUVertexData = m_VertexData;
+
     size_t NumVertices = 0;
     for (Uint32 i = 0; i < VBCount; ++i)
     {
@@ -276,6 +833,12 @@ void MeshLoader::InitVertexBuffers(IRenderDevice* pDevice)
         }
 
         VERIFY(!m_Model.VertexData.pAllocation, "This vertex buffer has already been initialized");
+        if (m_CI.DeduplicateMeshData)
+        {
+            InitSharedVertexData(pDevice, LayoutKey);
+            return;
+        }
+
         m_Model.VertexData.pAllocation = m_CI.pResourceManager->AllocateVertices(LayoutKey, static_cast<Uint32>(NumVertices));
         if (m_Model.VertexData.pAllocation)
         {
@@ -340,6 +903,129 @@ void MeshLoader::InitVertexBuffers(IRenderDevice* pDevice)
     }
 }
 
+void MeshLoader::InitSharedIndexData(IRenderDevice* pDevice)
+{
+    std::vector<Uint8> Indices;
+    for (Mesh& M : m_Model.Meshes)
+    {
+        for (Primitive& Prim : M.Primitives)
+        {
+            if (!Prim.HasIndices())
+                continue;
+
+            // The primitive indices are relative to its vertex range (see LoadMesh) and are
+            // followed by the indices of its levels of detail (see Model::GetFirstIndexLocation).
+            const size_t IndexSize = Prim.IndexType == VT_UINT32 ? 4 : 2;
+            const auto   AddRange  = [&](Uint32 FirstIndex, Uint32 IndexCount) {
+                const size_t Offset = size_t{FirstIndex} * IndexSize;
+                VERIFY_EXPR(Offset + IndexCount * IndexSize <= m_IndexData.size());
+                Indices.insert(Indices.end(), m_IndexData.begin() + Offset, m_IndexData.begin() + Offset + IndexCount * IndexSize);
+            };
+
+            Indices.clear();
+            AddRange(Prim.FirstIndex, Prim.IndexCount);
+            for (const PrimitiveLOD& LOD : Prim.LODs)
+                AddRange(LOD.FirstIndex, LOD.IndexCount);
+
+            XXH128State Hasher;
+            Hasher.Update(IndexSize);
+            Hasher.Update(Indices.size());
+            Hasher.UpdateRaw(Indices.data(), Indices.size());
+            const XXH128Hash ContentHash = Hasher.Digest();
+
+            const Uint32 DataSize = static_cast<Uint32>(Indices.size());
+
+            Primitive::SharedDataInfo& SharedData = Prim.SharedData;
+            SharedData.pIndexAllocation           = m_CI.pResourceManager->FindOrAllocateIndices(
+                DataSize, 4, ContentHash,
+                [&](IBufferSuballocation* pAllocation) {
+                    // The function is called under the registry lock, so other models can only
+                    // find the allocation after its data upload has been set up.
+                    RefCntAutoPtr<BufferInitData> pBuffInitData = BufferInitData::Create();
+                    pBuffInitData->Add(std::move(Indices));
+                    if (m_CI.pUploadMgr)
+                    {
+                        ScheduleIndexBufferUpdate(pDevice, m_CI.pUploadMgr, RefCntAutoPtr<IBufferSuballocation>{pAllocation}, pBuffInitData);
+                    }
+                    pAllocation->SetUserData(pBuffInitData);
+                });
+            if (!SharedData.pIndexAllocation)
+            {
+                UNEXPECTED("Failed to allocate indices from the pool.");
+                continue;
+            }
+            VERIFY_EXPR(SharedData.pIndexAllocation->GetSize() == DataSize);
+
+            SharedData.IndexAllocatorId = m_CI.pResourceManager->GetIndexAllocatorIndex(SharedData.pIndexAllocation->GetAllocator());
+            VERIFY_EXPR(SharedData.IndexAllocatorId != ~0u);
+        }
+    }
+}
+
+void MeshLoader::InitSharedVertexData(IRenderDevice* pDevice, const ResourceManager::VertexLayoutKey& LayoutKey)
+{
+    const size_t VBCount = m_Model.GetVertexBufferCount();
+    for (Mesh& M : m_Model.Meshes)
+    {
+        for (Primitive& Prim : M.Primitives)
+        {
+            if (Prim.VertexCount == 0)
+                continue;
+
+            // Primitives that use the same accessors share the vertex range and thus also the allocation
+            XXH128State Hasher;
+            Hasher.Update(Prim.VertexCount);
+            for (size_t i = 0; i < VBCount; ++i)
+            {
+                const std::vector<Uint8>& Data   = m_VertexData[i];
+                const size_t              Stride = m_Model.VertexData.Strides[i];
+                if (Data.empty())
+                {
+                    Hasher.Update(size_t{0});
+                    continue;
+                }
+                VERIFY_EXPR((size_t{Prim.VertexRangeStart} + Prim.VertexCount) * Stride <= Data.size());
+                Hasher.Update(Prim.VertexCount * Stride);
+                Hasher.UpdateRaw(&Data[Prim.VertexRangeStart * Stride], Prim.VertexCount * Stride);
+            }
+            const XXH128Hash ContentHash = Hasher.Digest();
+
+            Primitive::SharedDataInfo& SharedData = Prim.SharedData;
+            SharedData.pVertexAllocation          = m_CI.pResourceManager->FindOrAllocateVertices(
+                LayoutKey, Prim.VertexCount, ContentHash,
+                [&](IVertexPoolAllocation* pAllocation) {
+                    RefCntAutoPtr<BufferInitData> pBuffInitData = BufferInitData::Create();
+
+                    pBuffInitData->Reserve(VBCount);
+                    for (Uint32 i = 0; i < VBCount; ++i)
+                    {
+                        const std::vector<Uint8>& Data   = m_VertexData[i];
+                        const Uint32              Stride = m_Model.VertexData.Strides[i];
+
+                        std::vector<Uint8> RangeData;
+                        if (!Data.empty())
+                            RangeData.assign(Data.begin() + size_t{Prim.VertexRangeStart} * Stride, Data.begin() + (size_t{Prim.VertexRangeStart} + Prim.VertexCount) * Stride);
+                        pBuffInitData->Add(std::move(RangeData));
+                        if (m_CI.pUploadMgr)
+                        {
+                            ScheduleVertexBufferUpdate(pDevice, m_CI.pUploadMgr, RefCntAutoPtr<IVertexPoolAllocation>{pAllocation}, pBuffInitData, i, Stride);
+                        }
+                    }
+                    pAllocation->SetUserData(pBuffInitData);
+                });
+            if (!SharedData.pVertexAllocation)
+            {
+                UNEXPECTED("Failed to allocate vertices from the pool. Make sure that you proived the required layout when creating the pool.");
+                continue;
+            }
+            VERIFY_EXPR(SharedData.pVertexAllocation->GetVertexCount() == Prim.VertexCount);
+
+            SharedData.VertexPoolId = m_CI.pResourceManager->GetVertexPoolIndex(LayoutKey, SharedData.pVertexAllocation->GetPool());
+            VERIFY_EXPR(SharedData.VertexPoolId != ~0u);
+        }
+    }
+}
+
 } // namespace GLTF
 
 } // namespace Diligent
@@ -0,0 +1,1218 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFCookedModel.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#if PLATFORM_WIN32
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    include "StringTools.hpp"
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+#    include <sys/stat.h>
+#endif
+
+#include "GLTFLoader.hpp"
+#include "MemoryMappedFile.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "DataBlob.h"
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+namespace
+{
+
+struct CookedFileHeader
+{
+    Uint32 Magic   = 0;
+    Uint32 Version = 0;
+
+    Uint64 KeyLowPart  = 0;
+    Uint64 KeyHighPart = 0;
+
+    // Total file size, used to detect truncated files.
+    Uint64 FileSize = 0;
+
+    // The number of CookedBlob records that immediately follow the header.
+    Uint32 NumBlobs = 0;
+    Uint32 Padding  = 0;
+
+    // Source file identity, see CookedModel::SourceInfo.
+    Uint64 SourceSize             = 0;
+    Uint64 SourceModificationTime = 0;
+    Uint64 SourceHashLowPart      = 0;
+    Uint64 SourceHashHighPart     = 0;
+};
+static_assert(sizeof(CookedFileHeader) == 72, "Unexpected cooked file header size");
+
+struct CookedBlob
+{
+    Uint64 Offset = 0;
+    Uint64 Size   = 0;
+};
+
+static constexpr Uint32 CookedFileMagic     = 0x4D434744; // DGCM
+static constexpr Uint64 CookedBlobAlignment = 16;
+
+// Blob 0 holds the model tables, blob 1 holds the index data,
+// the remaining blobs hold the data of each vertex buffer.
+static constexpr Uint32 CookedTablesBlobId      = 0;
+static constexpr Uint32 CookedIndexDataBlobId   = 1;
+static constexpr Uint32 CookedFirstVertexBlobId = 2;
+
+template <typename T>
+void HashValue(XXH128State& Hasher, const T& Val)
+{
+    Hasher.UpdateRaw(&Val, sizeof(Val));
+}
+
+void HashString(XXH128State& Hasher, const char* Str)
+{
+    const Uint64 Len = Str != nullptr ? strlen(Str) : 0;
+    HashValue(Hasher, Len);
+    if (Len > 0)
+        Hasher.UpdateRaw(Str, Len);
+}
+
+// Reads the size and the modification time of the file without opening it.
+bool GetFileStamp(const char* FilePath, Uint64& Size, Uint64& ModificationTime)
+{
+#if PLATFORM_WIN32
+    WIN32_FILE_ATTRIBUTE_DATA FileAttribs{};
+    if (!GetFileAttributesExW(WidenString(FilePath).c_str(), GetFileExInfoStandard, &FileAttribs))
+        return false;
+
+    Size             = (Uint64{FileAttribs.nFileSizeHigh} << 32u) | FileAttribs.nFileSizeLow;
+    ModificationTime = (Uint64{FileAttribs.ftLastWriteTime.dwHighDateTime} << 32u) | FileAttribs.ftLastWriteTime.dwLowDateTime;
+    return true;
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+    struct stat FileStat = {};
+    if (stat(FilePath, &FileStat) != 0)
+        return false;
+
+#    if PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+    const timespec& MTime = FileStat.st_mtimespec;
+#    else
+    const timespec& MTime = FileStat.st_mtim;
+#    endif
+    Size             = static_cast<Uint64>(FileStat.st_size);
+    ModificationTime = static_cast<Uint64>(MTime.tv_sec) * 1000000000ull + static_cast<Uint64>(MTime.tv_nsec);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Hashes the contents of the source file.
+bool HashSourceFile(const ModelCreateInfo& CI, XXH128Hash& Hash, Uint64& Size)
+{
+    XXH128State Hasher;
+    if (CI.ReadWholeFileCallback)
+    {
+        std::vector<unsigned char> Data;
+        std::string                Error;
+        if (!CI.ReadWholeFileCallback(CI.FileName, Data, Error))
+            return false;
+        Size = Data.size();
+        Hasher.UpdateRaw(Data.data(), Data.size());
+    }
+    else if (std::unique_ptr<MemoryMappedFile> pFile = MemoryMappedFile::Open(CI.FileName))
+    {
+        Size = pFile->GetSize();
+        Hasher.UpdateRaw(pFile->GetData(), pFile->GetSize());
+    }
+    else
+    {
+        if (!FileSystem::FileExists(CI.FileName))
+            return false;
+
+        RefCntAutoPtr<IDataBlob> pData;
+        if (!FileWrapper::ReadWholeFile(CI.FileName, &pData))
+            return false;
+        Size = pData->GetSize();
+        Hasher.UpdateRaw(pData->GetConstDataPtr(), pData->GetSize());
+    }
+
+    Hash = Hasher.Digest();
+    return true;
+}
+
+// Checks if the cooked file was produced from the current contents of the source file.
+bool IsSourceUpToDate(const ModelCreateInfo& CI, const CookedFileHeader& Header)
+{
+    // The time stamp is not available when the file is read by the callback
+    if (!CI.ReadWholeFileCallback)
+    {
+        Uint64 Size             = 0;
+        Uint64 ModificationTime = 0;
+        if (GetFileStamp(CI.FileName, Size, ModificationTime))
+        {
+            if (Size != Header.SourceSize)
+                return false;
+            if (ModificationTime != 0 && ModificationTime == Header.SourceModificationTime)
+                return true;
+        }
+    }
+
+    // The size is the same, but the file may have been modified: compare the contents
+    XXH128Hash Hash;
+    Uint64     Size = 0;
+    if (!HashSourceFile(CI, Hash, Size))
+        return false;
+
+    return (Size == Header.SourceSize &&
+            Hash.LowPart == Header.SourceHashLowPart &&
+            Hash.HighPart == Header.SourceHashHighPart);
+}
+
+} // namespace
+
+class CookedModel::TableWriter
+{
+public:
+    void WriteRaw(const void* pData, size_t Size)
+    {
+        if (Size == 0)
+            return;
+        const Uint8* pBytes = static_cast<const Uint8*>(pData);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+    }
+
+    template <typename T>
+    void Write(const T& Val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly");
+        WriteRaw(&Val, sizeof(Val));
+    }
+
+    void WriteCount(size_t Count)
+    {
+        VERIFY_EXPR(Count <= UINT32_MAX);
+        Write(static_cast<Uint32>(Count));
+    }
+
+    void WriteString(const std::string& Str)
+    {
+        WriteCount(Str.size());
+        WriteRaw(Str.data(), Str.size());
+    }
+
+    template <typename T>
+    void WriteArray(const std::vector<T>& Vec)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly");
+        WriteCount(Vec.size());
+        WriteRaw(Vec.data(), Vec.size() * sizeof(T));
+    }
+
+    // Writes the index of the element in the array, or -1 if the pointer is null.
+    template <typename T>
+    void WriteIndex(const std::vector<T>& Vec, const T* pElem)
+    {
+        if (pElem != nullptr)
+        {
+            VERIFY_EXPR(pElem >= Vec.data() && pElem < Vec.data() + Vec.size());
+            Write(static_cast<Int32>(pElem - Vec.data()));
+        }
+        else
+        {
+            Write(Int32{-1});
+        }
+    }
+
+    const std::vector<Uint8>& GetData() const { return m_Data; }
+
+private:
+    std::vector<Uint8> m_Data;
+};
+
+class CookedModel::TableReader
+{
+public:
+    TableReader(const Uint8* pData, size_t Size) :
+        m_pCurr{pData},
+        m_pEnd{pData + Size}
+    {}
+
+    void ReadRaw(void* pData, size_t Size)
+    {
+        if (!m_IsValid || static_cast<size_t>(m_pEnd - m_pCurr) < Size)
+        {
+            m_IsValid = false;
+            return;
+        }
+        if (Size > 0)
+        {
+            memcpy(pData, m_pCurr, Size);
+            m_pCurr += Size;
+        }
+    }
+
+    template <typename T>
+    void Read(T& Val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly");
+        ReadRaw(&Val, sizeof(Val));
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T Val{};
+        Read(Val);
+        return Val;
+    }
+
+    // Reads the number of elements that follow. Every element occupies
+    // at least MinElementSize bytes, which is used to reject corrupted counts
+    // before any memory is allocated.
+    Uint32 ReadCount(size_t MinElementSize = 1)
+    {
+        const Uint32 Count = Read<Uint32>();
+        if (!m_IsValid || Count > static_cast<size_t>(m_pEnd - m_pCurr) / MinElementSize)
+        {
+            m_IsValid = false;
+            return 0;
+        }
+        return Count;
+    }
+
+    std::string ReadString()
+    {
+        std::string Str;
+        Str.resize(ReadCount());
+        ReadRaw(&Str[0], Str.size());
+        return Str;
+    }
+
+    template <typename T>
+    void ReadArray(std::vector<T>& Vec)
+    {
+        Vec.resize(ReadCount(sizeof(T)));
+        ReadRaw(Vec.data(), Vec.size() * sizeof(T));
+    }
+
+    // Reads the element index written by TableWriter::WriteIndex and returns the pointer
+    // to the element, or null if the index is -1.
+    template <typename T>
+    T* ReadPointer(std::vector<T>& Vec)
+    {
+        const Int32 Index = Read<Int32>();
+        if (Index == -1)
+            return nullptr;
+
+        if (Index < 0 || static_cast<size_t>(Index) >= Vec.size())
+        {
+            m_IsValid = false;
+            return nullptr;
+        }
+        return &Vec[Index];
+    }
+
+    bool IsValid() const { return m_IsValid; }
+    bool IsAtEnd() const { return m_pCurr == m_pEnd; }
+
+    void Invalidate() { m_IsValid = false; }
+
+private:
+    const Uint8*       m_pCurr   = nullptr;
+    const Uint8* const m_pEnd    = nullptr;
+    bool               m_IsValid = true;
+};
+
+bool CookedModel::IsCacheable(const ModelCreateInfo& CI)
+{
+    return (CI.FileName != nullptr &&
+            CI.NodeLoadCallback == nullptr &&
+            CI.MeshLoadCallback == nullptr &&
+            CI.PrimitiveLoadCallback == nullptr &&
+            CI.MaterialLoadCallback == nullptr);
+}
+
+bool CookedModel::ComputeKey(const Model& Mdl, const ModelCreateInfo& CI, XXH128Hash& Key)
+{
+    if (CI.FileName == nullptr)
+        return false;
+
+    XXH128State Hasher;
+    HashValue(Hasher, CookedFileMagic);
+    HashValue(Hasher, Version);
+    HashString(Hasher, CI.FileName);
+
+    // Resolved vertex layout
+    HashValue(Hasher, Mdl.GetNumVertexAttributes());
+    for (Uint32 i = 0; i < Mdl.GetNumVertexAttributes(); ++i)
+    {
+        const VertexAttributeDesc& Attrib = Mdl.GetVertexAttribute(i);
+        HashString(Hasher, Attrib.Name);
+        HashValue(Hasher, Attrib.BufferId);
+        HashValue(Hasher, Attrib.ValueType);
+        HashValue(Hasher, Attrib.NumComponents);
+        HashValue(Hasher, Attrib.RelativeOffset);
+        HashValue(Hasher, Attrib.Encoding);
+
+        const Uint32 DefaultValueSize = Attrib.pDefaultValue != nullptr ? GetValueSize(Attrib.ValueType) * Attrib.NumComponents : 0;
+        HashValue(Hasher, DefaultValueSize);
+        if (DefaultValueSize > 0)
+            Hasher.UpdateRaw(Attrib.pDefaultValue, DefaultValueSize);
+    }
+
+    // Texture attributes
+    HashValue(Hasher, Mdl.GetNumTextureAttributes());
+    for (Uint32 i = 0; i < Mdl.GetNumTextureAttributes(); ++i)
+    {
+        const TextureAttributeDesc& Attrib = Mdl.GetTextureAttribute(i);
+        HashString(Hasher, Attrib.Name);
+        HashValue(Hasher, Attrib.Index);
+    }
+
+    HashValue(Hasher, CI.IndexType);
+    HashValue(Hasher, CI.SceneId);
+    HashValue(Hasher, CI.ComputeBoundingBoxes);
+    HashValue(Hasher, CI.CreateStubVertexBuffers);
+    HashValue(Hasher, CI.OptimizeVertexCache);
+    HashValue(Hasher, CI.OptimizeVertexCache ? CI.OverdrawThreshold : 0.f);
+    HashValue(Hasher, CI.BuildMeshlets);
+    HashValue(Hasher, CI.BuildMeshlets ? CI.MeshletMaxVertices : 0u);
+    HashValue(Hasher, CI.BuildMeshlets ? CI.MeshletMaxTriangles : 0u);
+    HashValue(Hasher, CI.LODCount);
+    HashValue(Hasher, CI.LODCount > 0 ? CI.LODReductionRatio : 0.f);
+    HashValue(Hasher, CI.LODCount > 0 ? CI.LODTargetError : 0.f);
+    HashValue(Hasher, CI.NarrowIndices);
+    HashValue(Hasher, CI.DeduplicateMeshData);
+
+    Key = Hasher.Digest();
+    return true;
+}
+
+bool CookedModel::GetSourceInfo(const ModelCreateInfo& CI, SourceInfo& Info)
+{
+    if (CI.FileName == nullptr)
+        return false;
+
+    Info.ModificationTime = 0;
+
+    Uint64 StampSize = 0;
+    if (!CI.ReadWholeFileCallback && !GetFileStamp(CI.FileName, StampSize, Info.ModificationTime))
+        Info.ModificationTime = 0;
+
+    if (!HashSourceFile(CI, Info.ContentHash, Info.Size))
+        return false;
+
+    // The file was modified between the calls: the contents will be compared next time
+    if (StampSize != Info.Size)
+        Info.ModificationTime = 0;
+
+    return true;
+}
+
+void CookedModel::WriteTables(TableWriter&                    Writer,
+                              const Model&                    Mdl,
+                              const std::vector<TextureRef>&  Textures,
+                              const std::vector<SamplerDesc>& Samplers)
+{
+    // Texture references
+    Writer.WriteCount(Samplers.size());
+    for (const SamplerDesc& Desc : Samplers)
+    {
+        Writer.Write(Desc.MinFilter);
+        Writer.Write(Desc.MagFilter);
+        Writer.Write(Desc.MipFilter);
+        Writer.Write(Desc.AddressU);
+        Writer.Write(Desc.AddressV);
+        Writer.Write(Desc.AddressW);
+    }
+
+    Writer.WriteCount(Textures.size());
+    for (const TextureRef& Tex : Textures)
+    {
+        Writer.WriteString(Tex.CacheId);
+        Writer.Write(Int32{Tex.SamplerId});
+    }
+
+    // Element counts. All elements are allocated up front when the tables are read,
+    // so that cross-references between them can be resolved in a single pass.
+    Writer.WriteCount(Mdl.Nodes.size());
+    Writer.WriteCount(Mdl.Meshes.size());
+    Writer.WriteCount(Mdl.Cameras.size());
+    Writer.WriteCount(Mdl.Lights.size());
+    Writer.WriteCount(Mdl.Skins.size());
+    Writer.WriteCount(Mdl.Materials.size());
+    Writer.WriteCount(Mdl.Animations.size());
+    Writer.WriteCount(Mdl.Scenes.size());
+
+    for (const Mesh& M : Mdl.Meshes)
+    {
+        Writer.WriteString(M.Name);
+        Writer.Write(M.BB.Min);
+        Writer.Write(M.BB.Max);
+        Writer.WriteArray(M.MorphWeights);
+        Writer.WriteCount(M.Primitives.size());
+        for (const Primitive& Prim : M.Primitives)
+        {
+            Writer.Write(Prim.FirstIndex);
+            Writer.Write(Prim.IndexCount);
+            Writer.Write(Prim.FirstVertex);
+            Writer.Write(Prim.VertexCount);
+            Writer.Write(Prim.MaterialId);
+            Writer.Write(Prim.BB.Min);
+            Writer.Write(Prim.BB.Max);
+            Writer.Write(Prim.IndexType);
+            Writer.Write(Prim.FirstMeshlet);
+            Writer.Write(Prim.MeshletCount);
+            Writer.WriteArray(Prim.LODs);
+            Writer.Write(Prim.FirstMorphTarget);
+            Writer.Write(Prim.MorphTargetCount);
+            Writer.Write(Prim.VertexRangeStart);
+        }
+    }
+
+    for (const Camera& Cam : Mdl.Cameras)
+    {
+        Writer.WriteString(Cam.Name);
+        Writer.Write(static_cast<Int32>(Cam.Type));
+        if (Cam.Type == Camera::Projection::Orthographic)
+            Writer.Write(Cam.Orthographic);
+        else
+            Writer.Write(Cam.Perspective);
+    }
+
+    for (const Light& L : Mdl.Lights)
+    {
+        Writer.WriteString(L.Name);
+        Writer.Write(static_cast<Int32>(L.Type));
+        Writer.Write(L.Color);
+        Writer.Write(L.Intensity);
+        Writer.Write(L.Range);
+        Writer.Write(L.InnerConeAngle);
+        Writer.Write(L.OuterConeAngle);
+    }
+
+    for (const Skin& S : Mdl.Skins)
+    {
+        Writer.WriteString(S.Name);
+        Writer.WriteIndex(Mdl.Nodes, S.pSkeletonRoot);
+        Writer.WriteArray(S.InverseBindMatrices);
+        Writer.WriteCount(S.Joints.size());
+        for (const Node* pJoint : S.Joints)
+            Writer.WriteIndex(Mdl.Nodes, pJoint);
+    }
+
+    for (const Node& N : Mdl.Nodes)
+    {
+        Writer.WriteString(N.Name);
+        Writer.Write(Int32{N.SkinTransformsIndex});
+        Writer.Write(Int32{N.MorphWeightsOffset});
+        Writer.WriteIndex(Mdl.Nodes, N.Parent);
+        Writer.WriteCount(N.Children.size());
+        for (const Node* pChild : N.Children)
+            Writer.WriteIndex(Mdl.Nodes, pChild);
+        Writer.WriteIndex(Mdl.Meshes, N.pMesh);
+        Writer.WriteIndex(Mdl.Cameras, N.pCamera);
+        Writer.WriteIndex(Mdl.Skins, N.pSkin);
+        Writer.WriteIndex(Mdl.Lights, N.pLight);
+        Writer.Write(N.Translation);
+        Writer.Write(N.Rotation);
+        Writer.Write(N.Scale);
+        Writer.Write(N.Matrix);
+        Writer.WriteArray(N.InstanceMatrices);
+    }
+
+    for (const Scene& S : Mdl.Scenes)
+    {
+        Writer.WriteString(S.Name);
+        Writer.WriteCount(S.RootNodes.size());
+        for (const Node* pNode : S.RootNodes)
+            Writer.WriteIndex(Mdl.Nodes, pNode);
+        Writer.WriteCount(S.LinearNodes.size());
+        for (const Node* pNode : S.LinearNodes)
+            Writer.WriteIndex(Mdl.Nodes, pNode);
+    }
+
+    for (const Material& Mat : Mdl.Materials)
+    {
+        Writer.Write(Mat.Attribs);
+
+        auto WriteOptional = [&Writer](const auto& pAttribs) {
+            Writer.Write(static_cast<Uint8>(pAttribs ? 1 : 0));
+            if (pAttribs)
+                Writer.Write(*pAttribs);
+        };
+        WriteOptional(Mat.Sheen);
+        WriteOptional(Mat.Anisotropy);
+        WriteOptional(Mat.Iridescence);
+        WriteOptional(Mat.Transmission);
+        WriteOptional(Mat.Volume);
+
+        Writer.Write(Mat.ActiveTextureAttribs);
+        Mat.ProcessActiveTextureAttibs(
+            [&](Uint32 Idx, const Material::TextureShaderAttribs& TexAttribs, int TextureId) //
+            {
+                Material::TextureShaderAttribs CookedAttribs = TexAttribs;
+                if (TextureId >= 0 && static_cast<size_t>(TextureId) < Mdl.Textures.size() && Mdl.Textures[TextureId].pAtlasSuballocation)
+                {
+                    // Atlas addressing depends on the allocation made at load time and
+                    // is initialized again when the texture is added to the model.
+                    static constexpr Material::TextureShaderAttribs DefaultAttribs{};
+                    CookedAttribs.AtlasUVScaleAndBias = DefaultAttribs.AtlasUVScaleAndBias;
+                    CookedAttribs.TextureSlice        = DefaultAttribs.TextureSlice;
+                }
+                Writer.Write(Int32{TextureId});
+                Writer.Write(CookedAttribs);
+                return true;
+            });
+
+        Writer.Write(static_cast<Uint8>(Mat.DoubleSided ? 1 : 0));
+        Writer.Write(static_cast<Uint8>(Mat.HasClearcoat ? 1 : 0));
+    }
+
+    for (const Animation& Anim : Mdl.Animations)
+    {
+        Writer.WriteString(Anim.Name);
+        Writer.Write(Anim.Start);
+        Writer.Write(Anim.End);
+
+        Writer.WriteCount(Anim.Samplers.size());
+        for (const AnimationSampler& Sampler : Anim.Samplers)
+        {
+            Writer.Write(static_cast<Int32>(Sampler.Interpolation));
+            Writer.WriteArray(Sampler.Inputs);
+            Writer.WriteArray(Sampler.OutputsVec4);
+            Writer.WriteArray(Sampler.OutputWeights);
+        }
+
+        Writer.WriteCount(Anim.Channels.size());
+        for (const AnimationChannel& Channel : Anim.Channels)
+        {
+            Writer.Write(static_cast<Int32>(Channel.PathType));
+            Writer.WriteIndex<Node>(Mdl.Nodes, Channel.pNode);
+            Writer.Write(Channel.SamplerIndex);
+        }
+    }
+
+    Writer.WriteCount(Mdl.Extensions.size());
+    for (const std::string& Ext : Mdl.Extensions)
+        Writer.WriteString(Ext);
+
+    Writer.Write(Int32{Mdl.SkinTransformsCount});
+    Writer.Write(Int32{Mdl.DefaultSceneId});
+    Writer.Write(Mdl.VertexData.EnabledAttributeFlags);
+
+    Writer.WriteArray(Mdl.Meshlets.Meshlets);
+    Writer.WriteArray(Mdl.Meshlets.VertexIndices);
+    Writer.WriteArray(Mdl.Meshlets.Triangles);
+
+    Writer.WriteArray(Mdl.MorphTargets.Targets);
+    Writer.WriteArray(Mdl.MorphTargets.VertexIds);
+    Writer.WriteArray(Mdl.MorphTargets.Deltas);
+    Writer.WriteArray(Mdl.DefaultMorphWeights);
+}
+
+bool CookedModel::ReadTables(TableReader&              Reader,
+                             Model&                    Mdl,
+                             std::vector<TextureRef>&  Textures,
+                             std::vector<SamplerDesc>& Samplers)
+{
+    Samplers.resize(Reader.ReadCount());
+    for (SamplerDesc& Desc : Samplers)
+    {
+        Reader.Read(Desc.MinFilter);
+        Reader.Read(Desc.MagFilter);
+        Reader.Read(Desc.MipFilter);
+        Reader.Read(Desc.AddressU);
+        Reader.Read(Desc.AddressV);
+        Reader.Read(Desc.AddressW);
+    }
+
+    Textures.resize(Reader.ReadCount());
+    for (TextureRef& Tex : Textures)
+    {
+        Tex.CacheId   = Reader.ReadString();
+        Tex.SamplerId = Reader.Read<Int32>();
+        if (Tex.SamplerId < -1 || Tex.SamplerId >= static_cast<int>(Samplers.size()))
+            Reader.Invalidate();
+    }
+
+    const Uint32 NumNodes      = Reader.ReadCount();
+    const Uint32 NumMeshes     = Reader.ReadCount();
+    const Uint32 NumCameras    = Reader.ReadCount();
+    const Uint32 NumLights     = Reader.ReadCount();
+    const Uint32 NumSkins      = Reader.ReadCount();
+    const Uint32 NumMaterials  = Reader.ReadCount();
+    const Uint32 NumAnimations = Reader.ReadCount();
+    const Uint32 NumScenes     = Reader.ReadCount();
+    if (!Reader.IsValid())
+        return false;
+
+    // Allocate all elements first: pointers to them must remain stable.
+    Mdl.Nodes.reserve(NumNodes);
+    for (Uint32 i = 0; i < NumNodes; ++i)
+        Mdl.Nodes.emplace_back(static_cast<int>(i));
+    Mdl.Meshes.resize(NumMeshes);
+    Mdl.Cameras.resize(NumCameras);
+    Mdl.Lights.resize(NumLights);
+    Mdl.Skins.resize(NumSkins);
+    Mdl.Materials.resize(NumMaterials);
+    Mdl.Animations.resize(NumAnimations);
+    Mdl.Scenes.resize(NumScenes);
+
+    for (Mesh& M : Mdl.Meshes)
+    {
+        M.Name   = Reader.ReadString();
+        M.BB.Min = Reader.Read<float3>();
+        M.BB.Max = Reader.Read<float3>();
+        Reader.ReadArray(M.MorphWeights);
+
+        const Uint32 NumPrimitives = Reader.ReadCount();
+        M.Primitives.reserve(NumPrimitives);
+        for (Uint32 i = 0; i < NumPrimitives && Reader.IsValid(); ++i)
+        {
+            const Uint32     FirstIndex  = Reader.Read<Uint32>();
+            const Uint32     IndexCount  = Reader.Read<Uint32>();
+            const Uint32     FirstVertex = Reader.Read<Uint32>();
+            const Uint32     VertexCount = Reader.Read<Uint32>();
+            const Uint32     MaterialId  = Reader.Read<Uint32>();
+            const float3     BBMin       = Reader.Read<float3>();
+            const float3     BBMax       = Reader.Read<float3>();
+            const VALUE_TYPE IndexType   = Reader.Read<VALUE_TYPE>();
+            if (MaterialId >= NumMaterials || (IndexType != VT_UNDEFINED && IndexType != VT_UINT16 && IndexType != VT_UINT32))
+                Reader.Invalidate();
+            M.Primitives.emplace_back(FirstIndex, IndexCount, FirstVertex, VertexCount, MaterialId, BBMin, BBMax, IndexType);
+
+            Primitive& Prim   = M.Primitives.back();
+            Prim.FirstMeshlet = Reader.Read<Uint32>();
+            Prim.MeshletCount = Reader.Read<Uint32>();
+            Reader.ReadArray(Prim.LODs);
+            Prim.FirstMorphTarget = Reader.Read<Uint32>();
+            Prim.MorphTargetCount = Reader.Read<Uint32>();
+            Prim.VertexRangeStart = Reader.Read<Uint32>();
+        }
+    }
+
+    for (Camera& Cam : Mdl.Cameras)
+    {
+        Cam.Name = Reader.ReadString();
+        Cam.Type = static_cast<Camera::Projection>(Reader.Read<Int32>());
+        if (Cam.Type < Camera::Projection::Unknown || Cam.Type > Camera::Projection::Orthographic)
+            Reader.Invalidate();
+        if (Cam.Type == Camera::Projection::Orthographic)
+            Reader.Read(Cam.Orthographic);
+        else
+            Reader.Read(Cam.Perspective);
+    }
+
+    for (Light& L : Mdl.Lights)
+    {
+        L.Name = Reader.ReadString();
+        L.Type = static_cast<Light::TYPE>(Reader.Read<Int32>());
+        if (L.Type < Light::TYPE::UNKNOWN || L.Type > Light::TYPE::SPOT)
+            Reader.Invalidate();
+        Reader.Read(L.Color);
+        Reader.Read(L.Intensity);
+        Reader.Read(L.Range);
+        Reader.Read(L.InnerConeAngle);
+        Reader.Read(L.OuterConeAngle);
+    }
+
+    for (Skin& S : Mdl.Skins)
+    {
+        S.Name          = Reader.ReadString();
+        S.pSkeletonRoot = Reader.ReadPointer(Mdl.Nodes);
+        Reader.ReadArray(S.InverseBindMatrices);
+        S.Joints.resize(Reader.ReadCount());
+        for (const Node*& pJoint : S.Joints)
+            pJoint = Reader.ReadPointer(Mdl.Nodes);
+    }
+
+    for (Node& N : Mdl.Nodes)
+    {
+        N.Name                = Reader.ReadString();
+        N.SkinTransformsIndex = Reader.Read<Int32>();
+        N.MorphWeightsOffset  = Reader.Read<Int32>();
+        N.Parent              = Reader.ReadPointer(Mdl.Nodes);
+        N.Children.resize(Reader.ReadCount());
+        for (const Node*& pChild : N.Children)
+        {
+            pChild = Reader.ReadPointer(Mdl.Nodes);
+            if (pChild == nullptr)
+                Reader.Invalidate();
+        }
+        N.pMesh   = Reader.ReadPointer(Mdl.Meshes);
+        N.pCamera = Reader.ReadPointer(Mdl.Cameras);
+        N.pSkin   = Reader.ReadPointer(Mdl.Skins);
+        N.pLight  = Reader.ReadPointer(Mdl.Lights);
+        Reader.Read(N.Translation);
+        Reader.Read(N.Rotation);
+        Reader.Read(N.Scale);
+        Reader.Read(N.Matrix);
+        Reader.ReadArray(N.InstanceMatrices);
+    }
+
+    for (Scene& S : Mdl.Scenes)
+    {
+        S.Name = Reader.ReadString();
+        S.RootNodes.resize(Reader.ReadCount());
+        for (Node*& pNode : S.RootNodes)
+        {
+            pNode = Reader.ReadPointer(Mdl.Nodes);
+            if (pNode == nullptr)
+                Reader.Invalidate();
+        }
+        S.LinearNodes.resize(Reader.ReadCount());
+        for (Node*& pNode : S.LinearNodes)
+        {
+            pNode = Reader.ReadPointer(Mdl.Nodes);
+            if (pNode == nullptr)
+                Reader.Invalidate();
+        }
+        // The scene nodes are dereferenced without checks once the model is loaded
+        if (!Reader.IsValid())
+            return false;
+        S.InitHierarchy(Mdl.Nodes.size());
+    }
+
+    for (Material& Mat : Mdl.Materials)
+    {
+        Reader.Read(Mat.Attribs);
+
+        auto ReadOptional = [&Reader](auto& pAttribs) {
+            if (Reader.Read<Uint8>() != 0)
+            {
+                pAttribs = std::make_unique<typename std::decay_t<decltype(pAttribs)>::element_type>();
+                Reader.Read(*pAttribs);
+            }
+        };
+        ReadOptional(Mat.Sheen);
+        ReadOptional(Mat.Anisotropy);
+        ReadOptional(Mat.Iridescence);
+        ReadOptional(Mat.Transmission);
+        ReadOptional(Mat.Volume);
+
+        Mat.ActiveTextureAttribs = Reader.Read<decltype(Mat.ActiveTextureAttribs)>();
+
+        const Uint32 NumActiveTextureAttribs = Mat.GetNumActiveTextureAttribs();
+        if (NumActiveTextureAttribs > 0)
+        {
+            Mat.TextureAttribs = std::make_unique<Material::TextureShaderAttribs[]>(NumActiveTextureAttribs);
+            Mat.TextureIds     = std::make_unique<int[]>(NumActiveTextureAttribs);
+            Mat.ProcessActiveTextureAttibs(
+                [&](Uint32 Idx, Material::TextureShaderAttribs& TexAttribs, int& TextureId) //
+                {
+                    TextureId = Reader.Read<Int32>();
+                    Reader.Read(TexAttribs);
+                    if (TextureId < -1 || TextureId >= static_cast<int>(Textures.size()))
+                        Reader.Invalidate();
+                    return Reader.IsValid();
+                });
+        }
+
+        Mat.DoubleSided  = Reader.Read<Uint8>() != 0;
+        Mat.HasClearcoat = Reader.Read<Uint8>() != 0;
+    }
+
+    for (Animation& Anim : Mdl.Animations)
+    {
+        Anim.Name  = Reader.ReadString();
+        Anim.Start = Reader.Read<float>();
+        Anim.End   = Reader.Read<float>();
+
+        const Uint32 NumSamplers = Reader.ReadCount();
+        Anim.Samplers.reserve(NumSamplers);
+        for (Uint32 i = 0; i < NumSamplers && Reader.IsValid(); ++i)
+        {
+            const auto Interpolation = static_cast<AnimationSampler::INTERPOLATION_TYPE>(Reader.Read<Int32>());
+            if (Interpolation < AnimationSampler::INTERPOLATION_TYPE::LINEAR || Interpolation > AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE)
+                Reader.Invalidate();
+            Anim.Samplers.emplace_back(Interpolation);
+            Reader.ReadArray(Anim.Samplers.back().Inputs);
+            Reader.ReadArray(Anim.Samplers.back().OutputsVec4);
+            Reader.ReadArray(Anim.Samplers.back().OutputWeights);
+        }
+
+        const Uint32 NumChannels = Reader.ReadCount();
+        Anim.Channels.reserve(NumChannels);
+        for (Uint32 i = 0; i < NumChannels && Reader.IsValid(); ++i)
+        {
+            const auto   PathType     = static_cast<AnimationChannel::PATH_TYPE>(Reader.Read<Int32>());
+            Node*        pNode        = Reader.ReadPointer(Mdl.Nodes);
+            const Uint32 SamplerIndex = Reader.Read<Uint32>();
+            if (pNode == nullptr || SamplerIndex >= Anim.Samplers.size() ||
+                PathType < AnimationChannel::PATH_TYPE::TRANSLATION || PathType > AnimationChannel::PATH_TYPE::WEIGHTS)
+            {
+                Reader.Invalidate();
+                break;
+            }
+            Anim.Channels.emplace_back(PathType, pNode, SamplerIndex);
+
+            // Every key has one output, or three for the cubic spline interpolation (in-tangent, value, out-tangent).
+            // Weights channels have one output per morph target of the node mesh.
+            const AnimationSampler& Sampler    = Anim.Samplers[SamplerIndex];
+            const size_t            NumOutputs = Sampler.Inputs.size() * (Sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE ? 3 : 1);
+            if (PathType != AnimationChannel::PATH_TYPE::WEIGHTS)
+            {
+                if (Sampler.GetOutputCount() != NumOutputs)
+                    Reader.Invalidate();
+            }
+            else if (pNode->pMesh != nullptr && !pNode->pMesh->MorphWeights.empty())
+            {
+                if (Sampler.OutputWeights.size() != NumOutputs * pNode->pMesh->MorphWeights.size())
+                    Reader.Invalidate();
+            }
+        }
+    }
+
+    Mdl.Extensions.resize(Reader.ReadCount());
+    for (std::string& Ext : Mdl.Extensions)
+        Ext = Reader.ReadString();
+
+    Mdl.SkinTransformsCount              = Reader.Read<Int32>();
+    Mdl.DefaultSceneId                   = Reader.Read<Int32>();
+    Mdl.VertexData.EnabledAttributeFlags = Reader.Read<Uint32>();
+
+    Reader.ReadArray(Mdl.Meshlets.Meshlets);
+    Reader.ReadArray(Mdl.Meshlets.VertexIndices);
+    Reader.ReadArray(Mdl.Meshlets.Triangles);
+
+    Reader.ReadArray(Mdl.MorphTargets.Targets);
+    Reader.ReadArray(Mdl.MorphTargets.VertexIds);
+    Reader.ReadArray(Mdl.MorphTargets.Deltas);
+    Reader.ReadArray(Mdl.DefaultMorphWeights);
+
+    if (Mdl.DefaultSceneId < 0 || (NumScenes > 0 && Mdl.DefaultSceneId >= static_cast<int>(NumScenes)))
+        Reader.Invalidate();
+    for (const Node& N : Mdl.Nodes)
+    {
+        if (N.SkinTransformsIndex < -1 || N.SkinTransformsIndex >= Mdl.SkinTransformsCount)
+            Reader.Invalidate();
+        if (N.MorphWeightsOffset >= 0 &&
+            (N.pMesh == nullptr || Uint64{static_cast<Uint32>(N.MorphWeightsOffset)} + N.pMesh->MorphWeights.size() > Mdl.DefaultMorphWeights.size()))
+            Reader.Invalidate();
+    }
+    for (const Mesh& M : Mdl.Meshes)
+    {
+        for (const Primitive& Prim : M.Primitives)
+        {
+            if (Uint64{Prim.FirstMeshlet} + Prim.MeshletCount > Mdl.Meshlets.Meshlets.size())
+                Reader.Invalidate();
+            if (Uint64{Prim.FirstMorphTarget} + Prim.MorphTargetCount > Mdl.MorphTargets.Targets.size() ||
+                Prim.MorphTargetCount > M.MorphWeights.size())
+                Reader.Invalidate();
+        }
+    }
+    if (Mdl.MorphTargets.VertexIds.size() != Mdl.MorphTargets.Deltas.size())
+        Reader.Invalidate();
+    for (const MorphTargetData::Target& Target : Mdl.MorphTargets.Targets)
+    {
+        for (Uint32 attrib = 0; attrib < MorphTargetData::ATTRIBUTE_COUNT; ++attrib)
+        {
+            if (Uint64{Target.FirstDelta[attrib]} + Target.DeltaCount[attrib] > Mdl.MorphTargets.Deltas.size())
+                Reader.Invalidate();
+        }
+    }
+    for (const Mesh& M : Mdl.Meshes)
+    {
+        for (const Primitive& Prim : M.Primitives)
+        {
+            // Vertex ids of the morph targets must be within the primitive vertex range
+            for (Uint32 t = 0; t < Prim.MorphTargetCount && Reader.IsValid(); ++t)
+            {
+                const MorphTargetData::Target& Target = Mdl.MorphTargets.Targets[Prim.FirstMorphTarget + t];
+                for (Uint32 attrib = 0; attrib < MorphTargetData::ATTRIBUTE_COUNT; ++attrib)
+                {
+                    for (Uint32 d = 0; d < Target.DeltaCount[attrib]; ++d)
+                    {
+                        if (Mdl.MorphTargets.VertexIds[Target.FirstDelta[attrib] + d] >= Prim.VertexCount)
+                            Reader.Invalidate();
+                    }
+                }
+            }
+        }
+    }
+    for (const Meshlet& Mshlt : Mdl.Meshlets.Meshlets)
+    {
+        if (Uint64{Mshlt.FirstVertex} + Mshlt.VertexCount > Mdl.Meshlets.VertexIndices.size() ||
+            Uint64{Mshlt.FirstTriangle} + Mshlt.TriangleCount > Mdl.Meshlets.Triangles.size())
+        {
+            Reader.Invalidate();
+            break;
+        }
+        for (Uint32 t = 0; t < Mshlt.TriangleCount; ++t)
+        {
+            const Uint32 Tri = Mdl.Meshlets.Triangles[Mshlt.FirstTriangle + t];
+            if (((Tri >> 0u) & 0xFFu) >= Mshlt.VertexCount ||
+                ((Tri >> 8u) & 0xFFu) >= Mshlt.VertexCount ||
+                ((Tri >> 16u) & 0xFFu) >= Mshlt.VertexCount)
+                Reader.Invalidate();
+        }
+    }
+
+    return Reader.IsValid() && Reader.IsAtEnd();
+}
+
+bool CookedModel::Write(const char*                            FilePath,
+                        const XXH128Hash&                      Key,
+                        const SourceInfo&                      Source,
+                        const Model&                           Mdl,
+                        const std::vector<TextureRef>&         Textures,
+                        const std::vector<SamplerDesc>&        Samplers,
+                        const std::vector<Uint8>&              IndexData,
+                        const std::vector<std::vector<Uint8>>& VertexData)
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+    VERIFY_EXPR(VertexData.size() == Mdl.GetVertexBufferCount());
+
+    TableWriter Tables;
+    WriteTables(Tables, Mdl, Textures, Samplers);
+
+    std::vector<std::pair<const void*, size_t>> BlobData;
+    BlobData.reserve(CookedFirstVertexBlobId + VertexData.size());
+    BlobData.emplace_back(Tables.GetData().data(), Tables.GetData().size());
+    BlobData.emplace_back(IndexData.data(), IndexData.size());
+    for (const std::vector<Uint8>& Data : VertexData)
+        BlobData.emplace_back(Data.data(), Data.size());
+
+    CookedFileHeader Header;
+    Header.Magic       = CookedFileMagic;
+    Header.Version     = Version;
+    Header.KeyLowPart  = Key.LowPart;
+    Header.KeyHighPart = Key.HighPart;
+    Header.NumBlobs    = static_cast<Uint32>(BlobData.size());
+
+    Header.SourceSize             = Source.Size;
+    Header.SourceModificationTime = Source.ModificationTime;
+    Header.SourceHashLowPart      = Source.ContentHash.LowPart;
+    Header.SourceHashHighPart     = Source.ContentHash.HighPart;
+
+    std::vector<CookedBlob> Blobs(BlobData.size());
+
+    Uint64 Offset = AlignUp(Uint64{sizeof(Header) + sizeof(CookedBlob) * Blobs.size()}, CookedBlobAlignment);
+    for (size_t i = 0; i < Blobs.size(); ++i)
+    {
+        Blobs[i].Offset = Offset;
+        Blobs[i].Size   = BlobData[i].second;
+        Offset          = AlignUp(Offset + Blobs[i].Size, CookedBlobAlignment);
+    }
+    Header.FileSize = Offset;
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open cooked model file '", FilePath, "' for writing.");
+        return false;
+    }
+
+    static constexpr Uint8 Padding[CookedBlobAlignment] = {};
+
+    bool Success = File->Write(&Header, sizeof(Header)) && File->Write(Blobs.data(), sizeof(CookedBlob) * Blobs.size());
+
+    Uint64 CurrOffset = sizeof(Header) + sizeof(CookedBlob) * Blobs.size();
+    for (size_t i = 0; i < Blobs.size() && Success; ++i)
+    {
+        VERIFY_EXPR(Blobs[i].Offset - CurrOffset < CookedBlobAlignment);
+        if (Blobs[i].Offset > CurrOffset)
+            Success = File->Write(Padding, static_cast<size_t>(Blobs[i].Offset - CurrOffset));
+        if (Success && Blobs[i].Size > 0)
+            Success = File->Write(BlobData[i].first, BlobData[i].second);
+        CurrOffset = Blobs[i].Offset + Blobs[i].Size;
+    }
+    if (Success && Header.FileSize > CurrOffset)
+        Success = File->Write(Padding, static_cast<size_t>(Header.FileSize - CurrOffset));
+
+    if (!Success)
+        LOG_ERROR_MESSAGE("Failed to write cooked model file '", FilePath, "'.");
+
+    return Success;
+}
+
+bool CookedModel::Read(const char*                      FilePath,
+                       const XXH128Hash&                Key,
+                       const ModelCreateInfo&           CI,
+                       Model&                           Mdl,
+                       std::vector<TextureRef>&         Textures,
+                       std::vector<SamplerDesc>&        Samplers,
+                       std::vector<Uint8>&              IndexData,
+                       std::vector<std::vector<Uint8>>& VertexData)
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+
+    std::unique_ptr<MemoryMappedFile> pMappedFile = MemoryMappedFile::Open(FilePath);
+    RefCntAutoPtr<IDataBlob>          pFileBlob;
+
+    const Uint8* pFileData = nullptr;
+    size_t       FileSize  = 0;
+    if (pMappedFile)
+    {
+        pFileData = pMappedFile->GetData();
+        FileSize  = pMappedFile->GetSize();
+    }
+    else
+    {
+        if (!FileSystem::FileExists(FilePath))
+            return false;
+
+        if (!FileWrapper::ReadWholeFile(FilePath, &pFileBlob))
+            return false;
+        pFileData = pFileBlob->GetConstDataPtr<Uint8>();
+        FileSize  = pFileBlob->GetSize();
+    }
+
+    if (FileSize < sizeof(CookedFileHeader))
+        return false;
+
+    CookedFileHeader Header;
+    memcpy(&Header, pFileData, sizeof(Header));
+    if (Header.Magic != CookedFileMagic ||
+        Header.Version != Version ||
+        Header.KeyLowPart != Key.LowPart ||
+        Header.KeyHighPart != Key.HighPart)
+    {
+        // Stale file from another version or another layout
+        return false;
+    }
+
+    if (!IsSourceUpToDate(CI, Header))
+        return false;
+
+    const size_t NumVertexBuffers = Mdl.GetVertexBufferCount();
+    if (Header.FileSize != FileSize ||
+        Header.NumBlobs != CookedFirstVertexBlobId + NumVertexBuffers ||
+        FileSize - sizeof(Header) < sizeof(CookedBlob) * Header.NumBlobs)
+    {
+        LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+        return false;
+    }
+
+    std::vector<CookedBlob> Blobs(Header.NumBlobs);
+    memcpy(Blobs.data(), pFileData + sizeof(Header), sizeof(CookedBlob) * Blobs.size());
+    for (const CookedBlob& Blob : Blobs)
+    {
+        if (Blob.Offset > FileSize || Blob.Size > FileSize - Blob.Offset)
+        {
+            LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+            return false;
+        }
+    }
+
+    Model       Cooked;
+    TableReader Reader{pFileData + Blobs[CookedTablesBlobId].Offset, static_cast<size_t>(Blobs[CookedTablesBlobId].Size)};
+    if (!ReadTables(Reader, Cooked, Textures, Samplers))
+    {
+        LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+        return false;
+    }
+
+    // Index and vertex data are stored in their final format and are copied as is.
+    const CookedBlob& IndexBlob = Blobs[CookedIndexDataBlobId];
+    if (IndexBlob.Size % Mdl.IndexData.IndexSize != 0)
+    {
+        LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+        return false;
+    }
+    IndexData.assign(pFileData + IndexBlob.Offset, pFileData + IndexBlob.Offset + IndexBlob.Size);
+
+    Uint64 NumVertices = 0;
+    VertexData.resize(NumVertexBuffers);
+    for (size_t i = 0; i < NumVertexBuffers; ++i)
+    {
+        const CookedBlob& VertexBlob = Blobs[CookedFirstVertexBlobId + i];
+        const Uint32      Stride     = Mdl.VertexData.Strides[i];
+        if (VertexBlob.Size > 0)
+        {
+            if (Stride == 0 || VertexBlob.Size % Stride != 0 || (NumVertices != 0 && VertexBlob.Size / Stride != NumVertices))
+            {
+                LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+                return false;
+            }
+            NumVertices = VertexBlob.Size / Stride;
+        }
+        VertexData[i].assign(pFileData + VertexBlob.Offset, pFileData + VertexBlob.Offset + VertexBlob.Size);
+    }
+
+    for (const Mesh& M : Cooked.Meshes)
+    {
+        for (const Primitive& Prim : M.Primitives)
+        {
+            // Narrowed primitives are stored as 16-bit indices in the same blob
+            const Uint64 NumIndices = IndexBlob.Size / (Prim.IndexType == VT_UINT16 ? 2 : Mdl.IndexData.IndexSize);
+            if (Uint64{Prim.FirstIndex} + Prim.IndexCount > NumIndices ||
+                Uint64{Prim.FirstVertex} + Prim.VertexCount > NumVertices ||
+                Uint64{Prim.VertexRangeStart} + Prim.VertexCount > NumVertices)
+            {
+                LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+                return false;
+            }
+            for (const PrimitiveLOD& LOD : Prim.LODs)
+            {
+                if (Uint64{LOD.FirstIndex} + LOD.IndexCount > NumIndices)
+                {
+                    LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+                    return false;
+                }
+            }
+        }
+    }
+    for (Uint32 Index : Cooked.Meshlets.VertexIndices)
+    {
+        if (Index >= NumVertices)
+        {
+            LOG_WARNING_MESSAGE("Cooked model file '", FilePath, "' is corrupted.");
+            return false;
+        }
+    }
+
+    Mdl.Scenes                           = std::move(Cooked.Scenes);
+    Mdl.Nodes                            = std::move(Cooked.Nodes);
+    Mdl.Meshes                           = std::move(Cooked.Meshes);
+    Mdl.Cameras                          = std::move(Cooked.Cameras);
+    Mdl.Lights                           = std::move(Cooked.Lights);
+    Mdl.Skins                            = std::move(Cooked.Skins);
+    Mdl.Materials                        = std::move(Cooked.Materials);
+    Mdl.Animations                       = std::move(Cooked.Animations);
+    Mdl.Extensions                       = std::move(Cooked.Extensions);
+    Mdl.Meshlets                         = std::move(Cooked.Meshlets);
+    Mdl.MorphTargets                     = std::move(Cooked.MorphTargets);
+    Mdl.DefaultMorphWeights              = std::move(Cooked.DefaultMorphWeights);
+    Mdl.SkinTransformsCount              = Cooked.SkinTransformsCount;
+    Mdl.DefaultSceneId                   = Cooked.DefaultSceneId;
+    Mdl.VertexData.EnabledAttributeFlags = Cooked.VertexData.EnabledAttributeFlags;
+
+    return true;
+}
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -26,6 +26,7 @@
 
 #include "GLTFDocument.hpp"
 
+#include <atomic>
 #include <cstring>
 #include <limits>
 #include <mutex>
@@ -37,9 +38,11 @@
 #include "GLTFResourceManager.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Image.h"
+#include "MemoryMappedFile.hpp"
 #include "StringTools.hpp"
 #include "Texture.h"
 #include "TextureUtilities.h"
+#include "ThreadPoolHelpers.hpp"
 
 #define TINYGLTF_IMPLEMENTATION
 #define TINYGLTF_NO_STB_IMAGE
@@ -167,13 +170,13 @@ bool Document::GetTextureSourceInfo(Uint32 TextureIndex, TextureSourceInfo& Sour
             return false;
 
         const tinygltf::Buffer& Buffer = gltf_model.buffers[static_cast<size_t>(BufferView.buffer)];
-        if (BufferView.byteOffset > Buffer.data.size() ||
-            BufferView.byteLength > Buffer.data.size() - BufferView.byteOffset)
+        if (BufferView.byteOffset > Buffer.GetSize() ||
+            BufferView.byteLength > Buffer.GetSize() - BufferView.byteOffset)
         {
             return false;
         }
 
-        Source.pData    = Buffer.data.data() + BufferView.byteOffset;
+        Source.pData    = Buffer.GetData() + BufferView.byteOffset;
         Source.DataSize = static_cast<Uint64>(BufferView.byteLength);
         return true;
     }
@@ -200,12 +203,26 @@ namespace Callbacks
 namespace
 {
 
+// Image whose decoding is deferred until the document is parsed.
+struct DeferredImage
+{
+    int ImageIndex = -1;
+    int ReqWidth   = 0;
+    int ReqHeight  = 0;
+
+    // TinyGLTF passes image data through temporary storage, so keep a copy.
+    std::vector<unsigned char> Data;
+};
+
 struct LoaderData
 {
     TextureCacheType* const pTextureCache;
     ResourceManager* const  pResourceMgr;
+    IThreadPool* const      pThreadPool;
 
-    std::vector<RefCntAutoPtr<IObject>> TexturesHold = {};
+    std::vector<RefCntAutoPtr<IObject>>            TexturesHold   = {};
+    std::vector<DeferredImage>                     DeferredImages = {};
+    std::vector<std::unique_ptr<MemoryMappedFile>> MappedFiles    = {};
 
     std::string BaseDir      = {};
     bool        DecodeImages = true;
@@ -248,104 +265,14 @@ bool IsImageFilePath(const std::string& FilePath)
     return false;
 }
 
-bool LoadImageData(tinygltf::Image*     gltf_image,
-                   const int            gltf_image_idx,
-                   std::string*         error,
-                   std::string*         warning,
-                   int                  req_width,
-                   int                  req_height,
-                   const unsigned char* image_data,
-                   int                  size,
-                   void*                user_data)
+bool DecodeImage(tinygltf::Image*     gltf_image,
+                 const int            gltf_image_idx,
+                 std::string*         error,
+                 int                  req_width,
+                 int                  req_height,
+                 const unsigned char* image_data,
+                 int                  size)
 {
-    (void)warning;
-
-    LoaderData* pLoaderData = static_cast<LoaderData*>(user_data);
-    if (pLoaderData != nullptr)
-    {
-        const auto CacheId = GetImagePath(pLoaderData->BaseDir, gltf_image->uri);
-
-        if (pLoaderData->pResourceMgr != nullptr)
-        {
-            if (RefCntAutoPtr<ITextureAtlasSuballocation> pAllocation = pLoaderData->pResourceMgr->FindTextureAllocation(CacheId.c_str()))
-            {
-                const TextureDesc           TexDesc    = pAllocation->GetAtlas()->GetAtlasDesc();
-                const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
-                const uint2                 Size       = pAllocation->GetSize();
-
-                gltf_image->width      = Size.x;
-                gltf_image->height     = Size.y;
-                gltf_image->component  = FmtAttribs.NumComponents;
-                gltf_image->bits       = FmtAttribs.ComponentSize * 8;
-                gltf_image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
-
-                // Keep strong reference to ensure the allocation is alive (second time, but that's fine).
-                pLoaderData->TexturesHold.emplace_back(std::move(pAllocation));
-
-                return true;
-            }
-        }
-        else if (pLoaderData->pTextureCache != nullptr)
-        {
-            TextureCacheType& TexCache = *pLoaderData->pTextureCache;
-
-            RefCntAutoPtr<ITexture> pTexture;
-            bool                    TextureExpired = false;
-
-            // Try with shared lock first
-            {
-                std::shared_lock<Threading::SharedMutex> SharedLock{TexCache.TexturesMtx};
-
-                auto it = TexCache.Textures.find(CacheId);
-                if (it != TexCache.Textures.end())
-                {
-                    pTexture = it->second.Lock();
-                    if (!pTexture)
-                    {
-                        // Texture is stale
-                        TextureExpired = true;
-                    }
-                }
-            }
-
-            if (TextureExpired)
-            {
-                // Upgrade to exclusive lock to remove stale texture
-                std::unique_lock<Threading::SharedMutex> UniqueLock{TexCache.TexturesMtx};
-
-                auto it = TexCache.Textures.find(CacheId);
-                if (it != TexCache.Textures.end())
-                {
-                    pTexture = it->second.Lock();
-                    if (!pTexture)
-                    {
-                        // Remove stale texture from the cache
-                        TexCache.Textures.erase(it);
-                    }
-                }
-            }
-
-            if (pTexture)
-            {
-                const TextureDesc&          TexDesc    = pTexture->GetDesc();
-                const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
-
-                gltf_image->width      = TexDesc.Width;
-                gltf_image->height     = TexDesc.Height;
-                gltf_image->component  = FmtAttribs.NumComponents;
-                gltf_image->bits       = FmtAttribs.ComponentSize * 8;
-                gltf_image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
-
-                // Keep strong reference to ensure the texture is alive (second time, but that's fine).
-                pLoaderData->TexturesHold.emplace_back(std::move(pTexture));
-
-                return true;
-            }
-        }
-    }
-
-    VERIFY(size != 1, "The texture was previously cached, but was not found in the cache now");
-
     ImageLoadInfo LoadInfo;
     LoadInfo.Format = Image::GetFileFormat(image_data, size);
     if (LoadInfo.Format == IMAGE_FILE_FORMAT_UNKNOWN)
@@ -457,6 +384,157 @@ bool LoadImageData(tinygltf::Image*     gltf_image,
     return true;
 }
 
+bool LoadImageData(tinygltf::Image*     gltf_image,
+                   const int            gltf_image_idx,
+                   std::string*         error,
+                   std::string*         warning,
+                   int                  req_width,
+                   int                  req_height,
+                   const unsigned char* image_data,
+                   int                  size,
+                   void*                user_data)
+{
+    (void)warning;
+
+    LoaderData* pLoaderData = static_cast<LoaderData*>(user_data);
+    if (pLoaderData != nullptr)
+    {
+        const auto CacheId = GetImagePath(pLoaderData->BaseDir, gltf_image->uri);
+
+        if (pLoaderData->pResourceMgr != nullptr)
+        {
+            if (RefCntAutoPtr<ITextureAtlasSuballocation> pAllocation = pLoaderData->pResourceMgr->FindTextureAllocation(CacheId.c_str()))
+            {
+                const TextureDesc           TexDesc    = pAllocation->GetAtlas()->GetAtlasDesc();
+                const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+                const uint2                 Size       = pAllocation->GetSize();
+
+                gltf_image->width      = Size.x;
+                gltf_image->height     = Size.y;
+                gltf_image->component  = FmtAttribs.NumComponents;
+                gltf_image->bits       = FmtAttribs.ComponentSize * 8;
+                gltf_image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+
+                // Keep strong reference to ensure the allocation is alive (second time, but that's fine).
+                pLoaderData->TexturesHold.emplace_back(std::move(pAllocation));
+
+                return true;
+            }
+        }
+        else if (pLoaderData->pTextureCache != nullptr)
+        {
+            TextureCacheType& TexCache = *pLoaderData->pTextureCache;
+
+            RefCntAutoPtr<ITexture> pTexture;
+            bool                    TextureExpired = false;
+
+            // Try with shared lock first
+            {
+                std::shared_lock<Threading::SharedMutex> SharedLock{TexCache.TexturesMtx};
+
+                auto it = TexCache.Textures.find(CacheId);
+                if (it != TexCache.Textures.end())
+                {
+                    pTexture = it->second.Lock();
+                    if (!pTexture)
+                    {
+                        // Texture is stale
+                        TextureExpired = true;
+                    }
+                }
+            }
+
+            if (TextureExpired)
+            {
+                // Upgrade to exclusive lock to remove stale texture
+                std::unique_lock<Threading::SharedMutex> UniqueLock{TexCache.TexturesMtx};
+
+                auto it = TexCache.Textures.find(CacheId);
+                if (it != TexCache.Textures.end())
+                {
+                    pTexture = it->second.Lock();
+                    if (!pTexture)
+                    {
+                        // Remove stale texture from the cache
+                        TexCache.Textures.erase(it);
+                    }
+                }
+            }
+
+            if (pTexture)
+            {
+                const TextureDesc&          TexDesc    = pTexture->GetDesc();
+                const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+
+                gltf_image->width      = TexDesc.Width;
+                gltf_image->height     = TexDesc.Height;
+                gltf_image->component  = FmtAttribs.NumComponents;
+                gltf_image->bits       = FmtAttribs.ComponentSize * 8;
+                gltf_image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+
+                // Keep strong reference to ensure the texture is alive (second time, but that's fine).
+                pLoaderData->TexturesHold.emplace_back(std::move(pTexture));
+
+                return true;
+            }
+        }
+    }
+
+    VERIFY(size != 1, "The texture was previously cached, but was not found in the cache now");
+
+    if (pLoaderData != nullptr && pLoaderData->pThreadPool != nullptr)
+    {
+        // Decode the image after the document is parsed, see DecodeDeferredImages().
+        DeferredImage& Deferred = pLoaderData->DeferredImages.emplace_back();
+        Deferred.ImageIndex     = gltf_image_idx;
+        Deferred.ReqWidth       = req_width;
+        Deferred.ReqHeight      = req_height;
+        Deferred.Data.assign(image_data, image_data + size);
+        return true;
+    }
+
+    return DecodeImage(gltf_image, gltf_image_idx, error, req_width, req_height, image_data, size);
+}
+
+// Decodes the images deferred by LoadImageData() using the thread pool.
+bool DecodeDeferredImages(tinygltf::Model& gltf_model, LoaderData& Data, std::string& error)
+{
+    if (Data.DeferredImages.empty())
+        return true;
+
+    VERIFY_EXPR(Data.pThreadPool != nullptr);
+
+    std::vector<std::string> Errors(Data.DeferredImages.size());
+    std::atomic<bool>        Result{true};
+    // Every image is written by one task only, so no synchronization is needed.
+    ProcessChunksAsync(Data.pThreadPool, Data.DeferredImages.size(), 1,
+                       [&gltf_model, &Data, &Errors, &Result](size_t Start, size_t End) {
+                           for (size_t i = Start; i < End; ++i)
+                           {
+                               const DeferredImage& Deferred = Data.DeferredImages[i];
+                               if (Deferred.ImageIndex < 0 || static_cast<size_t>(Deferred.ImageIndex) >= gltf_model.images.size())
+                               {
+                                   UNEXPECTED("Deferred image index is out of range");
+                                   continue;
+                               }
+
+                               tinygltf::Image& gltf_image = gltf_model.images[Deferred.ImageIndex];
+                               if (!DecodeImage(&gltf_image, Deferred.ImageIndex, &Errors[i], Deferred.ReqWidth, Deferred.ReqHeight,
+                                                Deferred.Data.data(), static_cast<int>(Deferred.Data.size())))
+                               {
+                                   Result.store(false);
+                               }
+                           }
+                       });
+
+    for (const std::string& Error : Errors)
+        error += Error;
+
+    Data.DeferredImages.clear();
+
+    return Result.load();
+}
+
 bool LoadImageDataNoDecode(tinygltf::Image*     gltf_image,
                            const int            gltf_image_idx,
                            std::string*         error,
@@ -615,6 +693,33 @@ bool ReadWholeFile(std::vector<unsigned char>* out,
     return true;
 }
 
+bool MapWholeFile(const unsigned char** out_data,
+                  size_t*               out_size,
+                  std::string*          err,
+                  const std::string&    filepath,
+                  void*                 user_data)
+{
+    VERIFY_EXPR(out_data != nullptr && out_size != nullptr);
+    (void)err;
+
+    LoaderData* pLoaderData = static_cast<LoaderData*>(user_data);
+    if (pLoaderData == nullptr)
+        return false;
+
+    std::unique_ptr<MemoryMappedFile> pFile = MemoryMappedFile::Open(filepath.c_str());
+    if (!pFile)
+    {
+        // TinyGLTF will fall back to ReadWholeFile
+        return false;
+    }
+
+    *out_data = pFile->GetData();
+    *out_size = pFile->GetSize();
+    pLoaderData->MappedFiles.emplace_back(std::move(pFile));
+
+    return true;
+}
+
 } // namespace
 
 } // namespace Callbacks
@@ -633,7 +738,7 @@ Document::Document(const DocumentLoadInfo& LoadInfo) :
     if (LoadInfo.pTextureCache != nullptr && LoadInfo.pResourceManager != nullptr)
         LOG_WARNING_MESSAGE("Texture cache is ignored when resource manager is used");
 
-    Callbacks::LoaderData LoaderData{LoadInfo.pTextureCache, LoadInfo.pResourceManager};
+    Callbacks::LoaderData LoaderData{LoadInfo.pTextureCache, LoadInfo.pResourceManager, LoadInfo.DecodeImages ? LoadInfo.pThreadPool : nullptr};
     LoaderData.BaseDir       = m_BaseDir;
     LoaderData.DecodeImages  = LoadInfo.DecodeImages;
     LoaderData.FileExists    = LoadInfo.FileExistsCallback;
@@ -647,6 +752,12 @@ Document::Document(const DocumentLoadInfo& LoadInfo) :
     fsCallbacks.ReadWholeFile         = Callbacks::ReadWholeFile;
     fsCallbacks.WriteWholeFile        = tinygltf::WriteWholeFile;
     fsCallbacks.user_data             = &LoaderData;
+
+    // Memory mapping bypasses the user-provided file reading callback, so it is only used without it.
+    const bool UseMemoryMapping = LoadInfo.UseMemoryMapping && !LoadInfo.ReadWholeFileCallback;
+    if (UseMemoryMapping)
+        fsCallbacks.MapWholeFile = Callbacks::MapWholeFile;
+
     gltf_context.SetFsCallbacks(fsCallbacks);
 
     bool   binary = false;
@@ -661,9 +772,36 @@ Document::Document(const DocumentLoadInfo& LoadInfo) :
 
     bool fileLoaded = false;
     if (binary)
-        fileLoaded = gltf_context.LoadBinaryFromFile(m_pModel.get(), &error, &warning, m_FileName.c_str());
+    {
+        std::unique_ptr<MemoryMappedFile> pGlbFile;
+        if (UseMemoryMapping)
+        {
+            pGlbFile = MemoryMappedFile::Open(m_FileName.c_str());
+            if (pGlbFile && pGlbFile->GetSize() > (std::numeric_limits<unsigned int>::max)())
+            {
+                LOG_WARNING_MESSAGE("GLB file ", m_FileName, " is too large to be memory-mapped; falling back to reading the file");
+                pGlbFile.reset();
+            }
+        }
+
+        if (pGlbFile)
+        {
+            // The BIN chunk is referenced in place and must stay mapped for the lifetime of the document
+            gltf_context.SetReferenceBinaryChunk(true);
+            fileLoaded = gltf_context.LoadBinaryFromMemory(m_pModel.get(), &error, &warning,
+                                                           pGlbFile->GetData(), static_cast<unsigned int>(pGlbFile->GetSize()),
+                                                           tinygltf::GetBaseDir(m_FileName));
+            LoaderData.MappedFiles.emplace_back(std::move(pGlbFile));
+        }
+        else
+        {
+            fileLoaded = gltf_context.LoadBinaryFromFile(m_pModel.get(), &error, &warning, m_FileName.c_str());
+        }
+    }
     else
         fileLoaded = gltf_context.LoadASCIIFromFile(m_pModel.get(), &error, &warning, m_FileName.c_str());
+    if (fileLoaded)
+        fileLoaded = Callbacks::DecodeDeferredImages(*m_pModel, LoaderData, error);
     if (!fileLoaded)
     {
         LOG_ERROR_AND_THROW("Failed to load gltf file ", m_FileName, ": ", error);
@@ -674,6 +812,7 @@ Document::Document(const DocumentLoadInfo& LoadInfo) :
     }
 
     m_TexturesHold = std::move(LoaderData.TexturesHold);
+    m_MappedFiles  = std::move(LoaderData.MappedFiles);
 }
 
 Document::~Document() = default;
@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFDrawList.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+namespace
+{
+
+// Sort key layout, from the most significant bit:
+//   alpha mode (2) | [blend depth (32)] | state (24) | [material (24)]
+// Blended records only use the depth and the state if the transforms are provided.
+// where the state is double-sided (1) | instanced (1) | index type (2) | vertex pool (10) | index allocator (10).
+// Values that do not fit into their fields are clamped, which only affects the order of the
+// records, but not the batches, as the batches compare the actual values.
+constexpr Uint32 StateBits          = 24;
+constexpr Uint32 VertexPoolBits     = 10;
+constexpr Uint32 IndexAllocBits     = 10;
+constexpr Uint32 MaterialBits       = 24;
+constexpr Uint32 AlphaModeShift     = 62;
+constexpr Uint32 StateShift         = AlphaModeShift - StateBits;
+constexpr Uint32 MaterialShift      = StateShift - MaterialBits;
+constexpr Uint32 BlendDepthShift    = AlphaModeShift - 32;
+constexpr Uint32 BlendStateShift    = BlendDepthShift - StateBits;
+constexpr Uint32 MaxVertexPoolIndex = (1u << VertexPoolBits) - 1u;
+constexpr Uint32 MaxIndexAllocIndex = (1u << IndexAllocBits) - 1u;
+constexpr Uint32 MaxMaterialId      = (1u << MaterialBits) - 1u;
+
+Uint64 GetStateBits(const DrawRecord& Record)
+{
+    const Uint64 IndexTypeBits = Record.IndexType == VT_UINT16 ? 0 : (Record.IndexType == VT_UINT32 ? 1 : 2);
+
+    Uint64 State = Record.DoubleSided ? 1 : 0;
+    State        = (State << 1) | (Record.IsInstanced() ? 1 : 0);
+    State        = (State << 2) | IndexTypeBits;
+    State        = (State << VertexPoolBits) | std::min(Record.VertexPoolIndex, MaxVertexPoolIndex);
+    State        = (State << IndexAllocBits) | std::min(Record.IndexAllocatorIndex, MaxIndexAllocIndex);
+    return State;
+}
+
+bool IsSameBatch(const DrawRecord& Record, const DrawBatch& Batch, bool SplitByMaterial)
+{
+    return (Record.AlphaMode == Batch.AlphaMode &&
+            Record.DoubleSided == Batch.DoubleSided &&
+            Record.IsInstanced() == Batch.Instanced &&
+            Record.IndexType == Batch.IndexType &&
+            Record.VertexPoolIndex == Batch.VertexPoolIndex &&
+            Record.IndexAllocatorIndex == Batch.IndexAllocatorIndex &&
+            (!SplitByMaterial || Record.MaterialId == Batch.MaterialId));
+}
+
+// Instances of a node with EXT_mesh_gpu_instancing instances in ModelTransforms::InstanceMatrices.
+struct NodeInstanceRange
+{
+    Int32  GroupIndex    = -1;
+    Uint32 FirstInstance = 0;
+    Uint32 NumInstances  = 1;
+};
+
+// Finds the instances of the node in the instance groups of the scene. The nodes with
+// EXT_mesh_gpu_instancing instances are always grouped, unless they are skinned or morphed.
+bool FindNodeInstances(const Model& Mdl, const Scene& scene, Uint32 NodeIndex, NodeInstanceRange& Range)
+{
+    for (size_t GroupIdx = 0; GroupIdx < scene.InstanceGroups.size(); ++GroupIdx)
+    {
+        const InstanceGroup& Group = scene.InstanceGroups[GroupIdx];
+
+        Uint32 FirstInstance = Group.FirstInstance;
+        for (Uint32 NodeId : Group.NodeIds)
+        {
+            const Uint32 NumInstances = std::max(static_cast<Uint32>(Mdl.Nodes[NodeId].InstanceMatrices.size()), 1u);
+            if (NodeId == NodeIndex)
+            {
+                Range = {static_cast<Int32>(GroupIdx), FirstInstance, NumInstances};
+                return true;
+            }
+            FirstInstance += NumInstances;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void DrawList::Clear()
+{
+    m_Records.clear();
+    m_Batches.clear();
+    m_IndexedArgs.clear();
+    m_Args.clear();
+}
+
+void DrawList::Build(const Model& Mdl, Uint32 SceneIndex, const DrawListBuildInfo& BuildInfo)
+{
+    Clear();
+    if (SceneIndex >= Mdl.Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+
+    const Scene& scene = Mdl.Scenes[SceneIndex];
+
+    // The nodes of the instance groups are drawn by the instanced records
+    std::vector<bool> IsInstancedNode;
+    if (BuildInfo.UseInstanceGroups)
+    {
+        IsInstancedNode.resize(Mdl.Nodes.size());
+        for (size_t GroupIdx = 0; GroupIdx < scene.InstanceGroups.size(); ++GroupIdx)
+        {
+            const InstanceGroup& Group = scene.InstanceGroups[GroupIdx];
+            VERIFY_EXPR(Group.pMesh != nullptr && !Group.NodeIds.empty());
+            for (Uint32 NodeId : Group.NodeIds)
+                IsInstancedNode[NodeId] = true;
+
+            for (size_t PrimIdx = 0; PrimIdx < Group.pMesh->Primitives.size(); ++PrimIdx)
+                AddPrimitive(Mdl, Group.NodeIds[0], static_cast<Uint32>(PrimIdx), BuildInfo, static_cast<Int32>(GroupIdx), Group.FirstInstance, Group.InstanceCount);
+        }
+    }
+
+    for (const Node* pNode : scene.LinearNodes)
+    {
+        if (pNode == nullptr || pNode->pMesh == nullptr || (!IsInstancedNode.empty() && IsInstancedNode[pNode->Index]))
+            continue;
+
+        const Uint32      NodeIndex = static_cast<Uint32>(pNode->Index);
+        NodeInstanceRange Instances;
+        if (!pNode->InstanceMatrices.empty())
+            FindNodeInstances(Mdl, scene, NodeIndex, Instances);
+
+        for (size_t PrimIdx = 0; PrimIdx < pNode->pMesh->Primitives.size(); ++PrimIdx)
+            AddPrimitive(Mdl, NodeIndex, static_cast<Uint32>(PrimIdx), BuildInfo, Instances.GroupIndex, Instances.FirstInstance, Instances.NumInstances);
+    }
+
+    Finalize(BuildInfo);
+}
+
+void DrawList::Build(const Model& Mdl, const ScenePrimitiveRef* pPrims, size_t NumPrims, const DrawListBuildInfo& BuildInfo)
+{
+    DEV_CHECK_ERR(pPrims != nullptr || NumPrims == 0, "pPrims must not be null");
+
+    Clear();
+    m_Records.reserve(NumPrims);
+    for (size_t i = 0; i < NumPrims; ++i)
+    {
+        const ScenePrimitiveRef& Ref = pPrims[i];
+        if (Ref.NodeIndex >= Mdl.Nodes.size())
+        {
+            DEV_ERROR("Invalid node index ", Ref.NodeIndex);
+            continue;
+        }
+
+        const Node& N = Mdl.Nodes[Ref.NodeIndex];
+        if (N.pMesh == nullptr || Ref.PrimitiveIndex >= N.pMesh->Primitives.size())
+        {
+            DEV_ERROR("Node '", N.Name, "' has no primitive ", Ref.PrimitiveIndex);
+            continue;
+        }
+
+        // Use the instances of the first scene that groups the node
+        NodeInstanceRange Instances;
+        if (!N.InstanceMatrices.empty())
+        {
+            for (size_t SceneIdx = 0; SceneIdx < Mdl.Scenes.size(); ++SceneIdx)
+            {
+                if (FindNodeInstances(Mdl, Mdl.Scenes[SceneIdx], Ref.NodeIndex, Instances))
+                    break;
+            }
+        }
+        AddPrimitive(Mdl, Ref.NodeIndex, Ref.PrimitiveIndex, BuildInfo, Instances.GroupIndex, Instances.FirstInstance, Instances.NumInstances);
+    }
+
+    Finalize(BuildInfo);
+}
+
+void DrawList::AddPrimitive(const Model&             Mdl,
+                            Uint32                   NodeIndex,
+                            Uint32                   PrimitiveIndex,
+                            const DrawListBuildInfo& BuildInfo,
+                            Int32                    GroupIndex,
+                            Uint32                   FirstInstance,
+                            Uint32                   NumInstances)
+{
+    const Node&      N    = Mdl.Nodes[NodeIndex];
+    const Primitive& Prim = N.pMesh->Primitives[PrimitiveIndex];
+
+    DrawRecord Record;
+    Record.NodeIndex           = NodeIndex;
+    Record.PrimitiveIndex      = PrimitiveIndex;
+    Record.MaterialId          = Prim.MaterialId;
+    Record.IndexType           = Prim.HasIndices() ? Prim.IndexType : VT_UNDEFINED;
+    Record.VertexPoolIndex     = Mdl.GetVertexPoolIndex(Prim);
+    Record.IndexAllocatorIndex = Mdl.GetIndexAllocatorIndex(Prim);
+    if (GroupIndex >= 0)
+    {
+        Record.NumInstances       = NumInstances;
+        Record.InstanceId         = FirstInstance;
+        Record.InstanceGroupIndex = GroupIndex;
+    }
+    if (Prim.MaterialId < Mdl.Materials.size())
+    {
+        const Material& Mat = Mdl.Materials[Prim.MaterialId];
+        Record.AlphaMode    = static_cast<Uint8>(Mat.Attribs.AlphaMode);
+        Record.DoubleSided  = Mat.DoubleSided;
+    }
+
+    if (Record.IsIndexed())
+    {
+        VERIFY_EXPR(Prim.IndexType == VT_UINT16 || Prim.IndexType == VT_UINT32);
+        Record.NumElements          = Prim.IndexCount;
+        Record.FirstElementLocation = Mdl.GetFirstIndexLocation(Prim);
+        Record.BaseVertex           = Mdl.GetBaseVertex(Prim);
+    }
+    else
+    {
+        Record.NumElements          = Prim.VertexCount;
+        Record.FirstElementLocation = Mdl.GetBaseVertex(Prim);
+    }
+    if (Record.NumElements == 0)
+        return;
+
+    Uint64 Key = Uint64{std::min<Uint32>(Record.AlphaMode, Material::ALPHA_MODE_BLEND)} << AlphaModeShift;
+    if (Record.AlphaMode != Material::ALPHA_MODE_BLEND)
+    {
+        Key |= GetStateBits(Record) << StateShift;
+        Key |= Uint64{std::min(Record.MaterialId, MaxMaterialId)} << MaterialShift;
+    }
+    else if (BuildInfo.pTransforms != nullptr && NodeIndex < BuildInfo.pTransforms->NodeGlobalMatrices.size())
+    {
+        const float3 Center   = float3{float4{(Prim.BB.Min + Prim.BB.Max) * 0.5f, 1} * BuildInfo.pTransforms->NodeGlobalMatrices[NodeIndex]};
+        const float  Distance = length(Center - BuildInfo.ViewPosition);
+
+        // The bits of non-negative floats are ordered as the floats, so invert them to draw far primitives first
+        Uint32 DistanceBits = 0;
+        std::memcpy(&DistanceBits, &Distance, sizeof(DistanceBits));
+        Key |= Uint64{~DistanceBits} << BlendDepthShift;
+        Key |= GetStateBits(Record) << BlendStateShift;
+    }
+    // Without the transforms, blended records only have the alpha mode bits, so the stable sort keeps the scene order
+    Record.SortKey = Key;
+
+    m_Records.push_back(Record);
+}
+
+void DrawList::Finalize(const DrawListBuildInfo& BuildInfo)
+{
+    // Records with equal keys keep the scene order
+    std::stable_sort(m_Records.begin(), m_Records.end(),
+                     [](const DrawRecord& R0, const DrawRecord& R1) {
+                         return R0.SortKey < R1.SortKey;
+                     });
+
+    for (Uint32 RecordIdx = 0; RecordIdx < m_Records.size(); ++RecordIdx)
+    {
+        DrawRecord& Record = m_Records[RecordIdx];
+        if (!Record.IsInstanced())
+            Record.InstanceId = BuildInfo.InstanceIds == DrawListBuildInfo::INSTANCE_IDS_RECORD_INDEX ? RecordIdx : Record.NodeIndex;
+
+        if (m_Batches.empty() || !IsSameBatch(Record, m_Batches.back(), BuildInfo.SplitBatchesByMaterial))
+        {
+            DrawBatch Batch;
+            Batch.FirstRecord         = RecordIdx;
+            Batch.FirstArgs           = static_cast<Uint32>(Record.IsIndexed() ? m_IndexedArgs.size() : m_Args.size());
+            Batch.AlphaMode           = Record.AlphaMode;
+            Batch.DoubleSided         = Record.DoubleSided;
+            Batch.Instanced           = Record.IsInstanced();
+            Batch.IndexType           = Record.IndexType;
+            Batch.VertexPoolIndex     = Record.VertexPoolIndex;
+            Batch.IndexAllocatorIndex = Record.IndexAllocatorIndex;
+            Batch.MaterialId          = Record.MaterialId;
+            m_Batches.push_back(Batch);
+        }
+        ++m_Batches.back().NumRecords;
+
+        if (Record.IsIndexed())
+        {
+            DrawIndexedIndirectArgs Args;
+            Args.NumIndices            = Record.NumElements;
+            Args.NumInstances          = Record.NumInstances;
+            Args.FirstIndexLocation    = Record.FirstElementLocation;
+            Args.BaseVertex            = static_cast<Int32>(Record.BaseVertex);
+            Args.FirstInstanceLocation = Record.InstanceId;
+            m_IndexedArgs.push_back(Args);
+        }
+        else
+        {
+            DrawIndirectArgs Args;
+            Args.NumVertices           = Record.NumElements;
+            Args.NumInstances          = Record.NumInstances;
+            Args.StartVertexLocation   = Record.FirstElementLocation;
+            Args.FirstInstanceLocation = Record.InstanceId;
+            m_Args.push_back(Args);
+        }
+    }
+}
+
+} // namespace GLTF
+
+} // namespace Diligent
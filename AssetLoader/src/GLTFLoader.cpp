@@ -29,6 +29,7 @@
 #include <memory>
 #include <cmath>
 #include <atomic>
+#include <numeric>
 
 #include "GLTFLoader.hpp"
 #include "MapHelper.hpp"
@@ -43,8 +44,11 @@
 #include "Align.hpp"
 #include "GLTFBuilder.hpp"
 #include "GLTFUtilities.hpp"
+#include "GLTFCookedModel.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadPoolHelpers.hpp"
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
@@ -56,6 +60,15 @@
 
 #include "TinyGltfModelView.hpp"
 
+// Node transforms are multiplied with SSE2 or NEON when they are part of the target baseline.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define GLTF_LOADER_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define GLTF_LOADER_NEON
+#endif
+
 namespace Diligent
 {
 
@@ -82,13 +95,56 @@ InputLayoutDescX VertexAttributesToInputLayout(const VertexAttributeDesc* pAttri
     InputLayoutDescX InputLayout;
     for (Uint32 i = 0; i < NumAttributes; ++i)
     {
-        const VertexAttributeDesc& Attrib       = pAttributes[i];
-        const bool                 IsNormalized = (Attrib.ValueType == VT_UINT8 || Attrib.ValueType == VT_INT8);
+        const VertexAttributeDesc& Attrib = pAttributes[i];
+        // Octahedral and AABB-quantized 16-bit components are normalized as well
+        const bool IsNormalized =
+            (Attrib.ValueType == VT_UINT8 || Attrib.ValueType == VT_INT8) ||
+            ((Attrib.Encoding == VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL || Attrib.Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED) &&
+             (Attrib.ValueType == VT_UINT16 || Attrib.ValueType == VT_INT16));
         InputLayout.Add(i, Attrib.BufferId, Attrib.NumComponents, Attrib.ValueType, IsNormalized, Attrib.RelativeOffset);
     }
     return InputLayout;
 }
 
+std::array<VertexAttributeDesc, DefaultVertexAttributes.size()> GetQuantizedVertexAttributes(float MaxError)
+{
+    constexpr float Unorm16PositionError = 0.5f / 65535.f;
+    constexpr float Unorm8PositionError  = 0.5f / 255.f;
+    constexpr float OctSnorm16Error      = 4e-5f;
+    constexpr float HalfTexcoordError    = 1.f / 2048.f;
+
+    std::array<VertexAttributeDesc, DefaultVertexAttributes.size()> Attributes = DefaultVertexAttributes;
+    for (VertexAttributeDesc& Attrib : Attributes)
+    {
+        if (strcmp(Attrib.Name, PositionAttributeName) == 0)
+        {
+            if (MaxError >= Unorm16PositionError)
+            {
+                // Use four components to keep the following attributes aligned
+                Attrib.ValueType     = MaxError >= Unorm8PositionError ? VT_UINT8 : VT_UINT16;
+                Attrib.NumComponents = 4;
+                Attrib.Encoding      = VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED;
+            }
+        }
+        else if (strcmp(Attrib.Name, NormalAttributeName) == 0 || strcmp(Attrib.Name, TangentAttributeName) == 0)
+        {
+            if (MaxError >= OctSnorm16Error)
+            {
+                Attrib.ValueType     = VT_INT16;
+                Attrib.NumComponents = 2;
+                Attrib.Encoding      = VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL;
+            }
+        }
+        else if (strcmp(Attrib.Name, Texcoord0AttributeName) == 0 || strcmp(Attrib.Name, Texcoord1AttributeName) == 0)
+        {
+            if (MaxError >= HalfTexcoordError)
+                Attrib.ValueType = VT_FLOAT16;
+        }
+    }
+
+    return Attributes;
+}
+
 namespace
 {
 
@@ -342,6 +398,13 @@ Model::Model(const ModelCreateInfo& CI)
     NumVertexAttributes                         = CI.VertexAttributes != nullptr ? CI.NumVertexAttributes : static_cast<Uint32>(DefaultVertexAttributes.size());
     NumTextureAttributes                        = CI.TextureAttributes != nullptr ? CI.NumTextureAttributes : static_cast<Uint32>(DefaultTextureAttributes.size());
 
+    std::array<VertexAttributeDesc, DefaultVertexAttributes.size()> QuantizedVertAttribs;
+    if (CI.VertexAttributes == nullptr && CI.VertexQuantizationError > 0)
+    {
+        QuantizedVertAttribs = GetQuantizedVertexAttributes(CI.VertexQuantizationError);
+        pSrcVertAttribs      = QuantizedVertAttribs.data();
+    }
+
     DefaultRawMemoryAllocator& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
     FixedLinearAllocator       Allocator{RawAllocator};
     Allocator.AddSpace<VertexAttributeDesc>(NumVertexAttributes);
@@ -355,6 +418,14 @@ Model::Model(const ModelCreateInfo& CI)
         DEV_CHECK_ERR(Attrib.Name != nullptr, "Vertex attribute name must not be null");
         DEV_CHECK_ERR(Attrib.ValueType != VT_UNDEFINED, "Undefined vertex attribute value type");
         DEV_CHECK_ERR(Attrib.NumComponents != 0, "The number of components must not be null");
+        DEV_CHECK_ERR(Attrib.Encoding != VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL ||
+                          ((Attrib.ValueType == VT_INT8 || Attrib.ValueType == VT_INT16 || Attrib.ValueType == VT_FLOAT16 || Attrib.ValueType == VT_FLOAT32) && Attrib.NumComponents >= 2),
+                      "Octahedral encoding requires at least two VT_INT8, VT_INT16, VT_FLOAT16 or VT_FLOAT32 components");
+        DEV_CHECK_ERR(Attrib.Encoding != VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2 || (Attrib.ValueType == VT_UINT32 && Attrib.NumComponents == 1),
+                      "10:10:10:2 encoding requires exactly one VT_UINT32 component");
+        DEV_CHECK_ERR(Attrib.Encoding != VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED || ((Attrib.ValueType == VT_UINT8 || Attrib.ValueType == VT_UINT16) && SafeStrEqual(Attrib.Name, PositionAttributeName)),
+                      "AABB-quantized encoding is only supported for VT_UINT8 or VT_UINT16 positions");
+        DEV_CHECK_ERR(Attrib.Encoding < VERTEX_ATTRIBUTE_ENCODING_COUNT, "Invalid vertex attribute encoding");
 
         MaxBufferId = std::max<Uint32>(MaxBufferId, Attrib.BufferId);
 
@@ -410,6 +481,19 @@ Model::Model(IRenderDevice*         pDevice,
     Model{CI}
 {
     LoadFromFile(pDevice, pContext, CI);
+
+    if (CI.AnimationCompressionError > 0)
+    {
+        std::vector<AnimationCompressionStats> Stats = CompressAnimations(CI.AnimationCompressionError);
+        if (CI.pAnimationCompressionStats != nullptr)
+            *CI.pAnimationCompressionStats = std::move(Stats);
+    }
+
+    if (CI.AnimationBakeRate > 0)
+        BakeAnimations(CI.AnimationBakeRate);
+
+    if (CI.AnimationBoundsSampleRate > 0)
+        ComputeAnimationBounds(CI.AnimationBoundsSampleRate);
 }
 
 Model::Model() noexcept
@@ -1058,17 +1142,94 @@ bool Model::PrepareTextureGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx,
     return AllTexturesReady;
 }
 
+// Writes the chunk of the buffer init data to the buffer at the given offset.
+// Returns false if the chunk is still being copied asynchronously.
+static bool UploadBufferInitData(IDeviceContext* pCtx, IBuffer* pBuffer, Uint32 Offset, const BufferInitData::ChunkData& Chunk)
+{
+    const std::vector<Uint8>&             Bytes      = Chunk.Bytes;
+    const BufferInitData::AsyncCopyStatus CopyStatus = Chunk.CopyStatus;
+
+    VERIFY_EXPR(Bytes.empty() || (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled));
+    if (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled)
+    {
+        if (!Bytes.empty())
+        {
+            pCtx->UpdateBuffer(pBuffer, Offset, static_cast<Uint32>(Bytes.size()), Bytes.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+    else if (CopyStatus == BufferInitData::AsyncCopyStatus::Pending)
+    {
+        return false;
+    }
+    else
+    {
+        VERIFY(CopyStatus == BufferInitData::AsyncCopyStatus::Enqueued, "Unexpected copy status");
+    }
+
+    return true;
+}
+
+// Uploads the index data of the primitive that is shared with other models (see ModelCreateInfo::DeduplicateMeshData).
+// The data is uploaded by whichever of the models is prepared first.
+static bool PrepareSharedIndexData(IBufferSuballocation* pAllocation, IRenderDevice* pDevice, IDeviceContext* pCtx)
+{
+    IBuffer* pBuffer = pAllocation->Update(pDevice, pCtx);
+    if (pBuffer == nullptr)
+        return true;
+
+    RefCntAutoPtr<BufferInitData> pInitData{pAllocation->GetUserData(), IID_BufferInitData};
+    if (!pInitData)
+        return true;
+
+    VERIFY_EXPR(pInitData->Chunks.size() == 1);
+    if (!UploadBufferInitData(pCtx, pBuffer, pAllocation->GetOffset(), pInitData->Chunks[0]))
+        return false;
+
+    pAllocation->SetUserData(nullptr);
+    return true;
+}
+
+// Uploads the vertex data of the primitive that is shared with other models, similar to PrepareSharedIndexData.
+static bool PrepareSharedVertexData(IVertexPoolAllocation* pAllocation, const std::vector<Uint32>& Strides, IRenderDevice* pDevice, IDeviceContext* pCtx)
+{
+    RefCntAutoPtr<BufferInitData> pInitData{pAllocation->GetUserData(), IID_BufferInitData};
+    VERIFY_EXPR(!pInitData || pInitData->Chunks.size() == Strides.size());
+
+    bool VertexDataReady = true;
+    for (Uint32 BuffId = 0; BuffId < Strides.size(); ++BuffId)
+    {
+        IBuffer* pBuffer = pAllocation->Update(BuffId, pDevice, pCtx);
+        if (pBuffer != nullptr && pInitData && !UploadBufferInitData(pCtx, pBuffer, pAllocation->GetStartVertex() * Strides[BuffId], pInitData->Chunks[BuffId]))
+            VertexDataReady = false;
+    }
+
+    if (pInitData && VertexDataReady)
+        pAllocation->SetUserData(nullptr);
+
+    return VertexDataReady;
+}
+
 bool Model::PrepareIndexGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx, std::vector<StateTransitionDesc>& Barriers)
 {
+    bool IndexDataReady = true;
+    for (const Mesh& M : Meshes)
+    {
+        for (const Primitive& Prim : M.Primitives)
+        {
+            if (Prim.SharedData.pIndexAllocation && !PrepareSharedIndexData(Prim.SharedData.pIndexAllocation, pDevice, pCtx))
+                IndexDataReady = false;
+        }
+    }
+
     if (!IndexData.pBuffer && !IndexData.pAllocation)
-        return true;
+        return IndexDataReady;
 
     IBuffer* pBuffer = IndexData.pAllocation ?
         IndexData.pAllocation->Update(pDevice, pCtx) :
         IndexData.pBuffer;
 
     if (pBuffer == nullptr)
-        return true;
+        return IndexDataReady;
 
     RefCntAutoPtr<BufferInitData> pInitData;
     if (IndexData.pAllocation)
@@ -1076,39 +1237,21 @@ bool Model::PrepareIndexGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx, st
     else if (IndexData.pBuffer)
         pInitData = RefCntAutoPtr<BufferInitData>{IndexData.pBuffer->GetUserData(), IID_BufferInitData};
 
-    bool IndexDataReady = true;
     if (pInitData)
     {
         VERIFY_EXPR(pInitData->Chunks.size() == 1);
-        const BufferInitData::ChunkData&      Chunk      = pInitData->Chunks[0];
-        const std::vector<Uint8>&             Bytes      = Chunk.Bytes;
-        const BufferInitData::AsyncCopyStatus CopyStatus = Chunk.CopyStatus;
-
-        VERIFY_EXPR(Bytes.empty() || (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled));
-        if (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled)
-        {
-            if (!Bytes.empty())
-            {
-                const Uint32 Offset = IndexData.pAllocation ? IndexData.pAllocation->GetOffset() : 0;
-                pCtx->UpdateBuffer(pBuffer, Offset, static_cast<Uint32>(Bytes.size()), Bytes.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-            }
-        }
-        else if (CopyStatus == BufferInitData::AsyncCopyStatus::Pending)
-        {
-            IndexDataReady = false;
-        }
-        else
-        {
-            VERIFY(CopyStatus == BufferInitData::AsyncCopyStatus::Enqueued, "Unexpected copy status");
-        }
-
-        if (IndexDataReady)
+        const Uint32 Offset = IndexData.pAllocation ? IndexData.pAllocation->GetOffset() : 0;
+        if (UploadBufferInitData(pCtx, pBuffer, Offset, pInitData->Chunks[0]))
         {
             if (IndexData.pAllocation)
                 IndexData.pAllocation->SetUserData(nullptr);
             else if (IndexData.pBuffer)
                 IndexData.pBuffer->SetUserData(nullptr);
         }
+        else
+        {
+            IndexDataReady = false;
+        }
     }
 
     if (IndexDataReady && IndexData.pBuffer != nullptr)
@@ -1123,6 +1266,15 @@ bool Model::PrepareIndexGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx, st
 bool Model::PrepareVertexGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx, std::vector<StateTransitionDesc>& Barriers)
 {
     bool VertexDataReady = true;
+    for (const Mesh& M : Meshes)
+    {
+        for (const Primitive& Prim : M.Primitives)
+        {
+            if (Prim.SharedData.pVertexAllocation && !PrepareSharedVertexData(Prim.SharedData.pVertexAllocation, VertexData.Strides, pDevice, pCtx))
+                VertexDataReady = false;
+        }
+    }
+
     for (Uint32 BuffId = 0; BuffId < GetVertexBufferCount(); ++BuffId)
     {
         IBuffer* pBuffer = nullptr;
@@ -1149,29 +1301,12 @@ bool Model::PrepareVertexGPUData(IRenderDevice* pDevice, IDeviceContext* pCtx, s
         bool VertexStreamUploaded = true;
         if (pInitData)
         {
-            const BufferInitData::ChunkData&      Chunk      = VertexData.pAllocation ? pInitData->Chunks[BuffId] : pInitData->Chunks[0];
-            const std::vector<Uint8>&             Bytes      = Chunk.Bytes;
-            const BufferInitData::AsyncCopyStatus CopyStatus = Chunk.CopyStatus;
-            VERIFY_EXPR(Bytes.empty() || (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled));
-            if (CopyStatus == BufferInitData::AsyncCopyStatus::Disabled)
-            {
-                if (!Bytes.empty())
-                {
-                    const Uint32 Offset = VertexData.pAllocation ?
-                        VertexData.pAllocation->GetStartVertex() * VertexData.Strides[BuffId] :
-                        0;
+            const BufferInitData::ChunkData& Chunk  = VertexData.pAllocation ? pInitData->Chunks[BuffId] : pInitData->Chunks[0];
+            const Uint32                     Offset = VertexData.pAllocation ?
+                VertexData.pAllocation->GetStartVertex() * VertexData.Strides[BuffId] :
+                0;
 
-                    pCtx->UpdateBuffer(pBuffer, Offset, static_cast<Uint32>(Bytes.size()), Bytes.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-                }
-            }
-            else if (CopyStatus == BufferInitData::AsyncCopyStatus::Pending)
-            {
-                VertexStreamUploaded = false;
-            }
-            else
-            {
-                VERIFY(CopyStatus == BufferInitData::AsyncCopyStatus::Enqueued, "Unexpected copy status");
-            }
+            VertexStreamUploaded = UploadBufferInitData(pCtx, pBuffer, Offset, Chunk);
         }
 
         if (!VertexStreamUploaded)
@@ -1220,18 +1355,24 @@ bool Model::PrepareGPUResources(IRenderDevice* pDevice, IDeviceContext* pCtx)
     return false;
 }
 
+static SamplerDesc GetGLTFSamplerDesc(const tinygltf::Sampler& smpl)
+{
+    SamplerDesc SamDesc;
+    SamDesc.MagFilter = GltfFilterModeToFilterType(smpl.magFilter).first;
+    auto MinMipFilter = GltfFilterModeToFilterType(smpl.minFilter);
+    SamDesc.MinFilter = MinMipFilter.first;
+    SamDesc.MipFilter = MinMipFilter.second;
+    SamDesc.AddressU  = GltfWrapModeToAddressMode(smpl.wrapS);
+    SamDesc.AddressV  = GltfWrapModeToAddressMode(smpl.wrapT);
+    SamDesc.AddressW  = SamDesc.AddressV;
+    return SamDesc;
+}
+
 void Model::LoadTextureSamplers(IRenderDevice* pDevice, const tinygltf::Model& gltf_model)
 {
     for (const tinygltf::Sampler& smpl : gltf_model.samplers)
     {
-        SamplerDesc SamDesc;
-        SamDesc.MagFilter = GltfFilterModeToFilterType(smpl.magFilter).first;
-        auto MinMipFilter = GltfFilterModeToFilterType(smpl.minFilter);
-        SamDesc.MinFilter = MinMipFilter.first;
-        SamDesc.MipFilter = MinMipFilter.second;
-        SamDesc.AddressU  = GltfWrapModeToAddressMode(smpl.wrapS);
-        SamDesc.AddressV  = GltfWrapModeToAddressMode(smpl.wrapT);
-        SamDesc.AddressW  = SamDesc.AddressV;
+        const SamplerDesc       SamDesc = GetGLTFSamplerDesc(smpl);
         RefCntAutoPtr<ISampler> pSampler;
         pDevice->CreateSampler(SamDesc, &pSampler);
         TextureSamplers.push_back(std::move(pSampler));
@@ -1686,6 +1827,20 @@ void Model::LoadFromFile(IRenderDevice*         pDevice,
                          IDeviceContext*        pContext,
                          const ModelCreateInfo& CI)
 {
+    XXH128Hash CookedKey;
+
+    const bool UseCookedFile = (CI.CookedFileName != nullptr &&
+                                CookedModel::IsCacheable(CI) &&
+                                CookedModel::ComputeKey(*this, CI, CookedKey));
+    if (UseCookedFile && LoadFromCookedFile(pDevice, pContext, CI, CookedKey))
+        return;
+
+    // The source identity is read before the document, so that a file modified
+    // while the model is being built is not matched by the new cooked file.
+    CookedModel::SourceInfo CookedSource;
+
+    const bool WriteCookedFile = UseCookedFile && CookedModel::GetSourceInfo(CI, CookedSource);
+
     // A null device is a CPU-only metadata load: keep the scene graph, cameras,
     // lights, meshes, materials, and animations, but skip GPU resource objects.
     DocumentLoadInfo DocLoadInfo;
@@ -1694,6 +1849,8 @@ void Model::LoadFromFile(IRenderDevice*         pDevice,
     DocLoadInfo.ReadWholeFileCallback = CI.ReadWholeFileCallback;
     DocLoadInfo.pTextureCache         = CI.pTextureCache;
     DocLoadInfo.pResourceManager      = CI.pResourceManager;
+    DocLoadInfo.pThreadPool           = CI.pThreadPool;
+    DocLoadInfo.UseMemoryMapping      = CI.UseMemoryMapping;
 
     Document               GltfDoc{DocLoadInfo};
     const tinygltf::Model& gltf_model = GltfDoc.GetModel();
@@ -1711,14 +1868,147 @@ void Model::LoadFromFile(IRenderDevice*         pDevice,
     ModelBuilder Builder{CI, *this};
     MeshLoader   Loader{CI, *this};
     Builder.BuildModel(TinyGltfModelView{gltf_model}, CI.SceneId, Loader);
+    Loader.OptimizePrimitives();
+    Loader.BuildLODs();
+    Loader.BuildMeshlets();
 
+    Extensions = gltf_model.extensionsUsed;
+
+    if (WriteCookedFile)
+    {
+        std::vector<CookedModel::TextureRef> CookedTextures;
+        CookedTextures.reserve(gltf_model.textures.size());
+        ForEachGLTFTexture(
+            gltf_model, GltfDoc.GetBaseDir(),
+            [&CookedTextures](const GLTFTextureSource& Source) //
+            {
+                CookedTextures.push_back({Source.CacheId, Source.SamplerIndex});
+            });
+
+        std::vector<SamplerDesc> CookedSamplers;
+        CookedSamplers.reserve(gltf_model.samplers.size());
+        for (const tinygltf::Sampler& smpl : gltf_model.samplers)
+            CookedSamplers.push_back(GetGLTFSamplerDesc(smpl));
+
+        CookedModel::Write(CI.CookedFileName, CookedKey, CookedSource, *this, CookedTextures, CookedSamplers, Loader.GetIndexData(), Loader.GetVertexData());
+    }
+
+    Loader.BuildRayCastBVHs();
+    Loader.ComputeJointBounds();
     Loader.InitIndexBuffer(pDevice);
     Loader.InitVertexBuffers(pDevice);
 
     if (pContext != nullptr)
         PrepareGPUResources(pDevice, pContext);
+}
 
-    Extensions = gltf_model.extensionsUsed;
+// Returns a strong reference to the texture or the atlas suballocation with the given
+// cache id, or null if the texture is not present in the cache.
+static RefCntAutoPtr<IObject> FindCachedTexture(const std::string& CacheId,
+                                                TextureCacheType*  pTextureCache,
+                                                ResourceManager*   pResourceMgr)
+{
+    if (CacheId.empty())
+        return {};
+
+    if (pResourceMgr != nullptr)
+        return RefCntAutoPtr<IObject>{pResourceMgr->FindTextureAllocation(CacheId.c_str())};
+
+    if (pTextureCache != nullptr)
+    {
+        std::shared_lock<Threading::SharedMutex> SharedLock{pTextureCache->TexturesMtx};
+
+        auto it = pTextureCache->Textures.find(CacheId);
+        if (it != pTextureCache->Textures.end())
+            return RefCntAutoPtr<IObject>{it->second.Lock()};
+    }
+
+    return {};
+}
+
+bool Model::LoadFromCookedFile(IRenderDevice*         pDevice,
+                               IDeviceContext*        pContext,
+                               const ModelCreateInfo& CI,
+                               const XXH128Hash&      CookedKey)
+{
+    std::vector<CookedModel::TextureRef> CookedTextures;
+    std::vector<SamplerDesc>             CookedSamplers;
+    std::vector<Uint8>                   IndexData;
+    std::vector<std::vector<Uint8>>      VertexData;
+    if (!CookedModel::Read(CI.CookedFileName, CookedKey, CI, *this, CookedTextures, CookedSamplers, IndexData, VertexData))
+        return false;
+
+    // Instance groups depend on the create info, so they are not stored in the cooked file
+    for (Scene& S : Scenes)
+    {
+        S.InitSkinDependencies(Nodes.size());
+        S.InitInstanceGroups(CI.InstancingMinNodeCount);
+    }
+
+    if (pDevice != nullptr)
+    {
+        // Hold strong references to the cached textures so that they can't expire
+        // before they are added to the model.
+        std::vector<RefCntAutoPtr<IObject>> CachedTextures;
+        CachedTextures.reserve(CookedTextures.size());
+        for (const CookedModel::TextureRef& TexRef : CookedTextures)
+        {
+            RefCntAutoPtr<IObject> pCachedTex = FindCachedTexture(TexRef.CacheId, CI.pTextureCache, CI.pResourceManager);
+            if (!pCachedTex)
+                break;
+            CachedTextures.emplace_back(std::move(pCachedTex));
+        }
+
+        if (CachedTextures.size() == CookedTextures.size())
+        {
+            // All textures are already loaded: the source document is not needed.
+            for (const SamplerDesc& SamDesc : CookedSamplers)
+            {
+                RefCntAutoPtr<ISampler> pSampler;
+                pDevice->CreateSampler(SamDesc, &pSampler);
+                TextureSamplers.push_back(std::move(pSampler));
+            }
+
+            Textures.reserve(CookedTextures.size());
+            for (const CookedModel::TextureRef& TexRef : CookedTextures)
+            {
+                ImageData Image;
+                Image.Width  = -1;
+                Image.Height = -1;
+                AddTexture(pDevice, CI.pTextureCache, CI.pResourceManager, CI.pUploadMgr, Image, TexRef.SamplerId, TexRef.CacheId);
+            }
+        }
+        else
+        {
+            DocumentLoadInfo DocLoadInfo;
+            DocLoadInfo.FileName              = CI.FileName;
+            DocLoadInfo.FileExistsCallback    = CI.FileExistsCallback;
+            DocLoadInfo.ReadWholeFileCallback = CI.ReadWholeFileCallback;
+            DocLoadInfo.pTextureCache         = CI.pTextureCache;
+            DocLoadInfo.pResourceManager      = CI.pResourceManager;
+            DocLoadInfo.pThreadPool           = CI.pThreadPool;
+            DocLoadInfo.UseMemoryMapping      = CI.UseMemoryMapping;
+
+            Document               GltfDoc{DocLoadInfo};
+            const tinygltf::Model& gltf_model = GltfDoc.GetModel();
+            VERIFY(gltf_model.textures.size() == CookedTextures.size(), "The cooked model key matches, but the number of textures is different. This appears to be a bug.");
+
+            LoadTextureSamplers(pDevice, gltf_model);
+            LoadTextures(pDevice, gltf_model, GltfDoc.GetBaseDir(), CI.pTextureCache, CI.pResourceManager, CI.pUploadMgr);
+        }
+    }
+
+    MeshLoader Loader{CI, *this};
+    Loader.SetData(std::move(IndexData), std::move(VertexData));
+    Loader.BuildRayCastBVHs();
+    Loader.ComputeJointBounds();
+    Loader.InitIndexBuffer(pDevice);
+    Loader.InitVertexBuffers(pDevice);
+
+    if (pContext != nullptr)
+        PrepareGPUResources(pDevice, pContext);
+
+    return true;
 }
 
 BoundBox Model::ComputeBoundingBox(Uint32 SceneIndex, const ModelTransforms& Transforms) const
@@ -1738,11 +2028,28 @@ BoundBox Model::ComputeBoundingBox(Uint32 SceneIndex, const ModelTransforms& Tra
             VERIFY_EXPR(pN != nullptr);
             if (pN->pMesh != nullptr && pN->pMesh->IsValidBB())
             {
-                const float4x4& GlobalMatrix = Transforms.NodeGlobalMatrices[pN->Index];
-                const BoundBox  NodeAABB     = pN->pMesh->BB.Transform(GlobalMatrix);
+                // Skinned vertices are not bounded by the bind-pose mesh box, so use the joint bounds if available
+                const bool      UseJointBounds = pN->pSkin != nullptr && !pN->pSkin->JointBounds.empty();
+                const float4x4& GlobalMatrix   = Transforms.NodeGlobalMatrices[pN->Index];
+                if (pN->InstanceMatrices.empty())
+                {
+                    const BoundBox NodeAABB = UseJointBounds ?
+                        ComputeSkinnedBoundingBox(*pN, Transforms) :
+                        pN->pMesh->BB.Transform(GlobalMatrix);
+
+                    ModelAABB.Min = std::min(ModelAABB.Min, NodeAABB.Min);
+                    ModelAABB.Max = std::max(ModelAABB.Max, NodeAABB.Max);
+                }
+                else
+                {
+                    for (const float4x4& InstanceMatrix : pN->InstanceMatrices)
+                    {
+                        const BoundBox InstanceAABB = pN->pMesh->BB.Transform(InstanceMatrix * GlobalMatrix);
 
-                ModelAABB.Min = std::min(ModelAABB.Min, NodeAABB.Min);
-                ModelAABB.Max = std::max(ModelAABB.Max, NodeAABB.Max);
+                        ModelAABB.Min = std::min(ModelAABB.Min, InstanceAABB.Min);
+                        ModelAABB.Max = std::max(ModelAABB.Max, InstanceAABB.Max);
+                    }
+                }
             }
         }
     }
@@ -1754,208 +2061,1875 @@ BoundBox Model::ComputeBoundingBox(Uint32 SceneIndex, const ModelTransforms& Tra
     return ModelAABB;
 }
 
-static void UpdateNodeGlobalTransform(const Node& node, const float4x4& ParentMatrix, ModelTransforms& Transforms)
+BoundBox Model::ComputeSkinnedBoundingBox(const Node& SkinnedNode, const ModelTransforms& Transforms) const
 {
-    const float4x4& LocalMat  = Transforms.NodeLocalMatrices[node.Index];
-    float4x4&       GlobalMat = Transforms.NodeGlobalMatrices[node.Index];
-    GlobalMat                 = LocalMat * ParentMatrix;
-    for (const Node* pChild : node.Children)
+    BoundBox SkinnedAABB{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    if (!CompatibleWithTransforms(Transforms))
     {
-        UpdateNodeGlobalTransform(*pChild, GlobalMat, Transforms);
+        UNEXPECTED("Incompatible transforms. Please use the ComputeTransforms() method first.");
+        return SkinnedAABB;
     }
-}
 
-void Model::ComputeTransforms(Uint32           SceneIndex,
-                              ModelTransforms& Transforms,
-                              const float4x4&  RootTransform,
-                              Int32            AnimationIndex,
-                              float            Time) const
-{
-    if (SceneIndex >= Scenes.size())
+    const Skin* pSkin = SkinnedNode.pSkin;
+    if (pSkin == nullptr)
     {
-        DEV_ERROR("Invalid scene index ", SceneIndex);
-        return;
+        DEV_ERROR("Node '", SkinnedNode.Name, "' has no skin");
+        return SkinnedAABB;
     }
-    const Scene& scene = Scenes[SceneIndex];
-
-    // Note that the matrices are indexed by the global node index,
-    // not the linear node index in the scene.
-    Transforms.NodeGlobalMatrices.resize(Nodes.size());
-    Transforms.NodeLocalMatrices.resize(Nodes.size());
+    VERIFY(pSkin->JointBounds.empty() || pSkin->JointBounds.size() == pSkin->Joints.size(), "Inconsistent number of joint bounds");
 
-    // Update node animation
-    if (AnimationIndex >= 0)
+    // Every skinned vertex is a convex combination of its positions transformed by the
+    // matrices of its joints, so it is inside the union of the transformed joint boxes.
+    for (size_t i = 0; i < pSkin->JointBounds.size(); ++i)
     {
-        Transforms.Skins.resize(SkinTransformsCount);
-        UpdateAnimation(SceneIndex, AnimationIndex, Time, Transforms);
+        const BoundBox& JointBB = pSkin->JointBounds[i];
+        const Node*     pJoint  = pSkin->Joints[i];
+        if (pJoint == nullptr || JointBB.Min.x > JointBB.Max.x)
+            continue;
+
+        const BoundBox JointAABB = JointBB.Transform(Transforms.NodeGlobalMatrices[pJoint->Index]);
+
+        SkinnedAABB.Min = std::min(SkinnedAABB.Min, JointAABB.Min);
+        SkinnedAABB.Max = std::max(SkinnedAABB.Max, JointAABB.Max);
     }
-    else
+
+    return SkinnedAABB;
+}
+
+void Scene::InitHierarchy(size_t NumNodes)
+{
+    HierarchyNodeIds.clear();
+    HierarchyParentIds.clear();
+
+    // Depth-first traversal that visits the nodes in the same order as the recursive
+    // traversal of the children. Every node is visited once even if the hierarchy is malformed.
+    std::vector<bool>                                 Visited(NumNodes);
+    std::vector<std::pair<const Node*, const Node*>> Stack; // {Node, Parent}
+    for (auto root_it = RootNodes.rbegin(); root_it != RootNodes.rend(); ++root_it)
+        Stack.emplace_back(*root_it, nullptr);
+
+    while (!Stack.empty())
     {
-        Transforms.Skins.clear();
-        for (Node* pNode : scene.LinearNodes)
-        {
-            VERIFY_EXPR(pNode != nullptr);
-            Transforms.NodeLocalMatrices[pNode->Index] = pNode->ComputeLocalTransform();
-        }
+        const auto [pNode, pParent] = Stack.back();
+        Stack.pop_back();
+
+        if (pNode == nullptr || pNode->Index < 0 || static_cast<size_t>(pNode->Index) >= NumNodes || Visited[pNode->Index])
+            continue;
+        Visited[pNode->Index] = true;
+
+        HierarchyNodeIds.push_back(static_cast<Uint32>(pNode->Index));
+        HierarchyParentIds.push_back(pParent != nullptr ? pParent->Index : -1);
+
+        for (auto child_it = pNode->Children.rbegin(); child_it != pNode->Children.rend(); ++child_it)
+            Stack.emplace_back(*child_it, pNode);
     }
+}
 
-    // Compute global transforms
-    for (Node* pRoot : scene.RootNodes)
-        UpdateNodeGlobalTransform(*pRoot, RootTransform, Transforms);
+void Scene::InitSkinDependencies(size_t NumNodes)
+{
+    SkinDependencyOffsets.assign(NumNodes + 1, 0);
+    SkinDependencies.clear();
 
-    // Update join matrices
-    if (!Transforms.Skins.empty())
-    {
-        for (const Node* pNode : scene.LinearNodes)
+    auto ForEachDependency = [&](auto&& Handler) {
+        for (const Node* pNode : LinearNodes)
         {
-            VERIFY_EXPR(pNode != nullptr);
-            const Mesh* pMesh = pNode->pMesh;
-            const Skin* pSkin = pNode->pSkin;
-            if (pMesh == nullptr || pSkin == nullptr)
+            if (pNode->pMesh == nullptr || pNode->pSkin == nullptr)
                 continue;
 
-            const float4x4& NodeGlobalMat = Transforms.NodeGlobalMatrices[pNode->Index];
-            VERIFY(pNode->SkinTransformsIndex < static_cast<int>(SkinTransformsCount),
-                   "Skin transform index (", pNode->SkinTransformsIndex, ") exceeds the skin transform count in this mesh (", SkinTransformsCount,
-                   "). This appears to be a bug.");
-            std::vector<float4x4>& JointMatrices = Transforms.Skins[pNode->SkinTransformsIndex].JointMatrices;
-            if (JointMatrices.size() != pSkin->Joints.size())
-                JointMatrices.resize(pSkin->Joints.size());
-
-            const float4x4 InverseTransform = NodeGlobalMat.Inverse();
-            for (size_t i = 0; i < pSkin->Joints.size(); i++)
+            const Uint32 SkinnedNodeId = static_cast<Uint32>(pNode->Index);
+            Handler(pNode->Index, SkinnedNodeId);
+            for (const Node* pJoint : pNode->pSkin->Joints)
             {
-                const Node*     JointNode          = pSkin->Joints[i];
-                const float4x4& JointNodeGlobalMat = Transforms.NodeGlobalMatrices[JointNode->Index];
-                JointMatrices[i] =
-                    pSkin->InverseBindMatrices[i] * JointNodeGlobalMat * InverseTransform;
+                if (pJoint != nullptr && pJoint != pNode)
+                    Handler(pJoint->Index, SkinnedNodeId);
             }
         }
-    }
-}
-
-bool Model::CompatibleWithTransforms(const ModelTransforms& Transforms) const
-{
-    return (Transforms.NodeLocalMatrices.size() == Nodes.size() &&
-            Transforms.NodeGlobalMatrices.size() == Nodes.size());
-}
+    };
 
-void Model::UpdateAnimation(Uint32 SceneIndex, Uint32 AnimationIndex, float time, ModelTransforms& Transforms) const
-{
-    if (AnimationIndex >= Animations.size())
+    // Count the dependencies of every node, then fill the lists
+    ForEachDependency([&](int NodeId, Uint32) {
+        if (NodeId >= 0 && static_cast<size_t>(NodeId) < NumNodes)
+            ++SkinDependencyOffsets[NodeId + 1];
+    });
+    std::partial_sum(SkinDependencyOffsets.begin(), SkinDependencyOffsets.end(), SkinDependencyOffsets.begin());
+    if (SkinDependencyOffsets.back() == 0)
     {
-        LOG_WARNING_MESSAGE("No animation with index ", AnimationIndex);
+        // No skinned nodes in the scene
+        SkinDependencyOffsets.clear();
         return;
     }
 
-    VERIFY_EXPR(SceneIndex < Scenes.size());
-    const Animation& animation = Animations[AnimationIndex];
-
-    time = clamp(time, animation.Start, animation.End);
+    SkinDependencies.resize(SkinDependencyOffsets.back());
+    std::vector<Uint32> WriteOffsets{SkinDependencyOffsets.begin(), SkinDependencyOffsets.end() - 1};
+    ForEachDependency([&](int NodeId, Uint32 SkinnedNodeId) {
+        if (NodeId >= 0 && static_cast<size_t>(NodeId) < NumNodes)
+            SkinDependencies[WriteOffsets[NodeId]++] = SkinnedNodeId;
+    });
+}
 
-    const Scene& scene = Scenes[SceneIndex];
-    if (Transforms.NodeAnimations.size() != scene.LinearNodes.size())
-        Transforms.NodeAnimations.resize(scene.LinearNodes.size());
-    VERIFY_EXPR(Transforms.NodeAnimations.size() == Transforms.NodeLocalMatrices.size());
+void Scene::InitInstanceGroups(Uint32 MinNodeCount)
+{
+    InstanceGroups.clear();
+    InstanceCount = 0;
 
-    for (const Node* pN : scene.LinearNodes)
+    // Collect the nodes of every mesh in the order of the first node that references it
+    std::unordered_map<const Mesh*, size_t> MeshToGroup;
+    std::vector<std::vector<const Node*>>   GroupNodes;
+    std::vector<bool>                       Added;
+    for (const Node* pNode : LinearNodes)
     {
-        VERIFY_EXPR(pN != nullptr);
-        ModelTransforms::AnimationTransforms& A = Transforms.NodeAnimations[pN->Index];
+        VERIFY_EXPR(pNode != nullptr);
+        if (pNode->pMesh == nullptr || pNode->pSkin != nullptr || pNode->MorphWeightsOffset >= 0)
+            continue;
 
-        // NB: not each component has to be animated (e.g. 'Fox' test model)
-        A.Translation = pN->Translation;
-        A.Rotation    = pN->Rotation;
-        A.Scale       = pN->Scale;
+        const size_t NodeId = static_cast<size_t>(pNode->Index);
+        if (NodeId >= Added.size())
+            Added.resize(NodeId + 1);
+        if (Added[NodeId])
+            continue;
+        Added[NodeId] = true;
+
+        auto it = MeshToGroup.emplace(pNode->pMesh, GroupNodes.size());
+        if (it.second)
+            GroupNodes.emplace_back();
+        GroupNodes[it.first->second].push_back(pNode);
     }
 
-    for (const AnimationChannel& channel : animation.Channels)
+    for (const std::vector<const Node*>& Nodes : GroupNodes)
     {
-        const AnimationSampler& sampler = animation.Samplers[channel.SamplerIndex];
-        if (sampler.Inputs.size() > sampler.OutputsVec4.size())
-        {
+        const bool HasGpuInstances = std::any_of(Nodes.begin(), Nodes.end(), [](const Node* pNode) { return !pNode->InstanceMatrices.empty(); });
+        if (!HasGpuInstances && (MinNodeCount == 0 || Nodes.size() < MinNodeCount))
             continue;
+
+        InstanceGroup Group;
+        Group.pMesh         = Nodes.front()->pMesh;
+        Group.FirstInstance = InstanceCount;
+        Group.NodeIds.reserve(Nodes.size());
+        for (const Node* pNode : Nodes)
+        {
+            Group.NodeIds.push_back(static_cast<Uint32>(pNode->Index));
+            Group.InstanceCount += std::max(static_cast<Uint32>(pNode->InstanceMatrices.size()), 1u);
         }
+        InstanceCount += Group.InstanceCount;
+        InstanceGroups.emplace_back(std::move(Group));
+    }
+}
 
-        ModelTransforms::AnimationTransforms& NodeAnim = Transforms.NodeAnimations[channel.pNode->Index];
+// Computes Dst = Local * Parent. Each row of the result is accumulated in the same
+// order as in float4x4::operator*, so that the results are identical to the scalar code.
+static inline void MultiplyNodeTransforms(const float4x4& Local, const float4x4& Parent, float4x4& Dst)
+{
+#if defined(GLTF_LOADER_SSE2)
+    const __m128 Row0 = _mm_loadu_ps(Parent.m[0]);
+    const __m128 Row1 = _mm_loadu_ps(Parent.m[1]);
+    const __m128 Row2 = _mm_loadu_ps(Parent.m[2]);
+    const __m128 Row3 = _mm_loadu_ps(Parent.m[3]);
+    for (int r = 0; r < 4; ++r)
+    {
+        __m128 Res = _mm_setzero_ps();
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(Local.m[r][0]), Row0));
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(Local.m[r][1]), Row1));
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(Local.m[r][2]), Row2));
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(Local.m[r][3]), Row3));
+        _mm_storeu_ps(Dst.m[r], Res);
+    }
+#elif defined(GLTF_LOADER_NEON)
+    const float32x4_t Row0 = vld1q_f32(Parent.m[0]);
+    const float32x4_t Row1 = vld1q_f32(Parent.m[1]);
+    const float32x4_t Row2 = vld1q_f32(Parent.m[2]);
+    const float32x4_t Row3 = vld1q_f32(Parent.m[3]);
+    for (int r = 0; r < 4; ++r)
+    {
+        // Separate multiplies and adds: fused multiply-add would change the rounding
+        float32x4_t Res = vdupq_n_f32(0);
+        Res             = vaddq_f32(Res, vmulq_n_f32(Row0, Local.m[r][0]));
+        Res             = vaddq_f32(Res, vmulq_n_f32(Row1, Local.m[r][1]));
+        Res             = vaddq_f32(Res, vmulq_n_f32(Row2, Local.m[r][2]));
+        Res             = vaddq_f32(Res, vmulq_n_f32(Row3, Local.m[r][3]));
+        vst1q_f32(Dst.m[r], Res);
+    }
+#else
+    Dst = Local * Parent;
+#endif
+}
 
-        // Get the keyframe index.
-        // Note that different channels may have different time ranges.
-        size_t Idx = sampler.FindKeyFrame(time);
+template <typename T>
+static void SetAnimatedValue(T& Dst, const T& Value, Uint8* pDirtyFlags, int NodeId)
+{
+    // Only the nodes whose values were actually changed are marked dirty
+    if (pDirtyFlags != nullptr && Dst != Value)
+        pDirtyFlags[NodeId] |= ModelTransforms::NODE_DIRTY_FLAG_LOCAL;
+    Dst = Value;
+}
 
+static QuaternionF MakeQuaternion(const float4& Value)
+{
+    QuaternionF q;
+    q.q = Value;
+    return q;
+}
+
+// Computes the value of the sampler at the given time.
+// Returns false if the sampler does not provide enough output values.
+static bool SampleAnimation(const AnimationSampler&     sampler,
+                            AnimationChannel::PATH_TYPE PathType,
+                            float                       time,
+                            Uint32&                     KeyFrameCursor,
+                            float4&                     Value)
+{
+    const size_t NumKeys  = sampler.Inputs.size();
+    const bool   IsCubic  = sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE;
+    const size_t NumElems = IsCubic ? 3 : 1;
+    if (NumKeys == 0 || sampler.GetOutputCount() < NumKeys * NumElems)
+        return false;
+
+    // Get the keyframe index.
+    // Note that different channels may have different time ranges.
+    size_t Idx = sampler.FindKeyFrame(time, KeyFrameCursor);
+
+    switch (sampler.Interpolation)
+    {
         // STEP: The animated values remain constant to the output of the first keyframe, until the next keyframe.
         //       The number of output elements **MUST** equal the number of input elements.
-        float u = 0;
+        case AnimationSampler::INTERPOLATION_TYPE::STEP:
+        {
+            if (Idx + 1 < NumKeys && time >= sampler.Inputs[Idx + 1])
+                ++Idx;
+            Value = sampler.GetOutput(Idx);
+            return true;
+        }
 
         // LINEAR: The animated values are linearly interpolated between keyframes.
         //         The number of output elements **MUST** equal the number of input elements.
-        if (sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::LINEAR)
+        case AnimationSampler::INTERPOLATION_TYPE::LINEAR:
         {
-            if (sampler.Inputs.size() < 2)
-                continue;
+            if (NumKeys < 2)
+            {
+                Value = sampler.GetOutput(0);
+                return true;
+            }
 
-            Idx = std::min(Idx, sampler.Inputs.size() - 2);
-            u   = (time - sampler.Inputs[Idx]) / (sampler.Inputs[Idx + 1] - sampler.Inputs[Idx]);
+            Idx           = std::min(Idx, NumKeys - 2);
+            const float u = clamp((time - sampler.Inputs[Idx]) / (sampler.Inputs[Idx + 1] - sampler.Inputs[Idx]), 0.f, 1.f);
+            if (PathType == AnimationChannel::PATH_TYPE::ROTATION)
+            {
+                const QuaternionF q1 = MakeQuaternion(sampler.GetOutput(Idx));
+                const QuaternionF q2 = MakeQuaternion(sampler.GetOutput(Idx + 1));
+                Value                = normalize(slerp(q1, q2, u)).q;
+            }
+            else
+            {
+                Value = lerp(sampler.GetOutput(Idx), sampler.GetOutput(Idx + 1), u);
+            }
+            return true;
         }
 
         // CUBICSPLINE: The animation's interpolation is computed using a cubic spline with specified tangents.
         //              The number of output elements **MUST** equal three times the number of input elements.
         //              For each input element, the output stores three elements, an in-tangent, a spline vertex,
         //              and an out-tangent. There **MUST** be at least two keyframes when using this interpolation.
-        //if (sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE)
-        // Not supported
+        case AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE:
+        {
+            if (NumKeys < 2)
+            {
+                Value = sampler.GetOutput(1);
+                return true;
+            }
+
+            Idx            = std::min(Idx, NumKeys - 2);
+            const float td = sampler.Inputs[Idx + 1] - sampler.Inputs[Idx];
+            const float t  = clamp((time - sampler.Inputs[Idx]) / td, 0.f, 1.f);
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+
+            const float4 v0 = sampler.GetOutput(Idx * 3 + 1);
+            const float4 b0 = sampler.GetOutput(Idx * 3 + 2);
+            const float4 a1 = sampler.GetOutput((Idx + 1) * 3 + 0);
+            const float4 v1 = sampler.GetOutput((Idx + 1) * 3 + 1);
+
+            Value = v0 * (2 * t3 - 3 * t2 + 1) +
+                b0 * (td * (t3 - 2 * t2 + t)) +
+                v1 * (-2 * t3 + 3 * t2) +
+                a1 * (td * (t3 - t2));
+            if (PathType == AnimationChannel::PATH_TYPE::ROTATION)
+                Value = normalize(Value);
+            return true;
+        }
+
+        default:
+            UNEXPECTED("Unexpected interpolation type");
+            return false;
+    }
+}
+
+// Returns the value of the channel's node property when it is not animated.
+static float4 GetRestValue(const AnimationChannel& channel)
+{
+    switch (channel.PathType)
+    {
+        case AnimationChannel::PATH_TYPE::TRANSLATION: return float4{channel.pNode->Translation, 0};
+        case AnimationChannel::PATH_TYPE::ROTATION: return channel.pNode->Rotation.q;
+        case AnimationChannel::PATH_TYPE::SCALE: return float4{channel.pNode->Scale, 0};
+        default: return float4{};
+    }
+}
+
+static void SetChannelValue(const AnimationChannel&               channel,
+                            const float4&                         Value,
+                            ModelTransforms::AnimationTransforms& NodeAnims,
+                            Uint8*                                pDirtyFlags)
+{
+    const int NodeId = channel.pNode->Index;
+    switch (channel.PathType)
+    {
+        case AnimationChannel::PATH_TYPE::TRANSLATION:
+            SetAnimatedValue(NodeAnims.Translations[NodeId], float3{Value}, pDirtyFlags, NodeId);
+            break;
+
+        case AnimationChannel::PATH_TYPE::SCALE:
+            SetAnimatedValue(NodeAnims.Scales[NodeId], float3{Value}, pDirtyFlags, NodeId);
+            break;
+
+        case AnimationChannel::PATH_TYPE::ROTATION:
+            SetAnimatedValue(NodeAnims.Rotations[NodeId], MakeQuaternion(Value), pDirtyFlags, NodeId);
+            break;
+
+        case AnimationChannel::PATH_TYPE::WEIGHTS:
+            UNEXPECTED("Morph target weights are not stored in the node animation transforms");
+            break;
+    }
+}
+
+// Returns the number of morph target weights of the node.
+static size_t GetNodeMorphWeightCount(const Node& N)
+{
+    return N.MorphWeightsOffset >= 0 && N.pMesh != nullptr ? N.pMesh->MorphWeights.size() : 0;
+}
+
+// Computes the NumWeights morph target weights of the sampler at the given time.
+// Returns false if the sampler does not provide enough output values.
+static bool SampleMorphWeights(const AnimationSampler& sampler,
+                               float                   time,
+                               Uint32&                 KeyFrameCursor,
+                               float*                  pWeights,
+                               size_t                  NumWeights)
+{
+    // The outputs of every key are NumWeights values, or in-tangents, values and out-tangents for cubic splines
+    const size_t NumKeys = sampler.Inputs.size();
+    const bool   IsCubic = sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE;
+    const size_t KeySize = NumWeights * (IsCubic ? 3 : 1);
+    if (NumKeys == 0 || NumWeights == 0 || sampler.OutputWeights.size() < NumKeys * KeySize)
+        return false;
+
+    const float* pOutputs = sampler.OutputWeights.data();
+
+    size_t Idx = sampler.FindKeyFrame(time, KeyFrameCursor);
+    switch (sampler.Interpolation)
+    {
+        case AnimationSampler::INTERPOLATION_TYPE::STEP:
+        {
+            if (Idx + 1 < NumKeys && time >= sampler.Inputs[Idx + 1])
+                ++Idx;
+            std::copy_n(pOutputs + Idx * KeySize, NumWeights, pWeights);
+            return true;
+        }
 
-        u = clamp(u, 0.f, 1.f);
-        switch (channel.PathType)
+        case AnimationSampler::INTERPOLATION_TYPE::LINEAR:
         {
-            case AnimationChannel::PATH_TYPE::TRANSLATION:
+            if (NumKeys < 2)
             {
-                const float3 f3Start = sampler.OutputsVec4[Idx];
-                const float3 f3End   = sampler.OutputsVec4[Idx + 1];
-                NodeAnim.Translation = lerp(f3Start, f3End, u);
-                break;
+                std::copy_n(pOutputs, NumWeights, pWeights);
+                return true;
             }
 
-            case AnimationChannel::PATH_TYPE::SCALE:
+            Idx           = std::min(Idx, NumKeys - 2);
+            const float u = clamp((time - sampler.Inputs[Idx]) / (sampler.Inputs[Idx + 1] - sampler.Inputs[Idx]), 0.f, 1.f);
+
+            const float* pValues0 = pOutputs + Idx * KeySize;
+            const float* pValues1 = pValues0 + KeySize;
+            for (size_t i = 0; i < NumWeights; ++i)
+                pWeights[i] = lerp(pValues0[i], pValues1[i], u);
+            return true;
+        }
+
+        case AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE:
+        {
+            if (NumKeys < 2)
             {
-                const float3 f3Start = sampler.OutputsVec4[Idx];
-                const float3 f3End   = sampler.OutputsVec4[Idx + 1];
-                NodeAnim.Scale       = lerp(f3Start, f3End, u);
-                break;
+                std::copy_n(pOutputs + NumWeights, NumWeights, pWeights);
+                return true;
             }
 
-            case AnimationChannel::PATH_TYPE::ROTATION:
+            Idx            = std::min(Idx, NumKeys - 2);
+            const float td = sampler.Inputs[Idx + 1] - sampler.Inputs[Idx];
+            const float t  = clamp((time - sampler.Inputs[Idx]) / td, 0.f, 1.f);
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+
+            const float* pKey0 = pOutputs + Idx * KeySize;
+            const float* pKey1 = pKey0 + KeySize;
+            for (size_t i = 0; i < NumWeights; ++i)
             {
-                QuaternionF q1;
-                q1.q.x = sampler.OutputsVec4[Idx].x;
-                q1.q.y = sampler.OutputsVec4[Idx].y;
-                q1.q.z = sampler.OutputsVec4[Idx].z;
-                q1.q.w = sampler.OutputsVec4[Idx].w;
-
-                QuaternionF q2;
-                q2.q.x = sampler.OutputsVec4[Idx + 1].x;
-                q2.q.y = sampler.OutputsVec4[Idx + 1].y;
-                q2.q.z = sampler.OutputsVec4[Idx + 1].z;
-                q2.q.w = sampler.OutputsVec4[Idx + 1].w;
-
-                NodeAnim.Rotation = normalize(slerp(q1, q2, u));
-                break;
+                const float v0 = pKey0[NumWeights + i];
+                const float b0 = pKey0[NumWeights * 2 + i];
+                const float a1 = pKey1[i];
+                const float v1 = pKey1[NumWeights + i];
+
+                pWeights[i] = v0 * (2 * t3 - 3 * t2 + 1) +
+                    b0 * (td * (t3 - 2 * t2 + t)) +
+                    v1 * (-2 * t3 + 3 * t2) +
+                    a1 * (td * (t3 - t2));
+            }
+            return true;
+        }
+
+        default:
+            UNEXPECTED("Unexpected interpolation type");
+            return false;
+    }
+}
+
+// Writes the values of the baked animation channels at the given time to the node animation transforms.
+static void ApplyBakedAnimationChannels(const Animation&                      animation,
+                                        float                                 time,
+                                        ModelTransforms::AnimationTransforms& NodeAnims,
+                                        Uint8*                                pDirtyFlags)
+{
+    VERIFY_EXPR(animation.IsBaked());
+    const size_t NumChannels = animation.Channels.size();
+    VERIFY_EXPR(animation.BakedValues.size() == NumChannels * animation.BakedFrameCount);
+
+    Uint32 Frame = 0;
+    float  u     = 0;
+    if (animation.BakedFrameCount > 1)
+    {
+        const float FramePos = std::max(time - animation.Start, 0.f) * animation.BakedFrameRate;
+        Frame                = std::min(static_cast<Uint32>(FramePos), animation.BakedFrameCount - 2);
+        u                    = clamp(FramePos - static_cast<float>(Frame), 0.f, 1.f);
+    }
+
+    const float4* pValues0 = &animation.BakedValues[Frame * NumChannels];
+    const float4* pValues1 = animation.BakedFrameCount > 1 ? pValues0 + NumChannels : pValues0;
+    for (size_t i = 0; i < NumChannels; ++i)
+    {
+        const AnimationChannel& channel = animation.Channels[i];
+        const AnimationSampler& sampler = animation.Samplers[channel.SamplerIndex];
+        if (channel.PathType == AnimationChannel::PATH_TYPE::WEIGHTS)
+            continue;
+
+        float4 Value;
+        if (sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::STEP)
+        {
+            Value = u < 1.f ? pValues0[i] : pValues1[i];
+        }
+        else if (channel.PathType == AnimationChannel::PATH_TYPE::ROTATION)
+        {
+            // Use the shortest path between the quaternions
+            const float4& q1 = pValues0[i];
+            const float4  q2 = dot(q1, pValues1[i]) < 0 ? -pValues1[i] : pValues1[i];
+            Value            = normalize(lerp(q1, q2, u));
+        }
+        else
+        {
+            Value = lerp(pValues0[i], pValues1[i], u);
+        }
+        SetChannelValue(channel, Value, NodeAnims, pDirtyFlags);
+    }
+}
+
+// Writes the values of the animation channels at the given time to the node animation transforms
+// and the morph target weights (see Node::MorphWeightsOffset), unless pMorphWeights is null.
+// If pDirtyFlags is not null, the nodes whose values have changed are marked dirty.
+static void ApplyAnimationChannels(const Animation&                      animation,
+                                   float                                 time,
+                                   ModelTransforms::AnimationTransforms& NodeAnims,
+                                   std::vector<Uint32>&                  KeyFrameCursors,
+                                   float*                                pMorphWeights,
+                                   Uint8*                                pDirtyFlags)
+{
+    // The cursors are only hints, so they may be shared by different animations
+    if (KeyFrameCursors.size() < animation.Samplers.size())
+        KeyFrameCursors.resize(animation.Samplers.size(), 0);
+
+    const bool IsBaked = animation.IsBaked();
+    if (IsBaked)
+        ApplyBakedAnimationChannels(animation, time, NodeAnims, pDirtyFlags);
+
+    for (const AnimationChannel& channel : animation.Channels)
+    {
+        const AnimationSampler& sampler = animation.Samplers[channel.SamplerIndex];
+
+        // Morph target weights are not baked and are always evaluated from the samplers
+        if (channel.PathType == AnimationChannel::PATH_TYPE::WEIGHTS)
+        {
+            const size_t NumWeights = GetNodeMorphWeightCount(*channel.pNode);
+            if (pMorphWeights != nullptr && NumWeights > 0)
+                SampleMorphWeights(sampler, time, KeyFrameCursors[channel.SamplerIndex], pMorphWeights + channel.pNode->MorphWeightsOffset, NumWeights);
+            continue;
+        }
+
+        if (IsBaked)
+            continue;
+
+        float4 Value;
+        if (SampleAnimation(sampler, channel.PathType, time, KeyFrameCursors[channel.SamplerIndex], Value))
+            SetChannelValue(channel, Value, NodeAnims, pDirtyFlags);
+    }
+}
+
+void Model::ComputeTransforms(Uint32           SceneIndex,
+                              ModelTransforms& Transforms,
+                              const float4x4&  RootTransform,
+                              Int32            AnimationIndex,
+                              float            Time) const
+{
+    if (SceneIndex >= Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+    const Scene& scene = Scenes[SceneIndex];
+
+    // Note that the matrices are indexed by the global node index,
+    // not the linear node index in the scene.
+    Transforms.NodeGlobalMatrices.resize(Nodes.size());
+    Transforms.NodeLocalMatrices.resize(Nodes.size());
+
+    // Update node animation
+    Transforms.MorphWeights = DefaultMorphWeights;
+    if (AnimationIndex >= 0)
+    {
+        Transforms.Skins.resize(SkinTransformsCount);
+        UpdateAnimation(SceneIndex, AnimationIndex, Time, Transforms);
+    }
+    else
+    {
+        Transforms.Skins.clear();
+        for (Uint32 NodeId : scene.HierarchyNodeIds)
+            Transforms.NodeLocalMatrices[NodeId] = Nodes[NodeId].ComputeLocalTransform();
+    }
+
+    ComputeGlobalTransforms(scene, Transforms, RootTransform);
+}
+
+void Model::ComputeGlobalTransforms(const Scene& scene, ModelTransforms& Transforms, const float4x4& RootTransform) const
+{
+    // Compute global transforms in a single pass: parents always precede their children
+    VERIFY(scene.HierarchyNodeIds.size() == scene.HierarchyParentIds.size(), "Scene hierarchy is not initialized");
+    const Uint32*   pNodeIds    = scene.HierarchyNodeIds.data();
+    const Int32*    pParentIds  = scene.HierarchyParentIds.data();
+    const float4x4* pLocalMats  = Transforms.NodeLocalMatrices.data();
+    float4x4*       pGlobalMats = Transforms.NodeGlobalMatrices.data();
+    for (size_t i = 0; i < scene.HierarchyNodeIds.size(); ++i)
+    {
+        const Uint32    NodeId    = pNodeIds[i];
+        const Int32     ParentId  = pParentIds[i];
+        const float4x4& ParentMat = ParentId >= 0 ? pGlobalMats[ParentId] : RootTransform;
+        MultiplyNodeTransforms(pLocalMats[NodeId], ParentMat, pGlobalMats[NodeId]);
+    }
+
+    // Update join matrices
+    if (!Transforms.Skins.empty())
+    {
+        for (const Node* pNode : scene.LinearNodes)
+        {
+            VERIFY_EXPR(pNode != nullptr);
+            if (pNode->pMesh != nullptr && pNode->pSkin != nullptr)
+                UpdateSkinTransforms(*pNode, Transforms);
+        }
+    }
+
+    UpdateInstanceTransforms(scene, Transforms);
+
+    // The incremental state is no longer valid
+    Transforms.NodeDirtyFlags.clear();
+}
+
+void Model::UpdateInstanceTransforms(const Scene& scene, ModelTransforms& Transforms, const Uint8* pDirtyFlags) const
+{
+    Transforms.InstanceMatrices.resize(scene.InstanceCount);
+    for (const InstanceGroup& Group : scene.InstanceGroups)
+    {
+        float4x4* pDst = Transforms.InstanceMatrices.data() + Group.FirstInstance;
+        for (Uint32 NodeId : Group.NodeIds)
+        {
+            const Node&     N            = Nodes[NodeId];
+            const float4x4& GlobalMatrix = Transforms.NodeGlobalMatrices[NodeId];
+            const size_t    NumInstances = std::max(N.InstanceMatrices.size(), size_t{1});
+            if (pDirtyFlags == nullptr || pDirtyFlags[NodeId] != ModelTransforms::NODE_DIRTY_FLAG_NONE)
+            {
+                if (N.InstanceMatrices.empty())
+                {
+                    *pDst = GlobalMatrix;
+                }
+                else
+                {
+                    for (size_t i = 0; i < NumInstances; ++i)
+                        pDst[i] = N.InstanceMatrices[i] * GlobalMatrix;
+                }
+            }
+            pDst += NumInstances;
+        }
+    }
+}
+
+void Model::ComputeTransforms(Uint32                          SceneIndex,
+                              const ModelTransformsBatchItem* pItems,
+                              size_t                          NumItems,
+                              IThreadPool*                    pThreadPool,
+                              size_t                          ItemsPerTask) const
+{
+    if (NumItems == 0)
+        return;
+
+    DEV_CHECK_ERR(pItems != nullptr, "pItems must not be null when NumItems is not zero");
+    if (SceneIndex >= Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+
+    const auto ProcessItems = [this, SceneIndex, pItems](size_t Start, size_t End) {
+        for (size_t i = Start; i < End; ++i)
+        {
+            const ModelTransformsBatchItem& Item = pItems[i];
+            VERIFY(Item.pTransforms != nullptr, "Transforms of batch item ", i, " are null");
+            ComputeTransforms(SceneIndex, *Item.pTransforms, Item.RootTransform, Item.AnimationIndex, Item.Time);
+        }
+    };
+
+    // Contiguous chunks keep the transforms of each task in separate memory ranges
+    ProcessChunksAsync(pThreadPool, NumItems, ItemsPerTask, ProcessItems);
+}
+
+static float4 ConjugateQuaternion(const float4& q)
+{
+    return float4{-q.x, -q.y, -q.z, q.w};
+}
+
+static float4 MultiplyQuaternions(const float4& a, const float4& b)
+{
+    return float4{
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+    };
+}
+
+void Model::ComputeTransforms(Uint32                SceneIndex,
+                              ModelTransforms&      Transforms,
+                              const AnimationLayer* pLayers,
+                              Uint32                NumLayers,
+                              const float4x4&       RootTransform) const
+{
+    if (SceneIndex >= Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+    DEV_CHECK_ERR(NumLayers == 0 || pLayers != nullptr, "pLayers must not be null when NumLayers is not zero");
+
+    const Scene& scene = Scenes[SceneIndex];
+
+    Transforms.NodeGlobalMatrices.resize(Nodes.size());
+    Transforms.NodeLocalMatrices.resize(Nodes.size());
+    Transforms.Skins.resize(SkinTransformsCount);
+
+    // The blended values are accumulated in NodeAnimations and MorphWeights
+    ModelTransforms::AnimationTransforms& NodeAnims    = Transforms.NodeAnimations;
+    ModelTransforms::AnimationTransforms& LayerAnims   = Transforms.LayerAnimations;
+    std::vector<float>&                   Weights      = Transforms.NodeBlendWeights;
+    std::vector<float>&                   MorphWeights = Transforms.MorphWeights;
+    std::vector<float>&                   LayerMorph   = Transforms.LayerMorphWeights;
+    NodeAnims.Resize(Nodes.size());
+    LayerAnims.Resize(Nodes.size());
+    Weights.resize(Nodes.size());
+    MorphWeights = DefaultMorphWeights;
+    for (Uint32 NodeId : scene.HierarchyNodeIds)
+    {
+        const Node& N = Nodes[NodeId];
+
+        NodeAnims.Translations[NodeId] = float3{0, 0, 0};
+        NodeAnims.Rotations[NodeId].q  = float4{0, 0, 0, 0};
+        NodeAnims.Scales[NodeId]       = float3{0, 0, 0};
+        Weights[NodeId]                = 0;
+        std::fill_n(MorphWeights.begin() + std::max(N.MorphWeightsOffset, 0), GetNodeMorphWeightCount(N), 0.f);
+    }
+
+    // Writes the node values of the layer to LayerAnims and LayerMorph
+    const auto EvaluateLayer = [&](const AnimationLayer& Layer) {
+        for (Uint32 NodeId : scene.HierarchyNodeIds)
+        {
+            const Node& N = Nodes[NodeId];
+
+            LayerAnims.Translations[NodeId] = N.Translation;
+            LayerAnims.Rotations[NodeId]    = N.Rotation;
+            LayerAnims.Scales[NodeId]       = N.Scale;
+        }
+        LayerMorph = DefaultMorphWeights;
+
+        if (Layer.AnimationIndex >= 0)
+        {
+            if (static_cast<size_t>(Layer.AnimationIndex) < Animations.size())
+            {
+                const Animation& animation = Animations[Layer.AnimationIndex];
+                ApplyAnimationChannels(animation, clamp(Layer.Time, animation.Start, animation.End), LayerAnims, Transforms.KeyFrameCursors, LayerMorph.data(), nullptr);
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("No animation with index ", Layer.AnimationIndex);
             }
+        }
+    };
+
+    // Blend the regular layers
+    for (Uint32 l = 0; l < NumLayers; ++l)
+    {
+        const AnimationLayer& Layer = pLayers[l];
+        if (Layer.Additive || Layer.Weight <= 0)
+            continue;
+
+        EvaluateLayer(Layer);
+        for (Uint32 NodeId : scene.HierarchyNodeIds)
+        {
+            const float w = Layer.pNodeWeights != nullptr ? Layer.Weight * Layer.pNodeWeights[NodeId] : Layer.Weight;
+            if (w <= 0)
+                continue;
+
+            // Use the hemisphere of the accumulated rotation
+            float4&       Rotation = NodeAnims.Rotations[NodeId].q;
+            const float4& q        = LayerAnims.Rotations[NodeId].q;
+
+            NodeAnims.Translations[NodeId] += LayerAnims.Translations[NodeId] * w;
+            NodeAnims.Scales[NodeId] += LayerAnims.Scales[NodeId] * w;
+            Rotation += dot(Rotation, q) < 0 ? q * -w : q * w;
+            Weights[NodeId] += w;
+
+            const Node& N = Nodes[NodeId];
+            for (size_t i = 0, Offset = std::max(N.MorphWeightsOffset, 0); i < GetNodeMorphWeightCount(N); ++i)
+                MorphWeights[Offset + i] += LayerMorph[Offset + i] * w;
+        }
+    }
+
+    // The rest pose takes the remaining weight up to one
+    for (Uint32 NodeId : scene.HierarchyNodeIds)
+    {
+        const Node& N = Nodes[NodeId];
+
+        const size_t NumMorphWeights = GetNodeMorphWeightCount(N);
+        const size_t MorphOffset     = std::max(N.MorphWeightsOffset, 0);
+
+        float4&     Rotation = NodeAnims.Rotations[NodeId].q;
+        const float RestW    = std::max(1.f - Weights[NodeId], 0.f);
+        if (RestW > 0)
+        {
+            NodeAnims.Translations[NodeId] += N.Translation * RestW;
+            NodeAnims.Scales[NodeId] += N.Scale * RestW;
+            Rotation += dot(Rotation, N.Rotation.q) < 0 ? N.Rotation.q * -RestW : N.Rotation.q * RestW;
+            Weights[NodeId] += RestW;
+            for (size_t i = 0; i < NumMorphWeights; ++i)
+                MorphWeights[MorphOffset + i] += DefaultMorphWeights[MorphOffset + i] * RestW;
+        }
+
+        const float InvW = 1.f / Weights[NodeId];
+        NodeAnims.Translations[NodeId] *= InvW;
+        NodeAnims.Scales[NodeId] *= InvW;
+        Rotation = normalize(Rotation);
+        for (size_t i = 0; i < NumMorphWeights; ++i)
+            MorphWeights[MorphOffset + i] *= InvW;
+    }
+
+    // Apply the differences between the additive layers and the rest pose
+    for (Uint32 l = 0; l < NumLayers; ++l)
+    {
+        const AnimationLayer& Layer = pLayers[l];
+        if (!Layer.Additive || Layer.Weight <= 0)
+            continue;
+
+        EvaluateLayer(Layer);
+        for (Uint32 NodeId : scene.HierarchyNodeIds)
+        {
+            const float w = Layer.pNodeWeights != nullptr ? Layer.Weight * Layer.pNodeWeights[NodeId] : Layer.Weight;
+            if (w <= 0)
+                continue;
 
-            case AnimationChannel::PATH_TYPE::WEIGHTS:
+            const Node& N = Nodes[NodeId];
+
+            NodeAnims.Translations[NodeId] += (LayerAnims.Translations[NodeId] - N.Translation) * w;
+
+            const float3& LayerScale = LayerAnims.Scales[NodeId];
+            float3&       Scale      = NodeAnims.Scales[NodeId];
+            for (Uint32 c = 0; c < 3; ++c)
             {
-                UNEXPECTED("Weights are not currently supported");
-                break;
+                if (N.Scale[c] != 0)
+                    Scale[c] *= lerp(1.f, LayerScale[c] / N.Scale[c], w);
             }
+
+            // Delta rotation relative to the rest pose, scaled by the weight along the shortest path
+            float4 Delta = MultiplyQuaternions(ConjugateQuaternion(N.Rotation.q), LayerAnims.Rotations[NodeId].q);
+            if (Delta.w < 0)
+                Delta = Delta * -1.f;
+            Delta = normalize(lerp(float4{0, 0, 0, 1}, Delta, w));
+
+            float4& Rotation = NodeAnims.Rotations[NodeId].q;
+            Rotation         = normalize(MultiplyQuaternions(Rotation, Delta));
+
+            for (size_t i = 0, Offset = std::max(N.MorphWeightsOffset, 0); i < GetNodeMorphWeightCount(N); ++i)
+                MorphWeights[Offset + i] += (LayerMorph[Offset + i] - DefaultMorphWeights[Offset + i]) * w;
         }
     }
 
-    for (const Node* pN : scene.LinearNodes)
+    for (Uint32 NodeId : scene.HierarchyNodeIds)
+    {
+        Transforms.NodeLocalMatrices[NodeId] =
+            ComputeNodeLocalMatrix(NodeAnims.Scales[NodeId], NodeAnims.Rotations[NodeId], NodeAnims.Translations[NodeId], Nodes[NodeId].Matrix);
+    }
+
+    ComputeGlobalTransforms(scene, Transforms, RootTransform);
+}
+
+// Returns the inverse of the global matrix of the skinned node. The inverse is cached in the
+// skin transforms of the node, if they are allocated, and only recomputed when the matrix changes.
+static const float4x4& GetNodeGlobalInverse(const Node& SkinnedNode, ModelTransforms& Transforms, float4x4& Scratch)
+{
+    const float4x4& NodeGlobalMat = Transforms.NodeGlobalMatrices[SkinnedNode.Index];
+    if (SkinnedNode.SkinTransformsIndex < 0 || static_cast<size_t>(SkinnedNode.SkinTransformsIndex) >= Transforms.Skins.size())
     {
-        VERIFY_EXPR(pN != nullptr);
-        const ModelTransforms::AnimationTransforms& A = Transforms.NodeAnimations[pN->Index];
+        Scratch = NodeGlobalMat.Inverse();
+        return Scratch;
+    }
 
-        Transforms.NodeLocalMatrices[pN->Index] = ComputeNodeLocalMatrix(A.Scale, A.Rotation, A.Translation, pN->Matrix);
+    ModelTransforms::SkinTransforms& SkinTransforms = Transforms.Skins[SkinnedNode.SkinTransformsIndex];
+    if (SkinTransforms.NodeGlobalMatrix != NodeGlobalMat)
+    {
+        SkinTransforms.NodeGlobalMatrix  = NodeGlobalMat;
+        SkinTransforms.NodeGlobalInverse = NodeGlobalMat.Inverse();
+    }
+    return SkinTransforms.NodeGlobalInverse;
+}
+
+// Computes the matrix of the skin joint relative to the skinned node.
+static float4x4 ComputeJointMatrix(const Skin& skin, size_t Joint, const ModelTransforms& Transforms, const float4x4& NodeGlobalInverse)
+{
+    const float4x4& JointNodeGlobalMat = Transforms.NodeGlobalMatrices[skin.Joints[Joint]->Index];
+    return Joint < skin.InverseBindMatrices.size() ?
+        skin.InverseBindMatrices[Joint] * JointNodeGlobalMat * NodeGlobalInverse :
+        JointNodeGlobalMat * NodeGlobalInverse;
+}
+
+void Model::UpdateSkinTransforms(const Node& SkinnedNode, ModelTransforms& Transforms) const
+{
+    const Skin* pSkin = SkinnedNode.pSkin;
+    VERIFY_EXPR(pSkin != nullptr);
+
+    VERIFY(SkinnedNode.SkinTransformsIndex < static_cast<int>(SkinTransformsCount),
+           "Skin transform index (", SkinnedNode.SkinTransformsIndex, ") exceeds the skin transform count in this mesh (", SkinTransformsCount,
+           "). This appears to be a bug.");
+
+    float4x4        Scratch;
+    const float4x4& InverseTransform = GetNodeGlobalInverse(SkinnedNode, Transforms, Scratch);
+
+    std::vector<float4x4>& JointMatrices = Transforms.Skins[SkinnedNode.SkinTransformsIndex].JointMatrices;
+    if (JointMatrices.size() != pSkin->Joints.size())
+        JointMatrices.resize(pSkin->Joints.size());
+
+    for (size_t i = 0; i < pSkin->Joints.size(); i++)
+        JointMatrices[i] = ComputeJointMatrix(*pSkin, i, Transforms, InverseTransform);
+}
+
+// Converts the joint matrix to a unit dual quaternion. The scale of the matrix is discarded.
+static void JointMatrixToDualQuaternion(const float4x4& Mat, float4& Real, float4& Dual)
+{
+    // Remove the scale from the rotation rows
+    float3 Rows[3];
+    for (int r = 0; r < 3; ++r)
+    {
+        Rows[r]         = float3{Mat.m[r][0], Mat.m[r][1], Mat.m[r][2]};
+        const float Len = length(Rows[r]);
+        if (Len > 0)
+            Rows[r] /= Len;
+    }
+
+    // The matrix transforms row vectors, so it is the transpose of the rotation matrix
+    // of the quaternion in the column vector convention.
+    const float Trace = Rows[0].x + Rows[1].y + Rows[2].z;
+    if (Trace > 0)
+    {
+        const float S = std::sqrt(Trace + 1.f) * 2.f;
+        Real          = float4{(Rows[1].z - Rows[2].y) / S, (Rows[2].x - Rows[0].z) / S, (Rows[0].y - Rows[1].x) / S, 0.25f * S};
+    }
+    else if (Rows[0].x > Rows[1].y && Rows[0].x > Rows[2].z)
+    {
+        const float S = std::sqrt(1.f + Rows[0].x - Rows[1].y - Rows[2].z) * 2.f;
+        Real          = float4{0.25f * S, (Rows[1].x + Rows[0].y) / S, (Rows[2].x + Rows[0].z) / S, (Rows[1].z - Rows[2].y) / S};
+    }
+    else if (Rows[1].y > Rows[2].z)
+    {
+        const float S = std::sqrt(1.f + Rows[1].y - Rows[0].x - Rows[2].z) * 2.f;
+        Real          = float4{(Rows[1].x + Rows[0].y) / S, 0.25f * S, (Rows[2].y + Rows[1].z) / S, (Rows[2].x - Rows[0].z) / S};
+    }
+    else
+    {
+        const float S = std::sqrt(1.f + Rows[2].z - Rows[0].x - Rows[1].y) * 2.f;
+        Real          = float4{(Rows[2].x + Rows[0].z) / S, (Rows[2].y + Rows[1].z) / S, 0.25f * S, (Rows[0].y - Rows[1].x) / S};
+    }
+    Real = normalize(Real);
+
+    // Dual part: 0.5 * t * q
+    const float4 Translation{Mat.m[3][0], Mat.m[3][1], Mat.m[3][2], 0};
+    Dual = MultiplyQuaternions(Translation, Real) * 0.5f;
+}
+
+void Model::WriteJointTransforms(const Node&            SkinnedNode,
+                                 ModelTransforms&       Transforms,
+                                 JOINT_TRANSFORM_FORMAT Format,
+                                 void*                  pDst,
+                                 size_t                 Stride) const
+{
+    const Skin* pSkin = SkinnedNode.pSkin;
+    if (pSkin == nullptr)
+    {
+        DEV_ERROR("Node '", SkinnedNode.Name, "' has no skin");
+        return;
+    }
+    DEV_CHECK_ERR(pDst != nullptr, "Destination buffer must not be null");
+    DEV_CHECK_ERR(Transforms.NodeGlobalMatrices.size() == Nodes.size(), "Node transforms have not been computed");
+
+    const size_t TransformSize = GetJointTransformSize(Format);
+    if (Stride == 0)
+        Stride = TransformSize;
+    DEV_CHECK_ERR(Stride >= TransformSize, "Stride (", Stride, ") is smaller than the joint transform size (", TransformSize, ")");
+
+    float4x4        Scratch;
+    const float4x4& InverseTransform = GetNodeGlobalInverse(SkinnedNode, Transforms, Scratch);
+
+    Uint8* pDstBytes = static_cast<Uint8*>(pDst);
+    for (size_t i = 0; i < pSkin->Joints.size(); ++i, pDstBytes += Stride)
+    {
+        const float4x4 JointMat = ComputeJointMatrix(*pSkin, i, Transforms, InverseTransform);
+        switch (Format)
+        {
+            case JOINT_TRANSFORM_FORMAT_FLOAT4X4:
+                memcpy(pDstBytes, JointMat.m, sizeof(float) * 16);
+                break;
+
+            case JOINT_TRANSFORM_FORMAT_FLOAT3X4:
+            {
+                // The last column of the affine matrix is always (0, 0, 0, 1)
+                float Rows[3][4];
+                for (int r = 0; r < 3; ++r)
+                {
+                    for (int c = 0; c < 4; ++c)
+                        Rows[r][c] = JointMat.m[c][r];
+                }
+                memcpy(pDstBytes, Rows, sizeof(Rows));
+                break;
+            }
+
+            case JOINT_TRANSFORM_FORMAT_DUAL_QUATERNION:
+            {
+                float4 DualQuat[2];
+                JointMatrixToDualQuaternion(JointMat, DualQuat[0], DualQuat[1]);
+                memcpy(pDstBytes, DualQuat, sizeof(DualQuat));
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected joint transform format");
+                return;
+        }
+    }
+}
+
+void Model::UpdateTransforms(Uint32           SceneIndex,
+                             ModelTransforms& Transforms,
+                             const float4x4&  RootTransform,
+                             Int32            AnimationIndex,
+                             float            Time) const
+{
+    if (SceneIndex >= Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+    const Scene& scene = Scenes[SceneIndex];
+
+    Transforms.ChangedNodes.clear();
+    Transforms.ChangedSkins.clear();
+
+    const bool FullUpdate =
+        !CompatibleWithTransforms(Transforms) ||
+        Transforms.NodeDirtyFlags.size() != Nodes.size() ||
+        Transforms.UpdateSceneIndex != static_cast<Int32>(SceneIndex) ||
+        Transforms.UpdateAnimationIndex != AnimationIndex ||
+        Transforms.UpdateRootTransform != RootTransform;
+    if (FullUpdate)
+    {
+        ComputeTransforms(SceneIndex, Transforms, RootTransform, AnimationIndex, Time);
+
+        // Node animation transforms hold the current transforms of all nodes that can be edited
+        if (AnimationIndex < 0 || static_cast<size_t>(AnimationIndex) >= Animations.size())
+        {
+            ModelTransforms::AnimationTransforms& NodeAnims = Transforms.NodeAnimations;
+            NodeAnims.Resize(Nodes.size());
+            for (Uint32 NodeId : scene.HierarchyNodeIds)
+            {
+                const Node& N = Nodes[NodeId];
+
+                NodeAnims.Translations[NodeId] = N.Translation;
+                NodeAnims.Rotations[NodeId]    = N.Rotation;
+                NodeAnims.Scales[NodeId]       = N.Scale;
+            }
+        }
+
+        Transforms.NodeDirtyFlags.assign(Nodes.size(), ModelTransforms::NODE_DIRTY_FLAG_NONE);
+        Transforms.UpdateSceneIndex     = static_cast<Int32>(SceneIndex);
+        Transforms.UpdateAnimationIndex = AnimationIndex;
+        Transforms.UpdateRootTransform  = RootTransform;
+
+        Transforms.ChangedNodes = scene.HierarchyNodeIds;
+        Transforms.ChangedSkins.resize(Transforms.Skins.size());
+        std::iota(Transforms.ChangedSkins.begin(), Transforms.ChangedSkins.end(), 0u);
+        return;
+    }
+
+    Uint8* pDirtyFlags = Transforms.NodeDirtyFlags.data();
+    if (AnimationIndex >= 0 && static_cast<size_t>(AnimationIndex) < Animations.size())
+    {
+        const Animation& animation = Animations[AnimationIndex];
+        float*           pMorphWeights = Transforms.MorphWeights.size() == DefaultMorphWeights.size() ? Transforms.MorphWeights.data() : nullptr;
+        ApplyAnimationChannels(animation, clamp(Time, animation.Start, animation.End), Transforms.NodeAnimations, Transforms.KeyFrameCursors, pMorphWeights, pDirtyFlags);
+    }
+
+    // Propagate the changes down the hierarchy: parents always precede their children
+    const ModelTransforms::AnimationTransforms& NodeAnims = Transforms.NodeAnimations;
+    for (size_t i = 0; i < scene.HierarchyNodeIds.size(); ++i)
+    {
+        const Uint32 NodeId   = scene.HierarchyNodeIds[i];
+        const Int32  ParentId = scene.HierarchyParentIds[i];
+
+        Uint8& Flags = pDirtyFlags[NodeId];
+        if (ParentId >= 0 && (pDirtyFlags[ParentId] & ModelTransforms::NODE_DIRTY_FLAG_GLOBAL) != 0)
+            Flags |= ModelTransforms::NODE_DIRTY_FLAG_GLOBAL;
+        if (Flags == ModelTransforms::NODE_DIRTY_FLAG_NONE)
+            continue;
+
+        if (Flags & ModelTransforms::NODE_DIRTY_FLAG_LOCAL)
+        {
+            Transforms.NodeLocalMatrices[NodeId] =
+                ComputeNodeLocalMatrix(NodeAnims.Scales[NodeId], NodeAnims.Rotations[NodeId], NodeAnims.Translations[NodeId], Nodes[NodeId].Matrix);
+        }
+
+        const float4x4& ParentMat = ParentId >= 0 ? Transforms.NodeGlobalMatrices[ParentId] : RootTransform;
+        MultiplyNodeTransforms(Transforms.NodeLocalMatrices[NodeId], ParentMat, Transforms.NodeGlobalMatrices[NodeId]);
+
+        Flags = ModelTransforms::NODE_DIRTY_FLAG_GLOBAL;
+        Transforms.ChangedNodes.push_back(NodeId);
+    }
+
+    // Update the skins whose node or joints have changed
+    if (!Transforms.Skins.empty() && !Transforms.ChangedNodes.empty() && scene.SkinDependencyOffsets.size() == Nodes.size() + 1)
+    {
+        const Uint32* pOffsets = scene.SkinDependencyOffsets.data();
+        for (Uint32 NodeId : Transforms.ChangedNodes)
+        {
+            for (Uint32 i = pOffsets[NodeId]; i < pOffsets[NodeId + 1]; ++i)
+            {
+                const Uint32 SkinnedNodeId = scene.SkinDependencies[i];
+                if (pDirtyFlags[SkinnedNodeId] & ModelTransforms::NODE_DIRTY_FLAG_SKIN)
+                    continue;
+                pDirtyFlags[SkinnedNodeId] |= ModelTransforms::NODE_DIRTY_FLAG_SKIN;
+
+                const Node& SkinnedNode = Nodes[SkinnedNodeId];
+                UpdateSkinTransforms(SkinnedNode, Transforms);
+                Transforms.ChangedSkins.push_back(static_cast<Uint32>(SkinnedNode.SkinTransformsIndex));
+            }
+        }
+
+        for (Uint32 NodeId : Transforms.ChangedNodes)
+        {
+            for (Uint32 i = pOffsets[NodeId]; i < pOffsets[NodeId + 1]; ++i)
+                pDirtyFlags[scene.SkinDependencies[i]] &= static_cast<Uint8>(~ModelTransforms::NODE_DIRTY_FLAG_SKIN);
+        }
+    }
+
+    // Update the instance matrices of the changed nodes
+    if (!scene.InstanceGroups.empty() && !Transforms.ChangedNodes.empty())
+        UpdateInstanceTransforms(scene, Transforms, pDirtyFlags);
+
+    for (Uint32 NodeId : Transforms.ChangedNodes)
+        pDirtyFlags[NodeId] = ModelTransforms::NODE_DIRTY_FLAG_NONE;
+}
+
+bool Model::CompatibleWithTransforms(const ModelTransforms& Transforms) const
+{
+    return (Transforms.NodeLocalMatrices.size() == Nodes.size() &&
+            Transforms.NodeGlobalMatrices.size() == Nodes.size());
+}
+
+void Model::ApplyMorphTargets(const Primitive& Prim,
+                              const float*     pWeights,
+                              float3*          pPositions,
+                              float3*          pNormals,
+                              float3*          pTangents) const
+{
+    if (Prim.MorphTargetCount == 0)
+        return;
+
+    DEV_CHECK_ERR(pWeights != nullptr, "Morph target weights must not be null");
+    VERIFY(Prim.FirstMorphTarget + Prim.MorphTargetCount <= MorphTargets.Targets.size(), "Morph target range is out of bounds. This appears to be a bug.");
+
+    float3* const pAttribs[MorphTargetData::ATTRIBUTE_COUNT] = {pPositions, pNormals, pTangents};
+    for (Uint32 t = 0; t < Prim.MorphTargetCount; ++t)
+    {
+        const float Weight = pWeights[t];
+        if (Weight == 0)
+            continue;
+
+        const MorphTargetData::Target& Target = MorphTargets.Targets[Prim.FirstMorphTarget + t];
+        for (Uint32 attrib = 0; attrib < MorphTargetData::ATTRIBUTE_COUNT; ++attrib)
+        {
+            float3* pDst = pAttribs[attrib];
+            if (pDst == nullptr)
+                continue;
+
+            const Uint32* pVertexIds = MorphTargets.VertexIds.data() + Target.FirstDelta[attrib];
+            const float3* pDeltas    = MorphTargets.Deltas.data() + Target.FirstDelta[attrib];
+            for (Uint32 d = 0; d < Target.DeltaCount[attrib]; ++d)
+            {
+                VERIFY_EXPR(pVertexIds[d] < Prim.VertexCount);
+                pDst[pVertexIds[d]] += pDeltas[d] * Weight;
+            }
+        }
+    }
+}
+
+template <typename T>
+static T LoadVertexValue(const Uint8* pData, Uint32 Index)
+{
+    T Value{};
+    std::memcpy(&Value, pData + size_t{Index} * sizeof(T), sizeof(T));
+    return Value;
+}
+
+// Reads a component of the vertex attribute as float. Integer components are mapped
+// to [0, 1] or [-1, 1] when Normalized is true.
+static float LoadVertexComponent(const Uint8* pData, VALUE_TYPE ValueType, Uint32 Index, bool Normalized)
+{
+    switch (ValueType)
+    {
+        // clang-format off
+        case VT_FLOAT32: return LoadVertexValue<float>(pData, Index);
+        case VT_UINT32:  return static_cast<float>(LoadVertexValue<Uint32>(pData, Index));
+        case VT_UINT8:   return static_cast<float>(pData[Index]) / (Normalized ? 255.f : 1.f);
+        case VT_UINT16:  return static_cast<float>(LoadVertexValue<Uint16>(pData, Index)) / (Normalized ? 65535.f : 1.f);
+        case VT_INT8:    return Normalized ? std::max(static_cast<float>(LoadVertexValue<Int8>(pData, Index)), -127.f) / 127.f : static_cast<float>(LoadVertexValue<Int8>(pData, Index));
+        case VT_INT16:   return Normalized ? std::max(static_cast<float>(LoadVertexValue<Int16>(pData, Index)), -32767.f) / 32767.f : static_cast<float>(LoadVertexValue<Int16>(pData, Index));
+        // clang-format on
+        default:
+            UNEXPECTED("Unsupported value type");
+            return 0;
+    }
+}
+
+static bool IsSkinningValueTypeSupported(VALUE_TYPE ValueType)
+{
+    return (ValueType == VT_FLOAT32 ||
+            ValueType == VT_UINT32 ||
+            ValueType == VT_UINT16 ||
+            ValueType == VT_INT16 ||
+            ValueType == VT_UINT8 ||
+            ValueType == VT_INT8);
+}
+
+// Blends the joint matrices with the weights and transforms the position and the normal.
+// Rows with zero weights are skipped, so every joint index must be valid when its weight is not zero.
+static inline void SkinVertex(const float4x4* pJointMatrices,
+                              const Uint32    Joints[4],
+                              const float     Weights[4],
+                              const float3&   Pos,
+                              const float3&   Normal,
+                              float3&         DstPos,
+                              float3*         pDstNormal)
+{
+#if defined(GLTF_LOADER_SSE2) || defined(GLTF_LOADER_NEON)
+#    if defined(GLTF_LOADER_SSE2)
+    using Float4     = __m128;
+    const auto Zero  = []() { return _mm_setzero_ps(); };
+    const auto Load  = [](const float* p) { return _mm_loadu_ps(p); };
+    const auto MAdd  = [](Float4 a, Float4 b, float s) { return _mm_add_ps(a, _mm_mul_ps(b, _mm_set1_ps(s))); };
+    const auto Store = [](float* p, Float4 v) { _mm_storeu_ps(p, v); };
+#    else
+    using Float4     = float32x4_t;
+    const auto Zero  = []() { return vdupq_n_f32(0); };
+    const auto Load  = [](const float* p) { return vld1q_f32(p); };
+    const auto MAdd  = [](Float4 a, Float4 b, float s) { return vaddq_f32(a, vmulq_n_f32(b, s)); };
+    const auto Store = [](float* p, Float4 v) { vst1q_f32(p, v); };
+#    endif
+    Float4 Row0 = Zero();
+    Float4 Row1 = Zero();
+    Float4 Row2 = Zero();
+    Float4 Row3 = Zero();
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        if (Weights[i] == 0)
+            continue;
+
+        const float4x4& JointMat = pJointMatrices[Joints[i]];
+
+        Row0 = MAdd(Row0, Load(JointMat.m[0]), Weights[i]);
+        Row1 = MAdd(Row1, Load(JointMat.m[1]), Weights[i]);
+        Row2 = MAdd(Row2, Load(JointMat.m[2]), Weights[i]);
+        Row3 = MAdd(Row3, Load(JointMat.m[3]), Weights[i]);
+    }
+
+    float Res[4];
+    Store(Res, MAdd(MAdd(MAdd(Row3, Row0, Pos.x), Row1, Pos.y), Row2, Pos.z));
+    DstPos = float3{Res[0], Res[1], Res[2]};
+    if (pDstNormal != nullptr)
+    {
+        Store(Res, MAdd(MAdd(MAdd(Zero(), Row0, Normal.x), Row1, Normal.y), Row2, Normal.z));
+        *pDstNormal = float3{Res[0], Res[1], Res[2]};
+    }
+#else
+    float4x4 SkinMat{0};
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        if (Weights[i] == 0)
+            continue;
+
+        const float4x4& JointMat = pJointMatrices[Joints[i]];
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                SkinMat.m[r][c] += JointMat.m[r][c] * Weights[i];
+        }
+    }
+
+    DstPos = float3{
+        Pos.x * SkinMat.m[0][0] + Pos.y * SkinMat.m[1][0] + Pos.z * SkinMat.m[2][0] + SkinMat.m[3][0],
+        Pos.x * SkinMat.m[0][1] + Pos.y * SkinMat.m[1][1] + Pos.z * SkinMat.m[2][1] + SkinMat.m[3][1],
+        Pos.x * SkinMat.m[0][2] + Pos.y * SkinMat.m[1][2] + Pos.z * SkinMat.m[2][2] + SkinMat.m[3][2],
+    };
+    if (pDstNormal != nullptr)
+    {
+        *pDstNormal = float3{
+            Normal.x * SkinMat.m[0][0] + Normal.y * SkinMat.m[1][0] + Normal.z * SkinMat.m[2][0],
+            Normal.x * SkinMat.m[0][1] + Normal.y * SkinMat.m[1][1] + Normal.z * SkinMat.m[2][1],
+            Normal.x * SkinMat.m[0][2] + Normal.y * SkinMat.m[1][2] + Normal.z * SkinMat.m[2][2],
+        };
+    }
+#endif
+
+    if (pDstNormal != nullptr)
+    {
+        const float Len = length(*pDstNormal);
+        if (Len > 0)
+            *pDstNormal /= Len;
+    }
+}
+
+bool Model::SkinVertices(const Node&            SkinnedNode,
+                         const Primitive&       Prim,
+                         const ModelTransforms& Transforms,
+                         float3*                pPositions,
+                         float3*                pNormals,
+                         IThreadPool*           pThreadPool) const
+{
+    DEV_CHECK_ERR(pPositions != nullptr, "pPositions must not be null");
+    if (CPUVertexData.empty())
+    {
+        DEV_ERROR("CPU vertex data is not available. Load the model with ModelCreateInfo::KeepCPUVertexData.");
+        return false;
+    }
+    if (SkinnedNode.SkinTransformsIndex < 0 || static_cast<size_t>(SkinnedNode.SkinTransformsIndex) >= Transforms.Skins.size())
+    {
+        DEV_ERROR("Node '", SkinnedNode.Name, "' has no skin transforms");
+        return false;
+    }
+
+    const std::vector<float4x4>& JointMatrices = Transforms.Skins[SkinnedNode.SkinTransformsIndex].JointMatrices;
+    if (Prim.VertexCount == 0)
+        return true;
+
+    const auto FindAttrib = [this, &Prim](const char* Name) -> const VertexAttributeDesc* {
+        for (Uint32 i = 0; i < GetNumVertexAttributes(); ++i)
+        {
+            const VertexAttributeDesc& Attrib = VertexAttributes[i];
+            if (!IsVertexAttributeEnabled(i) || strcmp(Attrib.Name, Name) != 0)
+                continue;
+
+            const Uint32 Stride = VertexData.Strides[Attrib.BufferId];
+            if (Attrib.BufferId >= CPUVertexData.size() ||
+                CPUVertexData[Attrib.BufferId].size() < (size_t{Prim.VertexRangeStart} + Prim.VertexCount) * Stride)
+                return nullptr;
+            return &Attrib;
+        }
+        return nullptr;
+    };
+
+    const VertexAttributeDesc* pPosAttrib     = FindAttrib(PositionAttributeName);
+    const VertexAttributeDesc* pNormalAttrib  = pNormals != nullptr ? FindAttrib(NormalAttributeName) : nullptr;
+    const VertexAttributeDesc* pJointsAttrib  = FindAttrib(JointsAttributeName);
+    const VertexAttributeDesc* pWeightsAttrib = FindAttrib(WeightsAttributeName);
+    if (pPosAttrib == nullptr || pJointsAttrib == nullptr || pWeightsAttrib == nullptr || (pNormals != nullptr && pNormalAttrib == nullptr))
+        return false;
+
+    // Positions are either plain or quantized relative to the primitive bounding box (see MeshLoader::ReadPositions)
+    const bool PositionsSupported =
+        IsSkinningValueTypeSupported(pPosAttrib->ValueType) &&
+        ((pPosAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_NONE && pPosAttrib->NumComponents >= 3) ||
+         (pPosAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED && (pPosAttrib->ValueType == VT_UINT8 || pPosAttrib->ValueType == VT_UINT16)));
+    const bool NormalsSupported =
+        pNormalAttrib == nullptr ||
+        (IsSkinningValueTypeSupported(pNormalAttrib->ValueType) &&
+         ((pNormalAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_NONE && pNormalAttrib->NumComponents >= 3) ||
+          (pNormalAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL && pNormalAttrib->NumComponents >= 2)));
+    if (!PositionsSupported || !NormalsSupported ||
+        !IsSkinningValueTypeSupported(pJointsAttrib->ValueType) ||
+        !IsSkinningValueTypeSupported(pWeightsAttrib->ValueType))
+        return false;
+
+    const auto GetAttribData = [this, &Prim](const VertexAttributeDesc& Attrib) {
+        return CPUVertexData[Attrib.BufferId].data() + size_t{Prim.VertexRangeStart} * VertexData.Strides[Attrib.BufferId] + Attrib.RelativeOffset;
+    };
+
+    float3 PosScale{1, 1, 1};
+    float3 PosBias{0, 0, 0};
+    if (pPosAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED)
+    {
+        PosScale = (Prim.BB.Max - Prim.BB.Min) / (pPosAttrib->ValueType == VT_UINT8 ? 255.f : 65535.f);
+        PosBias  = Prim.BB.Min;
+    }
+
+    const auto SkinRange = [&](Uint32 Start, Uint32 End) {
+        const Uint32 NumJointComponents  = std::min<Uint32>(pJointsAttrib->NumComponents, 4);
+        const Uint32 NumWeightComponents = std::min<Uint32>(pWeightsAttrib->NumComponents, 4);
+        // Integer weights are always normalized, while joint indices never are
+        const bool NormalizedWeights = pWeightsAttrib->ValueType != VT_FLOAT32;
+
+        for (Uint32 v = Start; v < End; ++v)
+        {
+            const Uint8* pPos = GetAttribData(*pPosAttrib) + size_t{v} * VertexData.Strides[pPosAttrib->BufferId];
+
+            float3 Pos;
+            for (Uint32 c = 0; c < 3; ++c)
+                Pos[c] = PosBias[c] + LoadVertexComponent(pPos, pPosAttrib->ValueType, c, false) * PosScale[c];
+
+            float3 Normal;
+            if (pNormalAttrib != nullptr)
+            {
+                const Uint8* pNormal = GetAttribData(*pNormalAttrib) + size_t{v} * VertexData.Strides[pNormalAttrib->BufferId];
+                if (pNormalAttrib->Encoding == VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL)
+                {
+                    // Inverse of the octahedral mapping (see VertexDataConverter)
+                    Normal.x = LoadVertexComponent(pNormal, pNormalAttrib->ValueType, 0, true);
+                    Normal.y = LoadVertexComponent(pNormal, pNormalAttrib->ValueType, 1, true);
+                    Normal.z = 1.f - std::abs(Normal.x) - std::abs(Normal.y);
+
+                    const float t = std::max(-Normal.z, 0.f);
+                    Normal.x += Normal.x >= 0 ? -t : t;
+                    Normal.y += Normal.y >= 0 ? -t : t;
+                }
+                else
+                {
+                    for (Uint32 c = 0; c < 3; ++c)
+                        Normal[c] = LoadVertexComponent(pNormal, pNormalAttrib->ValueType, c, true);
+                }
+            }
+
+            const Uint8* pJoints  = GetAttribData(*pJointsAttrib) + size_t{v} * VertexData.Strides[pJointsAttrib->BufferId];
+            const Uint8* pWeights = GetAttribData(*pWeightsAttrib) + size_t{v} * VertexData.Strides[pWeightsAttrib->BufferId];
+
+            Uint32 Joints[4]  = {};
+            float  Weights[4] = {};
+            for (Uint32 i = 0; i < std::min(NumJointComponents, NumWeightComponents); ++i)
+            {
+                Joints[i]  = static_cast<Uint32>(LoadVertexComponent(pJoints, pJointsAttrib->ValueType, i, false));
+                Weights[i] = LoadVertexComponent(pWeights, pWeightsAttrib->ValueType, i, NormalizedWeights);
+                if (Joints[i] >= JointMatrices.size())
+                    Weights[i] = 0;
+            }
+
+            SkinVertex(JointMatrices.data(), Joints, Weights, Pos, Normal, pPositions[v], pNormals != nullptr ? &pNormals[v] : nullptr);
+        }
+    };
+
+    constexpr size_t VerticesPerTask = 1024;
+    ProcessChunksAsync(pThreadPool, Prim.VertexCount, VerticesPerTask,
+                       [&SkinRange](size_t Start, size_t End) {
+                           SkinRange(static_cast<Uint32>(Start), static_cast<Uint32>(End));
+                       });
+    return true;
+}
+
+struct RayCastMeshNode
+{
+    const Node* pNode         = nullptr;
+    Uint32      InstanceIndex = 0;
+    float4x4    InvGlobalMatrix;
+};
+
+static std::vector<RayCastMeshNode> GetRayCastMeshNodes(const Scene& scene, const ModelTransforms& Transforms)
+{
+    std::vector<RayCastMeshNode> MeshNodes;
+    for (const Node* pNode : scene.LinearNodes)
+    {
+        if (pNode->pMesh == nullptr || pNode->pMesh->RayCastBVH.IsEmpty())
+            continue;
+
+        const float4x4& GlobalMatrix = Transforms.NodeGlobalMatrices[pNode->Index];
+        if (pNode->InstanceMatrices.empty())
+        {
+            MeshNodes.push_back({pNode, 0, GlobalMatrix.Inverse()});
+        }
+        else
+        {
+            // The mesh is only drawn by the EXT_mesh_gpu_instancing instances
+            for (size_t i = 0; i < pNode->InstanceMatrices.size(); ++i)
+                MeshNodes.push_back({pNode, static_cast<Uint32>(i), (pNode->InstanceMatrices[i] * GlobalMatrix).Inverse()});
+        }
+    }
+    return MeshNodes;
+}
+
+static void CastRay(const std::vector<RayCastMeshNode>& MeshNodes, const ModelRay& Ray, ModelRayHit& Hit)
+{
+    Hit = {};
+
+    TriangleBVH::Hit BVHHit;
+    BVHHit.Distance = Ray.MaxDistance;
+
+    const Mesh* pHitMesh = nullptr;
+    for (const RayCastMeshNode& MeshNode : MeshNodes)
+    {
+        // Affine transforms preserve the ray parameter, so the distances in all meshes are comparable
+        const float3 Origin    = float3{float4{Ray.Origin, 1} * MeshNode.InvGlobalMatrix};
+        const float3 Direction = float3{float4{Ray.Direction, 0} * MeshNode.InvGlobalMatrix};
+        if (MeshNode.pNode->pMesh->RayCastBVH.RayCast(Origin, Direction, BVHHit))
+        {
+            Hit.NodeIndex     = MeshNode.pNode->Index;
+            Hit.InstanceIndex = MeshNode.InstanceIndex;
+            pHitMesh          = MeshNode.pNode->pMesh;
+        }
+    }
+    if (pHitMesh == nullptr)
+        return;
+
+    Hit.Distance     = BVHHit.Distance;
+    Hit.Barycentrics = float2{BVHHit.U, BVHHit.V};
+
+    // Triangle ids are the triangle indices in the order of the primitives
+    Uint32 TriangleIndex = BVHHit.TriangleId;
+    for (Uint32 PrimId = 0; PrimId < pHitMesh->Primitives.size(); ++PrimId)
+    {
+        const Uint32 NumTriangles = pHitMesh->Primitives[PrimId].GetTriangleCount();
+        if (TriangleIndex < NumTriangles)
+        {
+            Hit.PrimitiveIndex = PrimId;
+            Hit.TriangleIndex  = TriangleIndex;
+            return;
+        }
+        TriangleIndex -= NumTriangles;
+    }
+    UNEXPECTED("Triangle id is out of range. This appears to be a bug.");
+}
+
+bool Model::RayCast(Uint32                 SceneIndex,
+                    const ModelTransforms& Transforms,
+                    const ModelRay&        Ray,
+                    ModelRayHit&           Hit) const
+{
+    RayCast(SceneIndex, Transforms, &Ray, 1, &Hit);
+    return Hit.IsHit();
+}
+
+void Model::RayCast(Uint32                 SceneIndex,
+                    const ModelTransforms& Transforms,
+                    const ModelRay*        pRays,
+                    size_t                 NumRays,
+                    ModelRayHit*           pHits,
+                    IThreadPool*           pThreadPool,
+                    size_t                 RaysPerTask) const
+{
+    if (NumRays == 0)
+        return;
+
+    DEV_CHECK_ERR(pRays != nullptr && pHits != nullptr, "pRays and pHits must not be null when NumRays is not zero");
+    if (SceneIndex >= Scenes.size() || !CompatibleWithTransforms(Transforms))
+    {
+        DEV_ERROR("Invalid scene index or incompatible transforms");
+        for (size_t i = 0; i < NumRays; ++i)
+            pHits[i] = {};
+        return;
+    }
+
+    // The node inverse matrices are computed once and shared by all rays
+    const std::vector<RayCastMeshNode> MeshNodes = GetRayCastMeshNodes(Scenes[SceneIndex], Transforms);
+
+    const auto CastRays = [&MeshNodes, pRays, pHits](size_t Start, size_t End) {
+        for (size_t i = Start; i < End; ++i)
+            CastRay(MeshNodes, pRays[i], pHits[i]);
+    };
+
+    ProcessChunksAsync(pThreadPool, NumRays, RaysPerTask, CastRays);
+}
+
+void Model::ComputeAnimationBounds(float SampleRate)
+{
+    if (SampleRate <= 0)
+    {
+        DEV_ERROR("Sample rate must be positive");
+        return;
+    }
+    if (Scenes.empty())
+        return;
+
+    const Uint32    SceneIndex = DefaultSceneId >= 0 && static_cast<size_t>(DefaultSceneId) < Scenes.size() ? static_cast<Uint32>(DefaultSceneId) : 0;
+    ModelTransforms Transforms;
+    for (size_t AnimIdx = 0; AnimIdx < Animations.size(); ++AnimIdx)
+    {
+        Animation& Anim = Animations[AnimIdx];
+        Anim.Bounds     = BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+
+        // Animations without channels have Start > End
+        const float  StartTime  = Anim.Start <= Anim.End ? Anim.Start : 0.f;
+        const float  Duration   = Anim.Start <= Anim.End ? Anim.End - Anim.Start : 0.f;
+        const Uint32 NumSamples = static_cast<Uint32>(std::ceil(Duration * SampleRate)) + 1;
+        for (Uint32 Sample = 0; Sample < NumSamples; ++Sample)
+        {
+            const float Time = NumSamples > 1 ?
+                StartTime + Duration * static_cast<float>(Sample) / static_cast<float>(NumSamples - 1) :
+                StartTime;
+            ComputeTransforms(SceneIndex, Transforms, float4x4::Identity(), static_cast<Int32>(AnimIdx), Time);
+
+            const BoundBox SceneAABB = ComputeBoundingBox(SceneIndex, Transforms);
+
+            Anim.Bounds.Min = std::min(Anim.Bounds.Min, SceneAABB.Min);
+            Anim.Bounds.Max = std::max(Anim.Bounds.Max, SceneAABB.Max);
+        }
+    }
+}
+
+void Model::BakeAnimations(float FrameRate)
+{
+    DEV_CHECK_ERR(FrameRate > 0, "Frame rate must be positive");
+
+    for (Animation& animation : Animations)
+    {
+        animation.BakedValues.clear();
+        animation.BakedFrameCount = 0;
+        animation.BakedFrameRate  = 0;
+
+        if (animation.Channels.empty() || !(animation.End >= animation.Start))
+            continue;
+
+        // Distribute the frames uniformly so that the last frame is at the end of the animation
+        const float  Duration    = animation.End - animation.Start;
+        const Uint32 NumFrames   = static_cast<Uint32>(std::ceil(Duration * FrameRate)) + 1;
+        const size_t NumChannels = animation.Channels.size();
+
+        animation.BakedFrameCount = NumFrames;
+        animation.BakedFrameRate  = NumFrames > 1 ? static_cast<float>(NumFrames - 1) / Duration : 0;
+        animation.BakedValues.resize(NumFrames * NumChannels);
+
+        std::vector<Uint32> KeyFrameCursors(animation.Samplers.size(), 0);
+        for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            const float Time = Frame + 1 < NumFrames ?
+                animation.Start + Duration * static_cast<float>(Frame) / static_cast<float>(NumFrames - 1) :
+                animation.End;
+
+            float4* pValues = &animation.BakedValues[Frame * NumChannels];
+            for (size_t i = 0; i < NumChannels; ++i)
+            {
+                const AnimationChannel& channel = animation.Channels[i];
+                if (!SampleAnimation(animation.Samplers[channel.SamplerIndex], channel.PathType, Time, KeyFrameCursors[channel.SamplerIndex], pValues[i]))
+                    pValues[i] = GetRestValue(channel);
+            }
+        }
+    }
+}
+
+// Returns the error between two animated values: the angle between rotations,
+// or the distance between translations and scales.
+static float GetAnimationValueError(AnimationChannel::PATH_TYPE PathType, const float4& Value0, const float4& Value1)
+{
+    if (PathType == AnimationChannel::PATH_TYPE::ROTATION)
+        return 2.f * std::acos(std::min(std::abs(dot(Value0, Value1)), 1.f));
+    else
+        return length(float3{Value0} - float3{Value1});
+}
+
+// Removes the keys of a linear or step sampler that can be restored from the remaining
+// keys with the error not exceeding MaxError.
+static void RemoveRedundantKeys(AnimationSampler& sampler, AnimationChannel::PATH_TYPE PathType, float MaxError)
+{
+    const size_t NumKeys = sampler.Inputs.size();
+    if (NumKeys <= 2 || sampler.OutputsVec4.size() != NumKeys)
+        return;
+
+    const bool IsStep = sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::STEP;
+
+    std::vector<float>&  Times  = sampler.Inputs;
+    std::vector<float4>& Values = sampler.OutputsVec4;
+
+    // Checks if the keys between First and Last can be restored from these two keys
+    const auto CanRemoveKeys = [&](size_t First, size_t Last) {
+        const float Duration = Times[Last] - Times[First];
+        if (!(Duration > 0))
+            return false;
+
+        for (size_t k = First + 1; k < Last; ++k)
+        {
+            float4 Value = Values[First];
+            if (!IsStep)
+            {
+                const float u = (Times[k] - Times[First]) / Duration;
+                if (PathType == AnimationChannel::PATH_TYPE::ROTATION)
+                    Value = normalize(slerp(MakeQuaternion(Values[First]), MakeQuaternion(Values[Last]), u)).q;
+                else
+                    Value = lerp(Values[First], Values[Last], u);
+            }
+            if (GetAnimationValueError(PathType, Value, Values[k]) > MaxError)
+                return false;
+        }
+        return true;
+    };
+
+    // Greedily extend the span of removed keys that starts at the last kept key
+    size_t NumKept  = 1;
+    size_t LastKept = 0;
+    for (size_t i = 1; i + 1 < NumKeys; ++i)
+    {
+        if (!CanRemoveKeys(LastKept, i + 1))
+        {
+            LastKept          = i;
+            Times[NumKept]    = Times[i];
+            Values[NumKept++] = Values[i];
+        }
+    }
+    Times[NumKept]    = Times[NumKeys - 1];
+    Values[NumKept++] = Values[NumKeys - 1];
+
+    Times.resize(NumKept);
+    Values.resize(NumKept);
+}
+
+static void QuantizeOutputsRange(AnimationSampler& sampler)
+{
+    float3 Min{+FLT_MAX, +FLT_MAX, +FLT_MAX};
+    float3 Max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (const float4& Value : sampler.OutputsVec4)
+    {
+        Min = std::min(Min, float3{Value});
+        Max = std::max(Max, float3{Value});
+    }
+
+    sampler.OutputsMin   = Min;
+    sampler.OutputsScale = (Max - Min) / 65535.f;
+
+    sampler.CompressedOutputs.resize(sampler.OutputsVec4.size() * 3);
+    for (size_t i = 0; i < sampler.OutputsVec4.size(); ++i)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            const float Range = Max[c] - Min[c];
+            const float Q     = Range > 0 ? (sampler.OutputsVec4[i][c] - Min[c]) / Range * 65535.f : 0.f;
+
+            sampler.CompressedOutputs[i * 3 + c] = static_cast<Uint16>(clamp(Q + 0.5f, 0.f, 65535.f));
+        }
+    }
+    sampler.OutputEncoding = AnimationSampler::OUTPUT_ENCODING::RANGE_UNORM16;
+}
+
+static void QuantizeOutputsSmallestThree(AnimationSampler& sampler)
+{
+    sampler.CompressedOutputs.resize(sampler.OutputsVec4.size() * 3);
+    for (size_t i = 0; i < sampler.OutputsVec4.size(); ++i)
+    {
+        float4 q = normalize(sampler.OutputsVec4[i]);
+
+        Uint32 Largest = 0;
+        for (Uint32 c = 1; c < 4; ++c)
+        {
+            if (std::abs(q[c]) > std::abs(q[Largest]))
+                Largest = c;
+        }
+        // q and -q represent the same rotation
+        if (q[Largest] < 0)
+            q = -q;
+
+        Uint16* pQ = &sampler.CompressedOutputs[i * 3];
+        for (Uint32 c = 0, j = 0; c < 4; ++c)
+        {
+            if (c == Largest)
+                continue;
+            const float Q = (q[c] + 0.70710678f) / 1.4142135f * 32767.f;
+            pQ[j++]       = static_cast<Uint16>(clamp(Q + 0.5f, 0.f, 32767.f));
+        }
+        pQ[0] |= static_cast<Uint16>((Largest & 1u) << 15u);
+        pQ[1] |= static_cast<Uint16>((Largest >> 1u) << 15u);
+    }
+    sampler.OutputEncoding = AnimationSampler::OUTPUT_ENCODING::QUATERNION_SMALLEST_THREE;
+}
+
+static size_t GetSamplerMemorySize(const AnimationSampler& sampler)
+{
+    size_t Size = (sampler.Inputs.size() + sampler.OutputWeights.size()) * sizeof(float);
+    if (sampler.OutputEncoding == AnimationSampler::OUTPUT_ENCODING::FLOAT4)
+        Size += sampler.OutputsVec4.size() * sizeof(float4);
+    else
+        Size += sampler.CompressedOutputs.size() * sizeof(Uint16);
+    if (sampler.OutputEncoding == AnimationSampler::OUTPUT_ENCODING::RANGE_UNORM16)
+        Size += sizeof(sampler.OutputsMin) + sizeof(sampler.OutputsScale);
+    return Size;
+}
+
+std::vector<AnimationCompressionStats> Model::CompressAnimations(float MaxError)
+{
+    DEV_CHECK_ERR(MaxError >= 0, "Maximum error must not be negative");
+
+    // Quantization error bounds that are subtracted from the key reduction error
+    constexpr float MaxQuaternionQuantizationError = 4.f * 1.4142135f / 32767.f;
+    constexpr float MaxRangeQuantizationError      = 0.5f / 65535.f;
+
+    std::vector<AnimationCompressionStats> Stats(Animations.size());
+    for (size_t anim = 0; anim < Animations.size(); ++anim)
+    {
+        Animation&                 animation = Animations[anim];
+        AnimationCompressionStats& AnimStats = Stats[anim];
+
+        // Samplers that are not used by any channel are left intact
+        std::vector<AnimationChannel::PATH_TYPE> SamplerPaths(animation.Samplers.size(), AnimationChannel::PATH_TYPE::WEIGHTS);
+        for (const AnimationChannel& channel : animation.Channels)
+            SamplerPaths[channel.SamplerIndex] = channel.PathType;
+
+        // Keep the original samplers to measure the error
+        std::vector<AnimationSampler> OriginalSamplers = animation.Samplers;
+
+        for (size_t sam = 0; sam < animation.Samplers.size(); ++sam)
+        {
+            AnimationSampler&                 sampler  = animation.Samplers[sam];
+            const AnimationChannel::PATH_TYPE PathType = SamplerPaths[sam];
+
+            AnimStats.OriginalSize += GetSamplerMemorySize(sampler);
+            AnimStats.OriginalKeyCount += static_cast<Uint32>(sampler.Inputs.size());
+
+            if (sampler.OutputEncoding == AnimationSampler::OUTPUT_ENCODING::FLOAT4 &&
+                PathType != AnimationChannel::PATH_TYPE::WEIGHTS &&
+                !sampler.OutputsVec4.empty())
+            {
+                const bool IsCubic  = sampler.Interpolation == AnimationSampler::INTERPOLATION_TYPE::CUBICSPLINE;
+                const bool Rotation = PathType == AnimationChannel::PATH_TYPE::ROTATION;
+                if (!IsCubic)
+                {
+                    // Leave room for the quantization error
+                    float QuantizationError = MaxQuaternionQuantizationError;
+                    if (!Rotation)
+                    {
+                        float3 Min{+FLT_MAX, +FLT_MAX, +FLT_MAX};
+                        float3 Max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+                        for (const float4& Value : sampler.OutputsVec4)
+                        {
+                            Min = std::min(Min, float3{Value});
+                            Max = std::max(Max, float3{Value});
+                        }
+                        QuantizationError = length(Max - Min) * MaxRangeQuantizationError;
+                    }
+                    RemoveRedundantKeys(sampler, PathType, std::max(MaxError - QuantizationError, 0.f));
+                }
+
+                if (!Rotation)
+                    QuantizeOutputsRange(sampler);
+                else if (!IsCubic)
+                    QuantizeOutputsSmallestThree(sampler);
+
+                if (sampler.OutputEncoding != AnimationSampler::OUTPUT_ENCODING::FLOAT4)
+                    std::vector<float4>{}.swap(sampler.OutputsVec4);
+                sampler.Inputs.shrink_to_fit();
+            }
+
+            AnimStats.CompressedSize += GetSamplerMemorySize(sampler);
+            AnimStats.CompressedKeyCount += static_cast<Uint32>(sampler.Inputs.size());
+        }
+
+        // Measure the error at the original key frame times and between them
+        for (const AnimationChannel& channel : animation.Channels)
+        {
+            const AnimationSampler& OrigSampler = OriginalSamplers[channel.SamplerIndex];
+            const AnimationSampler& CompSampler = animation.Samplers[channel.SamplerIndex];
+
+            float* pMaxError = nullptr;
+            switch (channel.PathType)
+            {
+                case AnimationChannel::PATH_TYPE::TRANSLATION: pMaxError = &AnimStats.MaxTranslationError; break;
+                case AnimationChannel::PATH_TYPE::ROTATION: pMaxError = &AnimStats.MaxRotationError; break;
+                case AnimationChannel::PATH_TYPE::SCALE: pMaxError = &AnimStats.MaxScaleError; break;
+                default: continue;
+            }
+
+            Uint32 OrigCursor = 0;
+            Uint32 CompCursor = 0;
+            for (size_t k = 0; k < OrigSampler.Inputs.size(); ++k)
+            {
+                const float Time = OrigSampler.Inputs[k];
+                for (float t : {Time, k + 1 < OrigSampler.Inputs.size() ? (Time + OrigSampler.Inputs[k + 1]) * 0.5f : Time})
+                {
+                    float4 OrigValue, CompValue;
+                    if (SampleAnimation(OrigSampler, channel.PathType, t, OrigCursor, OrigValue) &&
+                        SampleAnimation(CompSampler, channel.PathType, t, CompCursor, CompValue))
+                    {
+                        *pMaxError = std::max(*pMaxError, GetAnimationValueError(channel.PathType, OrigValue, CompValue));
+                    }
+                }
+            }
+        }
+    }
+
+    return Stats;
+}
+
+void Model::UpdateAnimation(Uint32 SceneIndex, Uint32 AnimationIndex, float time, ModelTransforms& Transforms) const
+{
+    if (AnimationIndex >= Animations.size())
+    {
+        LOG_WARNING_MESSAGE("No animation with index ", AnimationIndex);
+        return;
+    }
+
+    VERIFY_EXPR(SceneIndex < Scenes.size());
+    const Animation& animation = Animations[AnimationIndex];
+
+    time = clamp(time, animation.Start, animation.End);
+
+    const Scene& scene = Scenes[SceneIndex];
+
+    // Note that the animation transforms are indexed by the global node index
+    ModelTransforms::AnimationTransforms& NodeAnims = Transforms.NodeAnimations;
+    NodeAnims.Resize(Nodes.size());
+    VERIFY_EXPR(NodeAnims.Translations.size() == Transforms.NodeLocalMatrices.size());
+
+    for (Uint32 NodeId : scene.HierarchyNodeIds)
+    {
+        const Node& N = Nodes[NodeId];
+
+        // NB: not each component has to be animated (e.g. 'Fox' test model)
+        NodeAnims.Translations[NodeId] = N.Translation;
+        NodeAnims.Rotations[NodeId]    = N.Rotation;
+        NodeAnims.Scales[NodeId]       = N.Scale;
+    }
+
+    if (Transforms.MorphWeights.size() != DefaultMorphWeights.size())
+        Transforms.MorphWeights = DefaultMorphWeights;
+
+    ApplyAnimationChannels(animation, time, NodeAnims, Transforms.KeyFrameCursors, Transforms.MorphWeights.data(), nullptr);
+
+    for (Uint32 NodeId : scene.HierarchyNodeIds)
+    {
+        Transforms.NodeLocalMatrices[NodeId] =
+            ComputeNodeLocalMatrix(NodeAnims.Scales[NodeId], NodeAnims.Rotations[NodeId], NodeAnims.Translations[NodeId], Nodes[NodeId].Matrix);
     }
 }
 
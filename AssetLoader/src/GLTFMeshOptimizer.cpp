@@ -0,0 +1,1053 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFMeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+namespace
+{
+
+// Simulates a FIFO cache using per-vertex timestamps: a vertex is in the cache
+// if it was added within the last CacheSize insertions.
+class FIFOCacheSimulator
+{
+public:
+    FIFOCacheSimulator(Uint32 NumVertices, Uint32 CacheSize) :
+        m_Timestamps(NumVertices, 0),
+        m_CacheSize{CacheSize},
+        m_Time{CacheSize + 1}
+    {}
+
+    // Returns the number of cache misses for the triangle.
+    Uint32 AddTriangle(const Uint32* pTri)
+    {
+        Uint32 NumMisses = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            Uint32& Timestamp = m_Timestamps[pTri[i]];
+            if (m_Time - Timestamp > m_CacheSize)
+            {
+                Timestamp = m_Time++;
+                ++NumMisses;
+            }
+        }
+        return NumMisses;
+    }
+
+    void Flush()
+    {
+        m_Time += m_CacheSize + 1;
+    }
+
+private:
+    std::vector<Uint32> m_Timestamps;
+
+    const Uint32 m_CacheSize;
+    Uint32       m_Time;
+};
+
+// Vertex-to-triangle adjacency. The first NumActiveTris[v] entries of the vertex
+// adjacency list are the triangles that have not been removed yet.
+class TriangleAdjacency
+{
+public:
+    TriangleAdjacency(const Uint32* pIndices, size_t NumTriangles, Uint32 NumVertices) :
+        m_NumActiveTris(NumVertices, 0),
+        m_Offsets(size_t{NumVertices} + 1, 0),
+        m_Triangles(NumTriangles * 3)
+    {
+        for (size_t i = 0; i < NumTriangles * 3; ++i)
+        {
+            VERIFY(pIndices[i] < NumVertices, "Index ", pIndices[i], " is out of range");
+            ++m_NumActiveTris[pIndices[i]];
+        }
+
+        for (Uint32 v = 0; v < NumVertices; ++v)
+            m_Offsets[v + 1] = m_Offsets[v] + m_NumActiveTris[v];
+
+        std::vector<Uint32> Sizes(NumVertices, 0);
+        for (size_t Tri = 0; Tri < NumTriangles; ++Tri)
+        {
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 v = pIndices[Tri * 3 + i];
+                m_Triangles[m_Offsets[v] + Sizes[v]++] = static_cast<Uint32>(Tri);
+            }
+        }
+    }
+
+    Uint32 GetNumActiveTriangles(Uint32 v) const { return m_NumActiveTris[v]; }
+
+    const Uint32* GetActiveTriangles(Uint32 v) const { return &m_Triangles[m_Offsets[v]]; }
+
+    // Removes the triangle from the active lists of its vertices.
+    void RemoveTriangle(const Uint32* pIndices, Uint32 Tri)
+    {
+        // Degenerate triangles reference the same vertex more than once and
+        // are present in its list once for every reference.
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            const Uint32 v = pIndices[size_t{Tri} * 3 + i];
+
+            Uint32* const pAdjBegin = &m_Triangles[m_Offsets[v]];
+            Uint32* const pAdjEnd   = pAdjBegin + m_NumActiveTris[v];
+            Uint32* const pAdj      = std::find(pAdjBegin, pAdjEnd, Tri);
+            VERIFY_EXPR(pAdj != pAdjEnd);
+            std::swap(*pAdj, *(pAdjEnd - 1));
+            --m_NumActiveTris[v];
+        }
+    }
+
+private:
+    std::vector<Uint32> m_NumActiveTris;
+    std::vector<Uint32> m_Offsets;
+    std::vector<Uint32> m_Triangles;
+};
+
+float3 ReadPosition(const void* pPositions, Uint32 PositionStride, Uint32 v)
+{
+    float3 Pos;
+    std::memcpy(&Pos, static_cast<const Uint8*>(pPositions) + size_t{v} * PositionStride, sizeof(Pos));
+    return Pos;
+}
+
+// Vertex scoring from "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth.
+constexpr Uint32 ForsythCacheSize = 32;
+constexpr Uint32 MaxValenceScores = 32;
+
+class ForsythScoreTable
+{
+public:
+    ForsythScoreTable()
+    {
+        constexpr float CacheDecayPower   = 1.5f;
+        constexpr float LastTriScore      = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        for (Uint32 i = 0; i < ForsythCacheSize; ++i)
+        {
+            // The vertices of the last triangle get a fixed score to avoid
+            // favoring the triangle that was just added.
+            CacheScores[i] = i < 3 ?
+                LastTriScore :
+                std::pow(1.f - static_cast<float>(i - 3) / static_cast<float>(ForsythCacheSize - 3), CacheDecayPower);
+        }
+
+        ValenceScores[0] = 0;
+        for (Uint32 i = 1; i < MaxValenceScores; ++i)
+            ValenceScores[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+    }
+
+    float GetScore(int CachePos, Uint32 NumActiveTris) const
+    {
+        if (NumActiveTris == 0)
+            return -1.f; // The vertex is not used by any remaining triangle
+
+        float Score = CachePos >= 0 ? CacheScores[CachePos] : 0.f;
+        // Boost vertices with few remaining triangles to get rid of lone triangles
+        Score += NumActiveTris < MaxValenceScores ?
+            ValenceScores[NumActiveTris] :
+            2.0f * std::pow(static_cast<float>(NumActiveTris), -0.5f);
+        return Score;
+    }
+
+private:
+    float CacheScores[ForsythCacheSize];
+    float ValenceScores[MaxValenceScores];
+};
+
+} // namespace
+
+VertexCacheStats MeshOptimizer::ComputeVertexCacheStats(const Uint32* pIndices,
+                                                        size_t        NumIndices,
+                                                        Uint32        NumVertices,
+                                                        Uint32        CacheSize)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(CacheSize > 0, "Cache size must not be zero");
+
+    VertexCacheStats Stats;
+    if (NumIndices < 3 || NumVertices == 0)
+        return Stats;
+
+    std::vector<bool>  IsReferenced(NumVertices, false);
+    FIFOCacheSimulator Cache{NumVertices, CacheSize};
+
+    const size_t NumTriangles = NumIndices / 3;
+    for (size_t Tri = 0; Tri < NumTriangles; ++Tri)
+    {
+        const Uint32* pTri = pIndices + Tri * 3;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            VERIFY(pTri[i] < NumVertices, "Index ", pTri[i], " is out of range");
+            if (!IsReferenced[pTri[i]])
+            {
+                IsReferenced[pTri[i]] = true;
+                ++Stats.NumVertices;
+            }
+        }
+        Stats.NumTransformedVertices += Cache.AddTriangle(pTri);
+    }
+    Stats.NumTriangles = static_cast<Uint32>(NumTriangles);
+
+    return Stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(Uint32* pIndices,
+                                        size_t  NumIndices,
+                                        Uint32  NumVertices)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+
+    const size_t NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2 || NumVertices == 0)
+        return;
+
+    static const ForsythScoreTable ScoreTable;
+
+    TriangleAdjacency Adjacency{pIndices, NumTriangles, NumVertices};
+
+    std::vector<int>   CachePos(NumVertices, -1);
+    std::vector<float> VertexScores(NumVertices);
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        VertexScores[v] = ScoreTable.GetScore(-1, Adjacency.GetNumActiveTriangles(v));
+
+    std::vector<float> TriScores(NumTriangles);
+    std::vector<bool>  IsEmitted(NumTriangles, false);
+
+    auto GetTriangleScore = [&](size_t Tri) {
+        const Uint32* pTri = pIndices + Tri * 3;
+        return VertexScores[pTri[0]] + VertexScores[pTri[1]] + VertexScores[pTri[2]];
+    };
+
+    Uint32 BestTri   = 0;
+    float  BestScore = -1.f;
+    for (size_t Tri = 0; Tri < NumTriangles; ++Tri)
+    {
+        TriScores[Tri] = GetTriangleScore(Tri);
+        if (TriScores[Tri] > BestScore)
+        {
+            BestScore = TriScores[Tri];
+            BestTri   = static_cast<Uint32>(Tri);
+        }
+    }
+
+    std::vector<Uint32> OptimizedIndices;
+    OptimizedIndices.reserve(NumTriangles * 3);
+
+    // The cache holds up to ForsythCacheSize vertices plus the three vertices of the new triangle
+    // that temporarily push the oldest entries out.
+    Uint32 Cache[ForsythCacheSize + 3];
+    Uint32 NewCache[ForsythCacheSize + 3];
+    Uint32 CacheSize = 0;
+
+    size_t NextUnemittedTri = 0;
+    while (OptimizedIndices.size() < NumTriangles * 3)
+    {
+        if (BestTri == ~0u)
+        {
+            // No triangle in the cache neighborhood - continue with the next unemitted triangle.
+            while (IsEmitted[NextUnemittedTri])
+                ++NextUnemittedTri;
+            BestTri = static_cast<Uint32>(NextUnemittedTri);
+        }
+
+        const Uint32* pTri = pIndices + size_t{BestTri} * 3;
+        OptimizedIndices.insert(OptimizedIndices.end(), pTri, pTri + 3);
+        IsEmitted[BestTri] = true;
+
+        Adjacency.RemoveTriangle(pIndices, BestTri);
+
+        Uint32 NewCacheSize = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            // Degenerate triangles may reference the same vertex more than once
+            const Uint32 v = pTri[i];
+            if (std::find(NewCache, NewCache + NewCacheSize, v) == NewCache + NewCacheSize)
+                NewCache[NewCacheSize++] = v;
+        }
+
+        // The triangle vertices move to the front of the LRU cache
+        const Uint32 NumTriVerts = NewCacheSize;
+        for (Uint32 i = 0; i < CacheSize; ++i)
+        {
+            const Uint32 v = Cache[i];
+            if (std::find(NewCache, NewCache + NumTriVerts, v) == NewCache + NumTriVerts)
+                NewCache[NewCacheSize++] = v;
+        }
+
+        // Update the scores of the vertices in the cache and the vertices that were evicted
+        for (Uint32 i = 0; i < NewCacheSize; ++i)
+        {
+            const Uint32 v  = NewCache[i];
+            CachePos[v]     = i < ForsythCacheSize ? static_cast<int>(i) : -1;
+            VertexScores[v] = ScoreTable.GetScore(CachePos[v], Adjacency.GetNumActiveTriangles(v));
+        }
+
+        // Update the scores of the active triangles that use the affected vertices and find the best one
+        BestTri   = ~0u;
+        BestScore = -1.f;
+        for (Uint32 i = 0; i < NewCacheSize; ++i)
+        {
+            const Uint32  v     = NewCache[i];
+            const Uint32* pTris = Adjacency.GetActiveTriangles(v);
+            for (Uint32 a = 0; a < Adjacency.GetNumActiveTriangles(v); ++a)
+            {
+                const Uint32 Tri = pTris[a];
+                TriScores[Tri]   = GetTriangleScore(Tri);
+                if (TriScores[Tri] > BestScore)
+                {
+                    BestScore = TriScores[Tri];
+                    BestTri   = Tri;
+                }
+            }
+        }
+
+        CacheSize = std::min(NewCacheSize, ForsythCacheSize);
+        std::copy(NewCache, NewCache + CacheSize, Cache);
+    }
+
+    std::copy(OptimizedIndices.begin(), OptimizedIndices.end(), pIndices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(Uint32*     pIndices,
+                                     size_t      NumIndices,
+                                     const void* pPositions,
+                                     Uint32      PositionStride,
+                                     Uint32      NumVertices,
+                                     float       Threshold)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(pPositions != nullptr, "Positions must not be null");
+    DEV_CHECK_ERR(PositionStride >= sizeof(float3), "Position stride (", PositionStride, ") is too small");
+
+    const size_t NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2 || NumVertices == 0 || pPositions == nullptr)
+        return;
+
+    // Hard cluster boundaries are the triangles that miss the cache on all three vertices:
+    // reordering the clusters does not change the cache efficiency.
+    std::vector<size_t> HardBoundaries;
+    {
+        FIFOCacheSimulator Cache{NumVertices, StatsCacheSize};
+        for (size_t Tri = 0; Tri < NumTriangles; ++Tri)
+        {
+            if (Cache.AddTriangle(pIndices + Tri * 3) == 3 || Tri == 0)
+                HardBoundaries.push_back(Tri);
+        }
+    }
+
+    // Soft boundaries split the hard clusters further as long as the ACMR of each
+    // piece stays within Threshold times the ACMR of the hard cluster.
+    std::vector<size_t> Clusters;
+    {
+        FIFOCacheSimulator Cache{NumVertices, StatsCacheSize};
+        for (size_t i = 0; i < HardBoundaries.size(); ++i)
+        {
+            const size_t Start = HardBoundaries[i];
+            const size_t End   = i + 1 < HardBoundaries.size() ? HardBoundaries[i + 1] : NumTriangles;
+
+            Cache.Flush();
+            Uint32 NumClusterMisses = 0;
+            for (size_t Tri = Start; Tri < End; ++Tri)
+                NumClusterMisses += Cache.AddTriangle(pIndices + Tri * 3);
+
+            const float ClusterThreshold = Threshold * static_cast<float>(NumClusterMisses) / static_cast<float>(End - Start);
+
+            Clusters.push_back(Start);
+            Cache.Flush();
+            size_t SoftStart = Start;
+            Uint32 NumMisses = 0;
+            for (size_t Tri = Start; Tri < End; ++Tri)
+            {
+                NumMisses += Cache.AddTriangle(pIndices + Tri * 3);
+                if (Tri + 1 < End && static_cast<float>(NumMisses) <= ClusterThreshold * static_cast<float>(Tri + 1 - SoftStart))
+                {
+                    Clusters.push_back(Tri + 1);
+                    SoftStart = Tri + 1;
+                    NumMisses = 0;
+                    Cache.Flush();
+                }
+            }
+        }
+    }
+
+    const size_t NumClusters = Clusters.size();
+    if (NumClusters < 2)
+        return;
+
+    // Compute area-weighted centroids and average normals of the clusters
+    std::vector<float3> ClusterCentroids(NumClusters);
+    std::vector<float3> ClusterNormals(NumClusters);
+
+    float3 MeshCentroid;
+    float  MeshArea = 0;
+    for (size_t c = 0; c < NumClusters; ++c)
+    {
+        const size_t Start = Clusters[c];
+        const size_t End   = c + 1 < NumClusters ? Clusters[c + 1] : NumTriangles;
+
+        float3 Centroid;
+        float3 Normal;
+        float  Area = 0;
+        for (size_t Tri = Start; Tri < End; ++Tri)
+        {
+            const float3 P0 = ReadPosition(pPositions, PositionStride, pIndices[Tri * 3 + 0]);
+            const float3 P1 = ReadPosition(pPositions, PositionStride, pIndices[Tri * 3 + 1]);
+            const float3 P2 = ReadPosition(pPositions, PositionStride, pIndices[Tri * 3 + 2]);
+
+            // The length of the cross product is twice the triangle area
+            const float3 N       = cross(P1 - P0, P2 - P0);
+            const float  TriArea = length(N);
+
+            Centroid += (P0 + P1 + P2) * (TriArea / 3.f);
+            Normal += N;
+            Area += TriArea;
+        }
+
+        MeshCentroid += Centroid;
+        MeshArea += Area;
+
+        ClusterCentroids[c] = Area > 0 ? Centroid / Area : float3{};
+        ClusterNormals[c]   = Normal;
+    }
+    if (MeshArea == 0)
+        return;
+    MeshCentroid /= MeshArea;
+
+    // Clusters that are further away from the center in the direction of their normal
+    // are more likely to occlude other clusters and are drawn first.
+    std::vector<float> SortKeys(NumClusters);
+    for (size_t c = 0; c < NumClusters; ++c)
+    {
+        const float NormalLength = length(ClusterNormals[c]);
+        SortKeys[c]              = NormalLength > 0 ? dot(ClusterCentroids[c] - MeshCentroid, ClusterNormals[c] / NormalLength) : 0.f;
+    }
+
+    std::vector<size_t> ClusterOrder(NumClusters);
+    std::iota(ClusterOrder.begin(), ClusterOrder.end(), size_t{0});
+    std::stable_sort(ClusterOrder.begin(), ClusterOrder.end(),
+                     [&SortKeys](size_t c0, size_t c1) {
+                         return SortKeys[c0] > SortKeys[c1];
+                     });
+
+    std::vector<Uint32> OptimizedIndices;
+    OptimizedIndices.reserve(NumTriangles * 3);
+    for (size_t c : ClusterOrder)
+    {
+        const size_t Start = Clusters[c];
+        const size_t End   = c + 1 < NumClusters ? Clusters[c + 1] : NumTriangles;
+        OptimizedIndices.insert(OptimizedIndices.end(), pIndices + Start * 3, pIndices + End * 3);
+    }
+    VERIFY_EXPR(OptimizedIndices.size() == NumTriangles * 3);
+
+    std::copy(OptimizedIndices.begin(), OptimizedIndices.end(), pIndices);
+}
+
+Uint32 MeshOptimizer::ComputeVertexFetchRemap(const Uint32* pIndices,
+                                              size_t        NumIndices,
+                                              Uint32        NumVertices,
+                                              Uint32*       pRemap)
+{
+    DEV_CHECK_ERR(pRemap != nullptr || NumVertices == 0, "Remap table must not be null");
+
+    std::fill(pRemap, pRemap + NumVertices, ~0u);
+
+    Uint32 NextVertex = 0;
+    for (size_t i = 0; i < NumIndices; ++i)
+    {
+        const Uint32 v = pIndices[i];
+        VERIFY(v < NumVertices, "Index ", v, " is out of range");
+        if (pRemap[v] == ~0u)
+            pRemap[v] = NextVertex++;
+    }
+
+    const Uint32 NumReferencedVertices = NextVertex;
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        if (pRemap[v] == ~0u)
+            pRemap[v] = NextVertex++;
+    }
+    VERIFY_EXPR(NextVertex == NumVertices);
+
+    return NumReferencedVertices;
+}
+
+namespace
+{
+
+void ComputeMeshletBounds(const MeshletData& Data,
+                          const void*        pPositions,
+                          Uint32             PositionStride,
+                          Uint32             BaseVertex,
+                          Meshlet&           M)
+{
+    VERIFY_EXPR(M.VertexCount > 0);
+
+    auto GetVertexPosition = [&](Uint32 LocalIndex) {
+        return ReadPosition(pPositions, PositionStride, Data.VertexIndices[M.FirstVertex + LocalIndex] - BaseVertex);
+    };
+
+    float3 MinPos = GetVertexPosition(0);
+    float3 MaxPos = MinPos;
+    for (Uint32 i = 1; i < M.VertexCount; ++i)
+    {
+        const float3 Pos = GetVertexPosition(i);
+
+        MinPos = std::min(MinPos, Pos);
+        MaxPos = std::max(MaxPos, Pos);
+    }
+
+    const float3 Center = (MinPos + MaxPos) * 0.5f;
+    float        Radius = 0;
+    for (Uint32 i = 0; i < M.VertexCount; ++i)
+        Radius = std::max(Radius, length(GetVertexPosition(i) - Center));
+
+    M.BoundingSphere = float4{Center, Radius};
+
+    // Normal cone axis is the average direction of the triangle normals
+    std::vector<float3> TriNormals;
+    TriNormals.reserve(M.TriangleCount);
+
+    float3 Axis;
+    for (Uint32 t = 0; t < M.TriangleCount; ++t)
+    {
+        const Uint32 Tri = Data.Triangles[M.FirstTriangle + t];
+
+        const float3 P0 = GetVertexPosition((Tri >> 0u) & 0xFFu);
+        const float3 P1 = GetVertexPosition((Tri >> 8u) & 0xFFu);
+        const float3 P2 = GetVertexPosition((Tri >> 16u) & 0xFFu);
+
+        const float3 N       = cross(P1 - P0, P2 - P0);
+        const float  NLength = length(N);
+        if (NLength == 0)
+            continue;
+
+        TriNormals.push_back(N / NLength);
+        Axis += TriNormals.back();
+    }
+
+    const float AxisLength = length(Axis);
+    if (TriNormals.empty() || AxisLength < 1e-6f)
+    {
+        M.NormalCone = float4{0, 0, 0, 1};
+        return;
+    }
+    Axis /= AxisLength;
+
+    float MinDot = 1;
+    for (const float3& N : TriNormals)
+        MinDot = std::min(MinDot, dot(N, Axis));
+
+    // The cone must contain all normals. When the cone angle exceeds 90 degrees, no
+    // view direction is guaranteed to see only back faces.
+    const float Cutoff = MinDot > 0 ? std::sqrt(std::max(1 - MinDot * MinDot, 0.f)) : 1.f;
+
+    M.NormalCone = float4{Axis, Cutoff};
+}
+
+} // namespace
+
+Uint32 MeshOptimizer::BuildMeshlets(const Uint32* pIndices,
+                                    size_t        NumIndices,
+                                    const void*   pPositions,
+                                    Uint32        PositionStride,
+                                    Uint32        NumVertices,
+                                    Uint32        BaseVertex,
+                                    Uint32        MaxVertices,
+                                    Uint32        MaxTriangles,
+                                    MeshletData&  Data)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(MaxVertices >= 3 && MaxVertices <= MaxMeshletVertices, "Max meshlet vertex count (", MaxVertices, ") must be in range [3, ", MaxMeshletVertices, "]");
+    DEV_CHECK_ERR(MaxTriangles >= 1 && MaxTriangles <= MaxMeshletTriangles, "Max meshlet triangle count (", MaxTriangles, ") must be in range [1, ", MaxMeshletTriangles, "]");
+    DEV_CHECK_ERR(pPositions == nullptr || PositionStride >= sizeof(float3), "Position stride (", PositionStride, ") is too small");
+
+    MaxVertices  = std::min(std::max(MaxVertices, 3u), MaxMeshletVertices);
+    MaxTriangles = std::min(std::max(MaxTriangles, 1u), MaxMeshletTriangles);
+
+    const size_t NumTriangles = NumIndices / 3;
+    if (NumTriangles == 0 || NumVertices == 0)
+        return 0;
+
+    TriangleAdjacency Adjacency{pIndices, NumTriangles, NumVertices};
+
+    // Index of the vertex in the current meshlet, or ~0u if the vertex is not in the meshlet
+    std::vector<Uint32> LocalIndices(NumVertices, ~0u);
+    std::vector<bool>   IsEmitted(NumTriangles, false);
+
+    const size_t FirstMeshlet = Data.Meshlets.size();
+
+    Meshlet CurrMeshlet;
+    CurrMeshlet.FirstVertex   = static_cast<Uint32>(Data.VertexIndices.size());
+    CurrMeshlet.FirstTriangle = static_cast<Uint32>(Data.Triangles.size());
+
+    auto FinishMeshlet = [&]() {
+        if (CurrMeshlet.TriangleCount == 0)
+            return;
+
+        for (Uint32 i = 0; i < CurrMeshlet.VertexCount; ++i)
+            LocalIndices[Data.VertexIndices[CurrMeshlet.FirstVertex + i] - BaseVertex] = ~0u;
+
+        if (pPositions != nullptr)
+            ComputeMeshletBounds(Data, pPositions, PositionStride, BaseVertex, CurrMeshlet);
+
+        Data.Meshlets.push_back(CurrMeshlet);
+
+        CurrMeshlet               = Meshlet{};
+        CurrMeshlet.FirstVertex   = static_cast<Uint32>(Data.VertexIndices.size());
+        CurrMeshlet.FirstTriangle = static_cast<Uint32>(Data.Triangles.size());
+    };
+
+    auto CountNewVertices = [&](Uint32 Tri) {
+        const Uint32* pTri = pIndices + size_t{Tri} * 3;
+
+        Uint32 NumNewVertices = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            // Degenerate triangles may reference the same vertex more than once
+            if (LocalIndices[pTri[i]] == ~0u && (i == 0 || pTri[i] != pTri[0]) && (i < 2 || pTri[2] != pTri[1]))
+                ++NumNewVertices;
+        }
+        return NumNewVertices;
+    };
+
+    size_t NextUnemittedTri = 0;
+    for (size_t NumEmitted = 0; NumEmitted < NumTriangles; ++NumEmitted)
+    {
+        // Find the triangle adjacent to the meshlet that adds the fewest new vertices
+        Uint32 BestTri         = ~0u;
+        Uint32 BestNewVertices = ~0u;
+        for (Uint32 i = 0; i < CurrMeshlet.VertexCount && BestNewVertices > 0; ++i)
+        {
+            const Uint32  v     = Data.VertexIndices[CurrMeshlet.FirstVertex + i] - BaseVertex;
+            const Uint32* pTris = Adjacency.GetActiveTriangles(v);
+            for (Uint32 a = 0; a < Adjacency.GetNumActiveTriangles(v); ++a)
+            {
+                const Uint32 Tri            = pTris[a];
+                const Uint32 NumNewVertices = CountNewVertices(Tri);
+                if (NumNewVertices < BestNewVertices || (NumNewVertices == BestNewVertices && Tri < BestTri))
+                {
+                    BestTri         = Tri;
+                    BestNewVertices = NumNewVertices;
+                }
+            }
+        }
+
+        if (BestTri == ~0u)
+        {
+            // No triangles adjacent to the meshlet - continue with the next unemitted triangle.
+            while (IsEmitted[NextUnemittedTri])
+                ++NextUnemittedTri;
+            BestTri         = static_cast<Uint32>(NextUnemittedTri);
+            BestNewVertices = CountNewVertices(BestTri);
+        }
+
+        if (CurrMeshlet.VertexCount + BestNewVertices > MaxVertices || CurrMeshlet.TriangleCount + 1 > MaxTriangles)
+        {
+            FinishMeshlet();
+            // All vertices of the triangle are new in the empty meshlet
+            BestNewVertices = CountNewVertices(BestTri);
+        }
+
+        const Uint32* pTri      = pIndices + size_t{BestTri} * 3;
+        Uint32        PackedTri = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            const Uint32 v = pTri[i];
+            if (LocalIndices[v] == ~0u)
+            {
+                LocalIndices[v] = CurrMeshlet.VertexCount++;
+                Data.VertexIndices.push_back(v + BaseVertex);
+            }
+            PackedTri |= LocalIndices[v] << (i * 8u);
+        }
+        VERIFY_EXPR(CurrMeshlet.VertexCount <= MaxVertices);
+
+        Data.Triangles.push_back(PackedTri);
+        ++CurrMeshlet.TriangleCount;
+
+        IsEmitted[BestTri] = true;
+        Adjacency.RemoveTriangle(pIndices, BestTri);
+    }
+    FinishMeshlet();
+
+    return static_cast<Uint32>(Data.Meshlets.size() - FirstMeshlet);
+}
+
+namespace
+{
+
+// Symmetric 4x4 matrix that accumulates the squared distances to a set of weighted planes.
+struct Quadric
+{
+    float a00 = 0, a11 = 0, a22 = 0;
+    float a01 = 0, a02 = 0, a12 = 0;
+    float b0 = 0, b1 = 0, b2 = 0;
+    float c = 0;
+    float w = 0;
+
+    // Plane dot(N, P) + D = 0, N must be normalized.
+    Quadric(const float3& N, float D, float Weight) :
+        a00{Weight * N.x * N.x},
+        a11{Weight * N.y * N.y},
+        a22{Weight * N.z * N.z},
+        a01{Weight * N.x * N.y},
+        a02{Weight * N.x * N.z},
+        a12{Weight * N.y * N.z},
+        b0{Weight * N.x * D},
+        b1{Weight * N.y * D},
+        b2{Weight * N.z * D},
+        c{Weight * D * D},
+        w{Weight}
+    {
+    }
+
+    Quadric() = default;
+
+    Quadric& operator+=(const Quadric& Q)
+    {
+        a00 += Q.a00;
+        a11 += Q.a11;
+        a22 += Q.a22;
+        a01 += Q.a01;
+        a02 += Q.a02;
+        a12 += Q.a12;
+        b0 += Q.b0;
+        b1 += Q.b1;
+        b2 += Q.b2;
+        c += Q.c;
+        w += Q.w;
+        return *this;
+    }
+
+    // Returns the weighted average squared distance from P to the planes.
+    float GetError(const float3& P) const
+    {
+        if (w <= 0)
+            return 0;
+
+        const float E = a00 * P.x * P.x + a11 * P.y * P.y + a22 * P.z * P.z +
+            2 * (a01 * P.x * P.y + a02 * P.x * P.z + a12 * P.y * P.z) +
+            2 * (b0 * P.x + b1 * P.y + b2 * P.z) + c;
+        return std::max(E, 0.f) / w;
+    }
+};
+
+Uint64 GetEdgeKey(Uint32 v0, Uint32 v1)
+{
+    return v0 < v1 ? (Uint64{v0} << 32u) | v1 : (Uint64{v1} << 32u) | v0;
+}
+
+} // namespace
+
+size_t MeshOptimizer::SimplifyMesh(const Uint32* pIndices,
+                                   size_t        NumIndices,
+                                   const void*   pPositions,
+                                   Uint32        PositionStride,
+                                   Uint32        NumVertices,
+                                   size_t        TargetIndexCount,
+                                   float         TargetError,
+                                   Uint32*       pDstIndices,
+                                   float*        pResultError)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(pPositions != nullptr, "Positions must not be null");
+    DEV_CHECK_ERR(PositionStride >= sizeof(float3), "Position stride (", PositionStride, ") is too small");
+    DEV_CHECK_ERR(pDstIndices != nullptr, "Destination indices must not be null");
+
+    std::vector<Uint32> Indices{pIndices, pIndices + NumIndices};
+    if (pResultError != nullptr)
+        *pResultError = 0;
+
+    size_t       NumTriangles    = NumIndices / 3;
+    const size_t TargetTriangles = TargetIndexCount / 3;
+    if (NumTriangles <= TargetTriangles || NumVertices == 0 || pPositions == nullptr)
+    {
+        std::copy(Indices.begin(), Indices.end(), pDstIndices);
+        return NumIndices;
+    }
+
+    std::vector<float3> Positions(NumVertices);
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        Positions[v] = ReadPosition(pPositions, PositionStride, v);
+
+    // Vertices that share the position with other vertices lie on attribute seams.
+    // Removing them would open cracks, so they are locked.
+    std::vector<bool> IsLocked(NumVertices, false);
+    {
+        std::vector<Uint32> SortedVertices(NumVertices);
+        std::iota(SortedVertices.begin(), SortedVertices.end(), 0u);
+        auto PosLess = [&Positions](Uint32 v0, Uint32 v1) {
+            const float3& P0 = Positions[v0];
+            const float3& P1 = Positions[v1];
+            return P0.x != P1.x ? P0.x < P1.x : (P0.y != P1.y ? P0.y < P1.y : P0.z < P1.z);
+        };
+        std::sort(SortedVertices.begin(), SortedVertices.end(), PosLess);
+        for (Uint32 i = 1; i < NumVertices; ++i)
+        {
+            if (!PosLess(SortedVertices[i - 1], SortedVertices[i]))
+                IsLocked[SortedVertices[i - 1]] = IsLocked[SortedVertices[i]] = true;
+        }
+    }
+
+    // Sorted keys of the edges that belong to a single triangle
+    std::vector<Uint64> BorderEdges;
+    std::vector<bool>   IsBorder(NumVertices, false);
+    // Unique edges of the current triangles
+    std::vector<Uint64> Edges;
+
+    auto ClassifyEdges = [&]() {
+        Edges.clear();
+        for (size_t i = 0; i < NumTriangles * 3; i += 3)
+        {
+            for (Uint32 e = 0; e < 3; ++e)
+                Edges.push_back(GetEdgeKey(Indices[i + e], Indices[i + (e + 1) % 3]));
+        }
+        std::sort(Edges.begin(), Edges.end());
+
+        BorderEdges.clear();
+        std::fill(IsBorder.begin(), IsBorder.end(), false);
+        size_t NumUniqueEdges = 0;
+        for (size_t Start = 0; Start < Edges.size();)
+        {
+            size_t End = Start + 1;
+            while (End < Edges.size() && Edges[End] == Edges[Start])
+                ++End;
+
+            const Uint32 v0 = static_cast<Uint32>(Edges[Start] >> 32u);
+            const Uint32 v1 = static_cast<Uint32>(Edges[Start] & 0xFFFFFFFFu);
+            if (End - Start == 1)
+            {
+                BorderEdges.push_back(Edges[Start]);
+                IsBorder[v0] = IsBorder[v1] = true;
+            }
+            else if (End - Start > 2)
+            {
+                // Non-manifold edge
+                IsLocked[v0] = IsLocked[v1] = true;
+            }
+
+            Edges[NumUniqueEdges++] = Edges[Start];
+            Start                   = End;
+        }
+        Edges.resize(NumUniqueEdges);
+    };
+    ClassifyEdges();
+
+    // Border edges get an additional plane that is perpendicular to the triangle
+    // to keep the border vertices on the border line.
+    constexpr float BorderWeight = 10;
+
+    std::vector<Quadric> Quadrics(NumVertices);
+    for (size_t i = 0; i < NumTriangles * 3; i += 3)
+    {
+        const float3& P0 = Positions[Indices[i + 0]];
+        const float3& P1 = Positions[Indices[i + 1]];
+        const float3& P2 = Positions[Indices[i + 2]];
+
+        float3      N    = cross(P1 - P0, P2 - P0);
+        const float Area = length(N);
+        if (Area == 0)
+            continue;
+        N /= Area;
+
+        const Quadric Q{N, -dot(N, P0), Area};
+        for (Uint32 e = 0; e < 3; ++e)
+        {
+            const Uint32 v0 = Indices[i + e];
+            const Uint32 v1 = Indices[i + (e + 1) % 3];
+            Quadrics[v0] += Q;
+
+            if (!std::binary_search(BorderEdges.begin(), BorderEdges.end(), GetEdgeKey(v0, v1)))
+                continue;
+
+            const float3 Edge       = Positions[v1] - Positions[v0];
+            const float  EdgeLength = length(Edge);
+            if (EdgeLength == 0)
+                continue;
+
+            const float3  BorderN = cross(Edge / EdgeLength, N);
+            const Quadric BorderQ{BorderN, -dot(BorderN, Positions[v0]), EdgeLength * EdgeLength * BorderWeight};
+            Quadrics[v0] += BorderQ;
+            Quadrics[v1] += BorderQ;
+        }
+    }
+
+    struct Collapse
+    {
+        Uint32 From  = 0;
+        Uint32 To    = 0;
+        float  Error = 0;
+    };
+    std::vector<Collapse> Collapses;
+    std::vector<Uint32>   Remap(NumVertices);
+    std::vector<bool>     IsTouched(NumVertices);
+
+    const float ErrorLimit = TargetError * TargetError;
+    float       MaxError   = 0;
+    while (NumTriangles > TargetTriangles)
+    {
+        TriangleAdjacency Adjacency{Indices.data(), NumTriangles, NumVertices};
+
+        auto CanCollapse = [&](Uint32 From, Uint32 To) {
+            if (IsLocked[From])
+                return false;
+            // Border vertices may only move along the border
+            if (IsBorder[From] && !std::binary_search(BorderEdges.begin(), BorderEdges.end(), GetEdgeKey(From, To)))
+                return false;
+            return true;
+        };
+
+        Collapses.clear();
+        for (Uint64 Edge : Edges)
+        {
+            const Uint32 v0 = static_cast<Uint32>(Edge >> 32u);
+            const Uint32 v1 = static_cast<Uint32>(Edge & 0xFFFFFFFFu);
+            if (v0 == v1)
+                continue;
+
+            const float Error01 = CanCollapse(v0, v1) ? Quadrics[v0].GetError(Positions[v1]) : FLT_MAX;
+            const float Error10 = CanCollapse(v1, v0) ? Quadrics[v1].GetError(Positions[v0]) : FLT_MAX;
+            if (Error01 == FLT_MAX && Error10 == FLT_MAX)
+                continue;
+
+            Collapses.push_back(Error01 <= Error10 ? Collapse{v0, v1, Error01} : Collapse{v1, v0, Error10});
+        }
+        std::sort(Collapses.begin(), Collapses.end(),
+                  [](const Collapse& C0, const Collapse& C1) {
+                      return C0.Error < C1.Error;
+                  });
+
+        // Returns true if moving From to To flips any of the triangles that remain.
+        auto HasFlips = [&](Uint32 From, Uint32 To) {
+            const Uint32* pTris = Adjacency.GetActiveTriangles(From);
+            for (Uint32 a = 0; a < Adjacency.GetNumActiveTriangles(From); ++a)
+            {
+                const Uint32* pTri = &Indices[size_t{pTris[a]} * 3];
+                if (pTri[0] == To || pTri[1] == To || pTri[2] == To)
+                    continue;
+
+                float3 P[3] = {Positions[pTri[0]], Positions[pTri[1]], Positions[pTri[2]]};
+
+                const float3 N0 = cross(P[1] - P[0], P[2] - P[0]);
+                for (Uint32 i = 0; i < 3; ++i)
+                {
+                    if (pTri[i] == From)
+                        P[i] = Positions[To];
+                }
+                const float3 N1 = cross(P[1] - P[0], P[2] - P[0]);
+
+                // Also reject triangles that become too thin
+                if (dot(N0, N1) <= 0.25f * length(N0) * length(N1))
+                    return true;
+            }
+            return false;
+        };
+
+        std::iota(Remap.begin(), Remap.end(), 0u);
+        std::fill(IsTouched.begin(), IsTouched.end(), false);
+
+        size_t NumRemovedTriangles = 0;
+        size_t NumCollapses        = 0;
+        for (const Collapse& C : Collapses)
+        {
+            // Collapses that were skipped because of the touched vertices
+            // will be retried in the next pass.
+            if (C.Error > ErrorLimit || NumTriangles - NumRemovedTriangles <= TargetTriangles)
+                break;
+
+            // Every vertex is collapsed at most once per pass, and the triangles
+            // around the collapsed vertices are not changed twice.
+            if (IsTouched[C.From] || IsTouched[C.To] || HasFlips(C.From, C.To))
+                continue;
+
+            Remap[C.From] = C.To;
+            Quadrics[C.To] += Quadrics[C.From];
+            MaxError = std::max(MaxError, C.Error);
+            ++NumCollapses;
+
+            const Uint32* pTris = Adjacency.GetActiveTriangles(C.From);
+            for (Uint32 a = 0; a < Adjacency.GetNumActiveTriangles(C.From); ++a)
+            {
+                const Uint32* pTri = &Indices[size_t{pTris[a]} * 3];
+                for (Uint32 i = 0; i < 3; ++i)
+                    IsTouched[pTri[i]] = true;
+                if (pTri[0] == C.To || pTri[1] == C.To || pTri[2] == C.To)
+                    ++NumRemovedTriangles;
+            }
+        }
+
+        if (NumCollapses == 0)
+            break;
+
+        // Remap the indices and remove the degenerate triangles
+        size_t NumDstTriangles = 0;
+        for (size_t Tri = 0; Tri < NumTriangles; ++Tri)
+        {
+            const Uint32 v0 = Remap[Indices[Tri * 3 + 0]];
+            const Uint32 v1 = Remap[Indices[Tri * 3 + 1]];
+            const Uint32 v2 = Remap[Indices[Tri * 3 + 2]];
+            if (v0 == v1 || v1 == v2 || v2 == v0)
+                continue;
+
+            Indices[NumDstTriangles * 3 + 0] = v0;
+            Indices[NumDstTriangles * 3 + 1] = v1;
+            Indices[NumDstTriangles * 3 + 2] = v2;
+            ++NumDstTriangles;
+        }
+        NumTriangles = NumDstTriangles;
+        Indices.resize(NumTriangles * 3);
+
+        ClassifyEdges();
+    }
+
+    std::copy(Indices.begin(), Indices.end(), pDstIndices);
+    if (pResultError != nullptr)
+        *pResultError = std::sqrt(MaxError);
+
+    return Indices.size();
+}
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -47,6 +47,16 @@ size_t ResourceManager::VertexLayoutKey::Hasher::operator()(const VertexLayoutKe
     return Hash;
 }
 
+size_t ResourceManager::IndexDataKey::Hasher::operator()(const IndexDataKey& Key) const
+{
+    return ComputeHash(Key.ContentHash.LowPart, Key.ContentHash.HighPart);
+}
+
+size_t ResourceManager::VertexDataKey::Hasher::operator()(const VertexDataKey& Key) const
+{
+    return ComputeHash(Key.ContentHash.LowPart, Key.ContentHash.HighPart, VertexLayoutKey::Hasher{}(Key.LayoutKey));
+}
+
 RefCntAutoPtr<ResourceManager> ResourceManager::Create(IRenderDevice*    pDevice,
                                                        const CreateInfo& CI)
 {
@@ -187,6 +197,69 @@ size_t ResourceManager::TexAllocations::GetShardIndex(const char* CacheId, size_
     return ShardCount > 1 ? CStringHash<Char>{}(CacheId) % ShardCount : 0;
 }
 
+template <typename KeyType, typename AllocationType>
+template <typename CreateAllocationType>
+RefCntAutoPtr<AllocationType> ResourceManager::ContentAllocations<KeyType, AllocationType>::FindOrCreate(const KeyType& Key, CreateAllocationType&& CreateAllocation)
+{
+    {
+        std::shared_lock<Threading::SharedMutex> SharedLock{m_Mtx};
+
+        auto it = m_Map.find(Key);
+        if (it != m_Map.end())
+        {
+            if (RefCntAutoPtr<AllocationType> pAllocation = it->second.Lock())
+                return pAllocation;
+        }
+    }
+
+    // Check the map again and create the allocation under the same unique lock, so that
+    // no other thread can create an allocation for the same key in between.
+    std::unique_lock<Threading::SharedMutex> UniqueLock{m_Mtx};
+
+    auto it = m_Map.find(Key);
+    if (it != m_Map.end())
+    {
+        if (RefCntAutoPtr<AllocationType> pAllocation = it->second.Lock())
+            return pAllocation;
+    }
+
+    RefCntAutoPtr<AllocationType> pAllocation = CreateAllocation();
+    if (pAllocation)
+    {
+        if (it != m_Map.end())
+        {
+            it->second = RefCntWeakPtr<AllocationType>{pAllocation};
+        }
+        else
+        {
+            m_Map.emplace(Key, RefCntWeakPtr<AllocationType>{pAllocation});
+            if (m_Map.size() >= std::max(m_SizeAfterSweep * 2, size_t{64}))
+                RemoveExpiredAllocations();
+        }
+    }
+    else if (it != m_Map.end())
+    {
+        // Erase the expired allocation
+        m_Map.erase(it);
+    }
+
+    return pAllocation;
+}
+
+template <typename KeyType, typename AllocationType>
+void ResourceManager::ContentAllocations<KeyType, AllocationType>::RemoveExpiredAllocations()
+{
+    // Must be called under the unique lock
+    for (auto it = m_Map.begin(); it != m_Map.end();)
+    {
+        if (it->second.Lock())
+            ++it;
+        else
+            it = m_Map.erase(it);
+    }
+    m_SizeAfterSweep = m_Map.size();
+}
+
 RefCntAutoPtr<ITextureAtlasSuballocation> ResourceManager::FindTextureAllocation(const char* CacheId)
 {
     return m_TexAllocations[TexAllocations::GetShardIndex(CacheId, m_TexAllocations.size())].Find(CacheId);
@@ -354,6 +427,21 @@ RefCntAutoPtr<IBufferSuballocation> ResourceManager::AllocateIndices(Uint32 Size
     return pIndices;
 }
 
+RefCntAutoPtr<IBufferSuballocation> ResourceManager::FindOrAllocateIndices(Uint32                                            Size,
+                                                                          Uint32                                            Alignment,
+                                                                          const XXH128Hash&                                 ContentHash,
+                                                                          const std::function<void(IBufferSuballocation*)>& InitAllocation)
+{
+    return m_IndexAllocations.FindOrCreate(
+        {ContentHash},
+        [&]() {
+            RefCntAutoPtr<IBufferSuballocation> pIndices = AllocateIndices(Size, Alignment);
+            if (pIndices && InitAllocation)
+                InitAllocation(pIndices);
+            return pIndices;
+        });
+}
+
 RefCntAutoPtr<IVertexPool> ResourceManager::CreateVertexPoolForLayout(const VertexLayoutKey& Key) const
 {
     RefCntAutoPtr<IVertexPool> pVtxPool;
@@ -453,6 +541,20 @@ RefCntAutoPtr<IVertexPoolAllocation> ResourceManager::AllocateVertices(const Ver
     return pVertices;
 }
 
+RefCntAutoPtr<IVertexPoolAllocation> ResourceManager::FindOrAllocateVertices(const VertexLayoutKey&                             LayoutKey,
+                                                                            Uint32                                             VertexCount,
+                                                                            const XXH128Hash&                                  ContentHash,
+                                                                            const std::function<void(IVertexPoolAllocation*)>& InitAllocation)
+{
+    return m_VertexAllocations.FindOrCreate(
+        {LayoutKey, ContentHash},
+        [&]() {
+            RefCntAutoPtr<IVertexPoolAllocation> pVertices = AllocateVertices(LayoutKey, VertexCount);
+            if (pVertices && InitAllocation)
+                InitAllocation(pVertices);
+            return pVertices;
+        });
+}
 
 Uint32 ResourceManager::GetTextureVersion() const
 {
@@ -0,0 +1,486 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFSceneBVH.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+#include "DebugUtilities.hpp"
+
+// Box/frustum tests process four planes at once with SSE2 or NEON when they are part of the target baseline.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define GLTF_SCENE_BVH_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define GLTF_SCENE_BVH_NEON
+#endif
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+namespace
+{
+
+constexpr Uint32 MaxPrimsPerLeaf = 4;
+
+bool IsValidBoundBox(const BoundBox& BB)
+{
+    return BB.Min.x <= BB.Max.x && BB.Min.y <= BB.Max.y && BB.Min.z <= BB.Max.z;
+}
+
+BoundBox GetEmptyBoundBox()
+{
+    return BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+void EnlargeBoundBox(BoundBox& BB, const BoundBox& Other)
+{
+    BB.Min = std::min(BB.Min, Other.Min);
+    BB.Max = std::max(BB.Max, Other.Max);
+}
+
+// Box that is never culled. Its extent is small enough for the frustum test not to overflow.
+BoundBox GetUnboundedBox()
+{
+    constexpr float MaxCoord = FLT_MAX * 0.25f;
+    return BoundBox{float3{-MaxCoord, -MaxCoord, -MaxCoord}, float3{+MaxCoord, +MaxCoord, +MaxCoord}};
+}
+
+// Returns the world-space bounding box of the primitive of the node. The box of a node with
+// EXT_mesh_gpu_instancing instances encloses all instances.
+BoundBox GetPrimitiveWorldBounds(const Model& Mdl, const Node& N, const Primitive& Prim, const ModelTransforms& Transforms)
+{
+    if (N.pSkin != nullptr)
+    {
+        // Skinned vertices are placed by the joints and not by the node matrix. Without
+        // the joint bounds, they may be anywhere.
+        if (!N.pSkin->JointBounds.empty())
+        {
+            const BoundBox SkinnedBB = Mdl.ComputeSkinnedBoundingBox(N, Transforms);
+            if (IsValidBoundBox(SkinnedBB))
+                return SkinnedBB;
+        }
+        return GetUnboundedBox();
+    }
+
+    const float4x4& GlobalMatrix = Transforms.NodeGlobalMatrices[N.Index];
+    if (N.InstanceMatrices.empty())
+        return Prim.BB.Transform(GlobalMatrix);
+
+    BoundBox BB = GetEmptyBoundBox();
+    for (const float4x4& InstanceMatrix : N.InstanceMatrices)
+        EnlargeBoundBox(BB, Prim.BB.Transform(InstanceMatrix * GlobalMatrix));
+    return BB;
+}
+
+enum class FRUSTUM_TEST_RESULT
+{
+    OUTSIDE,
+    INTERSECTING,
+    INSIDE
+};
+
+// Frustum planes in structure-of-arrays layout. The six planes are padded to eight with
+// planes that contain every point, so that they can be tested in two groups of four.
+struct FrustumPlanesSoA
+{
+    static constexpr Uint32 NumPlanes = 8;
+
+    alignas(16) float NormalX[NumPlanes];
+    alignas(16) float NormalY[NumPlanes];
+    alignas(16) float NormalZ[NumPlanes];
+    alignas(16) float AbsNormalX[NumPlanes];
+    alignas(16) float AbsNormalY[NumPlanes];
+    alignas(16) float AbsNormalZ[NumPlanes];
+    alignas(16) float Distance[NumPlanes];
+
+    explicit FrustumPlanesSoA(const ViewFrustum& Frustum)
+    {
+        for (Uint32 i = 0; i < NumPlanes; ++i)
+        {
+            Plane3D Plane;
+            if (i < ViewFrustum::NUM_PLANES)
+                Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+            else
+                Plane.Distance = 1;
+
+            NormalX[i]    = Plane.Normal.x;
+            NormalY[i]    = Plane.Normal.y;
+            NormalZ[i]    = Plane.Normal.z;
+            AbsNormalX[i] = std::abs(Plane.Normal.x);
+            AbsNormalY[i] = std::abs(Plane.Normal.y);
+            AbsNormalZ[i] = std::abs(Plane.Normal.z);
+            Distance[i]   = Plane.Distance;
+        }
+    }
+
+    // The box is outside if it is entirely behind any plane, and inside if it is in front of all planes.
+    // The distance of the box center to the plane is compared with the projection of the box half-extent
+    // onto the plane normal.
+    FRUSTUM_TEST_RESULT TestBox(const BoundBox& BB) const
+    {
+        const float3 Center = (BB.Max + BB.Min) * 0.5f;
+        const float3 Extent = (BB.Max - BB.Min) * 0.5f;
+
+        bool Intersecting = false;
+#if defined(GLTF_SCENE_BVH_SSE2)
+        const __m128 CenterX = _mm_set1_ps(Center.x);
+        const __m128 CenterY = _mm_set1_ps(Center.y);
+        const __m128 CenterZ = _mm_set1_ps(Center.z);
+        const __m128 ExtentX = _mm_set1_ps(Extent.x);
+        const __m128 ExtentY = _mm_set1_ps(Extent.y);
+        const __m128 ExtentZ = _mm_set1_ps(Extent.z);
+        for (Uint32 i = 0; i < NumPlanes; i += 4)
+        {
+            __m128 Dist = _mm_load_ps(Distance + i);
+            Dist        = _mm_add_ps(Dist, _mm_mul_ps(_mm_load_ps(NormalX + i), CenterX));
+            Dist        = _mm_add_ps(Dist, _mm_mul_ps(_mm_load_ps(NormalY + i), CenterY));
+            Dist        = _mm_add_ps(Dist, _mm_mul_ps(_mm_load_ps(NormalZ + i), CenterZ));
+
+            __m128 Radius = _mm_mul_ps(_mm_load_ps(AbsNormalX + i), ExtentX);
+            Radius        = _mm_add_ps(Radius, _mm_mul_ps(_mm_load_ps(AbsNormalY + i), ExtentY));
+            Radius        = _mm_add_ps(Radius, _mm_mul_ps(_mm_load_ps(AbsNormalZ + i), ExtentZ));
+
+            if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(Dist, Radius), _mm_setzero_ps())) != 0)
+                return FRUSTUM_TEST_RESULT::OUTSIDE;
+            if (_mm_movemask_ps(_mm_cmplt_ps(Dist, Radius)) != 0)
+                Intersecting = true;
+        }
+#elif defined(GLTF_SCENE_BVH_NEON)
+        for (Uint32 i = 0; i < NumPlanes; i += 4)
+        {
+            float32x4_t Dist = vld1q_f32(Distance + i);
+            Dist             = vaddq_f32(Dist, vmulq_n_f32(vld1q_f32(NormalX + i), Center.x));
+            Dist             = vaddq_f32(Dist, vmulq_n_f32(vld1q_f32(NormalY + i), Center.y));
+            Dist             = vaddq_f32(Dist, vmulq_n_f32(vld1q_f32(NormalZ + i), Center.z));
+
+            float32x4_t Radius = vmulq_n_f32(vld1q_f32(AbsNormalX + i), Extent.x);
+            Radius             = vaddq_f32(Radius, vmulq_n_f32(vld1q_f32(AbsNormalY + i), Extent.y));
+            Radius             = vaddq_f32(Radius, vmulq_n_f32(vld1q_f32(AbsNormalZ + i), Extent.z));
+
+            if (vmaxvq_u32(vcltq_f32(vaddq_f32(Dist, Radius), vdupq_n_f32(0))) != 0)
+                return FRUSTUM_TEST_RESULT::OUTSIDE;
+            if (vmaxvq_u32(vcltq_f32(Dist, Radius)) != 0)
+                Intersecting = true;
+        }
+#else
+        for (Uint32 i = 0; i < NumPlanes; ++i)
+        {
+            const float Dist   = NormalX[i] * Center.x + NormalY[i] * Center.y + NormalZ[i] * Center.z + Distance[i];
+            const float Radius = AbsNormalX[i] * Extent.x + AbsNormalY[i] * Extent.y + AbsNormalZ[i] * Extent.z;
+            if (Dist + Radius < 0)
+                return FRUSTUM_TEST_RESULT::OUTSIDE;
+            if (Dist < Radius)
+                Intersecting = true;
+        }
+#endif
+        return Intersecting ? FRUSTUM_TEST_RESULT::INTERSECTING : FRUSTUM_TEST_RESULT::INSIDE;
+    }
+};
+
+} // namespace
+
+void SceneBVH::Build(const Model& Mdl, Uint32 SceneIndex, const ModelTransforms& Transforms)
+{
+    m_pModel = &Mdl;
+    m_Nodes.clear();
+    m_Prims.clear();
+    m_PrimBounds.clear();
+    m_NumStaticPrims    = 0;
+    m_DynamicNodesStart = 0;
+
+    if (SceneIndex >= Mdl.Scenes.size())
+    {
+        DEV_ERROR("Invalid scene index ", SceneIndex);
+        return;
+    }
+    if (!Mdl.CompatibleWithTransforms(Transforms))
+    {
+        DEV_ERROR("Incompatible transforms. Please use the ComputeTransforms() method first.");
+        return;
+    }
+
+    const Scene& scene = Mdl.Scenes[SceneIndex];
+
+    // A node is dynamic if it is animated, has an animated ancestor or is skinned.
+    // Parents precede their children in the flattened hierarchy.
+    std::vector<bool> IsDynamic(Mdl.Nodes.size(), false);
+    for (const Animation& Anim : Mdl.Animations)
+    {
+        for (const AnimationChannel& Channel : Anim.Channels)
+        {
+            if (Channel.pNode != nullptr && Channel.PathType != AnimationChannel::PATH_TYPE::WEIGHTS)
+                IsDynamic[Channel.pNode->Index] = true;
+        }
+    }
+    for (size_t i = 0; i < scene.HierarchyNodeIds.size(); ++i)
+    {
+        const Uint32 NodeId   = scene.HierarchyNodeIds[i];
+        const Int32  ParentId = scene.HierarchyParentIds[i];
+        if (Mdl.Nodes[NodeId].pSkin != nullptr || (ParentId >= 0 && IsDynamic[ParentId]))
+            IsDynamic[NodeId] = true;
+    }
+
+    std::vector<ScenePrimitiveRef> DynamicPrims;
+    for (const Node* pNode : scene.LinearNodes)
+    {
+        VERIFY_EXPR(pNode != nullptr);
+        if (pNode->pMesh == nullptr)
+            continue;
+
+        for (size_t PrimIdx = 0; PrimIdx < pNode->pMesh->Primitives.size(); ++PrimIdx)
+        {
+            if (!IsValidBoundBox(pNode->pMesh->Primitives[PrimIdx].BB))
+                continue;
+
+            const ScenePrimitiveRef Ref{static_cast<Uint32>(pNode->Index), static_cast<Uint32>(PrimIdx)};
+            if (IsDynamic[pNode->Index])
+                DynamicPrims.push_back(Ref);
+            else
+                m_Prims.push_back(Ref);
+        }
+    }
+    m_NumStaticPrims = m_Prims.size();
+    m_Prims.insert(m_Prims.end(), DynamicPrims.begin(), DynamicPrims.end());
+
+    m_PrimBounds.resize(m_Prims.size());
+    for (size_t i = 0; i < m_Prims.size(); ++i)
+    {
+        const ScenePrimitiveRef& Ref = m_Prims[i];
+        const Node&              N   = Mdl.Nodes[Ref.NodeIndex];
+        m_PrimBounds[i]              = GetPrimitiveWorldBounds(Mdl, N, N.pMesh->Primitives[Ref.PrimitiveIndex], Transforms);
+    }
+
+    if (m_Prims.empty())
+        return;
+
+    const Uint32 NumStaticPrims = static_cast<Uint32>(m_NumStaticPrims);
+    const Uint32 NumPrims       = static_cast<Uint32>(m_Prims.size());
+
+    std::vector<Uint32> Order(m_Prims.size());
+    std::iota(Order.begin(), Order.end(), 0u);
+    m_Nodes.reserve(size_t{NumPrims} * 2);
+    if (NumStaticPrims > 0 && NumStaticPrims < NumPrims)
+    {
+        // The root joins the static and the dynamic subtrees
+        m_Nodes.emplace_back();
+        BuildSubtree(Order, 0, NumStaticPrims);
+        m_DynamicNodesStart = static_cast<Uint32>(m_Nodes.size());
+        BuildSubtree(Order, NumStaticPrims, NumPrims);
+
+        BVHNode& Root = m_Nodes[0];
+        Root.Offset   = m_DynamicNodesStart;
+        Root.BB       = m_Nodes[1].BB;
+        EnlargeBoundBox(Root.BB, m_Nodes[m_DynamicNodesStart].BB);
+    }
+    else
+    {
+        BuildSubtree(Order, 0, NumPrims);
+        m_DynamicNodesStart = NumStaticPrims > 0 ? static_cast<Uint32>(m_Nodes.size()) : 0;
+    }
+
+    // Store the primitives in the order of the leaves
+    std::vector<ScenePrimitiveRef> SortedPrims(m_Prims.size());
+    std::vector<BoundBox>          SortedBounds(m_Prims.size());
+    for (size_t i = 0; i < Order.size(); ++i)
+    {
+        SortedPrims[i]  = m_Prims[Order[i]];
+        SortedBounds[i] = m_PrimBounds[Order[i]];
+    }
+    m_Prims.swap(SortedPrims);
+    m_PrimBounds.swap(SortedBounds);
+}
+
+Uint32 SceneBVH::BuildSubtree(std::vector<Uint32>& Order, Uint32 FirstPrim, Uint32 EndPrim)
+{
+    VERIFY_EXPR(FirstPrim < EndPrim);
+
+    const Uint32 NodeIdx = static_cast<Uint32>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    BoundBox BB             = GetEmptyBoundBox();
+    BoundBox CentroidBounds = GetEmptyBoundBox();
+    for (Uint32 i = FirstPrim; i < EndPrim; ++i)
+    {
+        const BoundBox& PrimBB = m_PrimBounds[Order[i]];
+        EnlargeBoundBox(BB, PrimBB);
+
+        const float3 Centroid = (PrimBB.Min + PrimBB.Max) * 0.5f;
+        EnlargeBoundBox(CentroidBounds, BoundBox{Centroid, Centroid});
+    }
+    m_Nodes[NodeIdx].BB = BB;
+
+    if (EndPrim - FirstPrim <= MaxPrimsPerLeaf)
+    {
+        m_Nodes[NodeIdx].Offset   = FirstPrim;
+        m_Nodes[NodeIdx].NumPrims = EndPrim - FirstPrim;
+        return NodeIdx;
+    }
+
+    // Split at the median centroid along the longest axis of the centroid bounds
+    const float3 Extent = CentroidBounds.Max - CentroidBounds.Min;
+    const int    Axis   = (Extent.x >= Extent.y && Extent.x >= Extent.z) ? 0 : (Extent.y >= Extent.z ? 1 : 2);
+
+    const Uint32 MidPrim = FirstPrim + (EndPrim - FirstPrim) / 2;
+    std::nth_element(Order.begin() + FirstPrim, Order.begin() + MidPrim, Order.begin() + EndPrim,
+                     [this, Axis](Uint32 Prim0, Uint32 Prim1) {
+                         const BoundBox& BB0 = m_PrimBounds[Prim0];
+                         const BoundBox& BB1 = m_PrimBounds[Prim1];
+                         return BB0.Min[Axis] + BB0.Max[Axis] < BB1.Min[Axis] + BB1.Max[Axis];
+                     });
+
+    BuildSubtree(Order, FirstPrim, MidPrim);
+    m_Nodes[NodeIdx].Offset = BuildSubtree(Order, MidPrim, EndPrim);
+    return NodeIdx;
+}
+
+void SceneBVH::RefitNode(Uint32 NodeIdx, const ModelTransforms& Transforms)
+{
+    BVHNode& CurrNode = m_Nodes[NodeIdx];
+    if (CurrNode.NumPrims == 0)
+    {
+        CurrNode.BB = m_Nodes[NodeIdx + 1].BB;
+        EnlargeBoundBox(CurrNode.BB, m_Nodes[CurrNode.Offset].BB);
+        return;
+    }
+
+    CurrNode.BB = GetEmptyBoundBox();
+    for (Uint32 i = CurrNode.Offset; i < CurrNode.Offset + CurrNode.NumPrims; ++i)
+    {
+        const ScenePrimitiveRef& Ref    = m_Prims[i];
+        const Node&              N      = m_pModel->Nodes[Ref.NodeIndex];
+        BoundBox&                PrimBB = m_PrimBounds[i];
+
+        PrimBB = GetPrimitiveWorldBounds(*m_pModel, N, N.pMesh->Primitives[Ref.PrimitiveIndex], Transforms);
+        EnlargeBoundBox(CurrNode.BB, PrimBB);
+    }
+}
+
+void SceneBVH::Refit(const ModelTransforms& Transforms, bool RefitStatic)
+{
+    if (m_Nodes.empty())
+        return;
+
+    VERIFY_EXPR(m_pModel != nullptr);
+    if (!m_pModel->CompatibleWithTransforms(Transforms))
+    {
+        DEV_ERROR("Incompatible transforms. Please use the ComputeTransforms() method first.");
+        return;
+    }
+
+    // Children are stored after their parents, so processing the nodes backwards
+    // refits every node after its children.
+    const Uint32 NumNodes  = static_cast<Uint32>(m_Nodes.size());
+    const Uint32 FirstNode = RefitStatic ? 0 : m_DynamicNodesStart;
+    for (Uint32 NodeIdx = NumNodes; NodeIdx > FirstNode; --NodeIdx)
+        RefitNode(NodeIdx - 1, Transforms);
+
+    // The root joins the subtrees when both are present
+    if (FirstNode > 0 && FirstNode < NumNodes)
+        RefitNode(0, Transforms);
+}
+
+size_t SceneBVH::QueryVisible(const ViewFrustum&              Frustum,
+                              std::vector<ScenePrimitiveRef>& VisiblePrims,
+                              SceneBVHQueryStats*             pStats) const
+{
+    if (pStats != nullptr)
+        *pStats = {};
+
+    if (m_Nodes.empty())
+        return 0;
+
+    const FrustumPlanesSoA Planes{Frustum};
+    const size_t           NumVisibleBefore = VisiblePrims.size();
+
+    Uint32 NumNodeTests      = 0;
+    Uint32 NumPrimitiveTests = 0;
+
+    // The second element is true if the node is known to be entirely inside the frustum
+    std::vector<std::pair<Uint32, bool>> Stack;
+    Stack.reserve(64);
+    Stack.emplace_back(0, false);
+    while (!Stack.empty())
+    {
+        const Uint32 NodeIdx = Stack.back().first;
+        bool         Inside  = Stack.back().second;
+        Stack.pop_back();
+
+        const BVHNode& CurrNode = m_Nodes[NodeIdx];
+        if (!Inside)
+        {
+            ++NumNodeTests;
+            const FRUSTUM_TEST_RESULT Result = Planes.TestBox(CurrNode.BB);
+            if (Result == FRUSTUM_TEST_RESULT::OUTSIDE)
+                continue;
+            Inside = Result == FRUSTUM_TEST_RESULT::INSIDE;
+        }
+
+        if (CurrNode.NumPrims == 0)
+        {
+            Stack.emplace_back(CurrNode.Offset, Inside);
+            Stack.emplace_back(NodeIdx + 1, Inside);
+            continue;
+        }
+
+        // The box of a single-primitive leaf is the box of the primitive
+        if (Inside || CurrNode.NumPrims == 1)
+        {
+            VisiblePrims.insert(VisiblePrims.end(), m_Prims.begin() + CurrNode.Offset, m_Prims.begin() + CurrNode.Offset + CurrNode.NumPrims);
+            continue;
+        }
+
+        for (Uint32 i = CurrNode.Offset; i < CurrNode.Offset + CurrNode.NumPrims; ++i)
+        {
+            ++NumPrimitiveTests;
+            if (Planes.TestBox(m_PrimBounds[i]) != FRUSTUM_TEST_RESULT::OUTSIDE)
+                VisiblePrims.push_back(m_Prims[i]);
+        }
+    }
+
+    if (pStats != nullptr)
+    {
+        pStats->NumNodeTests      = NumNodeTests;
+        pStats->NumPrimitiveTests = NumPrimitiveTests;
+    }
+
+    return VisiblePrims.size() - NumVisibleBefore;
+}
+
+BoundBox SceneBVH::GetBounds() const
+{
+    return !m_Nodes.empty() ? m_Nodes[0].BB : GetEmptyBoundBox();
+}
+
+} // namespace GLTF
+
+} // namespace Diligent
@@ -0,0 +1,367 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFTriangleBVH.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace GLTF
+{
+
+namespace
+{
+
+// The number of bins used to evaluate the surface area heuristic along each axis.
+constexpr Uint32 NumSAHBins = 16;
+
+// Nodes with at most this many triangles become leaves when splitting them does not reduce the SAH cost.
+constexpr Uint32 MaxLeafTriangles = 8;
+
+// Deeper nodes become leaves regardless of the triangle count, which bounds the traversal stack size.
+constexpr Uint32 MaxTreeDepth = 64;
+
+// The cost of traversing a node relative to the cost of intersecting a triangle.
+constexpr float TraversalCost = 1.f;
+
+// Half of the box surface area. The factor of two cancels out in the SAH cost ratios.
+float HalfSurfaceArea(const float3& Min, const float3& Max)
+{
+    const float3 Extent = Max - Min;
+    return Extent.x * Extent.y + Extent.y * Extent.z + Extent.z * Extent.x;
+}
+
+float SafeReciprocal(float Value)
+{
+    return std::abs(Value) > 1e-20f ? 1.f / Value : (Value >= 0 ? 1e20f : -1e20f);
+}
+
+} // namespace
+
+struct TriangleBVH::BuildTriangle
+{
+    float3 Min;
+    float3 Max;
+    float3 Centroid;
+
+    // Index of the triangle in the source index list
+    Uint32 Index = 0;
+};
+
+void TriangleBVH::Build(const float3* pPositions,
+                        Uint32        NumVertices,
+                        const Uint32* pIndices,
+                        Uint32        NumTriangles,
+                        const Uint32* pTriangleIds)
+{
+    m_Nodes.clear();
+    m_Vertices.clear();
+    m_TriangleIds.clear();
+
+    if (NumTriangles == 0)
+        return;
+
+    DEV_CHECK_ERR(pPositions != nullptr && pIndices != nullptr, "Positions and indices must not be null");
+
+    std::vector<BuildTriangle> Triangles;
+    Triangles.reserve(NumTriangles);
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        const Uint32* pTri = pIndices + size_t{t} * 3;
+        if (pTri[0] >= NumVertices || pTri[1] >= NumVertices || pTri[2] >= NumVertices)
+            continue;
+
+        const float3& P0 = pPositions[pTri[0]];
+        const float3& P1 = pPositions[pTri[1]];
+        const float3& P2 = pPositions[pTri[2]];
+
+        BuildTriangle Tri;
+        Tri.Min      = std::min(std::min(P0, P1), P2);
+        Tri.Max      = std::max(std::max(P0, P1), P2);
+        Tri.Centroid = (Tri.Min + Tri.Max) * 0.5f;
+        Tri.Index    = t;
+        Triangles.push_back(Tri);
+    }
+    if (Triangles.empty())
+        return;
+
+    m_Nodes.reserve(Triangles.size() * 2);
+    BuildSubtree(Triangles, 0, static_cast<Uint32>(Triangles.size()), 0);
+    m_Nodes.shrink_to_fit();
+
+    m_Vertices.resize(Triangles.size() * 3);
+    m_TriangleIds.resize(Triangles.size());
+    for (size_t i = 0; i < Triangles.size(); ++i)
+    {
+        const Uint32  SrcTri = Triangles[i].Index;
+        const Uint32* pTri   = pIndices + size_t{SrcTri} * 3;
+        for (size_t v = 0; v < 3; ++v)
+            m_Vertices[i * 3 + v] = pPositions[pTri[v]];
+        m_TriangleIds[i] = pTriangleIds != nullptr ? pTriangleIds[SrcTri] : SrcTri;
+    }
+}
+
+Uint32 TriangleBVH::BuildSubtree(std::vector<BuildTriangle>& Triangles, Uint32 First, Uint32 End, Uint32 Depth)
+{
+    VERIFY_EXPR(First < End);
+
+    const Uint32 NodeIdx = static_cast<Uint32>(m_Nodes.size());
+    m_Nodes.emplace_back();
+
+    float3 Min{+FLT_MAX, +FLT_MAX, +FLT_MAX};
+    float3 Max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    float3 CentroidMin = Min;
+    float3 CentroidMax = Max;
+    for (Uint32 i = First; i < End; ++i)
+    {
+        const BuildTriangle& Tri = Triangles[i];
+
+        Min         = std::min(Min, Tri.Min);
+        Max         = std::max(Max, Tri.Max);
+        CentroidMin = std::min(CentroidMin, Tri.Centroid);
+        CentroidMax = std::max(CentroidMax, Tri.Centroid);
+    }
+    m_Nodes[NodeIdx].Min = Min;
+    m_Nodes[NodeIdx].Max = Max;
+
+    const Uint32 Count    = End - First;
+    const auto   MakeLeaf = [&]() {
+        m_Nodes[NodeIdx].Offset       = First;
+        m_Nodes[NodeIdx].NumTriangles = Count;
+        return NodeIdx;
+    };
+    if (Count == 1 || Depth >= MaxTreeDepth)
+        return MakeLeaf();
+
+    // Bins of the centroids along the axis. The bin of a triangle must be computed identically
+    // when evaluating the splits and when partitioning the triangles.
+    const float3 CentroidExtent = CentroidMax - CentroidMin;
+    const auto   GetBin         = [&](const BuildTriangle& Tri, int Axis) {
+        const float Scale = static_cast<float>(NumSAHBins) / CentroidExtent[Axis];
+        return std::min(static_cast<Uint32>((Tri.Centroid[Axis] - CentroidMin[Axis]) * Scale), NumSAHBins - 1);
+    };
+
+    // Find the split with the lowest surface area heuristic cost: the number of triangles
+    // on each side weighted by the surface area of its bounding box.
+    float  BestCost  = FLT_MAX;
+    int    BestAxis  = -1;
+    Uint32 BestSplit = 0;
+    for (int Axis = 0; Axis < 3; ++Axis)
+    {
+        if (!(CentroidExtent[Axis] > 0))
+            continue;
+
+        struct Bin
+        {
+            float3 Min{+FLT_MAX, +FLT_MAX, +FLT_MAX};
+            float3 Max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            Uint32 Count = 0;
+        };
+        Bin Bins[NumSAHBins];
+        for (Uint32 i = First; i < End; ++i)
+        {
+            const BuildTriangle& Tri = Triangles[i];
+            Bin&                 B   = Bins[GetBin(Tri, Axis)];
+
+            B.Min = std::min(B.Min, Tri.Min);
+            B.Max = std::max(B.Max, Tri.Max);
+            ++B.Count;
+        }
+
+        // RightCosts[b] is the cost of the bins from b to the last one
+        float RightCosts[NumSAHBins] = {};
+        Bin   Right;
+        for (Uint32 b = NumSAHBins - 1; b > 0; --b)
+        {
+            Right.Min = std::min(Right.Min, Bins[b].Min);
+            Right.Max = std::max(Right.Max, Bins[b].Max);
+            Right.Count += Bins[b].Count;
+            RightCosts[b] = Right.Count > 0 ? HalfSurfaceArea(Right.Min, Right.Max) * static_cast<float>(Right.Count) : 0;
+        }
+
+        Bin Left;
+        for (Uint32 b = 0; b + 1 < NumSAHBins; ++b)
+        {
+            Left.Min = std::min(Left.Min, Bins[b].Min);
+            Left.Max = std::max(Left.Max, Bins[b].Max);
+            Left.Count += Bins[b].Count;
+            if (Left.Count == 0 || Left.Count == Count)
+                continue;
+
+            const float Cost = HalfSurfaceArea(Left.Min, Left.Max) * static_cast<float>(Left.Count) + RightCosts[b + 1];
+            if (Cost < BestCost)
+            {
+                BestCost  = Cost;
+                BestAxis  = Axis;
+                BestSplit = b;
+            }
+        }
+    }
+
+    Uint32 Mid = First;
+    if (BestAxis >= 0)
+    {
+        const float ParentArea = HalfSurfaceArea(Min, Max);
+        const float SplitCost  = TraversalCost + (ParentArea > 0 ? BestCost / ParentArea : 0);
+        if (SplitCost >= static_cast<float>(Count) && Count <= MaxLeafTriangles)
+            return MakeLeaf();
+
+        const auto MidIt = std::partition(Triangles.begin() + First, Triangles.begin() + End,
+                                          [&](const BuildTriangle& Tri) {
+                                              return GetBin(Tri, BestAxis) <= BestSplit;
+                                          });
+        Mid = static_cast<Uint32>(MidIt - Triangles.begin());
+    }
+    else if (Count <= MaxLeafTriangles)
+    {
+        return MakeLeaf();
+    }
+
+    // All centroids coincide: split the list in the middle
+    if (Mid == First || Mid == End)
+        Mid = First + Count / 2;
+
+    BuildSubtree(Triangles, First, Mid, Depth + 1);
+    m_Nodes[NodeIdx].Offset = BuildSubtree(Triangles, Mid, End, Depth + 1);
+    return NodeIdx;
+}
+
+bool TriangleBVH::RayCast(const float3& Origin, const float3& Direction, Hit& Hit) const
+{
+    if (m_Nodes.empty())
+        return false;
+
+    const float3 InvDir{SafeReciprocal(Direction.x), SafeReciprocal(Direction.y), SafeReciprocal(Direction.z)};
+
+    // Returns the distance to the box entry point, or FLT_MAX if the ray misses the box
+    // or enters it farther than the closest hit found so far.
+    const auto IntersectBox = [&](const BVHNode& Node) {
+        float TMin = 0;
+        float TMax = Hit.Distance;
+        for (int i = 0; i < 3; ++i)
+        {
+            const float T0 = (Node.Min[i] - Origin[i]) * InvDir[i];
+            const float T1 = (Node.Max[i] - Origin[i]) * InvDir[i];
+            TMin           = std::max(TMin, std::min(T0, T1));
+            TMax           = std::min(TMax, std::max(T0, T1));
+        }
+        return TMin <= TMax ? TMin : FLT_MAX;
+    };
+
+    struct StackEntry
+    {
+        Uint32 NodeIdx;
+        float  Distance;
+    };
+    StackEntry Stack[MaxTreeDepth + 2];
+    Uint32     StackSize = 0;
+
+    const float RootDist = IntersectBox(m_Nodes[0]);
+    if (RootDist == FLT_MAX)
+        return false;
+    Stack[StackSize++] = {0, RootDist};
+
+    bool Found = false;
+    while (StackSize > 0)
+    {
+        const StackEntry Entry = Stack[--StackSize];
+        if (Entry.Distance >= Hit.Distance)
+            continue;
+
+        const BVHNode& Node = m_Nodes[Entry.NodeIdx];
+        if (Node.NumTriangles == 0)
+        {
+            // Visit the closer child first
+            StackEntry Child0{Entry.NodeIdx + 1, IntersectBox(m_Nodes[Entry.NodeIdx + 1])};
+            StackEntry Child1{Node.Offset, IntersectBox(m_Nodes[Node.Offset])};
+            if (Child0.Distance > Child1.Distance)
+                std::swap(Child0, Child1);
+            if (Child1.Distance != FLT_MAX)
+                Stack[StackSize++] = Child1;
+            if (Child0.Distance != FLT_MAX)
+                Stack[StackSize++] = Child0;
+            VERIFY_EXPR(StackSize <= MaxTreeDepth + 2);
+            continue;
+        }
+
+        // Moller-Trumbore ray-triangle intersection
+        for (Uint32 t = Node.Offset; t < Node.Offset + Node.NumTriangles; ++t)
+        {
+            const float3& V0 = m_Vertices[size_t{t} * 3 + 0];
+            const float3  E1 = m_Vertices[size_t{t} * 3 + 1] - V0;
+            const float3  E2 = m_Vertices[size_t{t} * 3 + 2] - V0;
+
+            const float3 P   = cross(Direction, E2);
+            const float  Det = dot(E1, P);
+            if (std::abs(Det) < 1e-20f)
+                continue;
+
+            const float  InvDet = 1.f / Det;
+            const float3 S      = Origin - V0;
+            const float  U      = dot(S, P) * InvDet;
+            if (U < 0 || U > 1)
+                continue;
+
+            const float3 Q = cross(S, E1);
+            const float  V = dot(Direction, Q) * InvDet;
+            if (V < 0 || U + V > 1)
+                continue;
+
+            const float Distance = dot(E2, Q) * InvDet;
+            if (Distance >= 0 && Distance < Hit.Distance)
+            {
+                Hit.Distance   = Distance;
+                Hit.U          = U;
+                Hit.V          = V;
+                Hit.TriangleId = m_TriangleIds[t];
+                Found          = true;
+            }
+        }
+    }
+
+    return Found;
+}
+
+BoundBox TriangleBVH::GetBounds() const
+{
+    return !m_Nodes.empty() ?
+        BoundBox{m_Nodes[0].Min, m_Nodes[0].Max} :
+        BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+size_t TriangleBVH::GetMemorySize() const
+{
+    return m_Nodes.size() * sizeof(BVHNode) + m_Vertices.size() * sizeof(float3) + m_TriangleIds.size() * sizeof(Uint32);
+}
+
+} // namespace GLTF
+
+} // namespace Diligent
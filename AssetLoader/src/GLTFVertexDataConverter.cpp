@@ -25,13 +25,30 @@
  */
 
 #include "GLTFVertexDataConverter.hpp"
+#include "GLTFLoader.hpp"
 
 #include "DebugUtilities.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
 #include <type_traits>
 
+// SSE2 is part of the x86-64 baseline and NEON (with vector division) is part of the AArch64
+// baseline, so the vector kernels are selected at compile time and need no CPU feature checks.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define GLTF_VERTEX_CONVERTER_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define GLTF_VERTEX_CONVERTER_NEON
+#endif
+
+#if defined(GLTF_VERTEX_CONVERTER_SSE2) || defined(GLTF_VERTEX_CONVERTER_NEON)
+#    define GLTF_VERTEX_CONVERTER_SIMD
+#endif
+
 namespace Diligent
 {
 
@@ -102,6 +119,329 @@ inline float ConvertElement<float, true, Uint16>(Uint16 Src)
 }
 
 
+// Copies NumBytes bytes per element. The size is a compile-time constant, so the copy
+// compiles to a few register moves instead of a memcpy call per element.
+template <size_t NumBytes>
+void CopyElements(const Uint8* pSrc, size_t SrcStride, Uint8* pDst, size_t DstStride, Uint32 NumElements)
+{
+    for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
+        std::memcpy(pDst + DstStride * Elem, pSrc + SrcStride * Elem, NumBytes);
+}
+
+// Copies NumBytes bytes of the element at pSrc to every destination element.
+template <size_t NumBytes>
+void FillElements(const Uint8* pSrc, Uint8* pDst, size_t DstStride, Uint32 NumElements)
+{
+    Uint8 Value[NumBytes];
+    std::memcpy(Value, pSrc, NumBytes);
+    for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
+        std::memcpy(pDst + DstStride * Elem, Value, NumBytes);
+}
+
+// Stores the first NumBytes bytes of Value.
+inline void StoreBytes(Uint8* pDst, Uint32 Value, Uint32 NumBytes)
+{
+    switch (NumBytes)
+    {
+        case 4: std::memcpy(pDst, &Value, 4); break;
+        case 3: std::memcpy(pDst, &Value, 3); break;
+        case 2: std::memcpy(pDst, &Value, 2); break;
+        case 1: std::memcpy(pDst, &Value, 1); break;
+        default: UNEXPECTED("Unexpected number of bytes");
+    }
+}
+
+#if defined(GLTF_VERTEX_CONVERTER_SSE2)
+
+namespace SIMD
+{
+
+using Float4 = __m128;
+using Int4   = __m128i;
+
+inline Float4 Set(float f) { return _mm_set1_ps(f); }
+inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+inline Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+inline Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+inline Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+inline Float4 ToFloat(Int4 v) { return _mm_cvtepi32_ps(v); }
+inline Int4   TruncateToInt(Float4 v) { return _mm_cvttps_epi32(v); }
+
+// Returns IfPositive for lanes where v > 0 and Otherwise for all other lanes.
+inline Float4 SelectPositive(Float4 v, Float4 IfPositive, Float4 Otherwise)
+{
+    const Float4 Mask = _mm_cmpgt_ps(v, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(Mask, IfPositive), _mm_andnot_ps(Mask, Otherwise));
+}
+
+inline Float4 LoadFloat4(const Uint8* pSrc)
+{
+    return _mm_loadu_ps(reinterpret_cast<const float*>(pSrc));
+}
+
+inline Int4 LoadUint8x4(const Uint8* pSrc)
+{
+    Int32 Bits;
+    std::memcpy(&Bits, pSrc, sizeof(Bits));
+    const Int4 Zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(Bits), Zero), Zero);
+}
+
+inline Int4 LoadUint16x4(const Uint8* pSrc)
+{
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pSrc)), _mm_setzero_si128());
+}
+
+// Packs four integers in [0, 255] into bytes.
+inline Uint32 PackUint8(Int4 v)
+{
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    return static_cast<Uint32>(_mm_cvtsi128_si32(v));
+}
+
+// Packs four integers in [-127, 127] into bytes.
+inline Uint32 PackInt8(Int4 v)
+{
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packs_epi16(v, v);
+    return static_cast<Uint32>(_mm_cvtsi128_si32(v));
+}
+
+inline void StoreFloats(Uint8* pDst, Float4 v, Uint32 NumComponents)
+{
+    switch (NumComponents)
+    {
+        case 4:
+            _mm_storeu_ps(reinterpret_cast<float*>(pDst), v);
+            break;
+        case 3:
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), _mm_castps_si128(v));
+            const float z = _mm_cvtss_f32(_mm_movehl_ps(v, v));
+            std::memcpy(pDst + 8, &z, sizeof(z));
+            break;
+        }
+        case 2:
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst), _mm_castps_si128(v));
+            break;
+        case 1:
+        {
+            const float x = _mm_cvtss_f32(v);
+            std::memcpy(pDst, &x, sizeof(x));
+            break;
+        }
+        default:
+            UNEXPECTED("Unexpected number of components");
+    }
+}
+
+} // namespace SIMD
+
+#elif defined(GLTF_VERTEX_CONVERTER_NEON)
+
+namespace SIMD
+{
+
+using Float4 = float32x4_t;
+using Int4   = int32x4_t;
+
+inline Float4 Set(float f) { return vdupq_n_f32(f); }
+inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+inline Float4 Div(Float4 a, Float4 b) { return vdivq_f32(a, b); }
+inline Float4 Min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+inline Float4 Max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+inline Float4 ToFloat(Int4 v) { return vcvtq_f32_s32(v); }
+inline Int4   TruncateToInt(Float4 v) { return vcvtq_s32_f32(v); }
+
+// Returns IfPositive for lanes where v > 0 and Otherwise for all other lanes.
+inline Float4 SelectPositive(Float4 v, Float4 IfPositive, Float4 Otherwise)
+{
+    return vbslq_f32(vcgtq_f32(v, vdupq_n_f32(0)), IfPositive, Otherwise);
+}
+
+inline Float4 LoadFloat4(const Uint8* pSrc)
+{
+    return vreinterpretq_f32_u8(vld1q_u8(pSrc));
+}
+
+inline Int4 LoadUint8x4(const Uint8* pSrc)
+{
+    Uint32 Bits;
+    std::memcpy(&Bits, pSrc, sizeof(Bits));
+    const uint16x8_t Words = vmovl_u8(vcreate_u8(Bits));
+    return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(Words)));
+}
+
+inline Int4 LoadUint16x4(const Uint8* pSrc)
+{
+    return vreinterpretq_s32_u32(vmovl_u16(vreinterpret_u16_u8(vld1_u8(pSrc))));
+}
+
+// Packs four integers in [0, 255] into bytes.
+inline Uint32 PackUint8(Int4 v)
+{
+    const int16x4_t Words = vqmovn_s32(v);
+    return vget_lane_u32(vreinterpret_u32_u8(vqmovun_s16(vcombine_s16(Words, Words))), 0);
+}
+
+// Packs four integers in [-127, 127] into bytes.
+inline Uint32 PackInt8(Int4 v)
+{
+    const int16x4_t Words = vqmovn_s32(v);
+    return vget_lane_u32(vreinterpret_u32_s8(vqmovn_s16(vcombine_s16(Words, Words))), 0);
+}
+
+inline void StoreFloats(Uint8* pDst, Float4 v, Uint32 NumComponents)
+{
+    const uint8x16_t Bytes = vreinterpretq_u8_f32(v);
+    switch (NumComponents)
+    {
+        case 4:
+            vst1q_u8(pDst, Bytes);
+            break;
+        case 3:
+        {
+            vst1_u8(pDst, vget_low_u8(Bytes));
+            const float z = vgetq_lane_f32(v, 2);
+            std::memcpy(pDst + 8, &z, sizeof(z));
+            break;
+        }
+        case 2:
+            vst1_u8(pDst, vget_low_u8(Bytes));
+            break;
+        case 1:
+        {
+            const float x = vgetq_lane_f32(v, 0);
+            std::memcpy(pDst, &x, sizeof(x));
+            break;
+        }
+        default:
+            UNEXPECTED("Unexpected number of components");
+    }
+}
+
+} // namespace SIMD
+
+#endif
+
+#if defined(GLTF_VERTEX_CONVERTER_SIMD)
+
+// Returns the number of leading elements for which LoadSize bytes can be read starting at the
+// element without reading past the last copied component of the last element. Kernels load
+// four components at a time and ignore the lanes that are not copied.
+inline Uint32 GetNumVectorElements(const VertexDataConverter::WriteAttribs& Attribs, size_t ElementSize, size_t LoadSize)
+{
+    const size_t Span = size_t{Attribs.SrcElementStride} * (Attribs.NumElements - 1) + ElementSize;
+    if (Span < LoadSize)
+        return 0;
+    return static_cast<Uint32>(std::min<size_t>(Attribs.NumElements, (Span - LoadSize) / Attribs.SrcElementStride + 1));
+}
+
+// Kernels produce exactly the same bits as the scalar ConvertElement specializations:
+// every operation is performed in the same order and all of them are correctly rounded.
+// This relies on multiply-add not being contracted into FMA, which CMakeLists.txt disables
+// for this file with -ffp-contract=off (MSVC does not contract unless /fp:contract is given).
+template <typename ConvertFnType>
+Uint32 ConvertElementsFromFloat(const VertexDataConverter::WriteAttribs& Attribs, Uint32 NumComponents, ConvertFnType&& Convert)
+{
+    const Uint32 NumVectorElements = GetNumVectorElements(Attribs, sizeof(float) * NumComponents, sizeof(float) * 4);
+
+    const Uint8* pSrcBytes = static_cast<const Uint8*>(Attribs.pSrc);
+    Uint8*       pDstBytes = static_cast<Uint8*>(Attribs.pDst);
+    for (Uint32 Elem = 0; Elem < NumVectorElements; ++Elem)
+    {
+        const SIMD::Float4 Src = SIMD::LoadFloat4(pSrcBytes + size_t{Attribs.SrcElementStride} * Elem);
+        StoreBytes(pDstBytes + size_t{Attribs.DstElementStride} * Elem, Convert(Src), NumComponents);
+    }
+    return NumVectorElements;
+}
+
+template <typename SrcType, bool IsNormalized>
+Uint32 ConvertUnormElementsToFloat(const VertexDataConverter::WriteAttribs& Attribs, Uint32 NumComponents)
+{
+    const Uint32 NumVectorElements = GetNumVectorElements(Attribs, sizeof(SrcType) * NumComponents, sizeof(SrcType) * 4);
+
+    const SIMD::Float4 MaxValue = SIMD::Set(static_cast<float>(std::numeric_limits<SrcType>::max()));
+
+    const Uint8* pSrcBytes = static_cast<const Uint8*>(Attribs.pSrc);
+    Uint8*       pDstBytes = static_cast<Uint8*>(Attribs.pDst);
+    for (Uint32 Elem = 0; Elem < NumVectorElements; ++Elem)
+    {
+        const Uint8* pSrc = pSrcBytes + size_t{Attribs.SrcElementStride} * Elem;
+
+        SIMD::Float4 Dst = SIMD::ToFloat(sizeof(SrcType) == 1 ? SIMD::LoadUint8x4(pSrc) : SIMD::LoadUint16x4(pSrc));
+        if (IsNormalized)
+            Dst = SIMD::Div(Dst, MaxValue);
+        SIMD::StoreFloats(pDstBytes + size_t{Attribs.DstElementStride} * Elem, Dst, NumComponents);
+    }
+    return NumVectorElements;
+}
+
+#endif
+
+// Converts the leading elements using the fast paths and returns the number of
+// converted elements. The remaining elements are converted by the scalar reference path.
+template <typename SrcType, typename DstType, bool IsNormalized>
+Uint32 WriteAttributeDataFast(const VertexDataConverter::WriteAttribs& Attribs, Uint32 NumComponents)
+{
+    const Uint8* pSrcBytes = static_cast<const Uint8*>(Attribs.pSrc);
+    Uint8*       pDstBytes = static_cast<Uint8*>(Attribs.pDst);
+
+    if constexpr (std::is_same<SrcType, DstType>::value)
+    {
+        // Strided copy, e.g. float3 positions and normals or float2 texture coordinates
+        switch (sizeof(SrcType) * NumComponents)
+        {
+            case 4: CopyElements<4>(pSrcBytes, Attribs.SrcElementStride, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); break;
+            case 8: CopyElements<8>(pSrcBytes, Attribs.SrcElementStride, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); break;
+            case 12: CopyElements<12>(pSrcBytes, Attribs.SrcElementStride, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); break;
+            case 16: CopyElements<16>(pSrcBytes, Attribs.SrcElementStride, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); break;
+            default: return 0;
+        }
+        return Attribs.NumElements;
+    }
+#if defined(GLTF_VERTEX_CONVERTER_SIMD)
+    else if constexpr (std::is_same<SrcType, float>::value && std::is_same<DstType, Uint8>::value)
+    {
+        // Same conversion for normalized and non-normalized attributes (see ConvertElement)
+        const SIMD::Float4 Scale = SIMD::Set(255.f);
+        const SIMD::Float4 Half  = SIMD::Set(0.5f);
+        const SIMD::Float4 Zero  = SIMD::Set(0.f);
+        return ConvertElementsFromFloat(
+            Attribs, NumComponents,
+            [&](SIMD::Float4 Src) {
+                const SIMD::Float4 Value = SIMD::Min(SIMD::Max(SIMD::Add(SIMD::Mul(Src, Scale), Half), Zero), Scale);
+                return SIMD::PackUint8(SIMD::TruncateToInt(Value));
+            });
+    }
+    else if constexpr (std::is_same<SrcType, float>::value && std::is_same<DstType, Int8>::value)
+    {
+        const SIMD::Float4 Scale    = SIMD::Set(127.f);
+        const SIMD::Float4 MinValue = SIMD::Set(-127.f);
+        const SIMD::Float4 PosHalf  = SIMD::Set(+0.5f);
+        const SIMD::Float4 NegHalf  = SIMD::Set(-0.5f);
+        return ConvertElementsFromFloat(
+            Attribs, NumComponents,
+            [&](SIMD::Float4 Src) {
+                const SIMD::Float4 Round = SIMD::SelectPositive(Src, PosHalf, NegHalf);
+                const SIMD::Float4 Value = SIMD::Min(SIMD::Max(SIMD::Add(SIMD::Mul(Src, Scale), Round), MinValue), Scale);
+                return SIMD::PackInt8(SIMD::TruncateToInt(Value));
+            });
+    }
+    else if constexpr ((std::is_same<SrcType, Uint8>::value || std::is_same<SrcType, Uint16>::value) && std::is_same<DstType, float>::value)
+    {
+        return ConvertUnormElementsToFloat<SrcType, IsNormalized>(Attribs, NumComponents);
+    }
+#endif
+    else
+    {
+        return 0;
+    }
+}
+
 template <typename SrcType, typename DstType, bool IsNormalized>
 bool WriteAttributeData(const VertexDataConverter::WriteAttribs& Attribs)
 {
@@ -121,11 +461,13 @@ bool WriteAttributeData(const VertexDataConverter::WriteAttribs& Attribs)
     const Uint8* pSrcBytes = static_cast<const Uint8*>(Attribs.pSrc);
     Uint8*       pDstBytes = static_cast<Uint8*>(Attribs.pDst);
 
+    const Uint32 FirstElem = Attribs.UseSIMD ? WriteAttributeDataFast<SrcType, DstType, IsNormalized>(Attribs, NumComponentsToCopy) : 0;
+
     if constexpr (std::is_same<SrcType, DstType>::value)
     {
         const size_t NumBytesToCopy = sizeof(SrcType) * size_t{NumComponentsToCopy};
 
-        for (Uint32 Elem = 0; Elem < Attribs.NumElements; ++Elem)
+        for (Uint32 Elem = FirstElem; Elem < Attribs.NumElements; ++Elem)
         {
             const Uint8* pSrcCmpBytes = pSrcBytes + size_t{Attribs.SrcElementStride} * Elem;
             Uint8*       pDstCmpBytes = pDstBytes + size_t{Attribs.DstElementStride} * Elem;
@@ -134,7 +476,7 @@ bool WriteAttributeData(const VertexDataConverter::WriteAttribs& Attribs)
     }
     else
     {
-        for (Uint32 Elem = 0; Elem < Attribs.NumElements; ++Elem)
+        for (Uint32 Elem = FirstElem; Elem < Attribs.NumElements; ++Elem)
         {
             const Uint8* pSrcCmpBytes = pSrcBytes + size_t{Attribs.SrcElementStride} * Elem;
             Uint8*       pDstCmpBytes = pDstBytes + size_t{Attribs.DstElementStride} * Elem;
@@ -170,10 +512,330 @@ bool IsSupportedValueType(VALUE_TYPE Type)
     }
 }
 
+// Converts a float to a half-precision float, rounding to the nearest even value.
+Uint16 FloatToHalf(float Value)
+{
+    Uint32 Bits = 0;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    const Uint32 Sign    = (Bits >> 16u) & 0x8000u;
+    Uint32       AbsBits = Bits & 0x7FFFFFFFu;
+
+    if (AbsBits >= 0x7F800000u)
+    {
+        // Inf or NaN
+        return static_cast<Uint16>(Sign | 0x7C00u | (AbsBits > 0x7F800000u ? 0x200u : 0u));
+    }
+
+    if (AbsBits >= 0x477FF000u)
+    {
+        // The value is at least 65520 and rounds to infinity
+        return static_cast<Uint16>(Sign | 0x7C00u);
+    }
+
+    if (AbsBits < 0x38800000u)
+    {
+        // The result is a denormal or zero. Adding 0.5 moves the value into the mantissa
+        // with the ulp of 2^-24 (the smallest denormal), and the addition rounds to nearest even.
+        float AbsValue = 0;
+        std::memcpy(&AbsValue, &AbsBits, sizeof(AbsValue));
+        AbsValue += 0.5f;
+        std::memcpy(&AbsBits, &AbsValue, sizeof(AbsBits));
+        return static_cast<Uint16>(Sign | (AbsBits - 0x3F000000u));
+    }
+
+    // Rebias the exponent and round the mantissa to nearest even
+    const Uint32 MantissaOdd = (AbsBits >> 13u) & 1u;
+    AbsBits += 0xC8000FFFu + MantissaOdd; // ((15 - 127) << 23) + 0xFFF
+    return static_cast<Uint16>(Sign | (AbsBits >> 13u));
+}
+
+inline Uint32 FloatToUnormBits(float Value, Uint32 MaxValue)
+{
+    const float MaxValueF = static_cast<float>(MaxValue);
+    return static_cast<Uint32>(clamp(Value * MaxValueF + 0.5f, 0.f, MaxValueF));
+}
+
+template <typename DstType>
+DstType FloatToSnorm(float Value)
+{
+    constexpr float MaxValue = static_cast<float>(std::numeric_limits<DstType>::max());
+
+    float r = Value > 0.f ? +0.5f : -0.5f;
+    return static_cast<DstType>(clamp(Value * MaxValue + r, -MaxValue, MaxValue));
+}
+
+// Stores the component as the destination type. Integer types are normalized.
+void StoreEncodedComponent(Uint8* pDst, VALUE_TYPE DstType, float Value)
+{
+    switch (DstType)
+    {
+        case VT_INT8:
+        {
+            const Int8 DstValue = FloatToSnorm<Int8>(Value);
+            std::memcpy(pDst, &DstValue, sizeof(DstValue));
+            break;
+        }
+
+        case VT_INT16:
+        {
+            const Int16 DstValue = FloatToSnorm<Int16>(Value);
+            std::memcpy(pDst, &DstValue, sizeof(DstValue));
+            break;
+        }
+
+        case VT_UINT8:
+        {
+            const Uint8 DstValue = static_cast<Uint8>(FloatToUnormBits(Value, 0xFFu));
+            std::memcpy(pDst, &DstValue, sizeof(DstValue));
+            break;
+        }
+
+        case VT_UINT16:
+        {
+            const Uint16 DstValue = static_cast<Uint16>(FloatToUnormBits(Value, 0xFFFFu));
+            std::memcpy(pDst, &DstValue, sizeof(DstValue));
+            break;
+        }
+
+        case VT_FLOAT16:
+        {
+            const Uint16 DstValue = FloatToHalf(Value);
+            std::memcpy(pDst, &DstValue, sizeof(DstValue));
+            break;
+        }
+
+        case VT_FLOAT32:
+            std::memcpy(pDst, &Value, sizeof(Value));
+            break;
+
+        default:
+            UNEXPECTED("Unexpected encoded component type");
+    }
+}
+
+// Maps a unit vector to the octahedron and unfolds the lower hemisphere.
+void EncodeOctahedral(const float* v, float& u, float& w)
+{
+    const float L1 = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+    if (L1 == 0)
+    {
+        u = w = 0;
+        return;
+    }
+
+    u = v[0] / L1;
+    w = v[1] / L1;
+    if (v[2] < 0)
+    {
+        const float x = (1.f - std::abs(w)) * (u >= 0 ? 1.f : -1.f);
+        const float y = (1.f - std::abs(u)) * (w >= 0 ? 1.f : -1.f);
+
+        u = x;
+        w = y;
+    }
+}
+
+// Returns the cosine of the angle between the unit vector n and the decoded octahedral coordinates.
+// The cosine is computed in double precision since the candidates differ by less than the float epsilon.
+double GetOctahedralCosine(const double* n, float u, float w)
+{
+    double       x = u;
+    double       y = w;
+    const double z = 1.0 - std::abs(x) - std::abs(y);
+    const double t = std::max(-z, 0.0);
+    x += x >= 0 ? -t : t;
+    y += y >= 0 ? -t : t;
+
+    const double Len = std::sqrt(x * x + y * y + z * z);
+    return Len > 0 ? (n[0] * x + n[1] * y + n[2] * z) / Len : -1.0;
+}
+
+// Encodes the unit vector and quantizes the coordinates to signed normalized values.
+// Instead of rounding every coordinate, the function picks the closest of the four
+// neighbouring grid points, which roughly halves the error.
+void EncodeOctahedralSnorm(const float* v, float MaxValue, float& u, float& w)
+{
+    EncodeOctahedral(v, u, w);
+
+    const double Len = std::sqrt(double{v[0]} * v[0] + double{v[1]} * v[1] + double{v[2]} * v[2]);
+    if (Len == 0)
+        return;
+
+    const double n[3] = {v[0] / Len, v[1] / Len, v[2] / Len};
+
+    const float FloorU = std::floor(u * MaxValue);
+    const float FloorW = std::floor(w * MaxValue);
+
+    float  BestU   = u;
+    float  BestW   = w;
+    double BestCos = -2.0;
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        const float QuantU = clamp((FloorU + static_cast<float>(i & 1u)) / MaxValue, -1.f, 1.f);
+        const float QuantW = clamp((FloorW + static_cast<float>(i >> 1u)) / MaxValue, -1.f, 1.f);
+
+        const double Cos = GetOctahedralCosine(n, QuantU, QuantW);
+        if (Cos > BestCos)
+        {
+            BestU   = QuantU;
+            BestW   = QuantW;
+            BestCos = Cos;
+        }
+    }
+    u = BestU;
+    w = BestW;
+}
+
+bool IsValidEncoding(const VertexDataConverter::WriteAttribs& Attribs)
+{
+    switch (Attribs.Encoding)
+    {
+        case VERTEX_ATTRIBUTE_ENCODING_NONE:
+            return Attribs.DstType == VT_FLOAT16;
+
+        case VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL:
+            return (Attribs.DstType == VT_INT8 || Attribs.DstType == VT_INT16 || Attribs.DstType == VT_FLOAT16 || Attribs.DstType == VT_FLOAT32) &&
+                Attribs.NumDstComponents >= 2;
+
+        case VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2:
+            return Attribs.DstType == VT_UINT32 && Attribs.NumDstComponents == 1;
+
+        case VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED:
+            return (Attribs.DstType == VT_UINT8 || Attribs.DstType == VT_UINT16) &&
+                Attribs.pQuantizationMin != nullptr &&
+                Attribs.pQuantizationMax != nullptr;
+
+        default:
+            return false;
+    }
+}
+
+// Converts the source components to floats and encodes them. This path handles
+// VT_FLOAT16 destinations and all encodings other than VERTEX_ATTRIBUTE_ENCODING_NONE.
+template <typename SrcType, bool IsNormalized>
+bool WriteEncodedAttributeData(const VertexDataConverter::WriteAttribs& Attribs)
+{
+    if (Attribs.NumElements == 0)
+        return true;
+
+    const Uint32 NumSrcComponents = std::min(Attribs.NumSrcComponents, 4u);
+    const Uint32 NumDstComponents = std::min(Attribs.NumDstComponents, 4u);
+    const Uint32 DstValueSize     = GetValueSize(Attribs.DstType);
+    if (Attribs.pSrc == nullptr ||
+        Attribs.pDst == nullptr ||
+        NumSrcComponents == 0 ||
+        Attribs.SrcElementStride < sizeof(SrcType) * NumSrcComponents ||
+        Attribs.DstElementStride < DstValueSize * Attribs.NumDstComponents ||
+        !IsValidEncoding(Attribs))
+    {
+        return false;
+    }
+
+    float QuantizationOffset[3] = {};
+    float QuantizationScale[3]  = {};
+    if (Attribs.Encoding == VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED)
+    {
+        for (Uint32 Cmp = 0; Cmp < 3; ++Cmp)
+        {
+            const float Extent      = Attribs.pQuantizationMax[Cmp] - Attribs.pQuantizationMin[Cmp];
+            QuantizationOffset[Cmp] = Attribs.pQuantizationMin[Cmp];
+            QuantizationScale[Cmp]  = Extent > 0 ? 1.f / Extent : 0.f;
+        }
+    }
+
+    const Uint8* pSrcBytes = static_cast<const Uint8*>(Attribs.pSrc);
+    Uint8*       pDstBytes = static_cast<Uint8*>(Attribs.pDst);
+    for (Uint32 Elem = 0; Elem < Attribs.NumElements; ++Elem)
+    {
+        const Uint8* pSrcCmpBytes = pSrcBytes + size_t{Attribs.SrcElementStride} * Elem;
+        Uint8*       pDstCmpBytes = pDstBytes + size_t{Attribs.DstElementStride} * Elem;
+
+        // Missing w is treated as +1 (e.g. tangent handedness)
+        float Src[4] = {0, 0, 0, 1};
+        for (Uint32 Cmp = 0; Cmp < NumSrcComponents; ++Cmp)
+        {
+            SrcType SrcValue{};
+            std::memcpy(&SrcValue, pSrcCmpBytes + size_t{Cmp} * sizeof(SrcType), sizeof(SrcValue));
+            Src[Cmp] = ConvertElement<float, IsNormalized>(SrcValue);
+        }
+
+        float  Dst[4]        = {};
+        Uint32 NumDstToWrite = NumDstComponents;
+        switch (Attribs.Encoding)
+        {
+            case VERTEX_ATTRIBUTE_ENCODING_NONE:
+                std::memcpy(Dst, Src, sizeof(Dst));
+                NumDstToWrite = std::min(NumSrcComponents, NumDstComponents);
+                break;
+
+            case VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL:
+                if (Attribs.DstType == VT_INT8)
+                    EncodeOctahedralSnorm(Src, 127.f, Dst[0], Dst[1]);
+                else if (Attribs.DstType == VT_INT16)
+                    EncodeOctahedralSnorm(Src, 32767.f, Dst[0], Dst[1]);
+                else
+                    EncodeOctahedral(Src, Dst[0], Dst[1]);
+                Dst[2] = Src[3] < 0 ? -1.f : 1.f;
+                break;
+
+            case VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2:
+            {
+                const Uint32 Packed =
+                    (FloatToUnormBits(Src[0] * 0.5f + 0.5f, 1023u) << 0u) |
+                    (FloatToUnormBits(Src[1] * 0.5f + 0.5f, 1023u) << 10u) |
+                    (FloatToUnormBits(Src[2] * 0.5f + 0.5f, 1023u) << 20u) |
+                    (FloatToUnormBits(Src[3] * 0.5f + 0.5f, 3u) << 30u);
+                std::memcpy(pDstCmpBytes, &Packed, sizeof(Packed));
+                NumDstToWrite = 0;
+                break;
+            }
+
+            case VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED:
+                for (Uint32 Cmp = 0; Cmp < 3; ++Cmp)
+                    Dst[Cmp] = (Src[Cmp] - QuantizationOffset[Cmp]) * QuantizationScale[Cmp];
+                break;
+
+            default:
+                UNEXPECTED("Unexpected vertex attribute encoding");
+                return false;
+        }
+
+        for (Uint32 Cmp = 0; Cmp < NumDstToWrite; ++Cmp)
+            StoreEncodedComponent(pDstCmpBytes + size_t{Cmp} * DstValueSize, Attribs.DstType, Dst[Cmp]);
+    }
+
+    return true;
+}
+
 } // namespace
 
 bool VertexDataConverter::Write(const WriteAttribs& Attribs)
 {
+    if (Attribs.Encoding != VERTEX_ATTRIBUTE_ENCODING_NONE || Attribs.DstType == VT_FLOAT16)
+    {
+#define ENCODED_CASE(SrcType)                                                                           \
+    case SrcType:                                                                                       \
+        return Attribs.IsNormalized ?                                                                   \
+            GLTF::WriteEncodedAttributeData<typename VALUE_TYPE2CType<SrcType>::CType, true>(Attribs) : \
+            GLTF::WriteEncodedAttributeData<typename VALUE_TYPE2CType<SrcType>::CType, false>(Attribs)
+
+        switch (Attribs.SrcType)
+        {
+            ENCODED_CASE(VT_INT8);
+            ENCODED_CASE(VT_INT16);
+            ENCODED_CASE(VT_INT32);
+            ENCODED_CASE(VT_UINT8);
+            ENCODED_CASE(VT_UINT16);
+            ENCODED_CASE(VT_UINT32);
+            ENCODED_CASE(VT_FLOAT32);
+            default:
+                UNEXPECTED("Unexpected source type");
+                return false;
+        }
+#undef ENCODED_CASE
+    }
+
     if (!IsSupportedValueType(Attribs.SrcType) ||
         !IsSupportedValueType(Attribs.DstType))
     {
@@ -240,6 +902,18 @@ bool VertexDataConverter::WriteDefault(const WriteDefaultAttribs& Attribs)
 
     const Uint8* pDefaultBytes = static_cast<const Uint8*>(Attribs.pDefaultValue);
     Uint8*       pDstBytes     = static_cast<Uint8*>(Attribs.pDst);
+    if (Attribs.UseSIMD)
+    {
+        switch (ElementSize)
+        {
+            case 4: FillElements<4>(pDefaultBytes, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); return true;
+            case 8: FillElements<8>(pDefaultBytes, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); return true;
+            case 12: FillElements<12>(pDefaultBytes, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); return true;
+            case 16: FillElements<16>(pDefaultBytes, pDstBytes, Attribs.DstElementStride, Attribs.NumElements); return true;
+            default: break;
+        }
+    }
+
     for (Uint32 Elem = 0; Elem < Attribs.NumElements; ++Elem)
         std::memcpy(pDstBytes + size_t{Attribs.DstElementStride} * Elem, pDefaultBytes, ElementSize);
 
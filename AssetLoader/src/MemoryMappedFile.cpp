@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryMappedFile.hpp"
+
+#include <cstdint>
+
+#if PLATFORM_WIN32
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    include "StringTools.hpp"
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define DILIGENT_POSIX_MMAP_SUPPORTED 1
+#endif
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+std::unique_ptr<MemoryMappedFile> MemoryMappedFile::Open(const char* FilePath)
+{
+    if (FilePath == nullptr || *FilePath == '\0')
+        return {};
+
+#if PLATFORM_WIN32
+    HANDLE hFile = CreateFileW(WidenString(FilePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return {};
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(hFile, &FileSize) || FileSize.QuadPart <= 0 || static_cast<Uint64>(FileSize.QuadPart) > SIZE_MAX)
+    {
+        CloseHandle(hFile);
+        return {};
+    }
+
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The mapping object keeps the file open
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+        return {};
+
+    void* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    // The view keeps the mapping object alive
+    CloseHandle(hMapping);
+    if (pData == nullptr)
+        return {};
+
+    return std::unique_ptr<MemoryMappedFile>{new MemoryMappedFile{static_cast<const Uint8*>(pData), static_cast<size_t>(FileSize.QuadPart)}};
+#elif DILIGENT_POSIX_MMAP_SUPPORTED
+    const int fd = open(FilePath, O_RDONLY);
+    if (fd < 0)
+        return {};
+
+    struct stat FileStat = {};
+    if (fstat(fd, &FileStat) != 0 || FileStat.st_size <= 0)
+    {
+        close(fd);
+        return {};
+    }
+
+    const size_t Size  = static_cast<size_t>(FileStat.st_size);
+    void*        pData = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open
+    close(fd);
+    if (pData == MAP_FAILED)
+        return {};
+
+    return std::unique_ptr<MemoryMappedFile>{new MemoryMappedFile{static_cast<const Uint8*>(pData), Size}};
+#else
+    return {};
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if PLATFORM_WIN32
+    if (!UnmapViewOfFile(m_pData))
+        LOG_ERROR_MESSAGE("Failed to unmap file view");
+#elif DILIGENT_POSIX_MMAP_SUPPORTED
+    if (munmap(const_cast<Uint8*>(m_pData), m_Size) != 0)
+        LOG_ERROR_MESSAGE("Failed to unmap file");
+#endif
+}
+
+} // namespace Diligent
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFLoader.hpp"
+#include "GLTFResourceManager.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Primitive P is shared by both models, while Q and R are only used by one of them.
+// P is the first primitive of model A and the second primitive of model B, so its
+// vertices are stored at different offsets in the two models.
+// All primitives use the same indices (0, 1, 2).
+const std::string SharedPrimitiveModelA = R"({
+    "asset": {"version": "2.0"},
+    "scene": 0,
+    "scenes": [{"nodes": [0]}],
+    "nodes": [{"mesh": 0}],
+    "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "indices": 2}, {"attributes": {"POSITION": 1}, "indices": 3}]}],
+    "buffers": [{"byteLength": 88, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAIA/AAAAQAAAAAAAAIA/AAAAAAAAAEAAAIA/AAABAAIAAAAAAAEAAgAAAA=="}],
+    "bufferViews": [
+        {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+        {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+        {"buffer": 0, "byteOffset": 72, "byteLength": 6},
+        {"buffer": 0, "byteOffset": 80, "byteLength": 6}
+    ],
+    "accessors": [
+        {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+        {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 1], "max": [2, 2, 1]},
+        {"bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR"},
+        {"bufferView": 3, "componentType": 5123, "count": 3, "type": "SCALAR"}
+    ]
+})";
+
+const std::string SharedPrimitiveModelB = R"({
+    "asset": {"version": "2.0"},
+    "scene": 0,
+    "scenes": [{"nodes": [0]}],
+    "nodes": [{"mesh": 0}],
+    "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "indices": 2}, {"attributes": {"POSITION": 1}, "indices": 3}]}],
+    "buffers": [{"byteLength": 88, "uri": "data:application/octet-stream;base64,AACgQAAAoEAAAKBAAADAQAAAoEAAAKBAAACgQAAA4EAAAKBAAAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAAAAAEAAgAAAA=="}],
+    "bufferViews": [
+        {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+        {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+        {"buffer": 0, "byteOffset": 72, "byteLength": 6},
+        {"buffer": 0, "byteOffset": 80, "byteLength": 6}
+    ],
+    "accessors": [
+        {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [5, 5, 5], "max": [6, 7, 5]},
+        {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+        {"bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR"},
+        {"bufferView": 3, "componentType": 5123, "count": 3, "type": "SCALAR"}
+    ]
+})";
+
+// The Json string must outlive the model loading.
+GLTF::ModelCreateInfo GetSharedModelCI(const char* FileName, const std::string& Json, GLTF::ResourceManager* pResourceMgr)
+{
+    GLTF::ModelCreateInfo CI;
+    CI.FileName           = FileName;
+    CI.FileExistsCallback = [](const char*) {
+        return true;
+    };
+    CI.ReadWholeFileCallback = [&Json](const char*, std::vector<unsigned char>& Data, std::string&) {
+        Data.assign(Json.begin(), Json.end());
+        return true;
+    };
+    CI.pResourceManager    = pResourceMgr;
+    CI.DeduplicateMeshData = true;
+    return CI;
+}
+
+RefCntAutoPtr<GLTF::ResourceManager> CreateResourceManager(IRenderDevice* pDevice)
+{
+    GLTF::ResourceManager::CreateInfo ResMgrCI;
+    ResMgrCI.IndexAllocatorCI.Desc       = {"GLTF index buffer", 4096, BIND_INDEX_BUFFER, USAGE_DEFAULT};
+    ResMgrCI.DefaultPoolDesc.VertexCount = 1024;
+    return GLTF::ResourceManager::Create(pDevice, ResMgrCI);
+}
+
+TEST(Tools_GLTFResourceManager, SharesIdenticalPrimitives)
+{
+    GPUTestingEnvironment* pEnvironment = GPUTestingEnvironment::GetInstance();
+    ASSERT_NE(pEnvironment, nullptr);
+
+    IRenderDevice*  pDevice  = pEnvironment->GetDevice();
+    IDeviceContext* pContext = pEnvironment->GetDeviceContext();
+
+    RefCntAutoPtr<GLTF::ResourceManager> pResMgr = CreateResourceManager(pDevice);
+    ASSERT_NE(pResMgr, nullptr);
+
+    GLTF::Model ModelA{pDevice, pContext, GetSharedModelCI("SharedPrimitiveA.gltf", SharedPrimitiveModelA, pResMgr)};
+    GLTF::Model ModelB{pDevice, pContext, GetSharedModelCI("SharedPrimitiveB.gltf", SharedPrimitiveModelB, pResMgr)};
+    ASSERT_EQ(ModelA.Meshes.size(), 1u);
+    ASSERT_EQ(ModelB.Meshes.size(), 1u);
+    ASSERT_EQ(ModelA.Meshes[0].Primitives.size(), 2u);
+    ASSERT_EQ(ModelB.Meshes[0].Primitives.size(), 2u);
+    EXPECT_TRUE(ModelA.IsGPUDataInitialized());
+    EXPECT_TRUE(ModelB.IsGPUDataInitialized());
+
+    const GLTF::Primitive& PA = ModelA.Meshes[0].Primitives[0];
+    const GLTF::Primitive& QA = ModelA.Meshes[0].Primitives[1];
+    const GLTF::Primitive& RB = ModelB.Meshes[0].Primitives[0];
+    const GLTF::Primitive& PB = ModelB.Meshes[0].Primitives[1];
+    for (const GLTF::Primitive* pPrim : {&PA, &QA, &RB, &PB})
+    {
+        ASSERT_NE(pPrim->SharedData.pVertexAllocation, nullptr);
+        ASSERT_NE(pPrim->SharedData.pIndexAllocation, nullptr);
+    }
+
+    // The shared primitive uses the same allocations and draw locations in both models
+    EXPECT_EQ(PA.SharedData.pVertexAllocation.RawPtr(), PB.SharedData.pVertexAllocation.RawPtr());
+    EXPECT_EQ(PA.SharedData.pIndexAllocation.RawPtr(), PB.SharedData.pIndexAllocation.RawPtr());
+    EXPECT_EQ(ModelA.GetBaseVertex(PA), ModelB.GetBaseVertex(PB));
+    EXPECT_EQ(ModelA.GetFirstIndexLocation(PA), ModelB.GetFirstIndexLocation(PB));
+    EXPECT_EQ(ModelA.GetVertexPoolIndex(PA), ModelB.GetVertexPoolIndex(PB));
+    EXPECT_EQ(ModelA.GetIndexAllocatorIndex(PA), ModelB.GetIndexAllocatorIndex(PB));
+
+    // Other primitives have their own vertices
+    EXPECT_NE(QA.SharedData.pVertexAllocation.RawPtr(), PA.SharedData.pVertexAllocation.RawPtr());
+    EXPECT_NE(RB.SharedData.pVertexAllocation.RawPtr(), PA.SharedData.pVertexAllocation.RawPtr());
+    EXPECT_NE(RB.SharedData.pVertexAllocation.RawPtr(), QA.SharedData.pVertexAllocation.RawPtr());
+
+    // Indices are relative to the primitive vertex range, so identical indices are shared by all primitives
+    EXPECT_EQ(QA.SharedData.pIndexAllocation.RawPtr(), PA.SharedData.pIndexAllocation.RawPtr());
+    EXPECT_EQ(RB.SharedData.pIndexAllocation.RawPtr(), PA.SharedData.pIndexAllocation.RawPtr());
+}
+
+TEST(Tools_GLTFResourceManager, SharesPrimitivesOfModelsLoadedInParallel)
+{
+    GPUTestingEnvironment* pEnvironment = GPUTestingEnvironment::GetInstance();
+    ASSERT_NE(pEnvironment, nullptr);
+
+    IRenderDevice* pDevice = pEnvironment->GetDevice();
+
+    RefCntAutoPtr<GLTF::ResourceManager> pResMgr = CreateResourceManager(pDevice);
+    ASSERT_NE(pResMgr, nullptr);
+
+    // Every thread loads a model that contains primitive P. Since the lookup and the allocation are
+    // performed atomically, all models must end up with the same allocation.
+    constexpr size_t NumThreads = 8;
+
+    std::vector<std::unique_ptr<GLTF::Model>> Models(NumThreads);
+    std::vector<std::thread>                  Threads;
+    for (size_t i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back([&, i]() {
+            const bool                  UseModelA = (i % 2) == 0;
+            const GLTF::ModelCreateInfo CI        = UseModelA ?
+                GetSharedModelCI("SharedPrimitiveA.gltf", SharedPrimitiveModelA, pResMgr) :
+                GetSharedModelCI("SharedPrimitiveB.gltf", SharedPrimitiveModelB, pResMgr);
+            Models[i] = std::make_unique<GLTF::Model>(pDevice, nullptr, CI);
+        });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    const IVertexPoolAllocation* pSharedVertices = Models[0]->Meshes[0].Primitives[0].SharedData.pVertexAllocation;
+    const IBufferSuballocation*  pSharedIndices  = Models[0]->Meshes[0].Primitives[0].SharedData.pIndexAllocation;
+    ASSERT_NE(pSharedVertices, nullptr);
+    ASSERT_NE(pSharedIndices, nullptr);
+    for (size_t i = 0; i < NumThreads; ++i)
+    {
+        const GLTF::Primitive& P = Models[i]->Meshes[0].Primitives[(i % 2) == 0 ? 0 : 1];
+        EXPECT_EQ(P.SharedData.pVertexAllocation.RawPtr(), pSharedVertices) << "Model " << i;
+        EXPECT_EQ(P.SharedData.pIndexAllocation.RawPtr(), pSharedIndices) << "Model " << i;
+    }
+
+    for (std::unique_ptr<GLTF::Model>& pModel : Models)
+        EXPECT_TRUE(pModel->PrepareGPUResources(pDevice, pEnvironment->GetDeviceContext()));
+}
+
+} // namespace
@@ -25,10 +25,19 @@
  */
 
 #include "GLTFDocument.hpp"
+#include "ThreadPool.hpp"
+#include "ScopedTestFile.hpp"
+// Must match the configuration GLTFDocument.cpp compiles tinygltf with
+#define TINYGLTF_NO_STB_IMAGE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
 #include "../../../ThirdParty/tinygltf/tiny_gltf.h"
 
 #include "gtest/gtest.h"
 
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -323,4 +332,169 @@ TEST(Tools_GLTFDocument, CopiesDataUriImageBytesWhenDecodeImagesIsFalse)
     EXPECT_EQ(TextureSource.DataSize, Image.image.size());
 }
 
+TEST(Tools_GLTFDocument, DecodesImagesInParallelWithThreadPool)
+{
+    // Two 2x2 RGB PNG images that are expanded to RGBA8 by the loader.
+    InMemoryGLTFFiles Files;
+    Files.Files.emplace(
+        "parallel.gltf",
+        MakeBytes(R"({
+            "asset": {"version": "2.0"},
+            "images": [
+                {
+                    "name": "Image0",
+                    "uri": "data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAAAIAAAACCAIAAAD91JpzAAAAEklEQVR4nGP4z8DAAMIM/4EAAB/uBfsL2WiLAAAAAElFTkSuQmCC"
+                },
+                {
+                    "name": "Image1",
+                    "uri": "data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAAAIAAAACCAIAAAD91JpzAAAAEklEQVR4nGP4z8DAAMIM/4EAAB/uBfsL2WiLAAAAAElFTkSuQmCC"
+                }
+            ],
+            "textures": [{"source": 0}, {"source": 1}]
+        })"));
+
+    GLTF::DocumentLoadInfo LoadInfo;
+    LoadInfo.FileName           = "parallel.gltf";
+    LoadInfo.FileExistsCallback = [&Files](const char* FilePath) //
+    {
+        return Files.FileExists(FilePath);
+    };
+    LoadInfo.ReadWholeFileCallback = [&Files](const char* FilePath, std::vector<unsigned char>& Data, std::string& Error) //
+    {
+        return Files.ReadWholeFile(FilePath, Data, Error);
+    };
+
+    GLTF::Document SerialDocument{LoadInfo};
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+    LoadInfo.pThreadPool = pThreadPool;
+
+    GLTF::Document ParallelDocument{LoadInfo};
+
+    const tinygltf::Model& SerialModel   = SerialDocument.GetModel();
+    const tinygltf::Model& ParallelModel = ParallelDocument.GetModel();
+    ASSERT_EQ(SerialModel.images.size(), 2u);
+    ASSERT_EQ(ParallelModel.images.size(), 2u);
+
+    const std::vector<unsigned char> ExpectedPixels{
+        255, 0, 0, 255, /**/ 0, 255, 0, 255,
+        0, 0, 255, 255, /**/ 255, 255, 255, 255};
+    for (size_t i = 0; i < ParallelModel.images.size(); ++i)
+    {
+        const tinygltf::Image& SerialImage   = SerialModel.images[i];
+        const tinygltf::Image& ParallelImage = ParallelModel.images[i];
+        EXPECT_EQ(ParallelImage.name, SerialImage.name);
+        EXPECT_EQ(ParallelImage.width, 2);
+        EXPECT_EQ(ParallelImage.height, 2);
+        EXPECT_EQ(ParallelImage.component, 4);
+        EXPECT_EQ(ParallelImage.bits, 8);
+        EXPECT_EQ(ParallelImage.image, ExpectedPixels);
+        EXPECT_EQ(ParallelImage.image, SerialImage.image);
+    }
+
+    // The loader must only wait for its own tasks, so unrelated work that occupies
+    // one of the workers of a shared pool must not block the load.
+    std::promise<void>        ReleaseTask;
+    std::shared_future<void>  TaskReleased = ReleaseTask.get_future().share();
+    RefCntAutoPtr<IAsyncTask> pUnrelatedTask =
+        EnqueueAsyncWork(pThreadPool,
+                         [TaskReleased](Uint32 ThreadId) {
+                             TaskReleased.wait();
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         });
+
+    GLTF::Document SharedPoolDocument{LoadInfo};
+    ReleaseTask.set_value();
+    pUnrelatedTask->WaitForCompletion();
+
+    const tinygltf::Model& SharedPoolModel = SharedPoolDocument.GetModel();
+    ASSERT_EQ(SharedPoolModel.images.size(), 2u);
+    for (const tinygltf::Image& Image : SharedPoolModel.images)
+        EXPECT_EQ(Image.image, ExpectedPixels);
+}
+
+TEST(Tools_GLTFDocument, ReferencesMemoryMappedGlbBinChunk)
+{
+    std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "buffers": [{"byteLength": 8}],
+        "bufferViews": [{"buffer": 0, "byteOffset": 4, "byteLength": 4}],
+        "images": [{"name": "EmbeddedTexture", "bufferView": 0, "mimeType": "image/png"}],
+        "textures": [{"source": 0}]
+    })";
+    while (Json.size() % 4 != 0)
+        Json += ' ';
+
+    const std::vector<unsigned char> Bin{1, 2, 3, 4, 0x89u, 'P', 'N', 'G'};
+
+    std::vector<unsigned char> Glb;
+
+    auto WriteUint32 = [&Glb](uint32_t Value) {
+        for (int i = 0; i < 4; ++i)
+            Glb.push_back(static_cast<unsigned char>((Value >> (8 * i)) & 0xFFu));
+    };
+    WriteUint32(0x46546C67u); // glTF
+    WriteUint32(2);
+    WriteUint32(static_cast<uint32_t>(12 + 8 + Json.size() + 8 + Bin.size()));
+    WriteUint32(static_cast<uint32_t>(Json.size()));
+    WriteUint32(0x4E4F534Au); // JSON
+    Glb.insert(Glb.end(), Json.begin(), Json.end());
+    WriteUint32(static_cast<uint32_t>(Bin.size()));
+    WriteUint32(0x004E4942u); // BIN
+    Glb.insert(Glb.end(), Bin.begin(), Bin.end());
+
+    const ScopedTestFile TestFile{"MemoryMappedDocumentTest.glb"};
+    const char* const    FileName = TestFile.GetPath();
+    {
+        std::ofstream File{FileName, std::ios::binary};
+        ASSERT_TRUE(File.good());
+        File.write(reinterpret_cast<const char*>(Glb.data()), static_cast<std::streamsize>(Glb.size()));
+    }
+
+    {
+        GLTF::DocumentLoadInfo LoadInfo;
+        LoadInfo.FileName         = FileName;
+        LoadInfo.DecodeImages     = false;
+        LoadInfo.UseMemoryMapping = true;
+
+        GLTF::Document Document{LoadInfo};
+
+        const tinygltf::Model& Model = Document.GetModel();
+        ASSERT_EQ(Model.buffers.size(), 1u);
+
+        const tinygltf::Buffer& Buffer = Model.buffers[0];
+        EXPECT_TRUE(Buffer.data.empty());
+        ASSERT_NE(Buffer.external_data, nullptr);
+        ASSERT_EQ(Buffer.GetSize(), Bin.size());
+        EXPECT_EQ(std::vector<unsigned char>(Buffer.GetData(), Buffer.GetData() + Buffer.GetSize()), Bin);
+
+        GLTF::TextureSourceInfo TextureSource;
+        ASSERT_TRUE(Document.GetTextureSourceInfo(0, TextureSource));
+        EXPECT_EQ(TextureSource.pData, Buffer.GetData() + 4);
+        EXPECT_EQ(TextureSource.DataSize, 4u);
+
+        // Mapped buffers must be written by the serializer
+        tinygltf::Model ModelCopy = Model;
+        ModelCopy.images.clear();
+        ModelCopy.textures.clear();
+
+        tinygltf::TinyGLTF Writer;
+        {
+            std::stringstream GltfStream;
+            ASSERT_TRUE(Writer.WriteGltfSceneToStream(&ModelCopy, GltfStream, false, false));
+            const std::string Gltf = GltfStream.str();
+            EXPECT_NE(Gltf.find("\"byteLength\":8"), std::string::npos) << Gltf;
+            EXPECT_NE(Gltf.find("data:application/octet-stream;base64,AQIDBIlQTkc="), std::string::npos) << Gltf;
+        }
+        {
+            std::stringstream GlbStream;
+            ASSERT_TRUE(Writer.WriteGltfSceneToStream(&ModelCopy, GlbStream, false, true));
+            const std::string Glb = GlbStream.str();
+            ASSERT_GE(Glb.size(), Bin.size());
+            EXPECT_EQ(std::vector<unsigned char>(Glb.end() - Bin.size(), Glb.end()), Bin);
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,309 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Timing harness for the run-time paths of the GLTF loader. The results depend on the machine,
+// so the tests are disabled by default. Run them with
+//
+//   DiligentToolsTest --gtest_also_run_disabled_tests --gtest_filter=Tools_GLTFLoaderBenchmark.*
+
+#include "GLTFLoader.hpp"
+#include "GLTFSceneBVH.hpp"
+
+#include "gtest/gtest.h"
+
+#include "ThreadPool.hpp"
+#include "DebugOutput.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Diligent;
+
+namespace
+{
+
+// Returns the average duration of Func in milliseconds.
+template <typename FuncType>
+double MeasureTime(Uint32 NumRuns, FuncType&& Func)
+{
+    // Warm up the caches and the thread pool
+    Func();
+
+    const auto Start = std::chrono::steady_clock::now();
+    for (Uint32 i = 0; i < NumRuns; ++i)
+        Func();
+    const std::chrono::duration<double, std::milli> Duration = std::chrono::steady_clock::now() - Start;
+    return Duration.count() / NumRuns;
+}
+
+// The Json string must outlive the model loading.
+GLTF::ModelCreateInfo GetJsonModelCI(const char* FileName, const std::string& Json)
+{
+    GLTF::ModelCreateInfo CI;
+    CI.FileName           = FileName;
+    CI.FileExistsCallback = [](const char*) {
+        return true;
+    };
+    CI.ReadWholeFileCallback = [&Json](const char*, std::vector<unsigned char>& Data, std::string&) {
+        Data.assign(Json.begin(), Json.end());
+        return true;
+    };
+    return CI;
+}
+
+// Skeleton-like hierarchy of NumChains chains of ChainLength nodes.
+std::string GetSkeletonJson(Uint32 NumChains, Uint32 ChainLength)
+{
+    std::string Nodes;
+    std::string Roots;
+    for (Uint32 c = 0; c < NumChains; ++c)
+    {
+        for (Uint32 i = 0; i < ChainLength; ++i)
+        {
+            const Uint32 NodeId = c * ChainLength + i;
+            Nodes += NodeId > 0 ? ", " : "";
+            Nodes += "{\"translation\": [0, 1, 0]";
+            if (i + 1 < ChainLength)
+                Nodes += ", \"children\": [" + std::to_string(NodeId + 1) + "]";
+            Nodes += "}";
+        }
+        Roots += (c > 0 ? ", " : "") + std::to_string(c * ChainLength);
+    }
+
+    return R"({"asset": {"version": "2.0"}, "scene": 0, "scenes": [{"nodes": [)" + Roots + R"(]}], "nodes": [)" + Nodes + "]}";
+}
+
+// Adds an animation that rotates every node of the model, with NumKeys keys sampled at 30 fps.
+void AddRotationAnimation(GLTF::Model& Mdl, Uint32 NumKeys)
+{
+    GLTF::Animation Anim;
+    Anim.Samplers.emplace_back(GLTF::AnimationSampler::INTERPOLATION_TYPE::LINEAR);
+    GLTF::AnimationSampler& Sampler = Anim.Samplers.back();
+    for (Uint32 k = 0; k < NumKeys; ++k)
+    {
+        // Rotation around the Z axis
+        const float HalfAngle = static_cast<float>(k) * 0.025f;
+        Sampler.Inputs.push_back(static_cast<float>(k) / 30.f);
+        Sampler.OutputsVec4.push_back(float4{0, 0, std::sin(HalfAngle), std::cos(HalfAngle)});
+    }
+
+    for (GLTF::Node& N : Mdl.Nodes)
+        Anim.Channels.emplace_back(GLTF::AnimationChannel::PATH_TYPE::ROTATION, &N, 0u);
+
+    Anim.Start = Sampler.Inputs.front();
+    Anim.End   = Sampler.Inputs.back();
+    Mdl.Animations.push_back(std::move(Anim));
+}
+
+// Returns true if the box is not entirely behind any of the frustum planes.
+bool IsBoxInFrustum(const ViewFrustum& Frustum, const BoundBox& Box)
+{
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+    {
+        const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+
+        // The corner of the box that is the farthest along the plane normal
+        const float3 Corner{
+            Plane.Normal.x >= 0 ? Box.Max.x : Box.Min.x,
+            Plane.Normal.y >= 0 ? Box.Max.y : Box.Min.y,
+            Plane.Normal.z >= 0 ? Box.Max.z : Box.Min.z,
+        };
+        if (dot(Corner, Plane.Normal) + Plane.Distance < 0)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Batched ComputeTransforms() of a crowd of animated instances with different thread counts.
+// The speed-up should be close to the number of threads up to the number of physical cores.
+TEST(Tools_GLTFLoaderBenchmark, DISABLED_BatchedComputeTransforms)
+{
+    const std::string Json = GetSkeletonJson(8, 8);
+    GLTF::Model       Mdl{nullptr, nullptr, GetJsonModelCI("Skeleton.gltf", Json)};
+    ASSERT_EQ(Mdl.Nodes.size(), 64u);
+    AddRotationAnimation(Mdl, 300);
+
+    constexpr size_t NumInstances = 1024;
+
+    std::vector<GLTF::ModelTransforms>          Transforms(NumInstances);
+    std::vector<GLTF::ModelTransformsBatchItem> Items(NumInstances);
+    for (size_t i = 0; i < NumInstances; ++i)
+    {
+        Items[i].pTransforms    = &Transforms[i];
+        Items[i].RootTransform  = float4x4::Translation(static_cast<float>(i % 32), 0, static_cast<float>(i / 32));
+        Items[i].AnimationIndex = 0;
+        Items[i].Time           = static_cast<float>(i % 97) * 0.1f;
+    }
+
+    const double SerialTime = MeasureTime(20, [&]() {
+        Mdl.ComputeTransforms(0, Items.data(), Items.size());
+    });
+    LOG_INFO_MESSAGE(NumInstances, " instances, 1 thread: ", SerialTime, " ms");
+
+    const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    for (Uint32 NumThreads = 2; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        // The calling thread processes chunks too, so the pool needs one thread less
+        RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads - 1});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        const double Time = MeasureTime(20, [&]() {
+            Mdl.ComputeTransforms(0, Items.data(), Items.size(), pThreadPool);
+        });
+        LOG_INFO_MESSAGE(NumInstances, " instances, ", NumThreads, " threads: ", Time, " ms, speed-up: ", SerialTime / Time);
+    }
+}
+
+// Key frame lookups of monotonically advancing time with and without the key frame cursor for
+// clips of different lengths. The cost of a cursor lookup should not depend on the clip length.
+TEST(Tools_GLTFLoaderBenchmark, DISABLED_KeyFrameLookup)
+{
+    constexpr Uint32 NumLookups = 1000000;
+    for (Uint32 NumKeys : {1000u, 100000u, 1000000u})
+    {
+        GLTF::AnimationSampler Sampler{GLTF::AnimationSampler::INTERPOLATION_TYPE::LINEAR};
+        Sampler.Inputs.resize(NumKeys);
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            Sampler.Inputs[i] = static_cast<float>(i) / 30.f;
+
+        // 60 fps playback that loops over the clip
+        std::vector<float> Times(NumLookups);
+        const float        Duration = Sampler.Inputs.back();
+        for (Uint32 i = 0; i < NumLookups; ++i)
+            Times[i] = std::fmod(static_cast<float>(i) / 60.f, Duration);
+
+        size_t     SearchSum  = 0;
+        const auto SearchTime = MeasureTime(5, [&]() {
+            SearchSum = 0;
+            for (float Time : Times)
+                SearchSum += Sampler.FindKeyFrame(Time);
+        });
+
+        size_t     CursorSum  = 0;
+        const auto CursorTime = MeasureTime(5, [&]() {
+            CursorSum     = 0;
+            Uint32 Cursor = 0;
+            for (float Time : Times)
+                CursorSum += Sampler.FindKeyFrame(Time, Cursor);
+        });
+        EXPECT_EQ(CursorSum, SearchSum);
+
+        LOG_INFO_MESSAGE(NumKeys, " keys: binary search ", SearchTime * 1e6 / NumLookups, " ns, cursor ", CursorTime * 1e6 / NumLookups,
+                         " ns per lookup");
+    }
+}
+
+// Frustum culling of a large static scene with the scene BVH and with brute force tests of all
+// primitive boxes, for frusta that contain different fractions of the scene.
+TEST(Tools_GLTFLoaderBenchmark, DISABLED_SceneBVHFrustumCulling)
+{
+    // 64 x 64 x 8 copies of a triangle on a grid with a spacing of 2
+    constexpr Uint32 GridSize[] = {64, 64, 8};
+
+    std::string Nodes;
+    std::string SceneNodes;
+    Uint32      NumNodes = 0;
+    for (Uint32 z = 0; z < GridSize[2]; ++z)
+    {
+        for (Uint32 y = 0; y < GridSize[1]; ++y)
+        {
+            for (Uint32 x = 0; x < GridSize[0]; ++x, ++NumNodes)
+            {
+                Nodes += NumNodes > 0 ? ", " : "";
+                Nodes += "{\"mesh\": 0, \"translation\": [" + std::to_string(x * 2) + ", " + std::to_string(y * 2) + ", " + std::to_string(z * 2) + "]}";
+                SceneNodes += (NumNodes > 0 ? ", " : "") + std::to_string(NumNodes);
+            }
+        }
+    }
+
+    const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [)" + SceneNodes + R"(]}],
+        "nodes": [)" + Nodes + R"(],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+        "buffers": [{"byteLength": 36, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA"}],
+        "bufferViews": [{"buffer": 0, "byteOffset": 0, "byteLength": 36}],
+        "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]}]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("SceneBVHBenchmark.gltf", Json)};
+    ASSERT_EQ(Mdl.Nodes.size(), NumNodes);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+
+    GLTF::SceneBVH BVH;
+    BVH.Build(Mdl, 0, Transforms);
+    ASSERT_EQ(BVH.GetPrimitiveCount(), NumNodes);
+
+    std::vector<BoundBox> PrimBounds(NumNodes);
+    for (const GLTF::Node& N : Mdl.Nodes)
+        PrimBounds[N.Index] = N.pMesh->Primitives[0].BB.Transform(Transforms.NodeGlobalMatrices[N.Index]);
+
+    // Axis-aligned frusta that contain 1/64, 1/8 and 1/2 of the grid in X and Y
+    for (float Fraction : {1.f / 8.f, 1.f / 2.83f, 1.f / 1.41f})
+    {
+        const float Size = Fraction * GridSize[0] * 2;
+
+        ViewFrustum Frustum;
+        Frustum.LeftPlane   = Plane3D{float3{+1, 0, 0}, 0.5f};
+        Frustum.RightPlane  = Plane3D{float3{-1, 0, 0}, Size};
+        Frustum.BottomPlane = Plane3D{float3{0, +1, 0}, 0.5f};
+        Frustum.TopPlane    = Plane3D{float3{0, -1, 0}, Size};
+        Frustum.NearPlane   = Plane3D{float3{0, 0, +1}, 0.5f};
+        Frustum.FarPlane    = Plane3D{float3{0, 0, -1}, 1000.f};
+
+        std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+        VisiblePrims.reserve(NumNodes);
+        GLTF::SceneBVHQueryStats Stats;
+
+        const double BVHTime = MeasureTime(50, [&]() {
+            VisiblePrims.clear();
+            BVH.QueryVisible(Frustum, VisiblePrims, &Stats);
+        });
+        const size_t NumVisible = VisiblePrims.size();
+
+        const double BruteForceTime = MeasureTime(50, [&]() {
+            VisiblePrims.clear();
+            for (Uint32 i = 0; i < NumNodes; ++i)
+            {
+                if (IsBoxInFrustum(Frustum, PrimBounds[i]))
+                    VisiblePrims.push_back({i, 0});
+            }
+        });
+        EXPECT_EQ(VisiblePrims.size(), NumVisible);
+
+        LOG_INFO_MESSAGE(NumVisible, " of ", NumNodes, " primitives visible. BVH: ", BVHTime, " ms (", Stats.NumNodeTests, " node and ",
+                         Stats.NumPrimitiveTests, " primitive tests), brute force: ", BruteForceTime, " ms, speed-up: ", BruteForceTime / BVHTime);
+    }
+}
@@ -25,13 +25,28 @@
  */
 
 #include "GLTFLoader.hpp"
+#include "GLTFSceneBVH.hpp"
+#include "GLTFDrawList.hpp"
 #include "../../../ThirdParty/tinygltf/tiny_gltf.h"
 
 #include "gtest/gtest.h"
 
+#include "Align.hpp"
 #include "Image.h"
+#include "ThreadPool.hpp"
+#include "ScopedTestFile.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace Diligent
 {
@@ -102,4 +117,2162 @@ TEST(Tools_GLTFLoader, MSFTTextureDDSRejectsNonDDSImageData)
     EXPECT_EQ(GLTF::MSFTTextureDDS::GetSource(Texture, Model), -1);
 }
 
+TEST(Tools_GLTFLoader, LoadsModelFromCookedFile)
+{
+    const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"name": "Scene", "nodes": [0]}],
+        "nodes": [
+            {"name": "Root", "camera": 0, "children": [1]},
+            {"name": "Triangle", "mesh": 0, "translation": [1, 2, 3]}
+        ],
+        "cameras": [{"type": "perspective", "perspective": {"yfov": 0.75, "znear": 0.1, "zfar": 100}}],
+        "meshes": [{"name": "TriangleMesh", "primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 0}]}],
+        "materials": [{"pbrMetallicRoughness": {"baseColorTexture": {"index": 0}}, "normalTexture": {"index": 1}}],
+        "textures": [{"source": 0, "sampler": 0}, {"source": 0}],
+        "samplers": [{"magFilter": 9728, "minFilter": 9728, "wrapS": 33071, "wrapT": 33648}],
+        "images": [{"uri": "data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAAAIAAAACCAIAAAD91JpzAAAAEklEQVR4nGP4z8DAAMIM/4EAAB/uBfsL2WiLAAAAAElFTkSuQmCC"}],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 6}
+        ],
+        "buffers": [{"byteLength": 44, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAA="}]
+    })";
+
+    std::vector<unsigned char> Source{Json.begin(), Json.end()};
+
+    const char* const    FileName = "CookedModelTest.gltf";
+    const ScopedTestFile CookedFile{"CookedModelTest.cooked"};
+    const char* const    CookedFileName = CookedFile.GetPath();
+
+    int NumSourceReads = 0;
+
+    GLTF::ModelCreateInfo CI;
+    CI.FileName           = FileName;
+    CI.CookedFileName     = CookedFileName;
+    CI.NarrowIndices      = true;
+    CI.KeepCPUVertexData  = true;
+    CI.KeepCPUIndexData   = true;
+    CI.FileExistsCallback = [](const char*) {
+        return true;
+    };
+    CI.ReadWholeFileCallback = [&](const char*, std::vector<unsigned char>& Data, std::string&) {
+        ++NumSourceReads;
+        Data = Source;
+        return true;
+    };
+
+    // The first load parses the source file and writes the cooked file
+    GLTF::Model SourceModel{nullptr, nullptr, CI};
+    EXPECT_EQ(NumSourceReads, 2); // Source hash + document
+    ASSERT_TRUE(std::ifstream{CookedFileName}.good());
+
+    // The time stamp is not available through the callback, so the second
+    // load reads the source file to compare its contents.
+    NumSourceReads = 0;
+    GLTF::Model CachedModel{nullptr, nullptr, CI};
+    EXPECT_EQ(NumSourceReads, 1);
+
+    ASSERT_EQ(CachedModel.Nodes.size(), SourceModel.Nodes.size());
+    ASSERT_EQ(CachedModel.Nodes.size(), 2u);
+    for (size_t i = 0; i < CachedModel.Nodes.size(); ++i)
+    {
+        const GLTF::Node& SrcNode    = SourceModel.Nodes[i];
+        const GLTF::Node& CookedNode = CachedModel.Nodes[i];
+        EXPECT_EQ(CookedNode.Name, SrcNode.Name);
+        EXPECT_EQ(CookedNode.Translation, SrcNode.Translation);
+        EXPECT_EQ(CookedNode.Parent != nullptr ? CookedNode.Parent->Index : -1, SrcNode.Parent != nullptr ? SrcNode.Parent->Index : -1);
+        EXPECT_EQ(CookedNode.Children.size(), SrcNode.Children.size());
+        EXPECT_EQ(CookedNode.pMesh != nullptr, SrcNode.pMesh != nullptr);
+        EXPECT_EQ(CookedNode.pCamera != nullptr, SrcNode.pCamera != nullptr);
+    }
+    EXPECT_EQ(CachedModel.Nodes[1].Parent, &CachedModel.Nodes[0]);
+    EXPECT_EQ(CachedModel.Nodes[1].pMesh, &CachedModel.Meshes[0]);
+    EXPECT_EQ(CachedModel.Nodes[0].pCamera, &CachedModel.Cameras[0]);
+
+    ASSERT_EQ(CachedModel.Scenes.size(), 1u);
+    EXPECT_EQ(CachedModel.Scenes[0].Name, "Scene");
+    ASSERT_EQ(CachedModel.Scenes[0].RootNodes.size(), 1u);
+    EXPECT_EQ(CachedModel.Scenes[0].RootNodes[0], &CachedModel.Nodes[0]);
+    EXPECT_EQ(CachedModel.Scenes[0].LinearNodes.size(), SourceModel.Scenes[0].LinearNodes.size());
+
+    ASSERT_EQ(CachedModel.Cameras.size(), 1u);
+    EXPECT_EQ(CachedModel.Cameras[0].Type, GLTF::Camera::Projection::Perspective);
+    EXPECT_EQ(CachedModel.Cameras[0].Perspective.YFov, SourceModel.Cameras[0].Perspective.YFov);
+
+    ASSERT_EQ(CachedModel.Meshes.size(), 1u);
+    EXPECT_EQ(CachedModel.Meshes[0].Name, "TriangleMesh");
+    ASSERT_EQ(CachedModel.Meshes[0].Primitives.size(), 1u);
+    const GLTF::Primitive& SrcPrim    = SourceModel.Meshes[0].Primitives[0];
+    const GLTF::Primitive& CookedPrim = CachedModel.Meshes[0].Primitives[0];
+    EXPECT_EQ(CookedPrim.FirstIndex, SrcPrim.FirstIndex);
+    EXPECT_EQ(CookedPrim.IndexCount, SrcPrim.IndexCount);
+    EXPECT_EQ(CookedPrim.FirstVertex, SrcPrim.FirstVertex);
+    EXPECT_EQ(CookedPrim.VertexCount, SrcPrim.VertexCount);
+    EXPECT_EQ(CookedPrim.MaterialId, SrcPrim.MaterialId);
+    EXPECT_EQ(CookedPrim.BB.Min, SrcPrim.BB.Min);
+    EXPECT_EQ(CookedPrim.BB.Max, SrcPrim.BB.Max);
+    EXPECT_EQ(SrcPrim.IndexType, VT_UINT16);
+    EXPECT_EQ(CookedPrim.IndexType, SrcPrim.IndexType);
+
+    EXPECT_EQ(CachedModel.DefaultSceneId, SourceModel.DefaultSceneId);
+    for (Uint32 i = 0; i < CachedModel.GetNumVertexAttributes(); ++i)
+        EXPECT_EQ(CachedModel.IsVertexAttributeEnabled(i), SourceModel.IsVertexAttributeEnabled(i));
+
+    // The converted index and vertex data are restored byte for byte
+    ASSERT_FALSE(SourceModel.CPUIndexData.empty());
+    EXPECT_EQ(CachedModel.CPUIndexData, SourceModel.CPUIndexData);
+    ASSERT_EQ(CachedModel.CPUVertexData.size(), SourceModel.CPUVertexData.size());
+    for (size_t i = 0; i < CachedModel.CPUVertexData.size(); ++i)
+        EXPECT_EQ(CachedModel.CPUVertexData[i], SourceModel.CPUVertexData[i]) << "Vertex buffer " << i;
+
+    // Texture GPU objects are not created without a device, so the textures are compared
+    // through the material bindings: texture ids, UV selectors and packed sampler state.
+    ASSERT_EQ(CachedModel.Materials.size(), SourceModel.Materials.size());
+    ASSERT_EQ(CachedModel.Materials.size(), 1u);
+    const GLTF::Material& SrcMat    = SourceModel.Materials[0];
+    const GLTF::Material& CookedMat = CachedModel.Materials[0];
+    EXPECT_EQ(SrcMat.GetNumActiveTextureAttribs(), 2u);
+    ASSERT_EQ(CookedMat.GetMaxActiveTextureAttribIdx(), SrcMat.GetMaxActiveTextureAttribIdx());
+    EXPECT_EQ(CookedMat.GetNumActiveTextureAttribs(), SrcMat.GetNumActiveTextureAttribs());
+    for (Uint32 i = 0; i <= SrcMat.GetMaxActiveTextureAttribIdx(); ++i)
+    {
+        EXPECT_EQ(CookedMat.IsTextureAttribActive(i), SrcMat.IsTextureAttribActive(i)) << "Texture attribute " << i;
+        EXPECT_EQ(CookedMat.GetTextureId(i), SrcMat.GetTextureId(i)) << "Texture attribute " << i;
+        EXPECT_EQ(memcmp(&CookedMat.GetTextureAttrib(i), &SrcMat.GetTextureAttrib(i), sizeof(GLTF::Material::TextureShaderAttribs)), 0) << "Texture attribute " << i;
+    }
+    EXPECT_EQ(memcmp(&CookedMat.Attribs, &SrcMat.Attribs, sizeof(SrcMat.Attribs)), 0);
+
+    // Modifying the source file invalidates the cooked file
+    Source.push_back(' ');
+    NumSourceReads = 0;
+    GLTF::Model ModifiedModel{nullptr, nullptr, CI};
+    EXPECT_EQ(NumSourceReads, 3); // Source comparison + source hash + document
+    EXPECT_EQ(ModifiedModel.Nodes.size(), 2u);
+}
+
+TEST(Tools_GLTFLoader, CookedFileChecksSourceTimeStampBeforeContents)
+{
+    // Two versions of the source file of the same size that differ by the node name
+    const auto GetSource = [](const char* NodeName) {
+        return std::string{R"({
+            "asset": {"version": "2.0"},
+            "scene": 0,
+            "scenes": [{"nodes": [0]}],
+            "nodes": [{"name": ")"} +
+            NodeName + R"(", "mesh": 0}],
+            "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+            "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]}],
+            "bufferViews": [{"buffer": 0, "byteLength": 36}],
+            "buffers": [{"byteLength": 36, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA"}]
+        })"};
+    };
+
+    const ScopedTestFile SourceFile{"CookedTimeStampTest.gltf"};
+    const ScopedTestFile CookedFile{"CookedTimeStampTest.cooked"};
+
+    const auto WriteSource = [&SourceFile, &GetSource](const char* NodeName, std::filesystem::file_time_type ModificationTime) {
+        {
+            std::ofstream File{SourceFile.GetPath(), std::ios::binary};
+            File << GetSource(NodeName);
+        }
+        std::filesystem::last_write_time(SourceFile.GetPath(), ModificationTime);
+    };
+
+    // Whole seconds are representable by the file systems of all platforms
+    const std::filesystem::file_time_type ModificationTime =
+        std::chrono::floor<std::chrono::seconds>(std::filesystem::file_time_type::clock::now() - std::chrono::hours{1});
+
+    GLTF::ModelCreateInfo CI;
+    CI.FileName       = SourceFile.GetPath();
+    CI.CookedFileName = CookedFile.GetPath();
+
+    WriteSource("NodeA", ModificationTime);
+    {
+        GLTF::Model Mdl{nullptr, nullptr, CI};
+        ASSERT_EQ(Mdl.Nodes.size(), 1u);
+        EXPECT_EQ(Mdl.Nodes[0].Name, "NodeA");
+    }
+
+    // The size and the modification time match, so the contents are not read and the cooked model is used
+    WriteSource("NodeB", ModificationTime);
+    {
+        GLTF::Model Mdl{nullptr, nullptr, CI};
+        ASSERT_EQ(Mdl.Nodes.size(), 1u);
+        EXPECT_EQ(Mdl.Nodes[0].Name, "NodeA");
+    }
+
+    // The modification time differs, so the contents are compared and the model is rebuilt
+    WriteSource("NodeB", ModificationTime + std::chrono::seconds{1});
+    {
+        GLTF::Model Mdl{nullptr, nullptr, CI};
+        ASSERT_EQ(Mdl.Nodes.size(), 1u);
+        EXPECT_EQ(Mdl.Nodes[0].Name, "NodeB");
+    }
+}
+
+TEST(Tools_GLTFLoader, NarrowsIndicesOfSmallPrimitives)
+{
+    // Four primitives of one mesh. Primitives with up to 65535 vertices are narrowed to 16-bit
+    // indices, while the last one has 65536 vertices and must keep 32-bit indices. The x coordinate
+    // of every vertex encodes the primitive and the vertex index in the source data.
+    const Uint32                           VertexCounts[] = {3, 4, 65535, 65536};
+    const std::vector<std::vector<Uint32>> SrcIndices     = {{2, 1, 0}, {0, 1, 2, 2, 1, 3}, {65534, 0, 32767}, {0, 65535, 32768}};
+    const auto                             GetVertexX     = [](size_t Prim, Uint32 Vertex) {
+        return static_cast<float>(Prim * 100000 + Vertex);
+    };
+
+    std::vector<Uint8> Bin;
+    const auto         AddBufferView = [&Bin](std::string& Views, const void* pData, size_t Size) {
+        if (!Views.empty())
+            Views += ", ";
+        Views += "{\"buffer\": 0, \"byteOffset\": " + std::to_string(Bin.size()) + ", \"byteLength\": " + std::to_string(Size) + "}";
+        Bin.insert(Bin.end(), static_cast<const Uint8*>(pData), static_cast<const Uint8*>(pData) + Size);
+        Bin.resize(AlignUp(Bin.size(), size_t{4}));
+    };
+
+    std::string BufferViews;
+    std::string Accessors;
+    std::string Primitives;
+    for (size_t p = 0; p < SrcIndices.size(); ++p)
+    {
+        std::vector<float3> Positions(VertexCounts[p]);
+        for (Uint32 v = 0; v < VertexCounts[p]; ++v)
+            Positions[v] = float3{GetVertexX(p, v), static_cast<float>(p), 0};
+        AddBufferView(BufferViews, Positions.data(), Positions.size() * sizeof(float3));
+
+        const bool Is32Bit = VertexCounts[p] > 0xFFFF;
+        if (Is32Bit)
+        {
+            AddBufferView(BufferViews, SrcIndices[p].data(), SrcIndices[p].size() * sizeof(Uint32));
+        }
+        else
+        {
+            const std::vector<Uint16> Indices16(SrcIndices[p].begin(), SrcIndices[p].end());
+            AddBufferView(BufferViews, Indices16.data(), Indices16.size() * sizeof(Uint16));
+        }
+
+        const std::string PosAccessor = std::to_string(p * 2);
+        const std::string IdxAccessor = std::to_string(p * 2 + 1);
+        Accessors += std::string{Accessors.empty() ? "" : ", "} +
+            "{\"bufferView\": " + PosAccessor + ", \"componentType\": 5126, \"count\": " + std::to_string(VertexCounts[p]) +
+            ", \"type\": \"VEC3\", \"min\": [" + std::to_string(GetVertexX(p, 0)) + ", " + std::to_string(p) + ", 0]" +
+            ", \"max\": [" + std::to_string(GetVertexX(p, VertexCounts[p] - 1)) + ", " + std::to_string(p) + ", 0]}, " +
+            "{\"bufferView\": " + IdxAccessor + ", \"componentType\": " + (Is32Bit ? "5125" : "5123") +
+            ", \"count\": " + std::to_string(SrcIndices[p].size()) + ", \"type\": \"SCALAR\"}";
+        Primitives += std::string{Primitives.empty() ? "" : ", "} +
+            "{\"attributes\": {\"POSITION\": " + PosAccessor + "}, \"indices\": " + IdxAccessor + "}";
+    }
+
+    const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [{"mesh": 0}],
+        "meshes": [{"primitives": [)" + Primitives + R"(]}],
+        "buffers": [{"byteLength": )" + std::to_string(Bin.size()) + R"(, "uri": "NarrowIndicesTest.bin"}],
+        "bufferViews": [)" + BufferViews + R"(],
+        "accessors": [)" + Accessors + R"(]
+    })";
+
+    GLTF::ModelCreateInfo CI;
+    CI.FileName           = "NarrowIndicesTest.gltf";
+    CI.FileExistsCallback = [](const char*) {
+        return true;
+    };
+    CI.ReadWholeFileCallback = [&](const char* Path, std::vector<unsigned char>& Data, std::string&) {
+        const std::string PathStr{Path};
+        if (PathStr.size() >= 4 && PathStr.compare(PathStr.size() - 4, 4, ".bin") == 0)
+            Data.assign(Bin.begin(), Bin.end());
+        else
+            Data.assign(Json.begin(), Json.end());
+        return true;
+    };
+    CI.IndexType         = VT_UINT32;
+    CI.NarrowIndices     = true;
+    CI.KeepCPUIndexData  = true;
+    CI.KeepCPUVertexData = true;
+
+    GLTF::Model Mdl{nullptr, nullptr, CI};
+    ASSERT_EQ(Mdl.Meshes.size(), 1u);
+    const std::vector<GLTF::Primitive>& Prims = Mdl.Meshes[0].Primitives;
+    ASSERT_EQ(Prims.size(), SrcIndices.size());
+
+    EXPECT_EQ(Prims[0].IndexType, VT_UINT16);
+    EXPECT_EQ(Prims[1].IndexType, VT_UINT16);
+    EXPECT_EQ(Prims[2].IndexType, VT_UINT16);
+    EXPECT_EQ(Prims[3].IndexType, VT_UINT32);
+
+    // Narrowed indices are relative to the vertex range of every primitive, so its start is the
+    // base vertex. Wide indices include the start of the range, and the base vertex is zero.
+    for (size_t p = 0; p < 3; ++p)
+        EXPECT_EQ(Prims[p].FirstVertex, Prims[p].VertexRangeStart) << "Primitive " << p;
+    EXPECT_NE(Prims[1].FirstVertex, Prims[0].FirstVertex);
+    EXPECT_EQ(Prims[3].FirstVertex, 0u);
+    EXPECT_NE(Prims[3].VertexRangeStart, 0u);
+
+    int PosAttribId = -1;
+    for (Uint32 i = 0; i < Mdl.GetNumVertexAttributes(); ++i)
+    {
+        if (strcmp(Mdl.GetVertexAttribute(i).Name, GLTF::PositionAttributeName) == 0)
+            PosAttribId = static_cast<int>(i);
+    }
+    ASSERT_GE(PosAttribId, 0);
+    const GLTF::VertexAttributeDesc& PosAttrib = Mdl.GetVertexAttribute(PosAttribId);
+    ASSERT_EQ(PosAttrib.ValueType, VT_FLOAT32);
+    ASSERT_LT(size_t{PosAttrib.BufferId}, Mdl.CPUVertexData.size());
+    const std::vector<Uint8>& PosData   = Mdl.CPUVertexData[PosAttrib.BufferId];
+    const Uint32              PosStride = Mdl.GetVertexBufferStride(PosAttrib.BufferId);
+
+    // Emulate an indexed draw of every primitive: fetch the index in the units of the primitive
+    // index type, add the base vertex and check that the fetched vertex is the source vertex.
+    const std::vector<Uint8>& IndexData = Mdl.CPUIndexData;
+    for (size_t p = 0; p < Prims.size(); ++p)
+    {
+        const GLTF::Primitive& Prim      = Prims[p];
+        const size_t           IndexSize = Prim.IndexType == VT_UINT16 ? 2 : 4;
+        ASSERT_EQ(Prim.IndexCount, SrcIndices[p].size());
+        ASSERT_LE((size_t{Prim.FirstIndex} + Prim.IndexCount) * IndexSize, IndexData.size());
+        for (Uint32 i = 0; i < Prim.IndexCount; ++i)
+        {
+            Uint32 Index = 0;
+            if (Prim.IndexType == VT_UINT16)
+            {
+                Uint16 Index16 = 0;
+                memcpy(&Index16, &IndexData[(size_t{Prim.FirstIndex} + i) * IndexSize], sizeof(Index16));
+                EXPECT_LT(Index16, Prim.VertexCount);
+                Index = Index16;
+            }
+            else
+            {
+                memcpy(&Index, &IndexData[(size_t{Prim.FirstIndex} + i) * IndexSize], sizeof(Index));
+            }
+
+            const size_t Vertex = size_t{Index} + Prim.FirstVertex;
+            ASSERT_LE((Vertex + 1) * PosStride, PosData.size());
+            float3 Pos;
+            memcpy(&Pos, &PosData[Vertex * PosStride + PosAttrib.RelativeOffset], sizeof(Pos));
+            EXPECT_EQ(Pos, (float3{GetVertexX(p, SrcIndices[p][i]), static_cast<float>(p), 0})) << "Primitive " << p << ", index " << i;
+        }
+    }
+}
+
+void ComputeReferenceGlobalTransform(const GLTF::Node& N, const float4x4& ParentMatrix, std::vector<float4x4>& GlobalMatrices)
+{
+    GlobalMatrices[N.Index] = N.ComputeLocalTransform() * ParentMatrix;
+    for (const GLTF::Node* pChild : N.Children)
+        ComputeReferenceGlobalTransform(*pChild, GlobalMatrices[N.Index], GlobalMatrices);
+}
+
+// The Json string must outlive the model loading.
+GLTF::ModelCreateInfo GetJsonModelCI(const char* FileName, const std::string& Json)
+{
+    GLTF::ModelCreateInfo CI;
+    CI.FileName           = FileName;
+    CI.FileExistsCallback = [](const char*) {
+        return true;
+    };
+    CI.ReadWholeFileCallback = [&Json](const char*, std::vector<unsigned char>& Data, std::string&) {
+        Data.assign(Json.begin(), Json.end());
+        return true;
+    };
+    return CI;
+}
+
+// Node hierarchy:
+//   Root -> A -> C
+//        -> B
+//   Root2 -> D
+//
+// The animated version animates the translation of A and the rotation of Root2.
+GLTF::ModelCreateInfo GetTransformTestModelCI(bool Animated = false)
+{
+    static const std::string Nodes = R"(
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 4]}],
+        "nodes": [
+            {"name": "Root", "translation": [1, 2, 3], "children": [1, 2]},
+            {"name": "A", "rotation": [0, 0.38268343, 0, 0.9238795], "children": [3]},
+            {"name": "B", "scale": [2, 0.5, 1.5], "translation": [-1, 0, 4]},
+            {"name": "C", "matrix": [1, 0, 0, 0, 0, 0, 1, 0, 0, -1, 0, 0, 5, 6, 7, 1]},
+            {"name": "Root2", "rotation": [0.25881905, 0, 0, 0.9659258], "children": [5]},
+            {"name": "D", "translation": [0.1, 0.2, 0.3], "scale": [3, 3, 3]}
+        ])";
+
+    // Times: 0, 1, 2
+    // Translations: (0, 0, 0), (1, 2, 3), (4, 0, -1)
+    // Rotations: identity, 45 and 90 degrees around Y
+    static const std::string Animation = R"(,
+        "buffers": [{"byteLength": 96, "uri": "data:application/octet-stream;base64,AAAAAAAAgD8AAABAAAAAAAAAAAAAAAAAAACAPwAAAEAAAEBAAACAQAAAAAAAAIC/AAAAAAAAAAAAAAAAAACAPwAAAAAV78M+AAAAAF6DbD8AAAAA8wQ1PwAAAADzBDU/"}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0,  "byteLength": 12},
+            {"buffer": 0, "byteOffset": 12, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 48, "byteLength": 48}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "SCALAR", "min": [0], "max": [2]},
+            {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC4"}
+        ],
+        "animations": [{
+            "samplers": [
+                {"input": 0, "output": 1, "interpolation": "LINEAR"},
+                {"input": 0, "output": 2, "interpolation": "LINEAR"}
+            ],
+            "channels": [
+                {"sampler": 0, "target": {"node": 1, "path": "translation"}},
+                {"sampler": 1, "target": {"node": 4, "path": "rotation"}}
+            ]
+        }])";
+
+    static const std::string Json         = "{" + Nodes + "}";
+    static const std::string AnimatedJson = "{" + Nodes + Animation + "}";
+
+    return Animated ?
+        GetJsonModelCI("AnimatedTransformTest.gltf", AnimatedJson) :
+        GetJsonModelCI("TransformTest.gltf", Json);
+}
+
+Uint32 FindNode(const GLTF::Model& Mdl, const char* Name)
+{
+    for (const GLTF::Node& N : Mdl.Nodes)
+    {
+        if (N.Name == Name)
+            return static_cast<Uint32>(N.Index);
+    }
+    ADD_FAILURE() << "Node " << Name << " is not found";
+    return 0;
+}
+
+TEST(Tools_GLTFLoader, MeshletVertexIndicesAreRelativeToVertexRange)
+{
+    // Triangles at z = 0 and z = 1 with separate vertex ranges, and a line loop
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [{"mesh": 0}],
+        "meshes": [{"primitives": [
+            {"attributes": {"POSITION": 0}, "indices": 2},
+            {"attributes": {"POSITION": 1}, "indices": 2},
+            {"attributes": {"POSITION": 0}, "indices": 3, "mode": 1}
+        ]}],
+        "buffers": [{"byteLength": 92, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAIA/AACAPwAAAAAAAIA/AAAAAAAAgD8AAIA/AAABAAIAAAAAAAEAAQACAAIAAAA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 6},
+            {"buffer": 0, "byteOffset": 80, "byteLength": 12}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 1], "max": [1, 1, 1]},
+            {"bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR"},
+            {"bufferView": 3, "componentType": 5123, "count": 6, "type": "SCALAR"}
+        ]
+    })";
+
+    GLTF::ModelCreateInfo CI = GetJsonModelCI("MeshletTest.gltf", Json);
+    CI.BuildMeshlets         = true;
+    CI.KeepCPUVertexData     = true;
+
+    GLTF::Model Mdl{nullptr, nullptr, CI};
+    ASSERT_EQ(Mdl.Meshes.size(), 1u);
+    const std::vector<GLTF::Primitive>& Prims = Mdl.Meshes[0].Primitives;
+    ASSERT_EQ(Prims.size(), 3u);
+
+    // The line loop has six indices, but it is not split into meshlets
+    EXPECT_EQ(Prims[2].MeshletCount, 0u);
+
+    // The second triangle follows the first one in the vertex data
+    EXPECT_EQ(Mdl.GetVertexRangeStart(Prims[0]), 0u);
+    EXPECT_EQ(Mdl.GetVertexRangeStart(Prims[1]), 3u);
+
+    int PosAttribId = -1;
+    for (Uint32 i = 0; i < Mdl.GetNumVertexAttributes(); ++i)
+    {
+        if (strcmp(Mdl.GetVertexAttribute(i).Name, GLTF::PositionAttributeName) == 0)
+            PosAttribId = static_cast<int>(i);
+    }
+    ASSERT_GE(PosAttribId, 0);
+    const GLTF::VertexAttributeDesc& PosAttrib = Mdl.GetVertexAttribute(PosAttribId);
+    ASSERT_EQ(PosAttrib.ValueType, VT_FLOAT32);
+    const std::vector<Uint8>& PosData   = Mdl.CPUVertexData[PosAttrib.BufferId];
+    const Uint32              PosStride = Mdl.GetVertexBufferStride(PosAttrib.BufferId);
+
+    const GLTF::MeshletData& Meshlets = Mdl.Meshlets;
+    for (Uint32 p = 0; p < 2; ++p)
+    {
+        const GLTF::Primitive& Prim = Prims[p];
+        ASSERT_EQ(Prim.MeshletCount, 1u);
+        ASSERT_LT(Prim.FirstMeshlet, Meshlets.Meshlets.size());
+
+        const GLTF::Meshlet& M = Meshlets.Meshlets[Prim.FirstMeshlet];
+        ASSERT_EQ(M.VertexCount, 3u);
+        ASSERT_LE(size_t{M.FirstVertex} + M.VertexCount, Meshlets.VertexIndices.size());
+        for (Uint32 v = 0; v < M.VertexCount; ++v)
+        {
+            const Uint32 Index = Meshlets.VertexIndices[M.FirstVertex + v];
+            EXPECT_LT(Index, Prim.VertexCount) << "Primitive " << p;
+
+            const size_t Vertex = size_t{Mdl.GetVertexRangeStart(Prim)} + Index;
+            ASSERT_LE((Vertex + 1) * PosStride, PosData.size());
+            float3 Pos;
+            memcpy(&Pos, &PosData[Vertex * PosStride + PosAttrib.RelativeOffset], sizeof(Pos));
+            EXPECT_EQ(Pos.z, static_cast<float>(p)) << "Primitive " << p << ", vertex " << v;
+        }
+    }
+}
+
+TEST(Tools_GLTFLoader, ComputeTransformsMatchesRecursiveTraversal)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI()};
+    ASSERT_EQ(Mdl.Nodes.size(), 6u);
+    ASSERT_EQ(Mdl.Scenes.size(), 1u);
+
+    // Every parent must precede its children in the flattened hierarchy
+    const GLTF::Scene& Scene = Mdl.Scenes[0];
+    ASSERT_EQ(Scene.HierarchyNodeIds.size(), Mdl.Nodes.size());
+    ASSERT_EQ(Scene.HierarchyParentIds.size(), Mdl.Nodes.size());
+    for (size_t i = 0; i < Scene.HierarchyNodeIds.size(); ++i)
+    {
+        const GLTF::Node& N = Mdl.Nodes[Scene.HierarchyNodeIds[i]];
+        EXPECT_EQ(Scene.HierarchyParentIds[i], N.Parent != nullptr ? N.Parent->Index : -1);
+        if (N.Parent != nullptr)
+        {
+            const auto parent_it = std::find(Scene.HierarchyNodeIds.begin(), Scene.HierarchyNodeIds.begin() + i, static_cast<Uint32>(N.Parent->Index));
+            EXPECT_NE(parent_it, Scene.HierarchyNodeIds.begin() + i);
+        }
+    }
+
+    const float4x4 RootTransform = float4x4::Scale(0.5f, 0.5f, 0.5f) * float4x4::Translation(10, 0, -2);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms, RootTransform);
+    ASSERT_TRUE(Mdl.CompatibleWithTransforms(Transforms));
+
+    std::vector<float4x4> RefMatrices(Mdl.Nodes.size());
+    for (const GLTF::Node* pRoot : Scene.RootNodes)
+        ComputeReferenceGlobalTransform(*pRoot, RootTransform, RefMatrices);
+
+    for (size_t i = 0; i < Mdl.Nodes.size(); ++i)
+    {
+        EXPECT_EQ(Transforms.NodeGlobalMatrices[i], RefMatrices[i]) << "Node " << i;
+        EXPECT_EQ(Transforms.NodeLocalMatrices[i], Mdl.Nodes[i].ComputeLocalTransform()) << "Node " << i;
+    }
+}
+
+TEST(Tools_GLTFLoader, UpdateTransformsRecomputesChangedSubtrees)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI()};
+    ASSERT_EQ(Mdl.Nodes.size(), 6u);
+
+    const float4x4 RootTransform = float4x4::Translation(1, -2, 3);
+
+    // The first update is a full update
+    GLTF::ModelTransforms Transforms;
+    Mdl.UpdateTransforms(0, Transforms, RootTransform);
+    EXPECT_TRUE(Transforms.IsIncrementalUpdateEnabled());
+    EXPECT_EQ(Transforms.ChangedNodes.size(), Mdl.Nodes.size());
+
+    // Nothing has changed
+    Mdl.UpdateTransforms(0, Transforms, RootTransform);
+    EXPECT_TRUE(Transforms.ChangedNodes.empty());
+
+    // Editing node A only updates A and its child C
+    const Uint32 NodeA = FindNode(Mdl, "A");
+    const Uint32 NodeC = FindNode(Mdl, "C");
+    const float3 NewTranslation{4, 5, 6};
+    Transforms.SetNodeTranslation(NodeA, NewTranslation);
+    Mdl.UpdateTransforms(0, Transforms, RootTransform);
+    EXPECT_EQ(Transforms.ChangedNodes, (std::vector<Uint32>{NodeA, NodeC}));
+
+    // The result must match the full computation with the same node transforms
+    GLTF::Model RefMdl{nullptr, nullptr, GetTransformTestModelCI()};
+    RefMdl.Nodes[NodeA].Translation = NewTranslation;
+
+    GLTF::ModelTransforms RefTransforms;
+    RefMdl.ComputeTransforms(0, RefTransforms, RootTransform);
+    for (size_t i = 0; i < Mdl.Nodes.size(); ++i)
+    {
+        EXPECT_EQ(Transforms.NodeGlobalMatrices[i], RefTransforms.NodeGlobalMatrices[i]) << "Node " << i;
+    }
+
+    // Changing the root transform results in a full update
+    Mdl.UpdateTransforms(0, Transforms, float4x4::Identity());
+    EXPECT_EQ(Transforms.ChangedNodes.size(), Mdl.Nodes.size());
+
+    // ComputeTransforms() resets the incremental state
+    Mdl.ComputeTransforms(0, Transforms);
+    EXPECT_FALSE(Transforms.IsIncrementalUpdateEnabled());
+}
+
+TEST(Tools_GLTFLoader, KeyFrameCursorMatchesBinarySearch)
+{
+    // A long clip sampled at 30 fps with a few repeated key frame times
+    GLTF::AnimationSampler Sampler{GLTF::AnimationSampler::INTERPOLATION_TYPE::LINEAR};
+    for (Uint32 i = 0; i < 3000; ++i)
+    {
+        Sampler.Inputs.push_back(static_cast<float>(i) / 30.f);
+        if (i % 500 == 0)
+            Sampler.Inputs.push_back(Sampler.Inputs.back());
+    }
+    const float Duration = Sampler.Inputs.back();
+
+    Uint32 Cursor = 0;
+
+    // Time advances monotonically with a delta smaller and larger than the key frame interval
+    for (float Delta : {1.f / 144.f, 1.f / 60.f, 1.f / 24.f})
+    {
+        for (float Time = -0.5f; Time < Duration + 0.5f; Time += Delta)
+        {
+            const size_t Idx = Sampler.FindKeyFrame(Time, Cursor);
+            EXPECT_EQ(Idx, Sampler.FindKeyFrame(Time)) << "Time " << Time;
+            EXPECT_EQ(Cursor, Idx);
+        }
+    }
+
+    // Time jumps and exact key frame times
+    for (float Time : {50.f, 10.f, 10.f, 0.f, Sampler.Inputs[1], Sampler.Inputs[500], Sampler.Inputs[501], Duration, Duration + 1.f, -1.f})
+    {
+        EXPECT_EQ(Sampler.FindKeyFrame(Time, Cursor), Sampler.FindKeyFrame(Time)) << "Time " << Time;
+    }
+
+    // Stale cursor from a longer sampler
+    Cursor = 100000;
+    EXPECT_EQ(Sampler.FindKeyFrame(1.f, Cursor), Sampler.FindKeyFrame(1.f));
+
+    // When time advances by less than the key frame interval, the key frame is always the cursor
+    // one or the next one, so every lookup is resolved by the two probes without a binary search,
+    // however long the clip is.
+    for (Uint32 NumKeys : {100u, 10000u})
+    {
+        GLTF::AnimationSampler LongSampler{GLTF::AnimationSampler::INTERPOLATION_TYPE::LINEAR};
+        for (Uint32 i = 0; i < NumKeys; ++i)
+            LongSampler.Inputs.push_back(static_cast<float>(i) / 30.f);
+
+        Uint32 NumLookups        = 0;
+        Uint32 NumBinarySearches = 0;
+        Cursor                   = 0;
+        for (float Time = 0; Time < LongSampler.Inputs.back() + 0.5f; Time += 1.f / 60.f, ++NumLookups)
+        {
+            const Uint32 PrevCursor = Cursor;
+            const size_t Idx        = LongSampler.FindKeyFrame(Time, Cursor);
+            if (Idx != PrevCursor && Idx != PrevCursor + 1)
+                ++NumBinarySearches;
+        }
+        EXPECT_GT(NumLookups, NumKeys);
+        EXPECT_EQ(NumBinarySearches, 0u) << NumKeys << " keys";
+    }
+}
+
+TEST(Tools_GLTFLoader, BatchedComputeTransformsMatchesSerial)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI(/*Animated = */ true)};
+    ASSERT_EQ(Mdl.Nodes.size(), 6u);
+    ASSERT_EQ(Mdl.Animations.size(), 1u);
+
+    constexpr size_t NumInstances = 100;
+
+    std::vector<GLTF::ModelTransforms>          Transforms(NumInstances);
+    std::vector<GLTF::ModelTransformsBatchItem> Items(NumInstances);
+    for (size_t i = 0; i < NumInstances; ++i)
+    {
+        GLTF::ModelTransformsBatchItem& Item = Items[i];
+        Item.pTransforms                     = &Transforms[i];
+        Item.RootTransform                   = float4x4::Translation(static_cast<float>(i), 0, -static_cast<float>(i));
+        Item.AnimationIndex                  = (i % 3 == 0) ? -1 : 0;
+        Item.Time                            = static_cast<float>(i % 25) * 0.1f;
+    }
+
+    auto CheckResults = [&]() {
+        for (size_t i = 0; i < NumInstances; ++i)
+        {
+            GLTF::ModelTransforms RefTransforms;
+            Mdl.ComputeTransforms(0, RefTransforms, Items[i].RootTransform, Items[i].AnimationIndex, Items[i].Time);
+            ASSERT_EQ(Transforms[i].NodeGlobalMatrices.size(), Mdl.Nodes.size());
+            for (size_t n = 0; n < Mdl.Nodes.size(); ++n)
+            {
+                EXPECT_EQ(Transforms[i].NodeGlobalMatrices[n], RefTransforms.NodeGlobalMatrices[n]) << "Instance " << i << ", node " << n;
+            }
+        }
+    };
+
+    // Animation must affect the results
+    {
+        GLTF::ModelTransforms T0, T1;
+        Mdl.ComputeTransforms(0, T0, float4x4::Identity(), 0, 0.5f);
+        Mdl.ComputeTransforms(0, T1, float4x4::Identity(), 0, 1.5f);
+        EXPECT_NE(T0.NodeGlobalMatrices[FindNode(Mdl, "C")], T1.NodeGlobalMatrices[FindNode(Mdl, "C")]);
+        EXPECT_NE(T0.NodeGlobalMatrices[FindNode(Mdl, "D")], T1.NodeGlobalMatrices[FindNode(Mdl, "D")]);
+    }
+
+    // Serial batch
+    Mdl.ComputeTransforms(0, Items.data(), Items.size());
+    CheckResults();
+
+    // Parallel batch with a chunk size that does not divide the number of items
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+    Transforms.assign(NumInstances, GLTF::ModelTransforms{});
+    Mdl.ComputeTransforms(0, Items.data(), Items.size(), pThreadPool, 7);
+    CheckResults();
+
+    // The batch only waits for its own tasks, not for unrelated work in the shared pool
+    std::atomic<bool> ReleaseBlocker{false};
+    std::atomic<bool> BlockerDone{false};
+    EnqueueAsyncWork(pThreadPool,
+                     [&ReleaseBlocker, &BlockerDone](Uint32 ThreadId) {
+                         const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+                         while (!ReleaseBlocker.load() && std::chrono::steady_clock::now() < Deadline)
+                             std::this_thread::yield();
+                         BlockerDone.store(true);
+                         return ASYNC_TASK_STATUS_COMPLETE;
+                     });
+    Transforms.assign(NumInstances, GLTF::ModelTransforms{});
+    Mdl.ComputeTransforms(0, Items.data(), Items.size(), pThreadPool, 7);
+    EXPECT_FALSE(BlockerDone.load());
+    CheckResults();
+
+    ReleaseBlocker.store(true);
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Tools_GLTFLoader, EvaluatesCubicSplineAnimation)
+{
+    // Key frames at 0 and 1:
+    //   in-tangent, value, out-tangent
+    //   (0, 0, 0), (0, 0, 0), (3, 0, 0)
+    //   (1, 0, 4), (1, 2, 0), (0, 0, 0)
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [{"name": "N"}],
+        "buffers": [{"byteLength": 80, "uri": "data:application/octet-stream;base64,AAAAAAAAgD8AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAEBAAAAAAAAAAAAAAIA/AAAAAAAAgEAAAIA/AAAAQAAAAAAAAAAAAAAAAAAAAAA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 8},
+            {"buffer": 0, "byteOffset": 8, "byteLength": 72}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 2, "type": "SCALAR", "min": [0], "max": [1]},
+            {"bufferView": 1, "componentType": 5126, "count": 6, "type": "VEC3"}
+        ],
+        "animations": [{
+            "samplers": [{"input": 0, "output": 1, "interpolation": "CUBICSPLINE"}],
+            "channels": [{"sampler": 0, "target": {"node": 0, "path": "translation"}}]
+        }]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("CubicSplineTest.gltf", Json)};
+    ASSERT_EQ(Mdl.Nodes.size(), 1u);
+    ASSERT_EQ(Mdl.Animations.size(), 1u);
+
+    // Hermite spline at t = 0.5: 0.5 * v0 + 0.125 * b0 + 0.5 * v1 - 0.125 * a1
+    const float3 Expected{0.75f, 1.f, -0.5f};
+
+    GLTF::ModelTransforms Transforms;
+    for (float Time : {0.f, 1.f})
+    {
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, Time);
+        EXPECT_EQ(Transforms.NodeAnimations.Translations[0], Time == 0 ? float3{0, 0, 0} : float3{1, 2, 0});
+    }
+
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.5f);
+    EXPECT_LT(length(Transforms.NodeAnimations.Translations[0] - Expected), 1e-6f);
+
+    // Baking at 10 fps puts a frame exactly at 0.5
+    Mdl.BakeAnimations(10);
+    ASSERT_TRUE(Mdl.Animations[0].IsBaked());
+    EXPECT_EQ(Mdl.Animations[0].BakedFrameCount, 11u);
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.5f);
+    EXPECT_LT(length(Transforms.NodeAnimations.Translations[0] - Expected), 1e-6f);
+}
+
+TEST(Tools_GLTFLoader, BakedAnimationMatchesSourceAnimation)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI(/*Animated = */ true)};
+
+    GLTF::ModelCreateInfo BakedCI = GetTransformTestModelCI(/*Animated = */ true);
+    BakedCI.AnimationBakeRate     = 60;
+    GLTF::Model BakedMdl{nullptr, nullptr, BakedCI};
+    ASSERT_EQ(BakedMdl.Animations.size(), 1u);
+    ASSERT_TRUE(BakedMdl.Animations[0].IsBaked());
+    EXPECT_FALSE(Mdl.Animations[0].IsBaked());
+    EXPECT_EQ(BakedMdl.Animations[0].BakedFrameCount, 121u);
+
+    GLTF::ModelTransforms Transforms, BakedTransforms;
+    for (float Time = -0.1f; Time < 2.2f; Time += 0.037f)
+    {
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, Time);
+        BakedMdl.ComputeTransforms(0, BakedTransforms, float4x4::Identity(), 0, Time);
+        for (size_t n = 0; n < Mdl.Nodes.size(); ++n)
+        {
+            const float4x4& Mat      = Transforms.NodeGlobalMatrices[n];
+            const float4x4& BakedMat = BakedTransforms.NodeGlobalMatrices[n];
+            for (size_t r = 0; r < 4; ++r)
+            {
+                for (size_t c = 0; c < 4; ++c)
+                    EXPECT_NEAR(Mat[r][c], BakedMat[r][c], 1e-3f) << "Time " << Time << ", node " << n;
+            }
+        }
+    }
+}
+
+TEST(Tools_GLTFLoader, CompressesAnimations)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI(/*Animated = */ true)};
+
+    constexpr float MaxError = 1e-3f;
+
+    std::vector<GLTF::AnimationCompressionStats> Stats;
+
+    GLTF::ModelCreateInfo CompressedCI      = GetTransformTestModelCI(/*Animated = */ true);
+    CompressedCI.AnimationCompressionError  = MaxError;
+    CompressedCI.pAnimationCompressionStats = &Stats;
+    GLTF::Model CompressedMdl{nullptr, nullptr, CompressedCI};
+    ASSERT_EQ(CompressedMdl.Animations.size(), 1u);
+    ASSERT_EQ(Stats.size(), 1u);
+
+    // The rotation is uniform, so its middle key is removed
+    EXPECT_EQ(Stats[0].OriginalKeyCount, 6u);
+    EXPECT_EQ(Stats[0].CompressedKeyCount, 5u);
+    EXPECT_LT(Stats[0].CompressedSize, Stats[0].OriginalSize);
+    EXPECT_LE(Stats[0].MaxTranslationError, MaxError);
+    EXPECT_LE(Stats[0].MaxRotationError, MaxError);
+    EXPECT_EQ(Stats[0].MaxScaleError, 0.f);
+
+    for (const GLTF::AnimationSampler& Sampler : CompressedMdl.Animations[0].Samplers)
+    {
+        EXPECT_NE(Sampler.OutputEncoding, GLTF::AnimationSampler::OUTPUT_ENCODING::FLOAT4);
+        EXPECT_TRUE(Sampler.OutputsVec4.empty());
+    }
+
+    GLTF::ModelTransforms Transforms, CompressedTransforms;
+    for (float Time = 0; Time < 2.1f; Time += 0.05f)
+    {
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, Time);
+        CompressedMdl.ComputeTransforms(0, CompressedTransforms, float4x4::Identity(), 0, Time);
+        for (size_t n = 0; n < Mdl.Nodes.size(); ++n)
+        {
+            EXPECT_LE(length(Transforms.NodeAnimations.Translations[n] - CompressedTransforms.NodeAnimations.Translations[n]), MaxError) << "Time " << Time << ", node " << n;
+
+            const float4& q0 = Transforms.NodeAnimations.Rotations[n].q;
+            const float4& q1 = CompressedTransforms.NodeAnimations.Rotations[n].q;
+            EXPECT_GE(std::abs(dot(q0, q1)), std::cos(MaxError * 0.5f)) << "Time " << Time << ", node " << n;
+        }
+    }
+}
+
+void ExpectAnimationTransformsNear(const GLTF::ModelTransforms& T0, const GLTF::ModelTransforms& T1, size_t NumNodes, float Tolerance)
+{
+    for (size_t n = 0; n < NumNodes; ++n)
+    {
+        EXPECT_LE(length(T0.NodeAnimations.Translations[n] - T1.NodeAnimations.Translations[n]), Tolerance) << "Node " << n;
+        EXPECT_LE(length(T0.NodeAnimations.Scales[n] - T1.NodeAnimations.Scales[n]), Tolerance) << "Node " << n;
+        EXPECT_GE(std::abs(dot(T0.NodeAnimations.Rotations[n].q, T1.NodeAnimations.Rotations[n].q)), 1 - Tolerance) << "Node " << n;
+        for (size_t r = 0; r < 4; ++r)
+        {
+            for (size_t c = 0; c < 4; ++c)
+                EXPECT_NEAR(T0.NodeGlobalMatrices[n][r][c], T1.NodeGlobalMatrices[n][r][c], Tolerance) << "Node " << n;
+        }
+    }
+}
+
+TEST(Tools_GLTFLoader, BlendsAnimationLayers)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetTransformTestModelCI(/*Animated = */ true)};
+    ASSERT_EQ(Mdl.Animations.size(), 1u);
+
+    const Uint32   NodeA         = FindNode(Mdl, "A");
+    const Uint32   NodeRoot2     = FindNode(Mdl, "Root2");
+    const float4x4 RootTransform = float4x4::Translation(1, 2, 3);
+
+    GLTF::ModelTransforms RefTransforms;
+    Mdl.ComputeTransforms(0, RefTransforms, RootTransform, 0, 0.7f);
+
+    // A single layer with the full weight is the same as the animation
+    {
+        GLTF::AnimationLayer Layer;
+        Layer.AnimationIndex = 0;
+        Layer.Time           = 0.7f;
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, &Layer, 1, RootTransform);
+        ExpectAnimationTransformsNear(Transforms, RefTransforms, Mdl.Nodes.size(), 1e-5f);
+
+        // A single additive layer over the rest pose also reproduces the animation
+        Layer.Additive = true;
+        Mdl.ComputeTransforms(0, Transforms, &Layer, 1, RootTransform);
+        ExpectAnimationTransformsNear(Transforms, RefTransforms, Mdl.Nodes.size(), 1e-5f);
+    }
+
+    // Two layers with equal weights
+    {
+        GLTF::AnimationLayer Layers[2];
+        Layers[0].AnimationIndex = 0;
+        Layers[0].Time           = 0.2f;
+        Layers[0].Weight         = 0.5f;
+        Layers[1].AnimationIndex = 0;
+        Layers[1].Time           = 1.6f;
+        Layers[1].Weight         = 0.5f;
+
+        GLTF::ModelTransforms T0, T1;
+        Mdl.ComputeTransforms(0, T0, float4x4::Identity(), 0, Layers[0].Time);
+        Mdl.ComputeTransforms(0, T1, float4x4::Identity(), 0, Layers[1].Time);
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, Layers, 2);
+
+        const float3 ExpectedTranslation = (T0.NodeAnimations.Translations[NodeA] + T1.NodeAnimations.Translations[NodeA]) * 0.5f;
+        EXPECT_LE(length(Transforms.NodeAnimations.Translations[NodeA] - ExpectedTranslation), 1e-5f);
+
+        // The normalized sum of two quaternions is the slerp midpoint
+        const QuaternionF ExpectedRotation = slerp(T0.NodeAnimations.Rotations[NodeRoot2], T1.NodeAnimations.Rotations[NodeRoot2], 0.5f);
+        EXPECT_GE(std::abs(dot(Transforms.NodeAnimations.Rotations[NodeRoot2].q, ExpectedRotation.q)), 1 - 1e-5f);
+    }
+
+    // The mask excludes node A from the layer, so it keeps the rest pose
+    {
+        std::vector<float> Mask(Mdl.Nodes.size(), 1.f);
+        Mask[NodeA] = 0;
+
+        GLTF::AnimationLayer Layer;
+        Layer.AnimationIndex = 0;
+        Layer.Time           = 0.7f;
+        Layer.pNodeWeights   = Mask.data();
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, &Layer, 1, RootTransform);
+        EXPECT_EQ(Transforms.NodeAnimations.Translations[NodeA], Mdl.Nodes[NodeA].Translation);
+        EXPECT_GE(std::abs(dot(Transforms.NodeAnimations.Rotations[NodeRoot2].q, RefTransforms.NodeAnimations.Rotations[NodeRoot2].q)), 1 - 1e-5f);
+    }
+}
+
+// Triangle (0, 0, 0), (1, 0, 0), (0, 1, 0) with two position targets:
+//   target 0 moves vertex 1 by (0, 0, 1), target 1 moves vertex 2 by (0, 2, 0).
+// The weights animation goes from (0, 0) at 0 to (1, 1) at 1.
+const std::string& GetMorphTargetTestJson()
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0]}],
+        "nodes": [{"name": "N", "mesh": 0, "weights": [0.25, 0]}],
+        "meshes": [{
+            "primitives": [{"attributes": {"POSITION": 0}, "targets": [{"POSITION": 1}, {"POSITION": 2}]}],
+            "weights": [0.5, 0]
+        }],
+        "buffers": [{"byteLength": 132, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAIA/AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAEAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAgD8AAIA/"}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 108, "byteLength": 8},
+            {"buffer": 0, "byteOffset": 116, "byteLength": 16}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 3, "componentType": 5126, "count": 2, "type": "SCALAR", "min": [0], "max": [1]},
+            {"bufferView": 4, "componentType": 5126, "count": 4, "type": "SCALAR"}
+        ],
+        "animations": [{
+            "samplers": [{"input": 3, "output": 4}],
+            "channels": [{"sampler": 0, "target": {"node": 0, "path": "weights"}}]
+        }]
+    })";
+    return Json;
+}
+
+TEST(Tools_GLTFLoader, AppliesMorphTargets)
+{
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("MorphTargetTest.gltf", GetMorphTargetTestJson())};
+    ASSERT_EQ(Mdl.Meshes.size(), 1u);
+    ASSERT_EQ(Mdl.Meshes[0].Primitives.size(), 1u);
+
+    const GLTF::Primitive& Prim = Mdl.Meshes[0].Primitives[0];
+    ASSERT_EQ(Prim.MorphTargetCount, 2u);
+    ASSERT_EQ(Mdl.MorphTargets.Targets.size(), 2u);
+    // Zero deltas are not stored
+    EXPECT_EQ(Mdl.MorphTargets.Deltas.size(), 2u);
+    EXPECT_EQ(Mdl.Meshes[0].MorphWeights, (std::vector<float>{0.5f, 0.f}));
+
+    // Node weights override the mesh weights
+    ASSERT_EQ(Mdl.Nodes[0].MorphWeightsOffset, 0);
+    EXPECT_EQ(Mdl.DefaultMorphWeights, (std::vector<float>{0.25f, 0.f}));
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+    EXPECT_EQ(Transforms.MorphWeights, Mdl.DefaultMorphWeights);
+
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.5f);
+    ASSERT_EQ(Transforms.MorphWeights.size(), 2u);
+    EXPECT_FLOAT_EQ(Transforms.MorphWeights[0], 0.5f);
+    EXPECT_FLOAT_EQ(Transforms.MorphWeights[1], 0.5f);
+
+    float3 Positions[] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    Mdl.ApplyMorphTargets(Prim, Transforms.MorphWeights.data(), Positions);
+    EXPECT_EQ(Positions[0], float3(0, 0, 0));
+    EXPECT_EQ(Positions[1], float3(1, 0, 0.5f));
+    EXPECT_EQ(Positions[2], float3(0, 2, 0));
+
+    // Weights are evaluated from the source samplers when the animation is baked
+    Mdl.BakeAnimations(10);
+    Transforms.MorphWeights.clear();
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.25f);
+    ASSERT_EQ(Transforms.MorphWeights.size(), 2u);
+    EXPECT_FLOAT_EQ(Transforms.MorphWeights[0], 0.25f);
+    EXPECT_FLOAT_EQ(Transforms.MorphWeights[1], 0.25f);
+}
+
+TEST(Tools_GLTFLoader, WritesCompactJointTransforms)
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1]}],
+        "nodes": [
+            {"name": "Mesh", "mesh": 0, "skin": 0, "translation": [1, 0, 0]},
+            {"name": "Joint", "translation": [0, 2, 0], "rotation": [0, 0, 0.70710678, 0.70710678], "scale": [2, 2, 2]}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+        "skins": [{"joints": [1]}],
+        "buffers": [{"byteLength": 36, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA"}],
+        "bufferViews": [{"buffer": 0, "byteOffset": 0, "byteLength": 36}],
+        "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]}]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("SkinTest.gltf", Json)};
+    ASSERT_EQ(Mdl.SkinTransformsCount, 1);
+    const GLTF::Node& MeshNode = Mdl.Nodes[FindNode(Mdl, "Mesh")];
+    ASSERT_NE(MeshNode.pSkin, nullptr);
+
+    // Blending no layers evaluates the rest pose and computes the joint matrices
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms, nullptr, 0);
+    ASSERT_EQ(Transforms.Skins.size(), 1u);
+    ASSERT_EQ(Transforms.Skins[0].JointMatrices.size(), 1u);
+
+    const float4x4& NodeGlobal = Transforms.NodeGlobalMatrices[MeshNode.Index];
+    const float4x4& JointMat   = Transforms.Skins[0].JointMatrices[0];
+    const float4x4  Expected   = Transforms.NodeGlobalMatrices[FindNode(Mdl, "Joint")] * NodeGlobal.Inverse();
+    EXPECT_EQ(Transforms.Skins[0].NodeGlobalMatrix, NodeGlobal);
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+            EXPECT_NEAR(JointMat[r][c], Expected[r][c], 1e-6f);
+    }
+
+    float Mat4x4[4][4] = {};
+    Mdl.WriteJointTransforms(MeshNode, Transforms, GLTF::JOINT_TRANSFORM_FORMAT_FLOAT4X4, Mat4x4);
+    float Mat3x4[3][4] = {};
+    Mdl.WriteJointTransforms(MeshNode, Transforms, GLTF::JOINT_TRANSFORM_FORMAT_FLOAT3X4, Mat3x4);
+    for (int r = 0; r < 4; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            EXPECT_EQ(Mat4x4[r][c], JointMat[r][c]);
+            if (c < 3)
+                EXPECT_EQ(Mat3x4[c][r], JointMat[r][c]);
+        }
+    }
+
+    // The dual quaternion transforms points like the joint matrix without its scale of 2
+    float4 DualQuat[2];
+    Mdl.WriteJointTransforms(MeshNode, Transforms, GLTF::JOINT_TRANSFORM_FORMAT_DUAL_QUATERNION, DualQuat);
+
+    const auto MultiplyQuaternions = [](const float4& a, const float4& b) {
+        return float4{
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        };
+    };
+    const float4& Real = DualQuat[0];
+    const float4& Dual = DualQuat[1];
+    const float4  Conj{-Real.x, -Real.y, -Real.z, Real.w};
+    EXPECT_NEAR(length(Real), 1.f, 1e-6f);
+
+    const float3 Pos{1, 2, 3};
+    const float3 Translation{JointMat[3][0], JointMat[3][1], JointMat[3][2]};
+    float3       MatPos = Translation;
+    for (int r = 0; r < 3; ++r)
+        MatPos += float3{JointMat[r][0], JointMat[r][1], JointMat[r][2]} * Pos[r] * 0.5f;
+
+    const float3 DualQuatPos = float3{MultiplyQuaternions(MultiplyQuaternions(Real, float4{Pos, 0}), Conj)} +
+        float3{MultiplyQuaternions(Dual, Conj)} * 2.f;
+    EXPECT_LT(length(DualQuatPos - MatPos), 1e-5f);
+}
+
+TEST(Tools_GLTFLoader, UpdateTransformsUpdatesDependentSkins)
+{
+    // Two skinned nodes with a shared joint and a joint of their own
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2, 3, 4]}],
+        "nodes": [
+            {"name": "Mesh0", "mesh": 0, "skin": 0},
+            {"name": "Mesh1", "mesh": 0, "skin": 1, "translation": [0, 0, 1]},
+            {"name": "Shared", "translation": [0, 1, 0]},
+            {"name": "Joint0", "translation": [1, 0, 0]},
+            {"name": "Joint1", "translation": [-1, 0, 0]}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+        "skins": [{"joints": [2, 3]}, {"joints": [2, 4]}],
+        "buffers": [{"byteLength": 36, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAA"}],
+        "bufferViews": [{"buffer": 0, "byteOffset": 0, "byteLength": 36}],
+        "accessors": [{"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]}]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("SkinDependencyTest.gltf", Json)};
+    ASSERT_EQ(Mdl.SkinTransformsCount, 2);
+
+    const Uint32 Mesh0  = FindNode(Mdl, "Mesh0");
+    const Uint32 Mesh1  = FindNode(Mdl, "Mesh1");
+    const Uint32 Shared = FindNode(Mdl, "Shared");
+    const Uint32 Joint0 = FindNode(Mdl, "Joint0");
+    const Uint32 Joint1 = FindNode(Mdl, "Joint1");
+
+    // Every node lists the skinned nodes that depend on it
+    const GLTF::Scene& Scene = Mdl.Scenes[0];
+    ASSERT_EQ(Scene.SkinDependencyOffsets.size(), Mdl.Nodes.size() + 1);
+    const auto GetDependencies = [&](Uint32 NodeId) {
+        std::vector<Uint32> Deps{Scene.SkinDependencies.begin() + Scene.SkinDependencyOffsets[NodeId],
+                                 Scene.SkinDependencies.begin() + Scene.SkinDependencyOffsets[NodeId + 1]};
+        std::sort(Deps.begin(), Deps.end());
+        return Deps;
+    };
+    EXPECT_EQ(GetDependencies(Mesh0), (std::vector<Uint32>{Mesh0}));
+    EXPECT_EQ(GetDependencies(Mesh1), (std::vector<Uint32>{Mesh1}));
+    EXPECT_EQ(GetDependencies(Shared), (std::vector<Uint32>{std::min(Mesh0, Mesh1), std::max(Mesh0, Mesh1)}));
+    EXPECT_EQ(GetDependencies(Joint0), (std::vector<Uint32>{Mesh0}));
+    EXPECT_EQ(GetDependencies(Joint1), (std::vector<Uint32>{Mesh1}));
+
+    const Uint32 Skin0 = static_cast<Uint32>(Mdl.Nodes[Mesh0].SkinTransformsIndex);
+    const Uint32 Skin1 = static_cast<Uint32>(Mdl.Nodes[Mesh1].SkinTransformsIndex);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.UpdateTransforms(0, Transforms);
+    ASSERT_EQ(Transforms.Skins.size(), 2u);
+    EXPECT_EQ(Transforms.ChangedSkins.size(), 2u);
+
+    const auto CheckSkins = [&](const GLTF::Model& RefMdl) {
+        GLTF::ModelTransforms RefTransforms;
+        RefMdl.ComputeTransforms(0, RefTransforms);
+        for (size_t s = 0; s < Transforms.Skins.size(); ++s)
+        {
+            EXPECT_EQ(Transforms.Skins[s].NodeGlobalMatrix, RefTransforms.Skins[s].NodeGlobalMatrix) << "Skin " << s;
+            EXPECT_EQ(Transforms.Skins[s].JointMatrices, RefTransforms.Skins[s].JointMatrices) << "Skin " << s;
+        }
+    };
+
+    GLTF::Model RefMdl{nullptr, nullptr, GetJsonModelCI("SkinDependencyTest.gltf", Json)};
+
+    // A joint of one skin only updates that skin
+    Transforms.SetNodeTranslation(Joint1, float3{-2, 0, 0});
+    RefMdl.Nodes[Joint1].Translation = float3{-2, 0, 0};
+    Mdl.UpdateTransforms(0, Transforms);
+    EXPECT_EQ(Transforms.ChangedSkins, (std::vector<Uint32>{Skin1}));
+    CheckSkins(RefMdl);
+
+    // The skinned node itself
+    Transforms.SetNodeTranslation(Mesh0, float3{0, 0, -1});
+    RefMdl.Nodes[Mesh0].Translation = float3{0, 0, -1};
+    Mdl.UpdateTransforms(0, Transforms);
+    EXPECT_EQ(Transforms.ChangedSkins, (std::vector<Uint32>{Skin0}));
+    CheckSkins(RefMdl);
+
+    // A shared joint and a joint of the same skin update every skin once
+    Transforms.SetNodeTranslation(Shared, float3{0, 3, 0});
+    Transforms.SetNodeTranslation(Joint0, float3{2, 0, 0});
+    RefMdl.Nodes[Shared].Translation = float3{0, 3, 0};
+    RefMdl.Nodes[Joint0].Translation = float3{2, 0, 0};
+    Mdl.UpdateTransforms(0, Transforms);
+    std::vector<Uint32> ChangedSkins = Transforms.ChangedSkins;
+    std::sort(ChangedSkins.begin(), ChangedSkins.end());
+    EXPECT_EQ(ChangedSkins, (std::vector<Uint32>{std::min(Skin0, Skin1), std::max(Skin0, Skin1)}));
+    CheckSkins(RefMdl);
+
+    // Nothing has changed
+    Mdl.UpdateTransforms(0, Transforms);
+    EXPECT_TRUE(Transforms.ChangedSkins.empty());
+}
+
+TEST(Tools_GLTFLoader, SkinsVerticesOnCpu)
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2]}],
+        "nodes": [
+            {"name": "Mesh", "mesh": 0, "skin": 0, "translation": [1, 0, 0]},
+            {"name": "Joint0", "translation": [0, 1, 0]},
+            {"name": "Joint1", "translation": [0, 0, 1], "rotation": [0, 0, 0.70710678, 0.70710678]}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "JOINTS_0": 2, "WEIGHTS_0": 3}}]}],
+        "skins": [{"joints": [1, 2]}],
+        "buffers": [{"byteLength": 132, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAACAPwAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAEAAAABAAAAAQAAAACAPwAAAAAAAAAAAAAAAAAAAD8AAAA/AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAA"}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 72, "byteLength": 12},
+            {"buffer": 0, "byteOffset": 84, "byteLength": 48}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 2, "componentType": 5121, "count": 3, "type": "VEC4"},
+            {"bufferView": 3, "componentType": 5126, "count": 3, "type": "VEC4"}
+        ]
+    })";
+
+    const float3 Positions[] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    const float3 Normals[]   = {{1, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    const float  Weights[]   = {0, 0.5f, 1};
+
+    // Plain float attributes and quantized positions with octahedral normals
+    for (float QuantizationError : {0.f, 1e-3f})
+    {
+        GLTF::ModelCreateInfo CI = GetJsonModelCI("CpuSkinningTest.gltf", Json);
+        CI.KeepCPUVertexData       = true;
+        CI.VertexQuantizationError = QuantizationError;
+
+        GLTF::Model Mdl{nullptr, nullptr, CI};
+        ASSERT_FALSE(Mdl.CPUVertexData.empty());
+        const GLTF::Node& MeshNode = Mdl.Nodes[FindNode(Mdl, "Mesh")];
+        ASSERT_NE(MeshNode.pMesh, nullptr);
+        const GLTF::Primitive& Prim = MeshNode.pMesh->Primitives[0];
+        ASSERT_EQ(Prim.VertexCount, 3u);
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, nullptr, 0);
+        ASSERT_EQ(Transforms.Skins.size(), 1u);
+        const std::vector<float4x4>& JointMatrices = Transforms.Skins[0].JointMatrices;
+        ASSERT_EQ(JointMatrices.size(), 2u);
+
+        float3 SkinnedPositions[3];
+        float3 SkinnedNormals[3];
+        ASSERT_TRUE(Mdl.SkinVertices(MeshNode, Prim, Transforms, SkinnedPositions, SkinnedNormals));
+
+        const float Tolerance = QuantizationError > 0 ? 1e-3f : 1e-5f;
+        for (Uint32 v = 0; v < 3; ++v)
+        {
+            float4x4 SkinMat;
+            for (int r = 0; r < 4; ++r)
+            {
+                for (int c = 0; c < 4; ++c)
+                    SkinMat[r][c] = JointMatrices[0][r][c] * (1 - Weights[v]) + JointMatrices[1][r][c] * Weights[v];
+            }
+
+            const float3 ExpectedPos    = float3{float4{Positions[v], 1} * SkinMat};
+            const float3 ExpectedNormal = normalize(float3{float4{Normals[v], 0} * SkinMat});
+            EXPECT_LT(length(SkinnedPositions[v] - ExpectedPos), Tolerance) << "Vertex " << v;
+            EXPECT_LT(length(SkinnedNormals[v] - ExpectedNormal), Tolerance) << "Vertex " << v;
+        }
+    }
+}
+
+TEST(Tools_GLTFLoader, SceneBVHFrustumCulling)
+{
+    // 16 x 16 x 4 static copies of a triangle on a grid with a spacing of 2,
+    // and one copy animated from the origin to (100, 0, 0).
+    constexpr Uint32 GridSize[] = {16, 16, 4};
+
+    std::string Nodes;
+    std::string SceneNodes;
+    Uint32      NumNodes = 0;
+    for (Uint32 z = 0; z < GridSize[2]; ++z)
+    {
+        for (Uint32 y = 0; y < GridSize[1]; ++y)
+        {
+            for (Uint32 x = 0; x < GridSize[0]; ++x, ++NumNodes)
+            {
+                Nodes += "{\"mesh\": 0, \"translation\": [" + std::to_string(x * 2) + ", " + std::to_string(y * 2) + ", " + std::to_string(z * 2) + "]},";
+                SceneNodes += std::to_string(NumNodes) + ", ";
+            }
+        }
+    }
+    Nodes += R"({"name": "Animated", "mesh": 0})";
+    SceneNodes += std::to_string(NumNodes);
+
+    const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [)" + SceneNodes + R"(]}],
+        "nodes": [)" + Nodes + R"(],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}}]}],
+        "animations": [{
+            "channels": [{"sampler": 0, "target": {"node": )" + std::to_string(NumNodes) + R"(, "path": "translation"}}],
+            "samplers": [{"input": 1, "output": 2}]
+        }],
+        "buffers": [{"byteLength": 68, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAMhCAAAAAAAAAAA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 8},
+            {"buffer": 0, "byteOffset": 44, "byteLength": 24}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5126, "count": 2, "type": "SCALAR", "min": [0], "max": [1]},
+            {"bufferView": 2, "componentType": 5126, "count": 2, "type": "VEC3"}
+        ]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("SceneBVHTest.gltf", Json)};
+    ASSERT_EQ(Mdl.Nodes.size(), NumNodes + 1);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.f);
+
+    GLTF::SceneBVH BVH;
+    BVH.Build(Mdl, 0, Transforms);
+    ASSERT_EQ(BVH.GetPrimitiveCount(), NumNodes + 1);
+    EXPECT_EQ(BVH.GetDynamicPrimitiveCount(), 1u);
+
+    // Axis-aligned frustum that contains the box [-0.5, 10.5] x [-0.5, 6.5] x [-0.5, 3.5]
+    ViewFrustum Frustum;
+    Frustum.LeftPlane   = Plane3D{float3{+1, 0, 0}, 0.5f};
+    Frustum.RightPlane  = Plane3D{float3{-1, 0, 0}, 10.5f};
+    Frustum.BottomPlane = Plane3D{float3{0, +1, 0}, 0.5f};
+    Frustum.TopPlane    = Plane3D{float3{0, -1, 0}, 6.5f};
+    Frustum.NearPlane   = Plane3D{float3{0, 0, +1}, 0.5f};
+    Frustum.FarPlane    = Plane3D{float3{0, 0, -1}, 3.5f};
+    const BoundBox FrustumBox{float3{-0.5f, -0.5f, -0.5f}, float3{10.5f, 6.5f, 3.5f}};
+
+    const auto CheckVisiblePrims = [&]() {
+        std::vector<Uint32> Expected;
+        for (const GLTF::Node& N : Mdl.Nodes)
+        {
+            const BoundBox BB = N.pMesh->Primitives[0].BB.Transform(Transforms.NodeGlobalMatrices[N.Index]);
+            if (BB.Max.x >= FrustumBox.Min.x && BB.Min.x <= FrustumBox.Max.x &&
+                BB.Max.y >= FrustumBox.Min.y && BB.Min.y <= FrustumBox.Max.y &&
+                BB.Max.z >= FrustumBox.Min.z && BB.Min.z <= FrustumBox.Max.z)
+                Expected.push_back(static_cast<Uint32>(N.Index));
+        }
+
+        std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+        EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims), Expected.size());
+
+        std::vector<Uint32> Visible;
+        for (const GLTF::ScenePrimitiveRef& Ref : VisiblePrims)
+        {
+            EXPECT_EQ(Ref.PrimitiveIndex, 0u);
+            Visible.push_back(Ref.NodeIndex);
+        }
+        std::sort(Visible.begin(), Visible.end());
+        EXPECT_EQ(Visible, Expected);
+        return Visible;
+    };
+
+    const Uint32 AnimatedNode = FindNode(Mdl, "Animated");
+
+    // 6 x 4 x 2 static copies and the animated one at the origin
+    std::vector<Uint32> Visible = CheckVisiblePrims();
+    EXPECT_EQ(Visible.size(), 6u * 4u * 2u + 1u);
+    EXPECT_TRUE(std::find(Visible.begin(), Visible.end(), AnimatedNode) != Visible.end());
+
+    // Brute force culling tests all 1025 boxes. The hierarchy only tests the nodes whose parents
+    // intersect the frustum and the primitives of the leaves that cross its boundary.
+    {
+        std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+        GLTF::SceneBVHQueryStats             Stats;
+        BVH.QueryVisible(Frustum, VisiblePrims, &Stats);
+        EXPECT_EQ(VisiblePrims.size(), Visible.size());
+        EXPECT_GT(Stats.NumNodeTests, 0u);
+        EXPECT_LT(Stats.NumNodeTests + Stats.NumPrimitiveTests, BVH.GetPrimitiveCount() / 2);
+    }
+
+    // Only the dynamic subtree is refitted after the animated node moves out of the frustum
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 1.f);
+    BVH.Refit(Transforms);
+    EXPECT_GE(BVH.GetBounds().Max.x, 100.f);
+    Visible = CheckVisiblePrims();
+    EXPECT_EQ(Visible.size(), 6u * 4u * 2u);
+    EXPECT_TRUE(std::find(Visible.begin(), Visible.end(), AnimatedNode) == Visible.end());
+
+    // Frustum that contains the whole scene
+    Frustum.RightPlane.Distance = 1000.f;
+    Frustum.TopPlane.Distance   = 1000.f;
+    Frustum.FarPlane.Distance   = 1000.f;
+    std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+    GLTF::SceneBVHQueryStats             Stats;
+    EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims, &Stats), NumNodes + 1);
+
+    // The root is entirely inside the frustum, so no other box is tested
+    EXPECT_EQ(Stats.NumNodeTests, 1u);
+    EXPECT_EQ(Stats.NumPrimitiveTests, 0u);
+}
+
+TEST(Tools_GLTFLoader, RayCast)
+{
+    // Unit quad of two triangles, (0, 1, 2) and (2, 1, 3), referenced by two nodes
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1]}],
+        "nodes": [
+            {"name": "A", "mesh": 0},
+            {"name": "B", "mesh": 0, "translation": [0, 0, 2], "scale": [2, 2, 2]}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]}],
+        "buffers": [{"byteLength": 60, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAACAPwAAgD8AAAAAAAABAAIAAgABAAMA"}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 48},
+            {"buffer": 0, "byteOffset": 48, "byteLength": 12}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5123, "count": 6, "type": "SCALAR"}
+        ]
+    })";
+
+    GLTF::ModelCreateInfo CI = GetJsonModelCI("RayCastTest.gltf", Json);
+    CI.BuildRayCastBVHs      = true;
+
+    GLTF::Model Mdl{nullptr, nullptr, CI};
+    ASSERT_EQ(Mdl.Meshes.size(), 1u);
+    EXPECT_EQ(Mdl.Meshes[0].RayCastBVH.GetTriangleCount(), 2u);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+
+    const int NodeA = static_cast<int>(FindNode(Mdl, "A"));
+    const int NodeB = static_cast<int>(FindNode(Mdl, "B"));
+
+    GLTF::ModelRayHit Hit;
+
+    // Distances are measured in the units of the direction length
+    EXPECT_TRUE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{0.25f, 0.25f, 10}, float3{0, 0, -2}}, Hit));
+    EXPECT_EQ(Hit.NodeIndex, NodeB);
+    EXPECT_EQ(Hit.PrimitiveIndex, 0u);
+    EXPECT_EQ(Hit.TriangleIndex, 0u);
+    EXPECT_NEAR(Hit.Distance, 4.f, 1e-5f);
+    EXPECT_NEAR(Hit.Barycentrics.x, 0.125f, 1e-5f);
+    EXPECT_NEAR(Hit.Barycentrics.y, 0.125f, 1e-5f);
+
+    EXPECT_TRUE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{1.5f, 1.5f, 10}, float3{0, 0, -1}}, Hit));
+    EXPECT_EQ(Hit.NodeIndex, NodeB);
+    EXPECT_EQ(Hit.TriangleIndex, 1u);
+    EXPECT_NEAR(Hit.Distance, 8.f, 1e-5f);
+
+    EXPECT_TRUE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{0.5f, 0.75f, -10}, float3{0, 0, 1}}, Hit));
+    EXPECT_EQ(Hit.NodeIndex, NodeA);
+    EXPECT_EQ(Hit.TriangleIndex, 1u);
+    EXPECT_NEAR(Hit.Distance, 10.f, 1e-5f);
+
+    EXPECT_FALSE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{0.25f, 0.25f, 10}, float3{0, 0, -1}, 5.f}, Hit));
+    EXPECT_FALSE(Hit.IsHit());
+    EXPECT_FALSE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{5, 5, 10}, float3{0, 0, -1}}, Hit));
+
+    // Batched rays processed by the thread pool produce the same hits
+    std::vector<GLTF::ModelRay> Rays;
+    for (Uint32 y = 0; y < 25; ++y)
+    {
+        for (Uint32 x = 0; x < 25; ++x)
+            Rays.push_back({float3{x * 0.1f - 0.2f, y * 0.1f - 0.2f, (x + y) % 2 == 0 ? 10.f : -10.f}, float3{0.01f, 0.02f, (x + y) % 2 == 0 ? -1.f : 1.f}});
+    }
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::vector<GLTF::ModelRayHit> Hits(Rays.size());
+    Mdl.RayCast(0, Transforms, Rays.data(), Rays.size(), Hits.data(), pThreadPool, 16);
+
+    Uint32 NumHits = 0;
+    for (size_t i = 0; i < Rays.size(); ++i)
+    {
+        GLTF::ModelRayHit RefHit;
+        Mdl.RayCast(0, Transforms, Rays[i], RefHit);
+        EXPECT_EQ(Hits[i].NodeIndex, RefHit.NodeIndex);
+        EXPECT_EQ(Hits[i].TriangleIndex, RefHit.TriangleIndex);
+        EXPECT_EQ(Hits[i].Distance, RefHit.Distance);
+        NumHits += Hits[i].IsHit() ? 1 : 0;
+    }
+    EXPECT_GT(NumHits, 0u);
+    EXPECT_LT(NumHits, Rays.size());
+
+    // The rays are cast while an unrelated task keeps a pool thread busy
+    std::atomic<bool> ReleaseBlocker{false};
+    std::atomic<bool> BlockerDone{false};
+    EnqueueAsyncWork(pThreadPool,
+                     [&ReleaseBlocker, &BlockerDone](Uint32 ThreadId) {
+                         const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+                         while (!ReleaseBlocker.load() && std::chrono::steady_clock::now() < Deadline)
+                             std::this_thread::yield();
+                         BlockerDone.store(true);
+                         return ASYNC_TASK_STATUS_COMPLETE;
+                     });
+    std::vector<GLTF::ModelRayHit> Hits2(Rays.size());
+    Mdl.RayCast(0, Transforms, Rays.data(), Rays.size(), Hits2.data(), pThreadPool, 16);
+    EXPECT_FALSE(BlockerDone.load());
+    for (size_t i = 0; i < Rays.size(); ++i)
+        EXPECT_EQ(Hits2[i].Distance, Hits[i].Distance);
+
+    ReleaseBlocker.store(true);
+    pThreadPool->WaitForAllTasks();
+}
+
+// Joint1 moves from (0, 0, 1) to (0, 0, 5)
+const std::string& GetSkinnedBoundsTestJson()
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2]}],
+        "nodes": [
+            {"name": "Mesh", "mesh": 0, "skin": 0, "translation": [1, 0, 0]},
+            {"name": "Joint0", "translation": [0, 1, 0]},
+            {"name": "Joint1", "translation": [0, 0, 1], "rotation": [0, 0, 0.70710678, 0.70710678]}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0, "JOINTS_0": 1, "WEIGHTS_0": 2}}]}],
+        "skins": [{"joints": [1, 2]}],
+        "animations": [{
+            "channels": [{"sampler": 0, "target": {"node": 2, "path": "translation"}}],
+            "samplers": [{"input": 3, "output": 4}]
+        }],
+        "buffers": [{"byteLength": 128, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAEAAAABAAAAAQAAAACAPwAAAAAAAAAAAAAAAAAAAD8AAAA/AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAAAAAgD8AAAAAAAAAAAAAoEA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 12},
+            {"buffer": 0, "byteOffset": 48, "byteLength": 48},
+            {"buffer": 0, "byteOffset": 96, "byteLength": 8},
+            {"buffer": 0, "byteOffset": 104, "byteLength": 24}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5121, "count": 3, "type": "VEC4"},
+            {"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC4"},
+            {"bufferView": 3, "componentType": 5126, "count": 2, "type": "SCALAR", "min": [0], "max": [1]},
+            {"bufferView": 4, "componentType": 5126, "count": 2, "type": "VEC3"}
+        ]
+    })";
+    return Json;
+}
+
+TEST(Tools_GLTFLoader, SkinnedAndAnimationBounds)
+{
+    for (float QuantizationError : {0.f, 1e-3f})
+    {
+        GLTF::ModelCreateInfo CI = GetJsonModelCI("SkinnedBoundsTest.gltf", GetSkinnedBoundsTestJson());
+        CI.KeepCPUVertexData         = true;
+        CI.VertexQuantizationError   = QuantizationError;
+        CI.ComputeJointBounds        = true;
+        CI.AnimationBoundsSampleRate = 10;
+
+        GLTF::Model Mdl{nullptr, nullptr, CI};
+        ASSERT_EQ(Mdl.Skins.size(), 1u);
+        const std::vector<BoundBox>& JointBounds = Mdl.Skins[0].JointBounds;
+        ASSERT_EQ(JointBounds.size(), 2u);
+
+        // Without inverse bind matrices, the joint space is the mesh space
+        const float Tolerance = QuantizationError > 0 ? 1e-3f : 1e-5f;
+        EXPECT_LT(length(JointBounds[0].Min - float3{0, 0, 0}), Tolerance);
+        EXPECT_LT(length(JointBounds[0].Max - float3{1, 0, 0}), Tolerance);
+        EXPECT_LT(length(JointBounds[1].Min - float3{0, 0, 0}), Tolerance);
+        EXPECT_LT(length(JointBounds[1].Max - float3{1, 1, 0}), Tolerance);
+
+        const GLTF::Node& MeshNode = Mdl.Nodes[FindNode(Mdl, "Mesh")];
+        ASSERT_NE(MeshNode.pMesh, nullptr);
+        const GLTF::Primitive& Prim = MeshNode.pMesh->Primitives[0];
+        ASSERT_EQ(Prim.VertexCount, 3u);
+
+        ASSERT_EQ(Mdl.Animations.size(), 1u);
+        const GLTF::Animation& Anim = Mdl.Animations[0];
+        ASSERT_TRUE(Anim.HasBounds());
+        // At the end of the animation, the last vertex is moved by Joint1 to (-1, 0, 5)
+        EXPECT_NEAR(Anim.Bounds.Max.z, 5.f, Tolerance);
+        EXPECT_NEAR(Anim.Bounds.Min.x, -1.f, Tolerance);
+
+        for (float Time : {0.f, 0.25f, 0.5f, 0.7f, 1.f})
+        {
+            GLTF::ModelTransforms Transforms;
+            Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, Time);
+
+            const BoundBox SkinnedBB = Mdl.ComputeSkinnedBoundingBox(MeshNode, Transforms);
+            const BoundBox ModelBB   = Mdl.ComputeBoundingBox(0, Transforms);
+            EXPECT_EQ(SkinnedBB.Min, ModelBB.Min);
+            EXPECT_EQ(SkinnedBB.Max, ModelBB.Max);
+
+            float3 SkinnedPositions[3];
+            ASSERT_TRUE(Mdl.SkinVertices(MeshNode, Prim, Transforms, SkinnedPositions));
+            for (Uint32 v = 0; v < 3; ++v)
+            {
+                // Skinned positions are in the space of the mesh node
+                const float3 Pos = float3{float4{SkinnedPositions[v], 1} * Transforms.NodeGlobalMatrices[MeshNode.Index]};
+                for (int c = 0; c < 3; ++c)
+                {
+                    EXPECT_GE(Pos[c], SkinnedBB.Min[c] - Tolerance) << "Vertex " << v << ", time " << Time;
+                    EXPECT_LE(Pos[c], SkinnedBB.Max[c] + Tolerance) << "Vertex " << v << ", time " << Time;
+                    EXPECT_GE(Pos[c], Anim.Bounds.Min[c] - Tolerance) << "Vertex " << v << ", time " << Time;
+                    EXPECT_LE(Pos[c], Anim.Bounds.Max[c] + Tolerance) << "Vertex " << v << ", time " << Time;
+                }
+            }
+        }
+    }
+}
+
+TEST(Tools_GLTFLoader, CookedFileKeepsAnimations)
+{
+    // Translation and morph target weights animations pass the validation of the cooked file
+    for (const std::string* pJson : {&GetSkinnedBoundsTestJson(), &GetMorphTargetTestJson()})
+    {
+        const ScopedTestFile CookedFile{"CookedAnimationTest.cooked"};
+
+        int NumSourceReads = 0;
+
+        GLTF::ModelCreateInfo CI = GetJsonModelCI("CookedAnimationTest.gltf", *pJson);
+        CI.CookedFileName        = CookedFile.GetPath();
+        CI.ReadWholeFileCallback = [&](const char*, std::vector<unsigned char>& Data, std::string&) {
+            ++NumSourceReads;
+            Data.assign(pJson->begin(), pJson->end());
+            return true;
+        };
+
+        GLTF::Model SourceModel{nullptr, nullptr, CI};
+        EXPECT_EQ(NumSourceReads, 2); // Source hash + document
+
+        NumSourceReads = 0;
+        GLTF::Model CachedModel{nullptr, nullptr, CI};
+        EXPECT_EQ(NumSourceReads, 1); // Source comparison only
+
+        ASSERT_EQ(CachedModel.Animations.size(), 1u);
+        ASSERT_EQ(SourceModel.Animations.size(), 1u);
+        const GLTF::Animation& SrcAnim    = SourceModel.Animations[0];
+        const GLTF::Animation& CookedAnim = CachedModel.Animations[0];
+        ASSERT_EQ(CookedAnim.Samplers.size(), SrcAnim.Samplers.size());
+        for (size_t i = 0; i < SrcAnim.Samplers.size(); ++i)
+        {
+            EXPECT_EQ(CookedAnim.Samplers[i].Inputs, SrcAnim.Samplers[i].Inputs);
+            EXPECT_EQ(CookedAnim.Samplers[i].OutputsVec4, SrcAnim.Samplers[i].OutputsVec4);
+            EXPECT_EQ(CookedAnim.Samplers[i].OutputWeights, SrcAnim.Samplers[i].OutputWeights);
+        }
+        EXPECT_EQ(CookedAnim.Channels.size(), SrcAnim.Channels.size());
+    }
+}
+
+TEST(Tools_GLTFLoader, SceneBVHFollowsSkinnedJoints)
+{
+    // Frustum around the end position of Joint1 at (0, 0, 5), away from the mesh node at (1, 0, 0)
+    ViewFrustum Frustum;
+    Frustum.LeftPlane   = Plane3D{float3{+1, 0, 0}, 2.f};
+    Frustum.RightPlane  = Plane3D{float3{-1, 0, 0}, 2.f};
+    Frustum.BottomPlane = Plane3D{float3{0, +1, 0}, 2.f};
+    Frustum.TopPlane    = Plane3D{float3{0, -1, 0}, 2.f};
+    Frustum.NearPlane   = Plane3D{float3{0, 0, +1}, -4.f};
+    Frustum.FarPlane    = Plane3D{float3{0, 0, -1}, 6.f};
+
+    {
+        GLTF::ModelCreateInfo CI = GetJsonModelCI("SkinnedBoundsTest.gltf", GetSkinnedBoundsTestJson());
+        CI.ComputeJointBounds    = true;
+
+        GLTF::Model  Mdl{nullptr, nullptr, CI};
+        const Uint32 MeshNode = FindNode(Mdl, "Mesh");
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.f);
+
+        GLTF::SceneBVH BVH;
+        BVH.Build(Mdl, 0, Transforms);
+        ASSERT_EQ(BVH.GetPrimitiveCount(), 1u);
+        EXPECT_EQ(BVH.GetDynamicPrimitiveCount(), 1u);
+
+        // In the bind pose, the mesh is far from the frustum
+        std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+        EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims), 0u);
+
+        // The node matrix does not change, but the joint moves the vertices into the frustum
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 1.f);
+        BVH.Refit(Transforms);
+        EXPECT_NEAR(BVH.GetBounds().Max.z, 5.f, 1e-5f);
+        EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims), 1u);
+        EXPECT_EQ(VisiblePrims, (std::vector<GLTF::ScenePrimitiveRef>{{MeshNode, 0}}));
+    }
+
+    // Without the joint bounds, the skinned primitive is never culled
+    {
+        GLTF::Model  Mdl{nullptr, nullptr, GetJsonModelCI("SkinnedBoundsTest.gltf", GetSkinnedBoundsTestJson())};
+        const Uint32 MeshNode = FindNode(Mdl, "Mesh");
+
+        GLTF::ModelTransforms Transforms;
+        Mdl.ComputeTransforms(0, Transforms, float4x4::Identity(), 0, 0.f);
+
+        GLTF::SceneBVH BVH;
+        BVH.Build(Mdl, 0, Transforms);
+        ASSERT_EQ(BVH.GetPrimitiveCount(), 1u);
+
+        std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+        EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims), 1u);
+        EXPECT_EQ(VisiblePrims, (std::vector<GLTF::ScenePrimitiveRef>{{MeshNode, 0}}));
+    }
+}
+
+TEST(Tools_GLTFLoader, DrawList)
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2, 3, 4]}],
+        "nodes": [
+            {"name": "Blend0", "mesh": 0},
+            {"name": "Blend1", "mesh": 0, "translation": [0, 0, -10]},
+            {"name": "NonIndexed", "mesh": 1},
+            {"name": "Mask", "mesh": 2},
+            {"name": "Opaque", "mesh": 3}
+        ],
+        "materials": [
+            {"name": "Opaque"},
+            {"name": "Blend", "alphaMode": "BLEND"},
+            {"name": "Mask", "alphaMode": "MASK", "doubleSided": true}
+        ],
+        "meshes": [
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 1}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "material": 0}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 2}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 0}]}
+        ],
+        "buffers": [{"byteLength": 44, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 6}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("DrawListTest.gltf", Json)};
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+
+    const auto CheckRecords = [&Mdl](const GLTF::DrawList& List, const std::vector<const char*>& ExpectedNodes) {
+        const std::vector<GLTF::DrawRecord>& Records = List.GetRecords();
+        ASSERT_EQ(Records.size(), ExpectedNodes.size());
+
+        size_t NumIndexedArgs = 0;
+        size_t NumArgs        = 0;
+        for (size_t i = 0; i < Records.size(); ++i)
+        {
+            const GLTF::DrawRecord& Record = Records[i];
+            EXPECT_EQ(Record.NodeIndex, FindNode(Mdl, ExpectedNodes[i])) << "Record " << i;
+            if (i > 0)
+                EXPECT_LE(Records[i - 1].SortKey, Record.SortKey);
+
+            const GLTF::Primitive& Prim = Mdl.Nodes[Record.NodeIndex].pMesh->Primitives[Record.PrimitiveIndex];
+            EXPECT_EQ(Record.MaterialId, Prim.MaterialId);
+            EXPECT_EQ(Record.AlphaMode, Mdl.Materials[Prim.MaterialId].Attribs.AlphaMode);
+            if (Record.IsIndexed())
+            {
+                ASSERT_LT(NumIndexedArgs, List.GetIndexedArgs().size());
+                const GLTF::DrawIndexedIndirectArgs& Args = List.GetIndexedArgs()[NumIndexedArgs++];
+                EXPECT_EQ(Args.NumIndices, Prim.IndexCount);
+                EXPECT_EQ(Args.NumInstances, 1u);
+                EXPECT_EQ(Args.FirstIndexLocation, Mdl.GetFirstIndexLocation(Prim.IndexType) + Prim.FirstIndex);
+                EXPECT_EQ(Args.BaseVertex, static_cast<Int32>(Mdl.GetBaseVertex() + Prim.FirstVertex));
+                EXPECT_EQ(Args.FirstInstanceLocation, Record.InstanceId);
+            }
+            else
+            {
+                ASSERT_LT(NumArgs, List.GetArgs().size());
+                const GLTF::DrawIndirectArgs& Args = List.GetArgs()[NumArgs++];
+                EXPECT_EQ(Args.NumVertices, Prim.VertexCount);
+                EXPECT_EQ(Args.NumInstances, 1u);
+                EXPECT_EQ(Args.StartVertexLocation, Mdl.GetBaseVertex() + Prim.FirstVertex);
+                EXPECT_EQ(Args.FirstInstanceLocation, Record.InstanceId);
+            }
+        }
+        EXPECT_EQ(NumIndexedArgs, List.GetIndexedArgs().size());
+        EXPECT_EQ(NumArgs, List.GetArgs().size());
+
+        // Batches cover all records, and the records of every batch share the state
+        Uint32 NumBatchedRecords = 0;
+        for (const GLTF::DrawBatch& Batch : List.GetBatches())
+        {
+            EXPECT_EQ(Batch.FirstRecord, NumBatchedRecords);
+            NumBatchedRecords += Batch.NumRecords;
+            for (Uint32 r = Batch.FirstRecord; r < Batch.FirstRecord + Batch.NumRecords; ++r)
+            {
+                EXPECT_EQ(Records[r].AlphaMode, Batch.AlphaMode);
+                EXPECT_EQ(Records[r].DoubleSided, Batch.DoubleSided);
+                EXPECT_EQ(Records[r].IndexType, Batch.IndexType);
+            }
+        }
+        EXPECT_EQ(NumBatchedRecords, Records.size());
+    };
+
+    {
+        // Opaque, masked and blended records. Indexed records precede non-indexed ones
+        // with the same material. Blended records are sorted back-to-front.
+        GLTF::DrawListBuildInfo BuildInfo;
+        BuildInfo.pTransforms  = &Transforms;
+        BuildInfo.ViewPosition = float3{0, 0, 5};
+
+        GLTF::DrawList List;
+        List.Build(Mdl, 0, BuildInfo);
+        CheckRecords(List, {"Opaque", "NonIndexed", "Mask", "Blend1", "Blend0"});
+        EXPECT_EQ(List.GetIndexedArgs().size(), 4u);
+        EXPECT_EQ(List.GetArgs().size(), 1u);
+
+        const std::vector<GLTF::DrawBatch>& Batches = List.GetBatches();
+        ASSERT_EQ(Batches.size(), 4u);
+        EXPECT_EQ(Batches[3].NumRecords, 2u);
+        EXPECT_EQ(Batches[3].FirstArgs, 2u);
+        EXPECT_EQ(Batches[1].FirstArgs, 0u);
+        EXPECT_FALSE(Batches[1].IsIndexed());
+        EXPECT_TRUE(Batches[2].DoubleSided);
+        for (const GLTF::DrawRecord& Record : List.GetRecords())
+            EXPECT_EQ(Record.InstanceId, Record.NodeIndex);
+    }
+
+    {
+        // Without transforms, blended records keep the scene order
+        GLTF::DrawListBuildInfo BuildInfo;
+        BuildInfo.InstanceIds = GLTF::DrawListBuildInfo::INSTANCE_IDS_RECORD_INDEX;
+
+        GLTF::DrawList List;
+        List.Build(Mdl, 0, BuildInfo);
+        CheckRecords(List, {"Opaque", "NonIndexed", "Mask", "Blend0", "Blend1"});
+        for (size_t i = 0; i < List.GetRecords().size(); ++i)
+            EXPECT_EQ(List.GetRecords()[i].InstanceId, i);
+    }
+
+    {
+        // Subset of the primitives, e.g. returned by SceneBVH::QueryVisible()
+        const std::vector<GLTF::ScenePrimitiveRef> Prims = {
+            {FindNode(Mdl, "Blend0"), 0},
+            {FindNode(Mdl, "Mask"), 0},
+        };
+
+        GLTF::DrawList List;
+        List.Build(Mdl, Prims.data(), Prims.size());
+        CheckRecords(List, {"Mask", "Blend0"});
+        EXPECT_EQ(List.GetBatches().size(), 2u);
+    }
+}
+
+TEST(Tools_GLTFLoader, DrawListKeepsSceneOrderOfBlendedRecords)
+{
+    // Blended primitives with different draw state. All primitives of a model loaded without
+    // a device share one vertex pool, so the state differs by the double-sided flag, which
+    // sets the state bits of the sort key like the vertex pool index does.
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2]}],
+        "nodes": [
+            {"name": "DoubleSided0", "mesh": 0},
+            {"name": "SingleSided", "mesh": 1},
+            {"name": "DoubleSided1", "mesh": 0}
+        ],
+        "materials": [
+            {"name": "DoubleSided", "alphaMode": "BLEND", "doubleSided": true},
+            {"name": "SingleSided", "alphaMode": "BLEND"}
+        ],
+        "meshes": [
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 0}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1, "material": 1}]}
+        ],
+        "buffers": [{"byteLength": 44, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAA="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 6}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ]
+    })";
+
+    GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("DrawListBlendOrderTest.gltf", Json)};
+
+    // Without transforms, the state must not reorder the blended records
+    GLTF::DrawList List;
+    List.Build(Mdl, 0);
+
+    const std::vector<GLTF::DrawRecord>& Records = List.GetRecords();
+    ASSERT_EQ(Records.size(), 3u);
+    EXPECT_EQ(Records[0].NodeIndex, FindNode(Mdl, "DoubleSided0"));
+    EXPECT_EQ(Records[1].NodeIndex, FindNode(Mdl, "SingleSided"));
+    EXPECT_EQ(Records[2].NodeIndex, FindNode(Mdl, "DoubleSided1"));
+    for (const GLTF::DrawRecord& Record : Records)
+        EXPECT_EQ(Record.SortKey, Records[0].SortKey);
+
+    // Every state change starts a new batch
+    const std::vector<GLTF::DrawBatch>& Batches = List.GetBatches();
+    ASSERT_EQ(Batches.size(), 3u);
+    EXPECT_TRUE(Batches[0].DoubleSided);
+    EXPECT_FALSE(Batches[1].DoubleSided);
+    EXPECT_TRUE(Batches[2].DoubleSided);
+}
+
+// Nodes A, B and C share mesh 0, node D is the only user of mesh 1,
+// and node E draws mesh 2 three times with EXT_mesh_gpu_instancing.
+const std::string& GetInstancingTestJson()
+{
+    static const std::string Json = R"({
+        "asset": {"version": "2.0"},
+        "extensionsUsed": ["EXT_mesh_gpu_instancing"],
+        "scene": 0,
+        "scenes": [{"nodes": [0, 1, 2, 3, 4]}],
+        "nodes": [
+            {"name": "A", "mesh": 0, "translation": [0, 0, -5]},
+            {"name": "B", "mesh": 0, "translation": [0, 0, -10]},
+            {"name": "C", "mesh": 0, "translation": [0, 0, -15]},
+            {"name": "D", "mesh": 1},
+            {"name": "E", "mesh": 2, "translation": [0, 5, 0], "extensions": {"EXT_mesh_gpu_instancing": {"attributes": {"TRANSLATION": 2, "SCALE": 3}}}}
+        ],
+        "meshes": [
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]},
+            {"primitives": [{"attributes": {"POSITION": 0}, "indices": 1}]}
+        ],
+        "buffers": [{"byteLength": 116, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAABAAIAAAAAAAAAAAAAAAAAAAAAACBBAAAAAAAAAAAAAKBBAAAAAAAAAAAAAIA/AACAPwAAgD8AAABAAAAAQAAAAEAAAIA/AACAPwAAgD8="}],
+        "bufferViews": [
+            {"buffer": 0, "byteOffset": 0, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 36, "byteLength": 6},
+            {"buffer": 0, "byteOffset": 44, "byteLength": 36},
+            {"buffer": 0, "byteOffset": 80, "byteLength": 36}
+        ],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+            {"bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR"},
+            {"bufferView": 2, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 3, "componentType": 5126, "count": 3, "type": "VEC3"}
+        ]
+    })";
+    return Json;
+}
+
+TEST(Tools_GLTFLoader, InstanceGroups)
+{
+    const std::string& Json = GetInstancingTestJson();
+
+    {
+        // Only the nodes with the extension are grouped by default
+        GLTF::Model Mdl{nullptr, nullptr, GetJsonModelCI("InstanceGroupsTest.gltf", Json)};
+        ASSERT_EQ(Mdl.Scenes[0].InstanceGroups.size(), 1u);
+        EXPECT_EQ(Mdl.Scenes[0].InstanceGroups[0].NodeIds, std::vector<Uint32>{FindNode(Mdl, "E")});
+        EXPECT_EQ(Mdl.Scenes[0].InstanceCount, 3u);
+    }
+
+    GLTF::ModelCreateInfo CI = GetJsonModelCI("InstanceGroupsTest.gltf", Json);
+    CI.InstancingMinNodeCount = 2;
+
+    GLTF::Model Mdl{nullptr, nullptr, CI};
+    const Uint32 NodeA = FindNode(Mdl, "A");
+    const Uint32 NodeB = FindNode(Mdl, "B");
+    const Uint32 NodeC = FindNode(Mdl, "C");
+    const Uint32 NodeE = FindNode(Mdl, "E");
+    ASSERT_EQ(Mdl.Nodes[NodeE].InstanceMatrices.size(), 3u);
+
+    const GLTF::Scene& Scene = Mdl.Scenes[0];
+    ASSERT_EQ(Scene.InstanceGroups.size(), 2u);
+    EXPECT_EQ(Scene.InstanceCount, 6u);
+
+    const GLTF::InstanceGroup& Group0 = Scene.InstanceGroups[0];
+    EXPECT_EQ(Group0.pMesh, Mdl.Nodes[NodeA].pMesh);
+    EXPECT_EQ(Group0.NodeIds, (std::vector<Uint32>{NodeA, NodeB, NodeC}));
+    EXPECT_EQ(Group0.FirstInstance, 0u);
+    EXPECT_EQ(Group0.InstanceCount, 3u);
+
+    const GLTF::InstanceGroup& Group1 = Scene.InstanceGroups[1];
+    EXPECT_EQ(Group1.NodeIds, std::vector<Uint32>{NodeE});
+    EXPECT_EQ(Group1.FirstInstance, 3u);
+    EXPECT_EQ(Group1.InstanceCount, 3u);
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.UpdateTransforms(0, Transforms);
+    ASSERT_EQ(Transforms.InstanceMatrices.size(), 6u);
+    for (Uint32 i = 0; i < 3; ++i)
+        EXPECT_TRUE(Transforms.InstanceMatrices[i] == Transforms.NodeGlobalMatrices[Group0.NodeIds[i]]) << "Instance " << i;
+
+    // The instances of node E are translated by (0, 0, 0), (10, 0, 0), (20, 0, 0) and the second one is scaled by 2
+    const float3 ExpectedOrigins[] = {{0, 5, 0}, {10, 5, 0}, {20, 5, 0}};
+    const float3 ExpectedX[]       = {{1, 5, 0}, {12, 5, 0}, {21, 5, 0}};
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        const float4x4& InstanceMatrix = Transforms.InstanceMatrices[Group1.FirstInstance + i];
+        EXPECT_LT(length(float3{float4{0, 0, 0, 1} * InstanceMatrix} - ExpectedOrigins[i]), 1e-5f) << "Instance " << i;
+        EXPECT_LT(length(float3{float4{1, 0, 0, 1} * InstanceMatrix} - ExpectedX[i]), 1e-5f) << "Instance " << i;
+    }
+
+    const BoundBox ModelBB = Mdl.ComputeBoundingBox(0, Transforms);
+    EXPECT_FLOAT_EQ(ModelBB.Max.x, 21.f);
+    EXPECT_FLOAT_EQ(ModelBB.Max.y, 7.f);
+
+    // Incremental updates only rewrite the instances of the changed nodes
+    Transforms.SetNodeTranslation(NodeB, float3{3, 0, 0});
+    Mdl.UpdateTransforms(0, Transforms);
+    EXPECT_TRUE(Transforms.InstanceMatrices[1] == Transforms.NodeGlobalMatrices[NodeB]);
+    EXPECT_EQ(Transforms.InstanceMatrices[1][3][0], 3.f);
+
+    // One instanced record per group primitive and a regular record for node D
+    GLTF::DrawListBuildInfo BuildInfo;
+    BuildInfo.UseInstanceGroups = true;
+
+    GLTF::DrawList List;
+    List.Build(Mdl, 0, BuildInfo);
+    const std::vector<GLTF::DrawRecord>& Records = List.GetRecords();
+    ASSERT_EQ(Records.size(), 3u);
+    ASSERT_EQ(List.GetIndexedArgs().size(), 3u);
+    for (size_t i = 0; i < Records.size(); ++i)
+    {
+        const GLTF::DrawRecord&              Record = Records[i];
+        const GLTF::DrawIndexedIndirectArgs& Args   = List.GetIndexedArgs()[i];
+        if (Record.IsInstanced())
+        {
+            const GLTF::InstanceGroup& Group = Scene.InstanceGroups[Record.InstanceGroupIndex];
+            EXPECT_EQ(Record.NodeIndex, Group.NodeIds[0]);
+            EXPECT_EQ(Args.NumInstances, Group.InstanceCount);
+            EXPECT_EQ(Args.FirstInstanceLocation, Group.FirstInstance);
+        }
+        else
+        {
+            EXPECT_EQ(Record.NodeIndex, FindNode(Mdl, "D"));
+            EXPECT_EQ(Args.NumInstances, 1u);
+            EXPECT_EQ(Args.FirstInstanceLocation, Record.NodeIndex);
+        }
+    }
+    EXPECT_EQ(List.GetBatches().size(), 2u);
+}
+
+TEST(Tools_GLTFLoader, SceneBVHEnclosesGpuInstances)
+{
+    GLTF::Model  Mdl{nullptr, nullptr, GetJsonModelCI("InstanceGroupsTest.gltf", GetInstancingTestJson())};
+    const Uint32 NodeE = FindNode(Mdl, "E");
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+
+    GLTF::SceneBVH BVH;
+    BVH.Build(Mdl, 0, Transforms);
+    ASSERT_EQ(BVH.GetPrimitiveCount(), 5u);
+
+    // The box of node E encloses its three instances: (0, 5, 0), (10, 5, 0) scaled by 2 and (20, 5, 0)
+    const auto CheckInstanceBounds = [&](const float3& Offset) {
+        for (size_t i = 0; i < BVH.GetPrimitiveCount(); ++i)
+        {
+            if (BVH.GetPrimitive(i).NodeIndex != NodeE)
+                continue;
+
+            const BoundBox& BB = BVH.GetPrimitiveBounds(i);
+            EXPECT_LT(length(BB.Min - (float3{0, 5, 0} + Offset)), 1e-5f);
+            EXPECT_LT(length(BB.Max - (float3{21, 7, 0} + Offset)), 1e-5f);
+        }
+    };
+    CheckInstanceBounds(float3{0, 0, 0});
+
+    // Only the last instance is inside the frustum around x = 20.5
+    ViewFrustum Frustum;
+    Frustum.LeftPlane   = Plane3D{float3{+1, 0, 0}, -19.5f};
+    Frustum.RightPlane  = Plane3D{float3{-1, 0, 0}, 22.f};
+    Frustum.BottomPlane = Plane3D{float3{0, +1, 0}, -4.f};
+    Frustum.TopPlane    = Plane3D{float3{0, -1, 0}, 8.f};
+    Frustum.NearPlane   = Plane3D{float3{0, 0, +1}, 1.f};
+    Frustum.FarPlane    = Plane3D{float3{0, 0, -1}, 1.f};
+
+    std::vector<GLTF::ScenePrimitiveRef> VisiblePrims;
+    EXPECT_EQ(BVH.QueryVisible(Frustum, VisiblePrims), 1u);
+    EXPECT_EQ(VisiblePrims, (std::vector<GLTF::ScenePrimitiveRef>{{NodeE, 0}}));
+
+    // Refitting also encloses the instances
+    Mdl.ComputeTransforms(0, Transforms, float4x4::Translation(0, 0, 5));
+    BVH.Refit(Transforms, /*RefitStatic = */ true);
+    CheckInstanceBounds(float3{0, 0, 5});
+}
+
+TEST(Tools_GLTFLoader, RayCastHitsGpuInstances)
+{
+    GLTF::ModelCreateInfo CI = GetJsonModelCI("InstanceGroupsTest.gltf", GetInstancingTestJson());
+    CI.BuildRayCastBVHs      = true;
+
+    GLTF::Model  Mdl{nullptr, nullptr, CI};
+    const Uint32 NodeE = FindNode(Mdl, "E");
+
+    GLTF::ModelTransforms Transforms;
+    Mdl.ComputeTransforms(0, Transforms);
+
+    // Rays along -Z through the triangles of the three instances of node E
+    const float2 Points[] = {{0.25f, 5.25f}, {10.5f, 5.5f}, {20.25f, 5.25f}};
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        GLTF::ModelRayHit Hit;
+        ASSERT_TRUE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{Points[i].x, Points[i].y, 10}, float3{0, 0, -1}}, Hit)) << "Instance " << i;
+        EXPECT_EQ(Hit.NodeIndex, static_cast<int>(NodeE));
+        EXPECT_EQ(Hit.InstanceIndex, i);
+        EXPECT_EQ(Hit.TriangleIndex, 0u);
+        EXPECT_NEAR(Hit.Distance, 10.f, 1e-5f);
+    }
+
+    // The second instance is scaled by 2, so this point is only inside its triangle
+    GLTF::ModelRayHit Hit;
+    EXPECT_TRUE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{11.5f, 5.25f, 10}, float3{0, 0, -1}}, Hit));
+    EXPECT_EQ(Hit.InstanceIndex, 1u);
+    EXPECT_FALSE(Mdl.RayCast(0, Transforms, GLTF::ModelRay{float3{21.5f, 5.25f, 10}, float3{0, 0, -1}}, Hit));
+}
+
+TEST(Tools_GLTFLoader, DrawListDrawsGpuInstancesWithoutGrouping)
+{
+    GLTF::ModelCreateInfo CI  = GetJsonModelCI("InstanceGroupsTest.gltf", GetInstancingTestJson());
+    CI.InstancingMinNodeCount = 2;
+
+    GLTF::Model  Mdl{nullptr, nullptr, CI};
+    const Uint32 NodeE = FindNode(Mdl, "E");
+
+    const GLTF::Scene& Scene = Mdl.Scenes[0];
+    ASSERT_EQ(Scene.InstanceGroups.size(), 2u);
+    const GLTF::InstanceGroup& GroupE = Scene.InstanceGroups[1];
+    ASSERT_EQ(GroupE.NodeIds, std::vector<Uint32>{NodeE});
+
+    // Nodes A, B, C and D are drawn by regular records, and node E by its three instances
+    const auto CheckRecords = [&](const GLTF::DrawList& List) {
+        const std::vector<GLTF::DrawRecord>& Records = List.GetRecords();
+        ASSERT_EQ(Records.size(), 5u);
+        ASSERT_EQ(List.GetIndexedArgs().size(), 5u);
+        for (size_t i = 0; i < Records.size(); ++i)
+        {
+            const GLTF::DrawRecord&              Record = Records[i];
+            const GLTF::DrawIndexedIndirectArgs& Args   = List.GetIndexedArgs()[i];
+            if (Record.NodeIndex == NodeE)
+            {
+                EXPECT_TRUE(Record.IsInstanced());
+                EXPECT_EQ(Record.InstanceGroupIndex, 1);
+                EXPECT_EQ(Args.NumInstances, 3u);
+                EXPECT_EQ(Args.FirstInstanceLocation, GroupE.FirstInstance);
+            }
+            else
+            {
+                EXPECT_FALSE(Record.IsInstanced());
+                EXPECT_EQ(Args.NumInstances, 1u);
+                EXPECT_EQ(Args.FirstInstanceLocation, Record.NodeIndex);
+            }
+        }
+    };
+
+    GLTF::DrawList List;
+    List.Build(Mdl, 0);
+    CheckRecords(List);
+
+    // The same records are built from the primitives of the scene
+    std::vector<GLTF::ScenePrimitiveRef> Prims;
+    for (const GLTF::Node* pNode : Scene.LinearNodes)
+    {
+        if (pNode->pMesh != nullptr)
+            Prims.push_back({static_cast<Uint32>(pNode->Index), 0});
+    }
+    List.Build(Mdl, Prims.data(), Prims.size());
+    CheckRecords(List);
+}
+
 } // namespace
@@ -0,0 +1,324 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFMeshOptimizer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Diligent;
+
+namespace
+{
+
+struct GridMesh
+{
+    std::vector<float>  Positions;
+    std::vector<Uint32> Indices;
+    Uint32              NumVertices = 0;
+};
+
+GridMesh CreateGrid(Uint32 Size)
+{
+    GridMesh Grid;
+    Grid.NumVertices = (Size + 1) * (Size + 1);
+    for (Uint32 y = 0; y <= Size; ++y)
+    {
+        for (Uint32 x = 0; x <= Size; ++x)
+        {
+            Grid.Positions.push_back(static_cast<float>(x));
+            Grid.Positions.push_back(static_cast<float>(y));
+            Grid.Positions.push_back(0);
+        }
+    }
+
+    for (Uint32 y = 0; y < Size; ++y)
+    {
+        for (Uint32 x = 0; x < Size; ++x)
+        {
+            const Uint32 v0 = y * (Size + 1) + x;
+            const Uint32 v1 = v0 + 1;
+            const Uint32 v2 = v0 + Size + 1;
+            const Uint32 v3 = v2 + 1;
+            Grid.Indices.insert(Grid.Indices.end(), {v0, v1, v2, v2, v1, v3});
+        }
+    }
+
+    return Grid;
+}
+
+void ShuffleTriangles(std::vector<Uint32>& Indices)
+{
+    std::vector<std::array<Uint32, 3>> Triangles(Indices.size() / 3);
+    for (size_t i = 0; i < Triangles.size(); ++i)
+        Triangles[i] = {Indices[i * 3 + 0], Indices[i * 3 + 1], Indices[i * 3 + 2]};
+
+    std::mt19937 Rng{12345};
+    std::shuffle(Triangles.begin(), Triangles.end(), Rng);
+
+    for (size_t i = 0; i < Triangles.size(); ++i)
+        std::copy(Triangles[i].begin(), Triangles[i].end(), Indices.begin() + i * 3);
+}
+
+// Returns the sorted list of triangles, each rotated so that its smallest index comes first.
+// Rotation preserves the winding, so two index buffers with the same result
+// describe the same triangles with the same orientation.
+std::vector<std::array<Uint32, 3>> GetCanonicalTriangles(const std::vector<Uint32>& Indices)
+{
+    std::vector<std::array<Uint32, 3>> Triangles(Indices.size() / 3);
+    for (size_t i = 0; i < Triangles.size(); ++i)
+    {
+        std::array<Uint32, 3>& Tri = Triangles[i];
+
+        Tri = {Indices[i * 3 + 0], Indices[i * 3 + 1], Indices[i * 3 + 2]};
+        std::rotate(Tri.begin(), std::min_element(Tri.begin(), Tri.end()), Tri.end());
+    }
+    std::sort(Triangles.begin(), Triangles.end());
+    return Triangles;
+}
+
+TEST(Tools_GLTFMeshOptimizer, ComputeVertexCacheStats)
+{
+    {
+        const Uint32 Indices[] = {0, 1, 2};
+
+        const GLTF::VertexCacheStats Stats = GLTF::MeshOptimizer::ComputeVertexCacheStats(Indices, 3, 3);
+        EXPECT_EQ(Stats.NumTriangles, 1u);
+        EXPECT_EQ(Stats.NumVertices, 3u);
+        EXPECT_EQ(Stats.NumTransformedVertices, 3u);
+        EXPECT_EQ(Stats.GetACMR(), 3.f);
+        EXPECT_EQ(Stats.GetATVR(), 1.f);
+    }
+
+    {
+        // Two triangles sharing an edge
+        const Uint32 Indices[] = {0, 1, 2, 2, 1, 3};
+
+        const GLTF::VertexCacheStats Stats = GLTF::MeshOptimizer::ComputeVertexCacheStats(Indices, 6, 4);
+        EXPECT_EQ(Stats.NumTriangles, 2u);
+        EXPECT_EQ(Stats.NumVertices, 4u);
+        EXPECT_EQ(Stats.NumTransformedVertices, 4u);
+        EXPECT_EQ(Stats.GetACMR(), 2.f);
+        EXPECT_EQ(Stats.GetATVR(), 1.f);
+    }
+
+    {
+        // Vertex 0 is evicted from the two-entry cache before it is used again
+        const Uint32 Indices[] = {0, 1, 2, 0, 2, 3};
+
+        const GLTF::VertexCacheStats Stats = GLTF::MeshOptimizer::ComputeVertexCacheStats(Indices, 6, 4, 2);
+        EXPECT_EQ(Stats.NumVertices, 4u);
+        EXPECT_EQ(Stats.NumTransformedVertices, 5u);
+    }
+}
+
+TEST(Tools_GLTFMeshOptimizer, OptimizeVertexCache)
+{
+    GridMesh Grid = CreateGrid(32);
+    ShuffleTriangles(Grid.Indices);
+
+    const auto                   SrcTriangles = GetCanonicalTriangles(Grid.Indices);
+    const GLTF::VertexCacheStats SrcStats     = GLTF::MeshOptimizer::ComputeVertexCacheStats(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+
+    GLTF::MeshOptimizer::OptimizeVertexCache(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+
+    const GLTF::VertexCacheStats DstStats = GLTF::MeshOptimizer::ComputeVertexCacheStats(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+    EXPECT_EQ(GetCanonicalTriangles(Grid.Indices), SrcTriangles);
+    EXPECT_EQ(DstStats.NumTriangles, SrcStats.NumTriangles);
+    EXPECT_EQ(DstStats.NumVertices, SrcStats.NumVertices);
+    EXPECT_GT(SrcStats.GetACMR(), 2.f);
+    EXPECT_LT(DstStats.GetACMR(), 0.8f);
+    EXPECT_LT(DstStats.GetATVR(), 1.5f);
+}
+
+TEST(Tools_GLTFMeshOptimizer, OptimizeOverdraw)
+{
+    GridMesh Grid = CreateGrid(32);
+    ShuffleTriangles(Grid.Indices);
+    GLTF::MeshOptimizer::OptimizeVertexCache(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+
+    const auto                   SrcTriangles = GetCanonicalTriangles(Grid.Indices);
+    const GLTF::VertexCacheStats SrcStats     = GLTF::MeshOptimizer::ComputeVertexCacheStats(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+
+    GLTF::MeshOptimizer::OptimizeOverdraw(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3, Grid.NumVertices, 1.05f);
+
+    const GLTF::VertexCacheStats DstStats = GLTF::MeshOptimizer::ComputeVertexCacheStats(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+    EXPECT_EQ(GetCanonicalTriangles(Grid.Indices), SrcTriangles);
+    EXPECT_LE(DstStats.GetACMR(), SrcStats.GetACMR() * 1.25f);
+}
+
+TEST(Tools_GLTFMeshOptimizer, ComputeVertexFetchRemap)
+{
+    const Uint32 Indices[] = {3, 1, 3, 0};
+
+    Uint32 Remap[5] = {};
+    EXPECT_EQ(GLTF::MeshOptimizer::ComputeVertexFetchRemap(Indices, 4, 5, Remap), 3u);
+    EXPECT_EQ(Remap[3], 0u);
+    EXPECT_EQ(Remap[1], 1u);
+    EXPECT_EQ(Remap[0], 2u);
+    // Unreferenced vertices keep their relative order
+    EXPECT_EQ(Remap[2], 3u);
+    EXPECT_EQ(Remap[4], 4u);
+}
+
+TEST(Tools_GLTFMeshOptimizer, BuildMeshlets)
+{
+    GridMesh Grid = CreateGrid(32);
+    GLTF::MeshOptimizer::OptimizeVertexCache(Grid.Indices.data(), Grid.Indices.size(), Grid.NumVertices);
+
+    constexpr Uint32 MaxVertices  = 64;
+    constexpr Uint32 MaxTriangles = 124;
+    constexpr Uint32 BaseVertex   = 100;
+
+    GLTF::MeshletData Data;
+    // Existing data must be preserved
+    Data.Meshlets.resize(1);
+    Data.VertexIndices.resize(3);
+    Data.Triangles.resize(1);
+
+    const Uint32 NumMeshlets = GLTF::MeshOptimizer::BuildMeshlets(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3,
+                                                                  Grid.NumVertices, BaseVertex, MaxVertices, MaxTriangles, Data);
+    ASSERT_EQ(Data.Meshlets.size(), size_t{NumMeshlets} + 1);
+    // 2048 triangles with at most 124 triangles per meshlet
+    EXPECT_GE(NumMeshlets, 17u);
+    EXPECT_LE(NumMeshlets, 40u);
+
+    std::vector<Uint32> MeshletIndices;
+    for (Uint32 m = 1; m < Data.Meshlets.size(); ++m)
+    {
+        const GLTF::Meshlet& M = Data.Meshlets[m];
+        EXPECT_GT(M.TriangleCount, 0u);
+        EXPECT_LE(M.TriangleCount, MaxTriangles);
+        EXPECT_LE(M.VertexCount, MaxVertices);
+        ASSERT_LE(M.FirstVertex + M.VertexCount, Data.VertexIndices.size());
+        ASSERT_LE(M.FirstTriangle + M.TriangleCount, Data.Triangles.size());
+
+        for (Uint32 t = 0; t < M.TriangleCount; ++t)
+        {
+            const Uint32 Tri = Data.Triangles[M.FirstTriangle + t];
+            EXPECT_EQ(Tri >> 24u, 0u);
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 LocalIndex = (Tri >> (i * 8u)) & 0xFFu;
+                ASSERT_LT(LocalIndex, M.VertexCount);
+                MeshletIndices.push_back(Data.VertexIndices[M.FirstVertex + LocalIndex] - BaseVertex);
+            }
+        }
+
+        const float3 Center{M.BoundingSphere.x, M.BoundingSphere.y, M.BoundingSphere.z};
+        for (Uint32 i = 0; i < M.VertexCount; ++i)
+        {
+            const Uint32 v = Data.VertexIndices[M.FirstVertex + i] - BaseVertex;
+            ASSERT_LT(v, Grid.NumVertices);
+            const float3 Pos{Grid.Positions[v * 3 + 0], Grid.Positions[v * 3 + 1], Grid.Positions[v * 3 + 2]};
+            EXPECT_LE(length(Pos - Center), M.BoundingSphere.w * 1.0001f);
+        }
+
+        // The grid is flat and all triangles have the same orientation
+        EXPECT_NEAR(std::abs(M.NormalCone.z), 1.f, 1e-5f);
+        EXPECT_NEAR(M.NormalCone.w, 0.f, 1e-3f);
+    }
+
+    // Every triangle is in exactly one meshlet
+    EXPECT_EQ(GetCanonicalTriangles(MeshletIndices), GetCanonicalTriangles(Grid.Indices));
+}
+
+TEST(Tools_GLTFMeshOptimizer, SimplifyMesh)
+{
+    auto GetPosition = [](const GridMesh& Grid, Uint32 v) {
+        return float3{Grid.Positions[v * 3 + 0], Grid.Positions[v * 3 + 1], Grid.Positions[v * 3 + 2]};
+    };
+
+    {
+        // Flat grid can be simplified without any error
+        GridMesh Grid = CreateGrid(32);
+
+        std::vector<Uint32> Indices(Grid.Indices.size());
+
+        float        Error      = -1;
+        const size_t NumIndices = GLTF::MeshOptimizer::SimplifyMesh(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3,
+                                                                    Grid.NumVertices, Grid.Indices.size() / 10, 0.01f, Indices.data(), &Error);
+        ASSERT_GT(NumIndices, 0u);
+        EXPECT_EQ(NumIndices % 3, 0u);
+        EXPECT_LE(NumIndices, Grid.Indices.size() / 10);
+        EXPECT_LE(Error, 1e-3f);
+
+        // The triangles must cover the grid without flips
+        float Area = 0;
+        for (size_t i = 0; i < NumIndices; i += 3)
+        {
+            ASSERT_LT(Indices[i + 0], Grid.NumVertices);
+            ASSERT_LT(Indices[i + 1], Grid.NumVertices);
+            ASSERT_LT(Indices[i + 2], Grid.NumVertices);
+
+            const float3 P0 = GetPosition(Grid, Indices[i + 0]);
+            const float3 P1 = GetPosition(Grid, Indices[i + 1]);
+            const float3 P2 = GetPosition(Grid, Indices[i + 2]);
+
+            const float3 N = cross(P1 - P0, P2 - P0);
+            EXPECT_GT(N.z, 0.f);
+            Area += N.z * 0.5f;
+        }
+        EXPECT_NEAR(Area, 32.f * 32.f, 1e-2f);
+    }
+
+    {
+        // Curved surface
+        GridMesh Grid = CreateGrid(32);
+        for (Uint32 v = 0; v < Grid.NumVertices; ++v)
+            Grid.Positions[v * 3 + 2] = std::sin(Grid.Positions[v * 3 + 0] * 0.2f) * std::cos(Grid.Positions[v * 3 + 1] * 0.2f) * 4.f;
+
+        std::vector<Uint32> Indices(Grid.Indices.size());
+
+        float        Error0      = -1;
+        const size_t NumIndices0 = GLTF::MeshOptimizer::SimplifyMesh(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3,
+                                                                     Grid.NumVertices, 0, 0.05f, Indices.data(), &Error0);
+        EXPECT_LT(NumIndices0, Grid.Indices.size());
+        EXPECT_LE(Error0, 0.05f);
+
+        float        Error1      = -1;
+        const size_t NumIndices1 = GLTF::MeshOptimizer::SimplifyMesh(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3,
+                                                                     Grid.NumVertices, 0, 0.5f, Indices.data(), &Error1);
+        EXPECT_LT(NumIndices1, NumIndices0);
+        EXPECT_GT(Error1, Error0);
+        EXPECT_LE(Error1, 0.5f);
+
+        // In-place simplification
+        const size_t NumIndices2 = GLTF::MeshOptimizer::SimplifyMesh(Grid.Indices.data(), Grid.Indices.size(), Grid.Positions.data(), sizeof(float) * 3,
+                                                                     Grid.NumVertices, 0, 0.5f, Grid.Indices.data());
+        EXPECT_EQ(NumIndices2, NumIndices1);
+        Grid.Indices.resize(NumIndices2);
+        Indices.resize(NumIndices1);
+        EXPECT_EQ(Grid.Indices, Indices);
+    }
+}
+
+} // namespace
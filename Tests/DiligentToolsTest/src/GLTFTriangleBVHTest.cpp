@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GLTFTriangleBVH.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Diligent;
+
+namespace
+{
+
+// Creates a Size x Size grid of quads displaced by a smooth height field.
+void CreateHeightField(Uint32 Size, std::vector<float3>& Positions, std::vector<Uint32>& Indices)
+{
+    for (Uint32 y = 0; y <= Size; ++y)
+    {
+        for (Uint32 x = 0; x <= Size; ++x)
+        {
+            const float fx = static_cast<float>(x);
+            const float fy = static_cast<float>(y);
+            Positions.emplace_back(fx, fy, std::sin(fx * 0.3f) * std::cos(fy * 0.2f) * 2.f);
+        }
+    }
+
+    for (Uint32 y = 0; y < Size; ++y)
+    {
+        for (Uint32 x = 0; x < Size; ++x)
+        {
+            const Uint32 v0 = y * (Size + 1) + x;
+            const Uint32 v1 = v0 + 1;
+            const Uint32 v2 = v0 + Size + 1;
+            const Uint32 v3 = v2 + 1;
+            Indices.insert(Indices.end(), {v0, v1, v2, v2, v1, v3});
+        }
+    }
+}
+
+// Reference closest-hit search that tests every triangle.
+GLTF::TriangleBVH::Hit RayCastBruteForce(const std::vector<float3>& Positions, const std::vector<Uint32>& Indices, const float3& Origin, const float3& Direction)
+{
+    GLTF::TriangleBVH::Hit Hit;
+    for (Uint32 t = 0; t < Indices.size() / 3; ++t)
+    {
+        const float3& V0 = Positions[Indices[t * 3 + 0]];
+        const float3  E1 = Positions[Indices[t * 3 + 1]] - V0;
+        const float3  E2 = Positions[Indices[t * 3 + 2]] - V0;
+
+        const float3 P   = cross(Direction, E2);
+        const float  Det = dot(E1, P);
+        if (std::abs(Det) < 1e-20f)
+            continue;
+
+        const float  InvDet = 1.f / Det;
+        const float3 S      = Origin - V0;
+        const float  U      = dot(S, P) * InvDet;
+        const float3 Q      = cross(S, E1);
+        const float  V      = dot(Direction, Q) * InvDet;
+        const float  D      = dot(E2, Q) * InvDet;
+        if (U >= 0 && U <= 1 && V >= 0 && U + V <= 1 && D >= 0 && D < Hit.Distance)
+        {
+            Hit.Distance   = D;
+            Hit.TriangleId = t;
+        }
+    }
+    return Hit;
+}
+
+TEST(Tools_GLTFTriangleBVH, Build)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateHeightField(32, Positions, Indices);
+    const Uint32 NumTriangles = static_cast<Uint32>(Indices.size() / 3);
+
+    GLTF::TriangleBVH BVH;
+    EXPECT_TRUE(BVH.IsEmpty());
+    BVH.Build(Positions.data(), static_cast<Uint32>(Positions.size()), Indices.data(), NumTriangles);
+    EXPECT_FALSE(BVH.IsEmpty());
+    EXPECT_EQ(BVH.GetTriangleCount(), NumTriangles);
+    EXPECT_LT(BVH.GetNodeCount(), size_t{NumTriangles} * 2);
+
+    const BoundBox Bounds = BVH.GetBounds();
+    EXPECT_EQ(Bounds.Min.x, 0.f);
+    EXPECT_EQ(Bounds.Min.y, 0.f);
+    EXPECT_EQ(Bounds.Max.x, 32.f);
+    EXPECT_EQ(Bounds.Max.y, 32.f);
+
+    // Triangles with out-of-range indices are skipped
+    Indices.insert(Indices.end(), {0, 1, static_cast<Uint32>(Positions.size())});
+    BVH.Build(Positions.data(), static_cast<Uint32>(Positions.size()), Indices.data(), NumTriangles + 1);
+    EXPECT_EQ(BVH.GetTriangleCount(), NumTriangles);
+
+    BVH.Build(Positions.data(), static_cast<Uint32>(Positions.size()), Indices.data(), 0);
+    EXPECT_TRUE(BVH.IsEmpty());
+}
+
+TEST(Tools_GLTFTriangleBVH, RayCast)
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    CreateHeightField(64, Positions, Indices);
+    const Uint32 NumTriangles = static_cast<Uint32>(Indices.size() / 3);
+
+    std::vector<Uint32> TriangleIds(NumTriangles);
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+        TriangleIds[t] = t + 1000;
+
+    GLTF::TriangleBVH BVH;
+    BVH.Build(Positions.data(), static_cast<Uint32>(Positions.size()), Indices.data(), NumTriangles, TriangleIds.data());
+
+    std::mt19937                          Rng{12345};
+    std::uniform_real_distribution<float> Coord{-8.f, 72.f};
+    std::uniform_real_distribution<float> Height{-4.f, 4.f};
+
+    Uint32 NumHits = 0;
+    for (Uint32 i = 0; i < 1000; ++i)
+    {
+        // Rays between random points above and below the height field, including grazing and missing rays
+        const float3 Start{Coord(Rng), Coord(Rng), Height(Rng) + 6.f};
+        const float3 End{Coord(Rng), Coord(Rng), Height(Rng) - 6.f};
+        const float3 Direction = End - Start;
+
+        const GLTF::TriangleBVH::Hit Expected = RayCastBruteForce(Positions, Indices, Start, Direction);
+
+        GLTF::TriangleBVH::Hit Hit;
+        const bool             Found = BVH.RayCast(Start, Direction, Hit);
+        EXPECT_EQ(Found, Expected.TriangleId != ~0u);
+        if (!Found || Expected.TriangleId == ~0u)
+            continue;
+
+        ++NumHits;
+        EXPECT_NEAR(Hit.Distance, Expected.Distance, 1e-5f);
+
+        // Rays that hit a shared edge may report either triangle, so check that
+        // the intersection point reconstructed from the barycentrics lies on the ray
+        const Uint32  Tri  = Hit.TriangleId - 1000;
+        const float3& V0   = Positions[Indices[Tri * 3 + 0]];
+        const float3& V1   = Positions[Indices[Tri * 3 + 1]];
+        const float3& V2   = Positions[Indices[Tri * 3 + 2]];
+        const float3  Bary = V0 + (V1 - V0) * Hit.U + (V2 - V0) * Hit.V;
+        EXPECT_LT(length(Bary - (Start + Direction * Hit.Distance)), 1e-3f);
+
+        // Intersections farther than the initial distance are not reported
+        GLTF::TriangleBVH::Hit ClippedHit;
+        ClippedHit.Distance = Expected.Distance * 0.5f;
+        EXPECT_FALSE(BVH.RayCast(Start, Direction, ClippedHit));
+        EXPECT_EQ(ClippedHit.TriangleId, ~0u);
+    }
+    EXPECT_GT(NumHits, 100u);
+}
+
+} // namespace
@@ -25,6 +25,7 @@
  */
 
 #include "GLTFVertexDataConverter.hpp"
+#include "GLTFLoader.hpp"
 
 #include "TestingEnvironment.hpp"
 #include "gtest/gtest.h"
@@ -33,6 +34,7 @@
 #include <array>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <vector>
 
 using namespace Diligent;
@@ -288,6 +290,209 @@ void TestWriteDefaultType()
     }
 }
 
+template <typename ValueType>
+ValueType MakeVaryingSourceValue(Uint32 Index)
+{
+    // Cover the full range of the type, including the extremes
+    return static_cast<ValueType>(Index * 2654435761u);
+}
+
+template <>
+Float32 MakeVaryingSourceValue<Float32>(Uint32 Index)
+{
+    // Values in [-1.5, 1.5] with a step of 1/64 cover both in-range and clamped values,
+    // as well as the exact rounding midpoints.
+    return static_cast<Float32>(static_cast<int>(Index % 193) - 96) / 64.f;
+}
+
+template <VALUE_TYPE SrcValueType, VALUE_TYPE DstValueType, bool IsNormalized>
+void TestSIMDMatchesScalar(Uint32 NumSrcComponents, Uint32 NumDstComponents, Uint32 SrcStridePadding)
+{
+    using SrcType = typename VALUE_TYPE2CType<SrcValueType>::CType;
+    using DstType = typename VALUE_TYPE2CType<DstValueType>::CType;
+
+    // Enough elements to run both the vector loop and the scalar tail
+    constexpr Uint32 NumElements = 257;
+    constexpr Uint8  Sentinel    = 0xA5;
+
+    const Uint32 SrcStride = sizeof(SrcType) * NumSrcComponents + SrcStridePadding;
+    const Uint32 DstStride = sizeof(DstType) * NumDstComponents + 3;
+
+    // The source buffer is sized exactly, so that any read past the last element is caught by sanitizers
+    std::vector<Uint8> SrcData(size_t{NumElements - 1} * SrcStride + sizeof(SrcType) * NumSrcComponents, 0xCD);
+    for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
+    {
+        for (Uint32 Cmp = 0; Cmp < NumSrcComponents; ++Cmp)
+            WriteValue(SrcData, size_t{Elem} * SrcStride + size_t{Cmp} * sizeof(SrcType), MakeVaryingSourceValue<SrcType>(Elem * NumSrcComponents + Cmp));
+    }
+
+    std::vector<Uint8> DstData[2];
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        DstData[i].resize(size_t{NumElements} * DstStride, Sentinel);
+
+        GLTF::VertexDataConverter::WriteAttribs Attribs{
+            SrcData.data(),
+            SrcValueType,
+            NumSrcComponents,
+            SrcStride,
+            DstData[i].data(),
+            DstValueType,
+            NumDstComponents,
+            DstStride,
+            NumElements,
+            IsNormalized,
+        };
+        Attribs.UseSIMD = i == 0;
+        ASSERT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+
+    EXPECT_EQ(DstData[0], DstData[1]) << GetValueTypeString(SrcValueType) << " -> " << GetValueTypeString(DstValueType)
+                                      << ", " << NumSrcComponents << " -> " << NumDstComponents << " components"
+                                      << (IsNormalized ? ", normalized" : "");
+}
+
+template <VALUE_TYPE SrcValueType, VALUE_TYPE DstValueType, bool IsNormalized>
+void TestSIMDMatchesScalarAllLayouts()
+{
+    for (Uint32 NumSrcComponents = 1; NumSrcComponents <= 4; ++NumSrcComponents)
+    {
+        for (Uint32 NumDstComponents = 1; NumDstComponents <= 4; ++NumDstComponents)
+        {
+            TestSIMDMatchesScalar<SrcValueType, DstValueType, IsNormalized>(NumSrcComponents, NumDstComponents, 0);
+            TestSIMDMatchesScalar<SrcValueType, DstValueType, IsNormalized>(NumSrcComponents, NumDstComponents, 2);
+            TestSIMDMatchesScalar<SrcValueType, DstValueType, IsNormalized>(NumSrcComponents, NumDstComponents, 16);
+        }
+    }
+}
+
+template <VALUE_TYPE DstValueType>
+void TestWriteDefaultSIMDMatchesScalar(Uint32 NumDstComponents)
+{
+    using DstType = typename VALUE_TYPE2CType<DstValueType>::CType;
+
+    constexpr Uint32 NumElements = 33;
+    constexpr Uint8  Sentinel    = 0x5A;
+
+    const Uint32 DstStride = sizeof(DstType) * NumDstComponents + 5;
+
+    std::array<DstType, 4> DefaultValue{};
+    for (Uint32 Cmp = 0; Cmp < NumDstComponents; ++Cmp)
+        DefaultValue[Cmp] = MakeDefaultValue<DstType>(Cmp);
+
+    std::vector<Uint8> DstData[2];
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        DstData[i].resize(size_t{NumElements} * DstStride, Sentinel);
+
+        GLTF::VertexDataConverter::WriteDefaultAttribs Attribs{
+            DefaultValue.data(),
+            DstData[i].data(),
+            DstValueType,
+            NumDstComponents,
+            DstStride,
+            NumElements,
+        };
+        Attribs.UseSIMD = i == 0;
+        ASSERT_TRUE(GLTF::VertexDataConverter::WriteDefault(Attribs));
+    }
+
+    EXPECT_EQ(DstData[0], DstData[1]) << GetValueTypeString(DstValueType) << ", " << NumDstComponents << " components";
+}
+
+float HalfToFloat(Uint16 Half)
+{
+    const float Sign     = (Half & 0x8000u) != 0 ? -1.f : 1.f;
+    const int   Exponent = (Half >> 10) & 0x1F;
+    const int   Mantissa = Half & 0x3FF;
+    if (Exponent == 0)
+        return Sign * std::ldexp(static_cast<float>(Mantissa), -24);
+    if (Exponent == 31)
+        return Mantissa == 0 ? Sign * std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    return Sign * std::ldexp(static_cast<float>(Mantissa + 1024), Exponent - 25);
+}
+
+std::array<float, 3> DecodeOctahedral(float u, float v)
+{
+    float       x = u;
+    float       y = v;
+    const float z = 1.f - std::abs(x) - std::abs(y);
+    const float t = std::max(-z, 0.f);
+    x += x >= 0 ? -t : t;
+    y += y >= 0 ? -t : t;
+
+    const float Len = std::sqrt(x * x + y * y + z * z);
+    return {x / Len, y / Len, z / Len};
+}
+
+// Unit vectors that cover the sphere, including the axes and the octahedron edges
+std::vector<std::array<float, 3>> MakeUnitVectors()
+{
+    std::vector<std::array<float, 3>> Vectors = {
+        {1, 0, 0},
+        {-1, 0, 0},
+        {0, 1, 0},
+        {0, -1, 0},
+        {0, 0, 1},
+        {0, 0, -1},
+        {0.70710678f, 0, -0.70710678f},
+        {0, -0.70710678f, -0.70710678f},
+    };
+
+    constexpr Uint32 NumRings    = 64;
+    constexpr Uint32 NumSegments = 128;
+    for (Uint32 Ring = 1; Ring < NumRings; ++Ring)
+    {
+        const float Theta = 3.14159265f * static_cast<float>(Ring) / NumRings;
+        for (Uint32 Segment = 0; Segment < NumSegments; ++Segment)
+        {
+            const float Phi = 2.f * 3.14159265f * (static_cast<float>(Segment) + 0.37f) / NumSegments;
+            Vectors.push_back({std::sin(Theta) * std::cos(Phi), std::sin(Theta) * std::sin(Phi), std::cos(Theta)});
+        }
+    }
+    return Vectors;
+}
+
+template <VALUE_TYPE DstValueType>
+float GetMaxOctahedralError()
+{
+    using DstType = typename VALUE_TYPE2CType<DstValueType>::CType;
+
+    const auto Vectors = MakeUnitVectors();
+
+    std::vector<DstType> DstData(Vectors.size() * 2);
+
+    GLTF::VertexDataConverter::WriteAttribs Attribs{
+        Vectors.data(),
+        VT_FLOAT32,
+        3,
+        sizeof(Vectors[0]),
+        DstData.data(),
+        DstValueType,
+        2,
+        sizeof(DstType) * 2,
+        static_cast<Uint32>(Vectors.size()),
+        false,
+    };
+    Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL;
+    EXPECT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+
+    constexpr float MaxValue = static_cast<float>(std::numeric_limits<DstType>::max());
+
+    float MaxError = 0;
+    for (size_t i = 0; i < Vectors.size(); ++i)
+    {
+        const float u = std::max(static_cast<float>(DstData[i * 2 + 0]) / MaxValue, -1.f);
+        const float v = std::max(static_cast<float>(DstData[i * 2 + 1]) / MaxValue, -1.f);
+
+        const auto  Decoded = DecodeOctahedral(u, v);
+        const auto& Vector  = Vectors[i];
+        for (size_t c = 0; c < 3; ++c)
+            MaxError = std::max(MaxError, std::abs(Decoded[c] - Vector[c]));
+    }
+    return MaxError;
+}
+
 } // namespace
 
 TEST(Tools_GLTFVertexDataConverter, WritesEverySupportedTypePair)
@@ -435,3 +640,268 @@ TEST(Tools_GLTFVertexDataConverter, WriteDefaultRejectsInvalidAttribs)
         EXPECT_FALSE(GLTF::VertexDataConverter::WriteDefault(Attribs));
     }
 }
+
+TEST(Tools_GLTFVertexDataConverter, SIMDMatchesScalar)
+{
+    TestSIMDMatchesScalarAllLayouts<VT_FLOAT32, VT_FLOAT32, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_FLOAT32, VT_UINT8, true>();
+    TestSIMDMatchesScalarAllLayouts<VT_FLOAT32, VT_UINT8, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_FLOAT32, VT_INT8, true>();
+    TestSIMDMatchesScalarAllLayouts<VT_FLOAT32, VT_INT8, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT8, VT_FLOAT32, true>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT8, VT_FLOAT32, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT16, VT_FLOAT32, true>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT16, VT_FLOAT32, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT8, VT_UINT8, false>();
+    TestSIMDMatchesScalarAllLayouts<VT_UINT16, VT_UINT16, false>();
+}
+
+TEST(Tools_GLTFVertexDataConverter, WriteDefaultSIMDMatchesScalar)
+{
+    for (Uint32 NumDstComponents = 1; NumDstComponents <= 4; ++NumDstComponents)
+    {
+        TestWriteDefaultSIMDMatchesScalar<VT_UINT8>(NumDstComponents);
+        TestWriteDefaultSIMDMatchesScalar<VT_UINT16>(NumDstComponents);
+        TestWriteDefaultSIMDMatchesScalar<VT_FLOAT32>(NumDstComponents);
+    }
+}
+
+TEST(Tools_GLTFVertexDataConverter, WritesHalfFloats)
+{
+    // clang-format off
+    const std::array<std::pair<Float32, Uint16>, 12> Values =
+    {{
+        {0.f,           0x0000},
+        {-0.f,          0x8000},
+        {1.f,           0x3C00},
+        {-2.f,          0xC000},
+        {0.1f,          0x2E66},
+        {65504.f,       0x7BFF},
+        {65519.f,       0x7BFF},
+        {65520.f,       0x7C00},
+        {1e10f,         0x7C00},
+        {5.9604645e-8f, 0x0001}, // 2^-24, the smallest denormal
+        {2.9802322e-8f, 0x0000}, // 2^-25 is the midpoint between 0 and 2^-24 and rounds to even
+        {1.0009766f,    0x3C01}, // 1 + 2^-10
+    }};
+    // clang-format on
+
+    std::vector<Float32> SrcData;
+    for (const auto& Value : Values)
+        SrcData.push_back(Value.first);
+
+    std::vector<Uint16> DstData(Values.size());
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write({
+        SrcData.data(),
+        VT_FLOAT32,
+        1,
+        sizeof(Float32),
+        DstData.data(),
+        VT_FLOAT16,
+        1,
+        sizeof(Uint16),
+        static_cast<Uint32>(Values.size()),
+        false,
+    }));
+
+    for (size_t i = 0; i < Values.size(); ++i)
+        EXPECT_EQ(DstData[i], Values[i].second) << Values[i].first;
+
+    // Every value in [-4, 4] must round-trip with the relative error of at most 2^-11
+    SrcData.clear();
+    for (int i = -4096; i <= 4096; ++i)
+        SrcData.push_back(static_cast<Float32>(i) * 0.000977f + 0.0001f);
+    DstData.resize(SrcData.size());
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write({
+        SrcData.data(),
+        VT_FLOAT32,
+        1,
+        sizeof(Float32),
+        DstData.data(),
+        VT_FLOAT16,
+        1,
+        sizeof(Uint16),
+        static_cast<Uint32>(SrcData.size()),
+        false,
+    }));
+    for (size_t i = 0; i < SrcData.size(); ++i)
+        EXPECT_LE(std::abs(HalfToFloat(DstData[i]) - SrcData[i]), std::max(std::abs(SrcData[i]) / 2048.f, 3e-8f)) << SrcData[i];
+}
+
+TEST(Tools_GLTFVertexDataConverter, WritesOctahedralVectors)
+{
+    EXPECT_LT(GetMaxOctahedralError<VT_INT16>(), 6e-5f);
+    EXPECT_LT(GetMaxOctahedralError<VT_INT8>(), 1.5e-2f);
+
+    // Tangent with handedness in the third component
+    const std::array<Float32, 8> Tangents = {0, 0, -1, -1, 0.6f, 0.8f, 0, 1};
+
+    std::array<Int16, 8> DstData{};
+
+    GLTF::VertexDataConverter::WriteAttribs Attribs{
+        Tangents.data(),
+        VT_FLOAT32,
+        4,
+        sizeof(Float32) * 4,
+        DstData.data(),
+        VT_INT16,
+        4,
+        sizeof(Int16) * 4,
+        2,
+        false,
+    };
+    Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL;
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+
+    // (0, 0, -1) maps to a corner of the unfolded octahedron
+    EXPECT_EQ(std::abs(DstData[0]), 32767);
+    EXPECT_EQ(std::abs(DstData[1]), 32767);
+    EXPECT_EQ(DstData[2], -32767);
+    EXPECT_EQ(DstData[3], 0);
+
+    const auto Decoded = DecodeOctahedral(DstData[4] / 32767.f, DstData[5] / 32767.f);
+    EXPECT_NEAR(Decoded[0], 0.6f, 1e-4f);
+    EXPECT_NEAR(Decoded[1], 0.8f, 1e-4f);
+    EXPECT_NEAR(Decoded[2], 0.0f, 1e-4f);
+    EXPECT_EQ(DstData[6], 32767);
+    EXPECT_EQ(DstData[7], 0);
+}
+
+TEST(Tools_GLTFVertexDataConverter, WritesPacked10_10_10_2)
+{
+    const std::array<Float32, 7> SrcData = {
+        1, -1, 0, -1,
+        -0.5f, 0.25f, 2, // Missing w is treated as +1, out-of-range values are clamped
+    };
+
+    std::array<Uint32, 2> DstData{};
+
+    GLTF::VertexDataConverter::WriteAttribs Attribs{
+        SrcData.data(),
+        VT_FLOAT32,
+        4,
+        sizeof(Float32) * 4,
+        DstData.data(),
+        VT_UINT32,
+        1,
+        sizeof(Uint32),
+        1,
+        false,
+    };
+    Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2;
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+
+    Attribs.pSrc             = &SrcData[4];
+    Attribs.pDst             = &DstData[1];
+    Attribs.NumSrcComponents = 3;
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+
+    EXPECT_EQ(DstData[0], 1023u | (0u << 10u) | (512u << 20u) | (0u << 30u));
+    EXPECT_EQ(DstData[1], 256u | (639u << 10u) | (1023u << 20u) | (3u << 30u));
+}
+
+TEST(Tools_GLTFVertexDataConverter, WritesAABBQuantizedPositions)
+{
+    const float BBMin[] = {-2, 0, 10};
+    const float BBMax[] = {2, 0, 12};
+
+    std::vector<Float32> Positions;
+    for (Uint32 i = 0; i <= 1000; ++i)
+    {
+        const float t = static_cast<float>(i) / 1000.f;
+        Positions.push_back(BBMin[0] + (BBMax[0] - BBMin[0]) * t);
+        Positions.push_back(0);
+        Positions.push_back(BBMax[2] - (BBMax[2] - BBMin[2]) * t * t);
+    }
+    const Uint32 NumVertices = static_cast<Uint32>(Positions.size() / 3);
+
+    std::vector<Uint16> DstData(size_t{NumVertices} * 4, 0xCDCD);
+
+    GLTF::VertexDataConverter::WriteAttribs Attribs{
+        Positions.data(),
+        VT_FLOAT32,
+        3,
+        sizeof(Float32) * 3,
+        DstData.data(),
+        VT_UINT16,
+        4,
+        sizeof(Uint16) * 4,
+        NumVertices,
+        false,
+    };
+    Attribs.Encoding         = GLTF::VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED;
+    Attribs.pQuantizationMin = BBMin;
+    Attribs.pQuantizationMax = BBMax;
+    ASSERT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            const float Decoded = BBMin[c] + static_cast<float>(DstData[v * 4 + c]) / 65535.f * (BBMax[c] - BBMin[c]);
+            EXPECT_NEAR(Decoded, Positions[v * 3 + c], (BBMax[c] - BBMin[c]) * 0.5f / 65535.f + 1e-6f);
+        }
+        EXPECT_EQ(DstData[v * 4 + 3], 0);
+    }
+    EXPECT_EQ(DstData[0], 0);
+    EXPECT_EQ(DstData[size_t{NumVertices - 1} * 4], 65535);
+}
+
+TEST(Tools_GLTFVertexDataConverter, WriteRejectsInvalidEncodings)
+{
+    const std::array<Float32, 3> SrcData{};
+    std::array<Uint32, 3>        DstData{};
+
+    const float BBMin[] = {0, 0, 0};
+    const float BBMax[] = {1, 1, 1};
+
+    GLTF::VertexDataConverter::WriteAttribs ValidAttribs{
+        SrcData.data(),
+        VT_FLOAT32,
+        3,
+        sizeof(SrcData),
+        DstData.data(),
+        VT_UINT16,
+        2,
+        sizeof(DstData),
+        1,
+        false,
+    };
+    ValidAttribs.pQuantizationMin = BBMin;
+    ValidAttribs.pQuantizationMax = BBMax;
+
+    {
+        auto Attribs     = ValidAttribs;
+        Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL;
+        EXPECT_FALSE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+    {
+        auto Attribs             = ValidAttribs;
+        Attribs.DstType          = VT_INT16;
+        Attribs.NumDstComponents = 1;
+        Attribs.Encoding         = GLTF::VERTEX_ATTRIBUTE_ENCODING_OCTAHEDRAL;
+        EXPECT_FALSE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+    {
+        auto Attribs     = ValidAttribs;
+        Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_PACKED_10_10_10_2;
+        EXPECT_FALSE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+    {
+        auto Attribs     = ValidAttribs;
+        Attribs.DstType  = VT_FLOAT32;
+        Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED;
+        EXPECT_FALSE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+    {
+        auto Attribs             = ValidAttribs;
+        Attribs.Encoding         = GLTF::VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED;
+        Attribs.pQuantizationMax = nullptr;
+        EXPECT_FALSE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+    {
+        auto Attribs     = ValidAttribs;
+        Attribs.Encoding = GLTF::VERTEX_ATTRIBUTE_ENCODING_AABB_QUANTIZED;
+        EXPECT_TRUE(GLTF::VertexDataConverter::Write(Attribs));
+    }
+}
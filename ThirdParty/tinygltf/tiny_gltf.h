@@ -1037,6 +1037,12 @@ class Node {
 struct Buffer {
   std::string name;
   std::vector<unsigned char> data;
+  // Non-owning view of the buffer data that is used instead of `data` when
+  // the data is referenced in place(e.g. in a memory-mapped file).
+  // The memory must outlive the model. `data` is empty in this case.
+  // Use GetData()/GetSize() to access the contents; the serializer does.
+  const unsigned char *external_data = nullptr;
+  size_t external_size = 0;
   std::string
       uri;  // considered as required here but not in the spec (need to clarify)
             // uri is not decoded(e.g. whitespace may be represented as %20)
@@ -1050,6 +1056,13 @@ struct Buffer {
   Buffer() = default;
   DEFAULT_METHODS(Buffer)
   bool operator==(const Buffer &) const;
+
+  const unsigned char *GetData() const {
+    return external_data != nullptr ? external_data : data.data();
+  }
+  size_t GetSize() const {
+    return external_data != nullptr ? external_size : data.size();
+  }
 };
 
 struct Asset {
@@ -1354,6 +1367,16 @@ typedef bool (*GetFileSizeFunction)(size_t *filesize_out, std::string *err,
                                     const std::string &abs_filename,
                                     void *userdata);
 
+///
+/// MapWholeFileFunction type. Signature for custom filesystem callbacks.
+/// Returns a pointer to the whole file contents that must stay valid for the
+/// lifetime of the model(e.g. a memory-mapped view of the file).
+///
+typedef bool (*MapWholeFileFunction)(const unsigned char **data_out,
+                                     size_t *size_out, std::string *err,
+                                     const std::string &abs_filename,
+                                     void *userdata);
+
 ///
 /// A structure containing all required filesystem callbacks and a pointer to
 /// their user data.
@@ -1365,6 +1388,8 @@ struct FsCallbacks {
   WriteWholeFileFunction WriteWholeFile;
   GetFileSizeFunction GetFileSizeInBytes;  // To avoid GetFileSize Win32 API,
                                            // add `InBytes` suffix.
+  MapWholeFileFunction MapWholeFile;  // Optional. When set, external buffer
+                                      // files are referenced in place.
 
   void *user_data;  // An argument that is passed to all fs callbacks
 };
@@ -1535,6 +1560,16 @@ class TinyGLTF {
     preserve_image_channels_ = onoff;
   }
 
+  ///
+  /// Specify whether the BIN chunk of a binary glTF is referenced in place
+  /// by Buffer::external_data instead of being copied to Buffer::data.
+  /// Only effective for `LoadBinaryFromMemory()`. The memory passed to it must
+  /// outlive the model.
+  ///
+  void SetReferenceBinaryChunk(bool onoff) { reference_bin_chunk_ = onoff; }
+
+  bool GetReferenceBinaryChunk() const { return reference_bin_chunk_; }
+
   ///
   /// Set maximum allowed external file size in bytes.
   /// Default: 2GB
@@ -1572,6 +1607,8 @@ class TinyGLTF {
   bool preserve_image_channels_ = false;  /// Default false(expand channels to
                                           /// RGBA) for backward compatibility.
 
+  bool reference_bin_chunk_ = false;
+
   size_t max_external_file_size_{
       size_t((std::numeric_limits<int32_t>::max)())};  // Default 2GB
 
@@ -1586,10 +1623,11 @@ class TinyGLTF {
       &tinygltf::ReadWholeFile,
       &tinygltf::WriteWholeFile,
       &tinygltf::GetFileSizeInBytes,
+      nullptr,
 
       nullptr  // Fs callback user data
 #else
-      nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
 
       nullptr  // Fs callback user data
 #endif
@@ -1986,7 +2024,10 @@ bool Asset::operator==(const Asset &other) const {
          this->minVersion == other.minVersion && this->version == other.version;
 }
 bool Buffer::operator==(const Buffer &other) const {
-  return this->data == other.data && this->extensions == other.extensions &&
+  return this->GetSize() == other.GetSize() &&
+         (this->GetSize() == 0 ||
+          memcmp(this->GetData(), other.GetData(), this->GetSize()) == 0) &&
+         this->extensions == other.extensions &&
          this->extras == other.extras && this->name == other.name &&
          this->uri == other.uri;
 }
@@ -4439,13 +4480,55 @@ static bool ParseOcclusionTextureInfo(
   return true;
 }
 
+static bool LoadExternalBuffer(Buffer *buffer, std::string *err,
+                               const std::string &filename,
+                               const std::string &basedir, size_t byteLength,
+                               size_t max_buffer_size, FsCallbacks *fs) {
+  if (fs != nullptr && fs->MapWholeFile != nullptr &&
+      fs->FileExists != nullptr && fs->ExpandFilePath != nullptr) {
+    std::vector<std::string> paths;
+    paths.push_back(basedir);
+    paths.push_back(".");
+
+    std::string filepath = FindFile(paths, filename, fs);
+    if (!filepath.empty()) {
+      const unsigned char *mapped_data = nullptr;
+      size_t mapped_size = 0;
+      std::string map_err;
+      if (fs->MapWholeFile(&mapped_data, &mapped_size, &map_err, filepath,
+                           fs->user_data) &&
+          mapped_data != nullptr) {
+        if (mapped_size != byteLength) {
+          if (err) {
+            std::stringstream ss;
+            ss << "File size mismatch : " << filepath << ", requestedBytes "
+               << byteLength << ", but got " << mapped_size << std::endl;
+            (*err) += ss.str();
+          }
+          return false;
+        }
+        buffer->data.clear();
+        buffer->external_data = mapped_data;
+        buffer->external_size = mapped_size;
+        return true;
+      }
+      // Fall back to reading the file
+    }
+  }
+
+  return LoadExternalFile(&buffer->data, err, /* warn */ nullptr, filename,
+                          basedir, /* required */ true, byteLength,
+                          /* checkSize */ true,
+                          /* max file size */ max_buffer_size, fs);
+}
+
 static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
                         bool store_original_json_for_extras_and_extensions,
                         FsCallbacks *fs, const URICallbacks *uri_cb,
                         const std::string &basedir,
                         const size_t max_buffer_size, bool is_binary = false,
                         const unsigned char *bin_data = nullptr,
-                        size_t bin_size = 0) {
+                        size_t bin_size = 0, bool reference_bin_data = false) {
   size_t byteLength;
   if (!ParseUnsignedProperty(&byteLength, err, o, "byteLength", true,
                              "Buffer")) {
@@ -4493,10 +4576,8 @@ static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
         if (!uri_cb->decode(buffer->uri, &decoded_uri, uri_cb->user_data)) {
           return false;
         }
-        if (!LoadExternalFile(&buffer->data, err, /* warn */ nullptr,
-                              decoded_uri, basedir, /* required */ true,
-                              byteLength, /* checkSize */ true,
-                              /* max_file_size */ max_buffer_size, fs)) {
+        if (!LoadExternalBuffer(buffer, err, decoded_uri, basedir, byteLength,
+                                max_buffer_size, fs)) {
           return false;
         }
       }
@@ -4522,9 +4603,16 @@ static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
         return false;
       }
 
-      // Read buffer data
-      buffer->data.resize(static_cast<size_t>(byteLength));
-      memcpy(&(buffer->data.at(0)), bin_data, static_cast<size_t>(byteLength));
+      if (reference_bin_data) {
+        // Reference buffer data in place
+        buffer->external_data = bin_data;
+        buffer->external_size = static_cast<size_t>(byteLength);
+      } else {
+        // Read buffer data
+        buffer->data.resize(static_cast<size_t>(byteLength));
+        memcpy(&(buffer->data.at(0)), bin_data,
+               static_cast<size_t>(byteLength));
+      }
     }
 
   } else {
@@ -4543,10 +4631,8 @@ static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
       if (!uri_cb->decode(buffer->uri, &decoded_uri, uri_cb->user_data)) {
         return false;
       }
-      if (!LoadExternalFile(&buffer->data, err, /* warn */ nullptr, decoded_uri,
-                            basedir, /* required */ true, byteLength,
-                            /* checkSize */ true,
-                            /* max file size */ max_buffer_size, fs)) {
+      if (!LoadExternalBuffer(buffer, err, decoded_uri, basedir, byteLength,
+                              max_buffer_size, fs)) {
         return false;
       }
     }
@@ -4895,7 +4981,7 @@ static bool ParseDracoExtension(Primitive *primitive, Model *model,
   view.dracoDecoded = true;
 
   const char *bufferViewData =
-      reinterpret_cast<const char *>(buffer.data.data() + view.byteOffset);
+      reinterpret_cast<const char *>(buffer.GetData() + view.byteOffset);
   size_t bufferViewSize = view.byteLength;
 
   // decode draco
@@ -6082,7 +6168,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
       if (!ParseBuffer(&buffer, err, o,
                        store_original_json_for_extras_and_extensions_, &fs,
                        &uri_cb, base_dir, max_external_file_size_, is_binary_,
-                       bin_data_, bin_size_)) {
+                       bin_data_, bin_size_, reference_bin_chunk_)) {
         return false;
       }
 
@@ -6378,7 +6464,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
         }
         bool ret = LoadImageData(
             &image, idx, err, warn, image.width, image.height,
-            &buffer.data[bufferView.byteOffset],
+            buffer.GetData() + bufferView.byteOffset,
             static_cast<int>(bufferView.byteLength), load_image_user_data);
         if (!ret) {
           return false;
@@ -6870,9 +6956,14 @@ bool TinyGLTF::LoadBinaryFromFile(Model *model, std::string *err,
 
   std::string basedir = GetBaseDir(filename);
 
+  // `data` is released when this function returns, so the BIN chunk
+  // cannot be referenced in place.
+  const bool reference_bin_chunk = reference_bin_chunk_;
+  reference_bin_chunk_ = false;
   bool ret = LoadBinaryFromMemory(model, err, warn, &data.at(0),
                                   static_cast<unsigned int>(data.size()),
                                   basedir, check_sections);
+  reference_bin_chunk_ = reference_bin_chunk;
 
   return ret;
 }
@@ -7107,12 +7198,12 @@ static void SerializeValue(const std::string &key, const Value &value,
   }
 }
 
-static void SerializeGltfBufferData(const std::vector<unsigned char> &data,
+static void SerializeGltfBufferData(const unsigned char *data, size_t size,
                                     detail::json &o) {
   std::string header = "data:application/octet-stream;base64,";
-  if (data.size() > 0) {
+  if (size > 0) {
     std::string encodedData =
-        base64_encode(&data[0], static_cast<unsigned int>(data.size()));
+        base64_encode(data, static_cast<unsigned int>(size));
     SerializeStringProperty("uri", header + encodedData, o);
   } else {
     // Issue #229
@@ -7121,7 +7212,7 @@ static void SerializeGltfBufferData(const std::vector<unsigned char> &data,
   }
 }
 
-static bool SerializeGltfBufferData(const std::vector<unsigned char> &data,
+static bool SerializeGltfBufferData(const unsigned char *data, size_t size,
                                     const std::string &binFilename) {
 #ifdef _WIN32
 #if defined(__GLIBCXX__)  // mingw
@@ -7142,9 +7233,9 @@ static bool SerializeGltfBufferData(const std::vector<unsigned char> &data,
   std::ofstream output(binFilename.c_str(), std::ofstream::binary);
   if (!output.is_open()) return false;
 #endif
-  if (data.size() > 0) {
-    output.write(reinterpret_cast<const char *>(&data[0]),
-                 std::streamsize(data.size()));
+  if (size > 0) {
+    output.write(reinterpret_cast<const char *>(data),
+                 std::streamsize(size));
   } else {
     // Issue #229
     // size 0 will be still valid buffer data.
@@ -7405,8 +7496,10 @@ static void SerializeGltfAsset(const Asset &asset, detail::json &o) {
 
 static void SerializeGltfBufferBin(const Buffer &buffer, detail::json &o,
                                    std::vector<unsigned char> &binBuffer) {
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
-  binBuffer = buffer.data;
+  // Use GetData()/GetSize() so that buffers referenced in place through
+  // `external_data` are written as well.
+  SerializeNumberProperty("byteLength", buffer.GetSize(), o);
+  binBuffer.assign(buffer.GetData(), buffer.GetData() + buffer.GetSize());
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);
 
@@ -7414,8 +7507,8 @@ static void SerializeGltfBufferBin(const Buffer &buffer, detail::json &o,
 }
 
 static void SerializeGltfBuffer(const Buffer &buffer, detail::json &o) {
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
-  SerializeGltfBufferData(buffer.data, o);
+  SerializeNumberProperty("byteLength", buffer.GetSize(), o);
+  SerializeGltfBufferData(buffer.GetData(), buffer.GetSize(), o);
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);
 
@@ -7425,8 +7518,10 @@ static void SerializeGltfBuffer(const Buffer &buffer, detail::json &o) {
 static bool SerializeGltfBuffer(const Buffer &buffer, detail::json &o,
                                 const std::string &binFilename,
                                 const std::string &binUri) {
-  if (!SerializeGltfBufferData(buffer.data, binFilename)) return false;
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
+  if (!SerializeGltfBufferData(buffer.GetData(), buffer.GetSize(),
+                               binFilename))
+    return false;
+  SerializeNumberProperty("byteLength", buffer.GetSize(), o);
   SerializeStringProperty("uri", binUri, o);
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);